@@ -0,0 +1,139 @@
+#!/usr/bin/env python
+
+# Reads interpreter opcode sequence counts from stdin and prints a
+# src/runtime/vm/superinst.h that fuses the hottest opcode pairs.
+#
+# Input lines look like:
+#   STAT OpSeq_CGetL_CGetL2                 123456
+#   STAT OpSeq_CGetL_CGetL2_Add              98765
+#
+# They are written by Stats::dump() at the end of each request when the
+# server runs with TRACE=stats:3.  Counts for the same sequence are summed
+# across requests (and threads), so a whole hphp.log can be piped in:
+#
+# src$ grep 'STAT OpSeq_' hphp.log | ../bin/superinst.py > runtime/vm/superinst.h
+#
+# Every hot triple contributes both of its pairs, so the interpreter runs
+# the whole triple fused; the remaining slots go to the hottest pairs.
+
+import optparse
+import sys
+
+HEADER = """/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+/*
+ * Interpreter superinstructions.
+ *
+ * Each S(a, b) entry fuses opcode b onto the end of opcode a's handler in
+ * VMExecutionContext::dispatchImpl: after a executes, if the next opcode is
+ * b, control jumps straight to b's handler instead of going back through
+ * the indirect dispatch.  Chains of pairs (e.g. CGetL, CGetL2, Add) run
+ * fused end to end.  T(b) lists every distinct b.
+ *
+ * This file is generated by bin/superinst.py from opcode sequence counts
+ * (TRACE=stats:3); regenerate it from a representative workload with:
+ *
+ *   grep 'STAT OpSeq_' hphp.log | bin/superinst.py > \\
+ *     src/runtime/vm/superinst.h
+ */
+
+#ifndef incl_VM_SUPERINST_H_
+#define incl_VM_SUPERINST_H_
+"""
+
+
+def parse(stream):
+    pairs = {}
+    triples = {}
+    for line in stream:
+        fields = line.split()
+        if len(fields) < 3 or fields[0] != 'STAT':
+            continue
+        if not fields[1].startswith('OpSeq_'):
+            continue
+        ops = tuple(fields[1][len('OpSeq_'):].split('_'))
+        count = int(fields[2])
+        if len(ops) == 2:
+            pairs[ops] = pairs.get(ops, 0) + count
+        elif len(ops) == 3:
+            triples[ops] = triples.get(ops, 0) + count
+    return pairs, triples
+
+
+def select(pairs, triples, max_pairs, min_share):
+    total = sum(pairs.values()) or 1
+    chosen = []
+
+    def add(pair):
+        if pair not in chosen and len(chosen) < max_pairs:
+            chosen.append(pair)
+
+    for ops, count in sorted(triples.items(), key=lambda kv: -kv[1]):
+        if float(count) / total < min_share * 2:
+            break
+        if len(chosen) + 2 > max_pairs:
+            break
+        add(ops[0:2])
+        add(ops[1:3])
+
+    for ops, count in sorted(pairs.items(), key=lambda kv: -kv[1]):
+        if float(count) / total < min_share:
+            break
+        add(ops)
+    return chosen, total
+
+
+def main():
+    parser = optparse.OptionParser()
+    parser.add_option('--max-pairs', type='int', default=24,
+                      help='maximum number of fused pairs')
+    parser.add_option('--min-share', type='float', default=0.002,
+                      help='ignore pairs below this fraction of all pairs')
+    options, _ = parser.parse_args()
+
+    pairs, triples = parse(sys.stdin)
+    if not pairs:
+        sys.stderr.write('no STAT OpSeq_ lines found on stdin\n')
+        return 1
+    chosen, total = select(pairs, triples, options.max_pairs,
+                           options.min_share)
+
+    # The shares only go to stderr, so regenerating from a similar workload
+    # doesn't rewrite every line of the header.
+    for a, b in chosen:
+        share = 100.0 * pairs.get((a, b), 0) / total
+        sys.stderr.write('%-32s %6.2f%%\n' % ('%s, %s' % (a, b), share))
+
+    succs = []
+    for a, b in chosen:
+        if b not in succs:
+            succs.append(b)
+
+    out = sys.stdout
+    out.write(HEADER)
+    out.write('\n#define SUPERINSTS')
+    for a, b in chosen:
+        out.write(' \\\n  S(%s, %s)' % (a, b))
+    out.write('\n\n#define SUPERINST_SUCCS')
+    for b in succs:
+        out.write(' \\\n  T(%s)' % b)
+    out.write('\n\n#endif\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
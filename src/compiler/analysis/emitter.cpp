@@ -22,6 +22,7 @@
 #include <runtime/vm/bytecode.h>
 #include <runtime/vm/peephole.h>
 #include <runtime/vm/repo.h>
+#include <runtime/vm/repo_image.h>
 #include <runtime/vm/as.h>
 #include <runtime/base/runtime_option.h>
 #include <runtime/base/zend/zend_string.h>
@@ -5563,6 +5564,9 @@ static ConstructPtr doOptimize(ConstructPtr c, AnalysisResultConstPtr ar) {
   return ConstructPtr();
 }
 
+// Set by emitAllHHBC() while an offline repo image is being built.
+static HPHP::VM::RepoImageBuilder* s_repoImageBuilder = NULL;
+
 static Unit* emitHHBCUnit(AnalysisResultPtr ar, FileScopePtr fsp,
                           const MD5& md5, UnitOrigin unitOrigin, bool commit) {
   if (fsp->getPseudoMain()) {
@@ -5606,6 +5610,9 @@ static Unit* emitHHBCUnit(AnalysisResultPtr ar, FileScopePtr fsp,
   if (commit) {
     HPHP::VM::Repo::get().commitUnit(ue, unitOrigin);
   }
+  if (s_repoImageBuilder && unitOrigin == UnitOriginFile) {
+    s_repoImageBuilder->add(*ue);
+  }
   Unit* unit = ue->create();
   delete ue;
   return unit;
@@ -5943,9 +5950,19 @@ void emitAllHHBC(AnalysisResultPtr ar) {
   JobQueueDispatcher<EmitterWorker::JobType, EmitterWorker>
     dispatcher(threadCount, true, 0, false, ar.get());
 
+  HPHP::VM::RepoImageBuilder builder;
+  if (Option::GenerateImageHHBC) {
+    s_repoImageBuilder = &builder;
+  }
+
   dispatcher.start();
   ar->visitFiles(addEmitterWorker, &dispatcher);
   dispatcher.waitEmpty();
+
+  if (s_repoImageBuilder) {
+    s_repoImageBuilder = NULL;
+    builder.write(Option::RepoImagePath);
+  }
 }
 
 
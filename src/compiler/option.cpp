@@ -78,7 +78,9 @@ map<string, string> Option::FunctionSections;
 
 bool Option::GenerateTextHHBC = false;
 bool Option::GenerateBinaryHHBC = false;
+bool Option::GenerateImageHHBC = false;
 string Option::RepoCentralPath;
+string Option::RepoImagePath;
 bool Option::RepoDebugInfo = false;
 
 #if defined(HPHP_OSS)
@@ -181,7 +181,9 @@ public:
    */
   static bool GenerateTextHHBC;
   static bool GenerateBinaryHHBC;
+  static bool GenerateImageHHBC;
   static std::string RepoCentralPath;
+  static std::string RepoImagePath;
   static bool RepoDebugInfo;
 
   /**
@@ -229,7 +229,7 @@ int prepareOptions(ProgramOptions &po, int argc, char **argv) {
      "analyze: (none); \n"
      "php: trimmed (default) | inlined | pickled | typeinfo |"
      " <any combination of them by any separator>; \n"
-     "hhbc: binary (default) | text; \n"
+     "hhbc: binary (default) | text | image; \n"
      "cpp: cluster (default) | file | sys | exe | lib; \n"
      "run: cluster (default) | file")
     ("cluster-count", value<int>(&po.clusterCount)->default_value(0),
@@ -885,6 +885,12 @@ int hhbcTarget(const ProgramOptions &po, AnalysisResultPtr ar,
     type = "creating binary HHBC files";
     formatCount++;
   }
+  if (po.format.find("image") != string::npos) {
+    Option::GenerateImageHHBC = true;
+    Option::RepoImagePath = ar->getOutputPath() + '/' + po.program + ".img";
+    type = "creating HHBC repo image";
+    formatCount++;
+  }
 
   if (formatCount == 0) {
     Logger::Error("Unknown format for HHBC target: %s", po.format.c_str());
@@ -404,6 +404,31 @@ DefineFunction(
     'taint_observer' => false,
   ));
 
+DefineFunction(
+  array(
+    'name'   => "fb_curl_multi_await",
+    'desc'   => "Runs the transfers on a multi handle until at least one of them finishes, or the timeout passes. Only sockets with activity are serviced, so waiting costs the same however many handles there are.",
+    'flags'  =>  HasDocComment | HipHopSpecific,
+    'return' => array(
+      'type'   => Variant,
+      'desc'   => "An array of the handles that finished, each in the form curl_multi_info_read() returns; empty on timeout.",
+    ),
+    'args'   => array(
+      array(
+        'name'   => "mh",
+        'type'   => Resource,
+        'desc'   => "A cURL multi handle returned by curl_multi_init().",
+      ),
+      array(
+        'name'   => "timeout",
+        'type'   => Double,
+        'value'  => "1.0",
+        'desc'   => "Time, in seconds, to wait for a handle to finish.",
+      ),
+    ),
+    'taint_observer' => false,
+  ));
+
 DefineFunction(
   array(
     'name'   => "fb_curl_multi_fdset",
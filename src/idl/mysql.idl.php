@@ -862,6 +862,97 @@ DefineFunction(
     'taint_observer' => false,
   ));
 
+DefineFunction(
+  array(
+    'name'   => "mysql_async_query_start",
+    'desc'   => "Sends query to the server and returns without waiting for it to run. Use mysql_async_query_completed() or mysql_async_wait_actionable() to find out when the result is ready and mysql_async_query_result() to fetch it. The link can't be used for anything else until then.",
+    'flags'  =>  HasDocComment | HipHopSpecific,
+    'return' => array(
+      'type'   => Boolean,
+      'desc'   => "TRUE if the query was sent, or skipped because the server is read-only, FALSE on error.",
+    ),
+    'args'   => array(
+      array(
+        'name'   => "query",
+        'type'   => String,
+        'desc'   => "The SQL query to execute.\n\nData inside the query should be properly escaped.",
+      ),
+      array(
+        'name'   => "link_identifier",
+        'type'   => Variant,
+        'value'  => "null",
+        'desc'   => "The MySQL connection. If the link identifier is not specified, the last link opened by mysql_connect() is assumed. If no such link is found, it will try to create one as if mysql_connect() was called with no arguments. If no connection is found or established, an E_WARNING level error is generated.",
+      ),
+    ),
+    'taint_observer' => false,
+  ));
+
+DefineFunction(
+  array(
+    'name'   => "mysql_async_query_completed",
+    'desc'   => "Checks, without blocking, whether the result of a query started with mysql_async_query_start() can be fetched.",
+    'flags'  =>  HasDocComment | HipHopSpecific,
+    'return' => array(
+      'type'   => Boolean,
+      'desc'   => "TRUE if mysql_async_query_result() will not wait on the server, FALSE otherwise.",
+    ),
+    'args'   => array(
+      array(
+        'name'   => "link_identifier",
+        'type'   => Variant,
+        'value'  => "null",
+        'desc'   => "The MySQL connection. If the link identifier is not specified, the last link opened by mysql_connect() is assumed. If no such link is found, it will try to create one as if mysql_connect() was called with no arguments. If no connection is found or established, an E_WARNING level error is generated.",
+      ),
+    ),
+    'taint_observer' => false,
+  ));
+
+DefineFunction(
+  array(
+    'name'   => "mysql_async_query_result",
+    'desc'   => "Fetches the result of a query started with mysql_async_query_start(), waiting for it if it is not ready yet.",
+    'flags'  =>  HasDocComment | HipHopSpecific,
+    'return' => array(
+      'type'   => Variant,
+      'desc'   => "Same as mysql_query(): a result resource for queries returning rows, TRUE for other successful queries and FALSE on error.",
+    ),
+    'args'   => array(
+      array(
+        'name'   => "link_identifier",
+        'type'   => Variant,
+        'value'  => "null",
+        'desc'   => "The MySQL connection. If the link identifier is not specified, the last link opened by mysql_connect() is assumed. If no such link is found, it will try to create one as if mysql_connect() was called with no arguments. If no connection is found or established, an E_WARNING level error is generated.",
+      ),
+    ),
+    'taint_observer' => false,
+  ));
+
+DefineFunction(
+  array(
+    'name'   => "mysql_async_wait_actionable",
+    'desc'   => "Waits until at least one of the given links has an async query result ready to fetch, or the timeout expires.",
+    'flags'  =>  HasDocComment | HipHopSpecific,
+    'return' => array(
+      'type'   => VariantMap,
+      'desc'   => "The links from links whose results can be fetched without waiting, with their keys preserved. Empty if the timeout expired.",
+    ),
+    'args'   => array(
+      array(
+        'name'   => "links",
+        'type'   => VariantMap,
+        'value'  => "null",
+        'desc'   => "MySQL links to wait on. If empty, every link with an async query in flight in this request is used.",
+      ),
+      array(
+        'name'   => "timeout",
+        'type'   => Double,
+        'value'  => "-1.0",
+        'desc'   => "Seconds to wait. A negative value waits until something is ready, but no longer than the link's read timeout, or 60 seconds without one. It never waits past the request's time limit.",
+      ),
+    ),
+    'taint_observer' => false,
+  ));
+
 DefineFunction(
   array(
     'name'   => "mysql_db_query",
@@ -878,6 +878,66 @@ DefineFunction(
     'taint_observer' => false,
   ));
 
+DefineFunction(
+  array(
+    'name'   => "hphp_set_time_limit_ms",
+    'desc'   => "Sets how many milliseconds the current request is allowed to run from now, like set_time_limit() does in seconds. What is left of this limit also caps MySQL, curl and memcache timeouts.",
+    'flags'  =>  HasDocComment | HipHopSpecific,
+    'return' => array(
+      'type'   => null,
+    ),
+    'args'   => array(
+      array(
+        'name'   => "milliseconds",
+        'type'   => Int32,
+        'desc'   => "The maximum execution time, in milliseconds. If set to zero, no time limit is imposed.",
+      ),
+    ),
+    'taint_observer' => false,
+  ));
+
+DefineFunction(
+  array(
+    'name'   => "hphp_set_cpu_time_limit_ms",
+    'desc'   => "Sets how many milliseconds of CPU time the current request is allowed to use from now. Time spent blocked on I/O doesn't count.",
+    'flags'  =>  HasDocComment | HipHopSpecific,
+    'return' => array(
+      'type'   => null,
+    ),
+    'args'   => array(
+      array(
+        'name'   => "milliseconds",
+        'type'   => Int32,
+        'desc'   => "The maximum CPU time, in milliseconds. If set to zero, no CPU time limit is imposed.",
+      ),
+    ),
+    'taint_observer' => false,
+  ));
+
+DefineFunction(
+  array(
+    'name'   => "hphp_get_time_remaining_ms",
+    'desc'   => "Returns how many milliseconds the current request has left to run.",
+    'flags'  =>  HasDocComment | HipHopSpecific,
+    'return' => array(
+      'type'   => Int64,
+      'desc'   => "Milliseconds left, or -1 if there is no time limit.",
+    ),
+    'taint_observer' => false,
+  ));
+
+DefineFunction(
+  array(
+    'name'   => "hphp_get_cpu_time_remaining_ms",
+    'desc'   => "Returns how many milliseconds of CPU time the current request has left to use.",
+    'flags'  =>  HasDocComment | HipHopSpecific,
+    'return' => array(
+      'type'   => Int64,
+      'desc'   => "Milliseconds left, or -1 if there is no CPU time limit.",
+    ),
+    'taint_observer' => false,
+  ));
+
 DefineFunction(
   array(
     'name'   => "sys_get_temp_dir",
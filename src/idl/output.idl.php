@@ -476,6 +476,35 @@ DefineFunction(
     ),
   ));
 
+DefineFunction(
+  array(
+    'name'   => "hphp_io_trace_start",
+    'desc'   => "Starts recording the current request's blocking I/O, unless it is already being traced. This is the same trace Stats.IOTrace.SampleRate turns on, so a slow request traced this way is also kept for the admin server.",
+    'flags'  =>  HasDocComment | HipHopSpecific,
+    'return' => array(
+      'type'   => null,
+    ),
+    'taint_observer' => array(
+      'set_mask'   => "TAINT_BIT_NONE",
+      'clear_mask' => "TAINT_BIT_NONE",
+    ),
+  ));
+
+DefineFunction(
+  array(
+    'name'   => "hphp_get_io_trace",
+    'desc'   => "Returns the blocking I/O the current request has done since it started being traced.",
+    'flags'  =>  HasDocComment | HipHopSpecific,
+    'return' => array(
+      'type'   => VariantVec,
+      'desc'   => "One array per operation, with its 'name', 'peer', 'start' and 'end' in microseconds since the request started, and 'bytes'. Unknown values are -1.",
+    ),
+    'taint_observer' => array(
+      'set_mask'   => "TAINT_BIT_NONE",
+      'clear_mask' => "TAINT_BIT_NONE",
+    ),
+  ));
+
 DefineFunction(
   array(
     'name'   => "hphp_get_iostatus",
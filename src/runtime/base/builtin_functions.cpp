@@ -22,6 +22,8 @@
 #include <runtime/base/variable_unserializer.h>
 #include <runtime/base/runtime_option.h>
 #include <runtime/base/execution_context.h>
+#include <runtime/base/timeout_thread.h>
+#include <runtime/base/server/stack_sampler.h>
 #include <runtime/base/strings.h>
 #include <runtime/eval/eval.h>
 #include <runtime/eval/debugger/debugger.h>
@@ -973,12 +975,15 @@ void pause_and_exit() {
 
 void check_request_surprise(ThreadInfo *info) {
   RequestInjectionData &p = info->m_reqInjectionData;
-  bool do_timedout, do_memExceeded, do_signaled;
+  bool do_timedout, do_memExceeded, do_signaled, do_sample;
 
   ssize_t flags = p.fetchAndClearFlags();
   do_timedout = (flags & RequestInjectionData::TimedOutFlag) && !p.debugger;
   do_memExceeded = (flags & RequestInjectionData::MemExceededFlag);
   do_signaled = (flags & RequestInjectionData::SignaledFlag);
+  do_sample = (flags & RequestInjectionData::SampleFlag);
+
+  if (do_sample) StackSampler::Sample(info);
 
   if (do_timedout && !info->m_pendingException) {
     generate_request_timeout_exception();
@@ -1181,22 +1186,35 @@ void throw_infinite_recursion_exception() {
 void generate_request_timeout_exception() {
   ThreadInfo *info = ThreadInfo::s_threadInfo.getNoCheck();
   RequestInjectionData &data = info->m_reqInjectionData;
-  if (data.timeoutSeconds > 0) {
-    // This extra checking is needed, because there may be a race condition
-    // a TimeoutThread sets flag "true" right after an old request finishes and
-    // right before a new requets resets "started". In this case, we flag
-    // "timedout" back to "false".
-    if (time(0) - data.started >= data.timeoutSeconds) {
-      info->m_pendingException = true;
-      info->m_exceptionMsg = "entire web request took longer than ";
-      info->m_exceptionMsg +=
-        boost::lexical_cast<std::string>(data.timeoutSeconds);
-      info->m_exceptionMsg += " seconds and timed out";
-      if (RuntimeOption::InjectedStackTrace) {
-        info->m_exceptionStack = hhvm
-          ? ArrayPtr(new Array(g_vmContext->debugBacktrace(false, true, true)))
-          : ArrayPtr(new Array(FrameInjection::GetBacktrace(false, true)));
-      }
+  // This extra checking is needed, because there may be a race condition
+  // a TimeoutThread sets flag "true" right after an old request finishes and
+  // right before a new requets resets its deadlines. In this case, we flag
+  // "timedout" back to "false".
+  std::string msg;
+  int64 deadline = data.deadline;
+  int64 cpuDeadline = data.cpuDeadline;
+  if (deadline > 0 && TimeoutThread::Now() >= deadline) {
+    msg = "entire web request took longer than ";
+    if (data.limitMs % 1000 == 0) {
+      msg += boost::lexical_cast<std::string>(data.limitMs / 1000);
+      msg += " seconds and timed out";
+    } else {
+      msg += boost::lexical_cast<std::string>(data.limitMs);
+      msg += " ms and timed out";
+    }
+  } else if (cpuDeadline > 0 &&
+             TimeoutThread::CpuNow(data.cpuClock) >= cpuDeadline) {
+    msg = "entire web request used more than ";
+    msg += boost::lexical_cast<std::string>(data.cpuLimitMs);
+    msg += " ms of CPU time and timed out";
+  }
+  if (!msg.empty()) {
+    info->m_pendingException = true;
+    info->m_exceptionMsg = msg;
+    if (RuntimeOption::InjectedStackTrace) {
+      info->m_exceptionStack = hhvm
+        ? ArrayPtr(new Array(g_vmContext->debugBacktrace(false, true, true)))
+        : ArrayPtr(new Array(FrameInjection::GetBacktrace(false, true)));
     }
   }
 }
@@ -18,6 +18,7 @@
 #include <runtime/base/file/plain_file.h>
 #include <runtime/base/complex_types.h>
 #include <runtime/base/util/request_local.h>
+#include <runtime/base/server/io_trace.h>
 
 namespace HPHP {
 
@@ -113,6 +114,7 @@ bool PlainFile::closeImpl() {
 int64 PlainFile::readImpl(char *buffer, int64 length) {
   ASSERT(valid());
   ASSERT(length > 0);
+  IOTraceHelper trace("file::read", m_name.c_str());
   // use read instead of fread to handle EOL in stdin
   size_t ret = ::read(m_fd, buffer, length);
   if (ret == 0
@@ -120,6 +122,7 @@ int64 PlainFile::readImpl(char *buffer, int64 length) {
     && errno != EWOULDBLOCK && errno != EINTR && errno != EBADF)) {
     m_eof = true;
   }
+  trace.setBytes((ssize_t)ret);
   return ret == (size_t)-1 ? 0 : ret;
 }
 
@@ -134,7 +137,9 @@ int64 PlainFile::writeImpl(const char *buffer, int64 length) {
 
   // use write instead of fwrite to be consistent with read
   // o.w., read-and-write files would not work
+  IOTraceHelper trace("file::write", m_name.c_str());
   int64 written = ::write(m_fd, buffer, length);
+  trace.setBytes(written);
   return written < 0 ? 0 : written;
 }
 
@@ -161,6 +161,7 @@ int64 Socket::readImpl(char *buffer, int64 length) {
   if (ret == 0 || (ret == -1 && errno != EWOULDBLOCK)) {
     m_eof = true;
   }
+  io.setBytes(ret);
   return (ret < 0) ? 0 : ret;
 }
 
@@ -173,6 +174,7 @@ int64 Socket::writeImpl(const char *buffer, int64 length) {
   if (ret >= 0) {
     m_bytesSent += ret;
   }
+  io.setBytes(ret);
   return ret;
 }
 
@@ -0,0 +1,370 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include <runtime/base/memory/heap_profiler.h>
+#include <runtime/base/server/stack_sampler.h>
+#include <runtime/base/runtime_option.h>
+#include <runtime/base/types.h>
+#include <runtime/vm/translator/translator-x64.h>
+#include <util/thread_local.h>
+#include <util/lock.h>
+
+#include <math.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+#define HEAP_PROFILER_MAX_DEPTH 48
+
+bool HeapProfiler::Enabled = false;
+__thread int64 HeapProfiler::t_untilSample;
+__thread int HeapProfiler::t_liveSamples;
+
+namespace {
+
+struct Totals {
+  Totals() : bytes(0), count(0) {}
+  int64 bytes;
+  int64 count;
+
+  void add(int64 b, int64 c) {
+    bytes += b;
+    count += c;
+  }
+};
+
+typedef std::map<std::string, Totals> StackMap;
+
+/*
+ * What one thread has sampled in its current request. The thread itself
+ * only takes the lock when it samples, frees a sampled object, or finishes
+ * a request; reports take it to read the live heap.
+ */
+class ThreadHeap {
+public:
+  ThreadHeap();
+  ~ThreadHeap();
+
+  Mutex lock;
+  bool inRequest;
+  bool sampling;
+  char url[128];
+  unsigned short seed[3];
+
+  struct LiveSample {
+    StackMap::iterator stack;
+    int64 bytes;
+    int64 count;
+  };
+  hphp_hash_map<int64, LiveSample> samples;
+  StackMap live;
+  int64 liveBytes;
+  // Live is only copied into peak when it is about to drop from a new
+  // high, not on every sample that sets one.
+  StackMap peak;
+  int64 peakBytes;
+  bool atPeak;
+  StackMap allocated;
+};
+
+}
+
+static Mutex s_threadsLock;
+static std::set<ThreadHeap*> s_threads;
+
+static Mutex s_totalsLock;
+static StackMap s_allocated;
+static StackMap s_peak;
+
+static IMPLEMENT_THREAD_LOCAL(ThreadHeap, s_heap);
+
+ThreadHeap::ThreadHeap()
+  : inRequest(false), sampling(false), liveBytes(0), peakBytes(0),
+    atPeak(false) {
+  url[0] = '\0';
+  int64 now = (int64)time(NULL);
+  seed[0] = (unsigned short)(int64)this;
+  seed[1] = (unsigned short)now;
+  seed[2] = (unsigned short)(now >> 16);
+
+  Lock l(s_threadsLock);
+  s_threads.insert(this);
+}
+
+ThreadHeap::~ThreadHeap() {
+  Lock l(s_threadsLock);
+  s_threads.erase(this);
+}
+
+/*
+ * Exponentially distributed gaps make sampling a Poisson process over the
+ * bytes allocated, as in tcmalloc.
+ */
+static int64 next_interval(ThreadHeap *heap) {
+  double mean = RuntimeOption::HeapProfilerSampleBytes;
+  double u = erand48(heap->seed);
+  if (u <= 0) u = 1e-12;
+  return (int64)(-log(u) * mean) + 1;
+}
+
+/*
+ * Sampling runs inside the allocator, where the VM registers can't be
+ * synced. When translated code called in without syncing them, the
+ * innermost frame is read off the fixup map instead, without touching
+ * the registers; only if that fails does the sample go to "[jit]".
+ */
+static int collect_frames(const char **frames, int max) {
+  if (hhvm && VM::Transl::tl_regState != VM::Transl::REGSTATE_CLEAN) {
+    VM::Transl::FixupMap::VMRegs regs;
+    if (!VM::Transl::tx64->peekFixup(&regs)) {
+      frames[0] = "[jit]";
+      return 1;
+    }
+    return StackSampler::CollectFrames(regs.m_fp, frames, max);
+  }
+  return StackSampler::CollectFrames(ThreadInfo::s_threadInfo.getNoCheck(),
+                                     frames, max);
+}
+
+static void merge(StackMap &to, const StackMap &from) {
+  for (StackMap::const_iterator iter = from.begin(); iter != from.end();
+       ++iter) {
+    to[iter->first].add(iter->second.bytes, iter->second.count);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void HeapProfiler::Restart() {
+  Enabled = RuntimeOption::HeapProfilerSampleBytes > 0;
+}
+
+void HeapProfiler::StartRequest(const char *url) {
+  if (!Enabled) return;
+  ThreadHeap *heap = s_heap.get();
+  Lock l(heap->lock);
+  strncpy(heap->url, url, sizeof(heap->url) - 1);
+  heap->url[sizeof(heap->url) - 1] = '\0';
+  heap->inRequest = true;
+  t_untilSample = next_interval(heap);
+}
+
+/*
+ * Everything smart allocated goes away with the request, so the live
+ * samples go too, and the peak is added to the totals.
+ */
+void HeapProfiler::EndRequest() {
+  if (!Enabled) return;
+  ThreadHeap *heap = s_heap.get();
+  StackMap allocated, peak;
+  {
+    Lock l(heap->lock);
+    heap->inRequest = false;
+    heap->samples.clear();
+    if (heap->atPeak) heap->peak.swap(heap->live);
+    heap->atPeak = false;
+    heap->live.clear();
+    heap->liveBytes = 0;
+    heap->peak.swap(peak);
+    heap->peakBytes = 0;
+    heap->allocated.swap(allocated);
+    t_liveSamples = 0;
+  }
+  if (allocated.empty()) return;
+  Lock l(s_totalsLock);
+  merge(s_allocated, allocated);
+  merge(s_peak, peak);
+}
+
+void HeapProfiler::Sample(void *p, int64 size) {
+  ThreadHeap *heap = s_heap.get();
+  t_untilSample = next_interval(heap);
+  if (!heap->inRequest || heap->sampling) return;
+  heap->sampling = true;
+
+  // A sample stands for size / P(sampled) bytes, where P is the chance one
+  // of its bytes was picked.
+  double mean = RuntimeOption::HeapProfilerSampleBytes;
+  double bytes = size / (1 - exp(-size / mean));
+  int64 count = (int64)(bytes / size + 0.5);
+
+  const char *frames[HEAP_PROFILER_MAX_DEPTH];
+  int depth = collect_frames(frames, HEAP_PROFILER_MAX_DEPTH);
+  std::string stack(heap->url);
+  for (int i = depth - 1; i >= 0; i--) {
+    stack += ';';
+    stack += frames[i];
+  }
+
+  {
+    Lock l(heap->lock);
+    heap->allocated[stack].add((int64)bytes, count);
+    if (p) {
+      ThreadHeap::LiveSample &s = heap->samples[(int64)p];
+      s.stack = heap->live.insert(StackMap::value_type(stack, Totals())).first;
+      s.stack->second.add((int64)bytes, count);
+      s.bytes = (int64)bytes;
+      s.count = count;
+      t_liveSamples++;
+      heap->liveBytes += s.bytes;
+      if (heap->liveBytes > heap->peakBytes) {
+        heap->peakBytes = heap->liveBytes;
+        heap->atPeak = true;
+      }
+    }
+  }
+  heap->sampling = false;
+}
+
+void HeapProfiler::Free(void *p) {
+  ThreadHeap *heap = s_heap.get();
+  Lock l(heap->lock);
+  hphp_hash_map<int64, ThreadHeap::LiveSample>::iterator iter =
+    heap->samples.find((int64)p);
+  if (iter == heap->samples.end()) return;
+  if (heap->atPeak) {
+    heap->peak = heap->live;
+    heap->atPeak = false;
+  }
+  ThreadHeap::LiveSample &s = iter->second;
+  s.stack->second.add(-s.bytes, -s.count);
+  if (s.stack->second.bytes <= 0) heap->live.erase(s.stack);
+  heap->liveBytes -= s.bytes;
+  heap->samples.erase(iter);
+  t_liveSamples--;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// reports
+
+static void report_folded(std::string &out, const StackMap &stacks) {
+  char buf[32];
+  for (StackMap::const_iterator iter = stacks.begin(); iter != stacks.end();
+       ++iter) {
+    out += iter->first;
+    snprintf(buf, sizeof(buf), " %lld\n", (long long)iter->second.bytes);
+    out += buf;
+  }
+}
+
+static void collect_live(StackMap &live) {
+  Lock l(s_threadsLock);
+  for (std::set<ThreadHeap*>::const_iterator iter = s_threads.begin();
+       iter != s_threads.end(); ++iter) {
+    Lock tl((*iter)->lock);
+    merge(live, (*iter)->live);
+  }
+}
+
+void HeapProfiler::ReportAllocated(std::string &out) {
+  Lock l(s_totalsLock);
+  report_folded(out, s_allocated);
+}
+
+void HeapProfiler::ReportPeak(std::string &out) {
+  Lock l(s_totalsLock);
+  report_folded(out, s_peak);
+}
+
+void HeapProfiler::ReportLive(std::string &out) {
+  StackMap live;
+  collect_live(live);
+  report_folded(out, live);
+}
+
+/*
+ * pprof wants addresses, so every distinct frame name gets a made up one,
+ * listed in the symbol section. Call sites other than the innermost are
+ * looked up one byte back, as pprof takes them to be return addresses.
+ */
+void HeapProfiler::ReportPprof(std::string &out) {
+  StackMap live, allocated;
+  collect_live(live);
+  {
+    Lock l(s_totalsLock);
+    allocated = s_allocated;
+  }
+
+  // stack -> (live, allocated)
+  std::map<std::string, std::pair<Totals, Totals> > stacks;
+  for (StackMap::const_iterator iter = live.begin(); iter != live.end();
+       ++iter) {
+    stacks[iter->first].first = iter->second;
+  }
+  for (StackMap::const_iterator iter = allocated.begin();
+       iter != allocated.end(); ++iter) {
+    stacks[iter->first].second = iter->second;
+  }
+
+  hphp_string_map<int64> addresses;
+  std::string profile;
+  Totals liveTotal, allocTotal;
+  char buf[128];
+  for (std::map<std::string, std::pair<Totals, Totals> >::const_iterator
+         iter = stacks.begin(); iter != stacks.end(); ++iter) {
+    const Totals &l = iter->second.first;
+    const Totals &a = iter->second.second;
+    liveTotal.add(l.bytes, l.count);
+    allocTotal.add(a.bytes, a.count);
+    snprintf(buf, sizeof(buf), "%lld: %lld [%lld: %lld] @",
+             (long long)l.count, (long long)l.bytes,
+             (long long)a.count, (long long)a.bytes);
+    profile += buf;
+
+    // folded stacks are outermost first, pprof's innermost first
+    std::vector<std::string> frames;
+    const std::string &stack = iter->first;
+    size_t start = 0;
+    while (true) {
+      size_t end = stack.find(';', start);
+      frames.push_back(stack.substr(start, end - start));
+      if (end == std::string::npos) break;
+      start = end + 1;
+    }
+    for (int i = frames.size() - 1; i >= 0; i--) {
+      int64 &addr = addresses[frames[i]];
+      if (!addr) addr = (addresses.size() + 1) * 16;
+      snprintf(buf, sizeof(buf), " 0x%llx", (long long)addr);
+      profile += buf;
+    }
+    profile += '\n';
+  }
+
+  out += "--- symbol\nbinary=hhvm\n";
+  for (hphp_string_map<int64>::const_iterator iter = addresses.begin();
+       iter != addresses.end(); ++iter) {
+    snprintf(buf, sizeof(buf), "0x%llx ", (long long)iter->second);
+    out += buf + iter->first + "\n";
+    snprintf(buf, sizeof(buf), "0x%llx ", (long long)iter->second - 1);
+    out += buf + iter->first + "\n";
+  }
+  out += "---\n--- heap\n";
+  snprintf(buf, sizeof(buf),
+           "heap profile: %lld: %lld [%lld: %lld] @ heapprofile\n",
+           (long long)liveTotal.count, (long long)liveTotal.bytes,
+           (long long)allocTotal.count, (long long)allocTotal.bytes);
+  out += buf;
+  out += profile;
+}
+
+void HeapProfiler::Clear() {
+  Lock l(s_totalsLock);
+  s_allocated.clear();
+  s_peak.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
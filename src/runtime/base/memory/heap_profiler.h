@@ -0,0 +1,97 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef __HPHP_HEAP_PROFILER_H__
+#define __HPHP_HEAP_PROFILER_H__
+
+#include <util/base.h>
+#include <util/util.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Sampled heap profiler that charges allocations to PHP stacks.
+ *
+ * Allocations are sampled about once every Stats.HeapProfiler.SampleBytes
+ * bytes per thread. The gaps between samples are drawn at random, so every
+ * byte is equally likely to be sampled, and a sample stands for the bytes
+ * it statistically represents. A sample records the requesting URL and the
+ * PHP stack, gathered the same way StackSampler does it. When translated
+ * code allocates without syncing the VM registers, the stack is walked
+ * from the frame its call site is recorded under; "[jit]" is only for
+ * samples whose frame can't be found that way.
+ *
+ * SmartAllocator objects are tracked until they are freed. That gives the
+ * live heap of every running request, and each request's heap at its
+ * sampled peak. Memory malloc()ed directly shows up in jemalloc's
+ * per-thread counters. It is picked up when MemoryManager refreshes its
+ * stats, and only counts as allocated.
+ *
+ * The admin server hands out /heap-alloc.folded, /heap-peak.folded and
+ * /heap-live.folded for flamegraph.pl, and /heap-profile.pprof for pprof.
+ */
+class HeapProfiler {
+public:
+  static bool Enabled;
+
+  static void Restart();
+
+  static void StartRequest(const char *url);
+  static void EndRequest();
+
+  /**
+   * Hooks for the allocators; only called when Enabled.
+   */
+  static void OnAlloc(void *p, int64 size) {
+    if ((t_untilSample -= size) <= 0) Sample(p, size);
+  }
+  static void OnFree(void *p) {
+    if (t_liveSamples) Free(p);
+  }
+  static void OnMalloc(int64 size) {
+    if (size > 0 && (t_untilSample -= size) <= 0) Sample(NULL, size);
+  }
+
+  /**
+   * "url;outermost;...;innermost bytes" lines. Allocated is everything
+   * since the last Clear(); peak adds up each finished request's heap at
+   * its peak; live is what running requests hold right now.
+   */
+  static void ReportAllocated(std::string &out);
+  static void ReportPeak(std::string &out);
+  static void ReportLive(std::string &out);
+
+  /**
+   * Live and allocated heap in pprof's legacy heap format, with the
+   * symbols inlined.
+   */
+  static void ReportPprof(std::string &out);
+
+  static void Clear();
+
+private:
+  static __thread int64 t_untilSample;
+  static __thread int t_liveSamples;
+
+  static void Sample(void *p, int64 size) NEVER_INLINE;
+  static void Free(void *p) NEVER_INLINE;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif // __HPHP_HEAP_PROFILER_H__
@@ -138,7 +138,7 @@ void MemoryManager::AllocIterator::next() {
   ++m_it;
 }
 
-MemoryManager::MemoryManager() : m_enabled(false) {
+MemoryManager::MemoryManager() : m_enabled(false), m_lastPeakUsage(0) {
   if (RuntimeOption::EnableMemoryManager) {
     m_enabled = true;
   }
@@ -20,6 +20,7 @@
 #include <boost/noncopyable.hpp>
 #include <util/thread_local.h>
 #include <runtime/base/memory/memory_usage_stats.h>
+#include <runtime/base/memory/heap_profiler.h>
 
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
@@ -102,6 +103,13 @@ public:
    */
   void resetStats();
 
+  /**
+   * Peak usage of the last request to end on this thread, which
+   * hphp_session_exit() saves before it resets the stats.
+   */
+  int64 getLastPeakUsage() const { return m_lastPeakUsage; }
+  void saveLastPeakUsage() { m_lastPeakUsage = getStats(true).peakUsage; }
+
   /**
    * Refresh stats to reflect directly malloc()ed memory, and determine whether
    * the request memory limit has been exceeded.
@@ -129,6 +137,9 @@ public:
         m_stats.usage += delta - m_delta;
       }
       m_stats.totalAlloc += deltaAllocated;
+      if (UNLIKELY(HeapProfiler::Enabled)) {
+        HeapProfiler::OnMalloc(deltaAllocated);
+      }
       m_delta = delta;
       m_prevAllocated = int64(*m_allocated);
     }
@@ -192,6 +203,7 @@ private:
   std::vector<SmartAllocatorImpl*> m_smartAllocators;
 
   MemoryUsageStats m_stats;
+  int64 m_lastPeakUsage;
 #ifdef USE_JEMALLOC
   uint64* m_allocated;
   uint64* m_deallocated;
@@ -194,22 +194,24 @@ void *SmartAllocatorImpl::alloc() {
       MemoryManager::TheMemoryManager()->refreshStats();
     }
   }
+  void *ret;
 #ifndef SMART_ALLOCATOR_DEBUG_FREE
   if (m_freelist.size() > 0) {
 #else
   if (0) {
 #endif
     // Fast path
-    void *ret = m_freelist.back();
+    ret = m_freelist.back();
     m_freelist.pop_back();
-    return ret;
   } else if (m_col < m_colMax) {
-    char *ret = m_blocks[m_row] + m_col;
+    ret = m_blocks[m_row] + m_col;
     m_col += m_itemSize;
-    return ret;
+  } else {
+    // Slow path
+    ret = allocHelper();
   }
-  // Slow path
-  return allocHelper();
+  if (UNLIKELY(HeapProfiler::Enabled)) HeapProfiler::OnAlloc(ret, m_itemSize);
+  return ret;
 }
 
 void *SmartAllocatorImpl::allocHelper() {
@@ -28,6 +28,7 @@
 #include <runtime/base/types.h>
 #include <runtime/base/util/countable.h>
 #include <runtime/base/memory/memory_usage_stats.h>
+#include <runtime/base/memory/heap_profiler.h>
 
 namespace HPHP {
 
@@ -201,6 +202,7 @@ public:
     s_st_allocs.erase(obj);
 #endif
     ASSERT(isValid(obj));
+    if (UNLIKELY(HeapProfiler::Enabled)) HeapProfiler::OnFree(obj);
     m_freelist.push_back(obj);
 #ifdef SMART_ALLOCATOR_STACKTRACE
     {
@@ -17,6 +17,8 @@
 #include <runtime/base/util/request_local.h>
 #include <util/lock.h>
 #include <util/logger.h>
+#include <util/atomic.h>
+#include <algorithm>
 #include <pcre.h>
 #include <onigposix.h>
 #include <runtime/base/runtime_option.h>
@@ -24,6 +26,7 @@
 #include <runtime/base/zend/zend_functions.h>
 #include <runtime/base/array/array_iterator.h>
 #include <runtime/base/taint/taint_observer.h>
+#include <runtime/base/server/server_stats.h>
 
 #define PREG_PATTERN_ORDER          1
 #define PREG_SET_ORDER              2
@@ -37,8 +40,6 @@
 
 #define PREG_GREP_INVERT            (1<<0)
 
-#define PCRE_CACHE_SIZE 4096
-
 enum {
   PHP_PCRE_NO_ERROR = 0,
   PHP_PCRE_INTERNAL_ERROR,
@@ -52,15 +53,42 @@ namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 // regex cache and helpers
 
+static int s_cacheHit = ServerStats::Register("preg.cache.hit");
+static int s_cacheCompile = ServerStats::Register("preg.cache.compile");
+static int s_cacheEvict = ServerStats::Register("preg.cache.evict");
+
 class pcre_cache_entry {
 public:
+  pcre_cache_entry()
+    : re(NULL), extra(NULL), preg_options(0), compile_options(0),
+      key(NULL), m_refCount(1), m_lastUse(0) {}
+
   ~pcre_cache_entry() {
     free(re);
-    if (extra) free(extra);
+    if (extra) {
+#ifdef PCRE_STUDY_JIT_COMPILE
+      pcre_free_study(extra);
+#else
+      free(extra);
+#endif
+    }
 #if HAVE_SETLOCALE
     free(locale);
     if (tables) free(tables);
 #endif
+    if (key && !key->isStatic()) {
+      delete key;
+    }
+  }
+
+  /**
+   * One reference belongs to the cache while the entry is in it; every
+   * request that is using the entry holds another (see PCRERequestCache),
+   * so eviction never frees a pattern out from under a running pcre_exec().
+   */
+  void incRef() { atomic_inc(m_refCount); }
+  void decRef() {
+    if (atomic_dec(m_refCount) == 0) delete this;
   }
 
   pcre *re;
@@ -71,70 +99,236 @@ public:
   unsigned const char *tables;
 #endif
   int compile_options;
+  StringData *key;   // the pattern; a private copy unless it is static
+
+private:
+  friend class PCRECache;
+  int m_refCount;
+  uint64 m_lastUse;
 };
 
-typedef hphp_hash_map<StringData *, pcre_cache_entry*,
+typedef hphp_hash_map<const StringData *, pcre_cache_entry*,
                       string_data_hash, string_data_same> PCREStringMap;
 
-// TODO LRU cache
+/**
+ * Process-wide cache of compiled patterns, shared by all threads.
+ *
+ * Lookups take a read lock. Recency is tracked with a clock that only
+ * advances on insertion, so a hit on a hot pattern usually writes nothing.
+ * Readers holding the lock at the same time all stamp the same clock value,
+ * and eviction reads the stamps under the write lock, so the stamps are
+ * atomic loads and stores with no further ordering.
+ * Patterns that are static strings (literals in the program, or preloaded
+ * from Preg.Preload) stay for the life of the process. Once the other
+ * patterns exceed Preg.CacheSize, the least recently used eighth of them
+ * is evicted in one batch.
+ */
 class PCRECache {
 public:
-  ~PCRECache() { }
+  PCRECache() : m_clock(0), m_dynamic(0) {}
 
-  void cleanup() {
-    TAINT_OBSERVER_CAP_STACK();
-    for (PCREStringMap::iterator it = m_cache.begin(); it != m_cache.end();
-         ++it) {
-      delete it->second;
-      if (!it->first->isStatic()) {
-        delete it->first;
+  /**
+   * Returns the cached entry for regex with a reference taken for the
+   * caller, or NULL.
+   */
+  pcre_cache_entry *find(const StringData *regex) {
+    ReadLock lock(m_lock);
+    PCREStringMap::const_iterator it = m_cache.find(regex);
+    if (it == m_cache.end()) return NULL;
+    pcre_cache_entry *pce = it->second;
+    pce->incRef();
+    if (atomic_acquire_load(&pce->m_lastUse) != m_clock) {
+      atomic_release_store(&pce->m_lastUse, m_clock);
+    }
+    return pce;
+  }
+
+  /**
+   * Adds pce, which must have its key set and carry the one reference the
+   * cache will own. If another thread already cached the same pattern, pce
+   * is dropped in favor of that entry unless replace is set. Either way the
+   * entry to use is returned with a reference taken for the caller.
+   */
+  pcre_cache_entry *insert(pcre_cache_entry *pce, bool replace) {
+    int evicted = 0;
+    {
+      WriteLock lock(m_lock);
+      PCREStringMap::iterator it = m_cache.find(pce->key);
+      if (it != m_cache.end()) {
+        pcre_cache_entry *old = it->second;
+        if (!replace) {
+          old->incRef();
+          pce->decRef();
+          return old;
+        }
+        m_cache.erase(it);
+        if (!old->key->isStatic()) m_dynamic--;
+        old->decRef();
+      }
+      pce->m_lastUse = ++m_clock;
+      m_cache[pce->key] = pce;
+      pce->incRef();
+      if (!pce->key->isStatic() &&
+          ++m_dynamic > RuntimeOption::PregCacheSize) {
+        evicted = evict();
       }
     }
+    if (evicted) {
+      ServerStats::Log(s_cacheEvict, evicted);
+    }
+    return pce;
+  }
+
+private:
+  static bool olderThan(const pcre_cache_entry *a,
+                        const pcre_cache_entry *b) {
+    return a->m_lastUse < b->m_lastUse;
+  }
+
+  // Must be called with m_lock held for writing.
+  int evict() {
+    std::vector<pcre_cache_entry*> candidates;
+    candidates.reserve(m_dynamic);
+    for (PCREStringMap::const_iterator it = m_cache.begin();
+         it != m_cache.end(); ++it) {
+      if (!it->first->isStatic()) candidates.push_back(it->second);
+    }
+    int n = std::max(1, (int)candidates.size() / 8);
+    std::nth_element(candidates.begin(), candidates.begin() + n - 1,
+                     candidates.end(), olderThan);
+    for (int i = 0; i < n; i++) {
+      m_cache.erase(candidates[i]->key);
+      candidates[i]->decRef();
+    }
+    m_dynamic -= n;
+    return n;
+  }
+
+  ReadWriteMutex m_lock;
+  PCREStringMap m_cache;
+  uint64 m_clock;
+  int m_dynamic; // number of entries with non-static keys
+};
+static PCRECache s_pcre_cache;
+
+/**
+ * Per-thread state: the preg_last_error() code, the JIT stack, and the
+ * entries the current request has pinned. Repeated lookups of a pattern
+ * within a request are answered from here without touching the shared
+ * cache's lock; the pins are dropped at request shutdown.
+ */
+class PCRERequestCache : public RequestEventHandler {
+public:
+  PCRERequestCache() : error_code(PHP_PCRE_NO_ERROR), m_jitStack(NULL) {}
+  ~PCRERequestCache() {
+    requestShutdown();
+#ifdef PCRE_STUDY_JIT_COMPILE
+    if (m_jitStack) pcre_jit_stack_free(m_jitStack);
+#endif
+  }
+
+  virtual void requestInit() {}
+  virtual void requestShutdown() {
+    for (PCREStringMap::iterator it = m_pinned.begin(); it != m_pinned.end();
+         ++it) {
+      it->second->decRef();
+    }
+    m_pinned.clear();
+    for (unsigned int i = 0; i < m_replaced.size(); i++) {
+      m_replaced[i]->decRef();
+    }
+    m_replaced.clear();
   }
 
   pcre_cache_entry *find(CStrRef regex) {
-    TAINT_OBSERVER_CAP_STACK();
-    PCREStringMap::const_iterator it = m_cache.find(regex.get());
-    if (it != m_cache.end()) return it->second;
-    return NULL;
+    PCREStringMap::const_iterator it = m_pinned.find(regex.get());
+    return it != m_pinned.end() ? it->second : NULL;
   }
 
-  void set(CStrRef regex, pcre_cache_entry *pce) {
-    TAINT_OBSERVER_CAP_STACK();
-    PCREStringMap::iterator it = m_cache.find(regex.get());
-    if (it != m_cache.end()) {
-      delete it->second;
-      it->second = pce;
-    } else {
-      m_cache[regex->copy(true)] = pce;
+  /**
+   * Takes over the caller's reference to pce. Outside of a request there is
+   * no context to register with; those pins are dropped at the end of the
+   * thread's next request, or when the thread exits.
+   */
+  void pin(pcre_cache_entry *pce) {
+    if (!getInited() && !g_context.isNull()) {
+      setInited(true);
+      g_context->registerRequestEventHandler(this);
     }
+    PCREStringMap::iterator it = m_pinned.find(pce->key);
+    if (it != m_pinned.end()) {
+      // A replaced entry; the old one may still be in use further up the
+      // stack, so keep it alive until request shutdown like the rest.
+      m_replaced.push_back(it->second);
+      m_pinned.erase(it);
+    }
+    m_pinned[pce->key] = pce;
   }
 
+#ifdef PCRE_STUDY_JIT_COMPILE
+  pcre_jit_stack *jitStack() {
+    if (!m_jitStack) {
+      m_jitStack = pcre_jit_stack_alloc(32 * 1024,
+                                        RuntimeOption::PregJitStackSize);
+    }
+    return m_jitStack;
+  }
+#endif
+
   int error_code;
-  pcre_extra extra_data;
 
 private:
-  PCREStringMap m_cache;
+  PCREStringMap m_pinned;
+  std::vector<pcre_cache_entry*> m_replaced;
+#ifdef PCRE_STUDY_JIT_COMPILE
+  pcre_jit_stack *m_jitStack;
+#else
+  void *m_jitStack;
+#endif
 };
-IMPLEMENT_THREAD_LOCAL_NO_CHECK(PCRECache, s_pcre_cache);
+IMPLEMENT_THREAD_LOCAL_NO_CHECK(PCRERequestCache, s_pcre_local);
 
 void preg_get_pcre_cache() {
-  s_pcre_cache.getCheck();
+  s_pcre_local.getCheck();
 }
 
-static pcre_cache_entry *pcre_get_compiled_regex_cache(CStrRef regex) {
-  PCRECache &pcre_cache = *s_pcre_cache;
+#ifdef PCRE_STUDY_JIT_COMPILE
+/**
+ * Studied patterns are shared between threads, so instead of assigning a
+ * particular JIT stack to each one we assign this callback, which hands
+ * pcre_exec() the calling thread's stack.
+ */
+static pcre_jit_stack *pcre_jit_stack_callback(void *) {
+  return s_pcre_local->jitStack();
+}
+#endif
+
+static pcre_cache_entry *pcre_get_compiled_regex_cache(CStrRef regex,
+                                                       bool pin = true) {
+  PCRERequestCache &local = *s_pcre_local;
 
   /* Try to lookup the cached regex entry, and if successful, just pass
      back the compiled pattern, otherwise go on and compile it. */
-  pcre_cache_entry *pce = pcre_cache.find(regex);
+  bool replace = false;
+  pcre_cache_entry *pce = local.find(regex);
+  if (!pce) {
+    pce = s_pcre_cache.find(regex.get());
+    if (pce) {
+      if (pin) {
+        local.pin(pce);
+      } else {
+        pce->decRef();
+      }
+      ServerStats::Log(s_cacheHit, 1);
+    }
+  }
   if (pce) {
     /**
      * We use a quick pcre_info() check to see whether cache is corrupted,
-     * and if it is, we flush it and compile the pattern from scratch.
+     * and if it is, we compile the pattern from scratch and replace it.
      */
     if (pcre_info(pce->re, NULL, NULL) == PCRE_ERROR_BADMAGIC) {
-      pcre_cache.cleanup();
+      replace = true;
     } else {
 #if HAVE_SETLOCALE
       if (!strcmp(pce->locale, locale)) {
@@ -142,6 +336,7 @@ static pcre_cache_entry *pcre_get_compiled_regex_cache(CStrRef regex) {
         return pce;
 #if HAVE_SETLOCALE
       }
+      replace = true;
 #endif
     }
   }
@@ -269,16 +464,31 @@ static pcre_cache_entry *pcre_get_compiled_regex_cache(CStrRef regex) {
     return NULL;
   }
 
-  /* If study option was specified, study the pattern and
-     store the result in extra for passing to pcre_exec. */
+  /* If study option was specified, or the pattern can be JIT compiled,
+     study the pattern and store the result in extra for passing to
+     pcre_exec. */
   pcre_extra *extra = NULL;
-  if (do_study) {
-    int soptions = 0;
+  int soptions = 0;
+#ifdef PCRE_STUDY_JIT_COMPILE
+  if (RuntimeOption::PregJit) {
+    soptions |= PCRE_STUDY_JIT_COMPILE;
+  }
+#endif
+  if (do_study || soptions) {
     extra = pcre_study(re, soptions, &error);
-    if (extra) {
+    if (extra && do_study) {
+      // Only patterns studied on request (/S) carry the limits themselves;
+      // preg_split() relies on that, see there.
       extra->flags |= PCRE_EXTRA_MATCH_LIMIT |
         PCRE_EXTRA_MATCH_LIMIT_RECURSION;
+      extra->match_limit = RuntimeOption::PregBacktraceLimit;
+      extra->match_limit_recursion = RuntimeOption::PregRecursionLimit;
+    }
+#ifdef PCRE_STUDY_JIT_COMPILE
+    if (extra && (soptions & PCRE_STUDY_JIT_COMPILE)) {
+      pcre_assign_jit_stack(extra, pcre_jit_stack_callback, NULL);
     }
+#endif
     if (error != NULL) {
       raise_warning("Error while studying pattern");
     }
@@ -290,33 +500,56 @@ static pcre_cache_entry *pcre_get_compiled_regex_cache(CStrRef regex) {
   new_entry->extra = extra;
   new_entry->preg_options = poptions;
   new_entry->compile_options = coptions;
+  if (regex->isStatic()) {
+    new_entry->key = regex.get();
+  } else {
+    TAINT_OBSERVER_CAP_STACK();
+    new_entry->key = regex->copy(true);
+  }
 #if HAVE_SETLOCALE
   char *locale = setlocale(LC_CTYPE, NULL);
   new_entry->locale = strdup(locale);
   new_entry->tables = tables;
 #endif
-  pcre_cache.set(regex, new_entry);
+  ServerStats::Log(s_cacheCompile, 1);
+  new_entry = s_pcre_cache.insert(new_entry, replace);
+  if (pin) {
+    local.pin(new_entry);
+  } else {
+    new_entry->decRef();
+  }
   return new_entry;
 }
 
-static void set_extra_limits(pcre_extra *&extra) {
+void preg_preload_patterns() {
+  for (unsigned int i = 0; i < RuntimeOption::PregPreload.size(); i++) {
+    String regex(StringData::GetStaticString(RuntimeOption::PregPreload[i]));
+    if (!pcre_get_compiled_regex_cache(regex, false)) {
+      Logger::Warning("Unable to preload pattern %s", regex.data());
+    }
+  }
+}
+
+/**
+ * Cached pcre_extra blocks are shared by every thread, so the per-call
+ * match limits are set on a copy in the caller's frame.
+ */
+static pcre_extra *set_extra_limits(pcre_extra &local, pcre_extra *extra) {
   if (extra == NULL) {
-    pcre_extra &extra_data = s_pcre_cache->extra_data;
-    extra_data.flags = PCRE_EXTRA_MATCH_LIMIT |
-      PCRE_EXTRA_MATCH_LIMIT_RECURSION;
-    extra = &extra_data;
+    local.flags = PCRE_EXTRA_MATCH_LIMIT | PCRE_EXTRA_MATCH_LIMIT_RECURSION;
+  } else {
+    local = *extra;
   }
-  extra->match_limit = RuntimeOption::PregBacktraceLimit;
-  extra->match_limit_recursion = RuntimeOption::PregRecursionLimit;
+  local.match_limit = RuntimeOption::PregBacktraceLimit;
+  local.match_limit_recursion = RuntimeOption::PregRecursionLimit;
+  return &local;
 }
 
 static int *create_offset_array(pcre_cache_entry *pce, int &size_offsets) {
-  pcre_extra *extra = pce->extra;
-  set_extra_limits(extra);
-
   /* Calculate the size of the offsets array, and allocate memory for it. */
   int num_subpats; // Number of captured subpatterns
-  int rc = pcre_fullinfo(pce->re, extra, PCRE_INFO_CAPTURECOUNT, &num_subpats);
+  int rc = pcre_fullinfo(pce->re, pce->extra, PCRE_INFO_CAPTURECOUNT,
+                         &num_subpats);
   if (rc < 0) {
     raise_warning("Internal pcre_fullinfo() error %d", rc);
     return NULL;
@@ -406,7 +639,7 @@ static void pcre_handle_exec_error(int pcre_code) {
     preg_code = PHP_PCRE_INTERNAL_ERROR;
     break;
   }
-  s_pcre_cache->error_code = preg_code;
+  s_pcre_local->error_code = preg_code;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -425,12 +658,12 @@ Variant preg_grep(CStrRef pattern, CArrRef input, int flags /* = 0 */) {
 
   /* Initialize return array */
   Array ret = Array::Create();
-  s_pcre_cache->error_code = PHP_PCRE_NO_ERROR;
+  s_pcre_local->error_code = PHP_PCRE_NO_ERROR;
 
   /* Go through the input array */
   bool invert = (flags & PREG_GREP_INVERT);
-  pcre_extra *extra = pce->extra;
-  set_extra_limits(extra);
+  pcre_extra extra_data;
+  pcre_extra *extra = set_extra_limits(extra_data, pce->extra);
 
   for (ArrayIter iter(input); iter; ++iter) {
     String entry = iter.second().toString();
@@ -479,8 +712,8 @@ static Variant preg_match_impl(CStrRef pattern, CStrRef subject,
     return false;
   }
 
-  pcre_extra *extra = pce->extra;
-  set_extra_limits(extra);
+  pcre_extra extra_data;
+  pcre_extra *extra = set_extra_limits(extra_data, pce->extra);
   if (subpats) {
     *subpats = Array::Create();
   }
@@ -578,7 +811,7 @@ static Variant preg_match_impl(CStrRef pattern, CStrRef subject,
   }
 
   int matched = 0;
-  s_pcre_cache->error_code = PHP_PCRE_NO_ERROR;
+  s_pcre_local->error_code = PHP_PCRE_NO_ERROR;
 
   Variant result_set; // Holds a set of subpatterns after a global match
   int g_notempty = 0; // If the match should not be empty
@@ -856,9 +1089,9 @@ static String php_pcre_replace(CStrRef pattern, CStrRef subject,
   /* Initialize */
   const char *match = NULL;
   int start_offset = 0;
-  s_pcre_cache->error_code = PHP_PCRE_NO_ERROR;
-  pcre_extra *extra = pce->extra;
-  set_extra_limits(extra);
+  s_pcre_local->error_code = PHP_PCRE_NO_ERROR;
+  pcre_extra extra_data;
+  pcre_extra *extra = set_extra_limits(extra_data, pce->extra);
 
   int result_len = 0;
   int new_len;        // Length of needed storage
@@ -1169,7 +1402,9 @@ Variant preg_split(CVarRef pattern, CVarRef subject, int limit /* = -1 */,
   int start_offset = 0;
   int next_offset = 0;
   const char *last_match = ssubject.data();
-  s_pcre_cache->error_code = PHP_PCRE_NO_ERROR;
+  s_pcre_local->error_code = PHP_PCRE_NO_ERROR;
+  // Unlike the other preg functions, preg_split() has never applied the
+  // backtrack and recursion limits to patterns that were not studied.
   pcre_extra *extra = pce->extra;
 
   // Get next piece if no limit or limit not yet reached and something matched
@@ -1365,7 +1600,7 @@ String preg_quote(CStrRef str, CStrRef delimiter /* = null_string */) {
 }
 
 int preg_last_error() {
-  return s_pcre_cache->error_code;
+  return s_pcre_local->error_code;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -53,6 +53,12 @@ Variant php_split(CStrRef spliton, CStrRef str, int count, bool icase);
 int preg_last_error();
 
 void preg_get_pcre_cache() ATTRIBUTE_COLD;
+
+/**
+ * Compiles the patterns listed in Preg.Preload into the process-wide cache.
+ * Called once from hphp_process_init().
+ */
+void preg_preload_patterns();
 ///////////////////////////////////////////////////////////////////////////////
 }
 
@@ -28,13 +28,17 @@
 #include <system/gen/php/globals/symbols.h>
 #include <runtime/base/server/pagelet_server.h>
 #include <runtime/base/server/xbox_server.h>
+#include <runtime/base/server/compression_pool.h>
+#include <runtime/base/server/stack_sampler.h>
 #include <runtime/base/server/http_server.h>
 #include <runtime/base/server/replay_transport.h>
+#include <runtime/base/server/replay_benchmark.h>
 #include <runtime/base/server/http_request_handler.h>
 #include <runtime/base/server/admin_request_handler.h>
 #include <runtime/base/server/server_stats.h>
 #include <runtime/base/server/server_note.h>
 #include <runtime/base/memory/memory_manager.h>
+#include <runtime/base/memory/heap_profiler.h>
 #include <util/process.h>
 #include <util/capability.h>
 #include <util/timer.h>
@@ -54,6 +58,7 @@
 #include <runtime/eval/debugger/debugger_client.h>
 #include <runtime/base/util/simple_counter.h>
 #include <runtime/base/util/extended_logger.h>
+#include <runtime/base/preg.h>
 
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/positional_options.hpp>
@@ -93,6 +98,8 @@ struct ProgramOptions {
   string     lint;
   bool       isTempFile;
   int        count;
+  int        replayThreads;
+  int        replayRate;
   bool       noSafeAccessCheck;
   StringVec  args;
   string     buildId;
@@ -768,6 +775,11 @@ static int execute_program_impl(int argc, char **argv) {
      "file specified is temporary and removed after execution")
     ("count", value<int>(&po.count)->default_value(1),
      "how many times to repeat execution")
+    ("replay-threads", value<int>(&po.replayThreads)->default_value(0),
+     "in replay mode, benchmark the requests on this many threads")
+    ("replay-rate", value<int>(&po.replayRate)->default_value(0),
+     "in replay mode, requests per second to benchmark at, or 0 for as "
+     "fast as possible")
     ("no-safe-access-check",
       value<bool>(&po.noSafeAccessCheck)->default_value(false),
      "whether to ignore safe file access check")
@@ -1076,6 +1088,13 @@ static int execute_program_impl(int argc, char **argv) {
     RuntimeOption::RecordInput = false;
     RuntimeOption::ExecutionMode = "srv";
     HttpServer server; // so we initialize runtime properly
+    if (po.replayThreads > 0) {
+      ReplayBenchmark bench(po.args, po.replayThreads, po.replayRate,
+                            po.count);
+      bench.run();
+      printf("%s", bench.report().c_str());
+      return 0;
+    }
     HttpRequestHandler handler;
     for (int i = 0; i < po.count; i++) {
       for (unsigned int j = 0; j < po.args.size(); j++) {
@@ -1150,8 +1169,13 @@ void hphp_process_init() {
 
   PageletServer::Restart();
   XboxServer::Restart();
+  CompressionPool::Restart();
+  StackSampler::Restart();
+  HeapProfiler::Restart();
+  StatCache::StartRefresher();
   Extension::InitModules();
   apc_load(RuntimeOption::ApcLoadThread);
+  preg_preload_patterns();
   StaticString::FinishInit();
 
   // Reset the preloaded g_context
@@ -1348,6 +1372,7 @@ void hphp_session_exit() {
   if (RuntimeOption::EnableStats && RuntimeOption::EnableMemoryStats) {
     mm->logStats();
   }
+  mm->saveLastPeakUsage();
   mm->resetStats();
 
   if (mm->isEnabled()) {
@@ -1383,6 +1408,7 @@ void hphp_process_exit() {
   Eval::Debugger::Stop();
   Extension::ShutdownModules();
   LightProcess::Close();
+  StatCache::StopRefresher();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -77,6 +77,8 @@ int64 RuntimeOption::StringOffsetLimit = 10 * 1024 * 1024; // 10MB
 
 std::string RuntimeOption::AccessLogDefaultFormat;
 std::vector<AccessLogFileData> RuntimeOption::AccessLogs;
+int RuntimeOption::AccessLogBufferKB = 256;
+int RuntimeOption::AccessLogFlushMs = 100;
 
 std::string RuntimeOption::AdminLogFormat;
 std::string RuntimeOption::AdminLogFile;
@@ -99,6 +101,7 @@ bool RuntimeOption::ServerThreadJobLIFO = false;
 bool RuntimeOption::ServerThreadDropStack = false;
 bool RuntimeOption::ServerHttpSafeMode = false;
 bool RuntimeOption::ServerStatCache = true;
+int RuntimeOption::ServerStatCacheRefreshMs = 0;
 int RuntimeOption::PageletServerThreadCount = 0;
 bool RuntimeOption::PageletServerThreadRoundRobin = false;
 int RuntimeOption::PageletServerThreadDropCacheTimeoutSeconds = 0;
@@ -106,6 +109,8 @@ int RuntimeOption::PageletServerQueueLimit = 0;
 bool RuntimeOption::PageletServerThreadDropStack = false;
 int RuntimeOption::FiberCount = 1;
 int RuntimeOption::RequestTimeoutSeconds = 0;
+int RuntimeOption::RequestTimeoutMs = 0;
+int RuntimeOption::RequestCpuTimeoutMs = 0;
 size_t RuntimeOption::ServerMemoryHeadRoom = 0;
 int64 RuntimeOption::RequestMemoryMaxBytes = -1;
 int64 RuntimeOption::ImageMemoryMaxBytes = 0;
@@ -115,6 +120,7 @@ bool RuntimeOption::ServerHarshShutdown = true;
 bool RuntimeOption::ServerEvilShutdown = true;
 int RuntimeOption::ServerDanglingWait;
 int RuntimeOption::GzipCompressionLevel = 3;
+int RuntimeOption::CompressionThreadCount = 0;
 std::string RuntimeOption::ForceCompressionURL;
 std::string RuntimeOption::ForceCompressionCookie;
 std::string RuntimeOption::ForceCompressionParam;
@@ -237,6 +243,16 @@ int RuntimeOption::MySQLSlowQueryThreshold = 1000; // ms
 bool RuntimeOption::MySQLKillOnTimeout = false;
 int RuntimeOption::MySQLMaxRetryOpenOnFail = 1;
 int RuntimeOption::MySQLMaxRetryQueryOnFail = 1;
+bool RuntimeOption::MySQLPool = false;
+int RuntimeOption::MySQLPoolMaxPerHost = 32;
+int RuntimeOption::MySQLPoolMinIdle = 0;
+int RuntimeOption::MySQLPoolMaxIdle = 8;
+int RuntimeOption::MySQLPoolIdleTimeout = 60; // seconds
+int RuntimeOption::MySQLPoolPingInterval = 10; // seconds
+int RuntimeOption::MySQLPoolWaitTimeout = 1000; // ms
+std::map<std::string, int> RuntimeOption::MySQLPoolHostMax;
+std::map<std::string, int> RuntimeOption::MySQLPoolHostMinIdle;
+std::map<std::string, int> RuntimeOption::MySQLPoolHostMaxIdle;
 
 int RuntimeOption::HttpDefaultTimeout = 30;
 int RuntimeOption::HttpSlowQueryThreshold = 5000; // ms
@@ -266,11 +282,20 @@ bool RuntimeOption::EnableMemcacheKeyStats = false;
 bool RuntimeOption::EnableSQLStats = false;
 bool RuntimeOption::EnableSQLTableStats = false;
 bool RuntimeOption::EnableNetworkIOStatus = false;
+bool RuntimeOption::EnableHardwareCounterStats = false;
 std::string RuntimeOption::StatsXSL;
 std::string RuntimeOption::StatsXSLProxy;
 int RuntimeOption::StatsSlotDuration = 10 * 60; // 10 minutes
 int RuntimeOption::StatsMaxSlot = 12 * 6; // 12 hours
 
+int RuntimeOption::IOTraceSampleRate = 0;
+int RuntimeOption::IOTraceSlowRequestMs = 1000;
+int RuntimeOption::IOTraceMaxEvents = 1024;
+int RuntimeOption::IOTraceKeepCount = 32;
+
+int RuntimeOption::StackSamplerIntervalMs = 0;
+int64 RuntimeOption::HeapProfilerSampleBytes = 0;
+
 bool RuntimeOption::EnableAPCSizeStats = false;
 bool RuntimeOption::EnableAPCSizeGroup = false;
 std::vector<std::string> RuntimeOption::APCSizeSpecialPrefix;
@@ -372,6 +397,8 @@ uint32 RuntimeOption::EvalJitWarmupRequests = kDefaultWarmupRequests;
 bool RuntimeOption::EvalJitProfileRecord = false;
 bool RuntimeOption::EvalJitNoGdb = false;
 bool RuntimeOption::EvalProfileBC = false;
+bool RuntimeOption::EvalPerfPidMap = true;
+bool RuntimeOption::EvalPerfJitDump = false;
 std::string RuntimeOption::EvalProfileHWEvents = "";
 #define JIT_TRAMPOLINES_DEFAULT true
 bool RuntimeOption::EvalJitTrampolines = JIT_TRAMPOLINES_DEFAULT;
@@ -395,6 +422,7 @@ std::string RuntimeOption::RepoLocalMode;
 std::string RuntimeOption::RepoLocalPath;
 std::string RuntimeOption::RepoCentralPath;
 std::string RuntimeOption::RepoEvalMode;
+std::string RuntimeOption::RepoImagePath;
 bool RuntimeOption::RepoCommit = true;
 bool RuntimeOption::RepoDebugInfo = true;
 // Missing: RuntimeOption::RepoAuthoritative's physical location is
@@ -427,6 +455,10 @@ std::string RuntimeOption::MailForceExtraParameters;
 int RuntimeOption::PregBacktraceLimit = 100000;
 int RuntimeOption::PregRecursionLimit = 100000;
 bool RuntimeOption::EnablePregErrorLog = true;
+int RuntimeOption::PregCacheSize = 4096;
+bool RuntimeOption::PregJit = true;
+int RuntimeOption::PregJitStackSize = 1024 * 1024;
+std::vector<std::string> RuntimeOption::PregPreload;
 
 bool RuntimeOption::EnableHotProfiler = true;
 int RuntimeOption::ProfilerTraceBuffer = 2000000;
@@ -594,6 +626,10 @@ void RuntimeOption::Load(Hdf &config, StringVec *overwrites /* = NULL */,
       }
     }
 
+    AccessLogBufferKB = logger["AccessLogBufferKB"].getInt32(256);
+    AccessLogFlushMs = logger["AccessLogFlushMs"].getInt32(100);
+    if (AccessLogFlushMs <= 0) AccessLogFlushMs = 100;
+
     AdminLogFormat = logger["AdminLog.Format"].getString("%h %t %s %U");
     AdminLogFile = logger["AdminLog.File"].getString();
     AdminLogSymLink = logger["AdminLog.SymLink"].getString();
@@ -654,7 +690,10 @@ void RuntimeOption::Load(Hdf &config, StringVec *overwrites /* = NULL */,
     ServerThreadDropStack = server["ThreadDropStack"].getBool();
     ServerHttpSafeMode = server["HttpSafeMode"].getBool();
     ServerStatCache = server["StatCache"].getBool(true);
+    ServerStatCacheRefreshMs = server["StatCacheRefreshMs"].getInt32(0);
     RequestTimeoutSeconds = server["RequestTimeoutSeconds"].getInt32(0);
+    RequestTimeoutMs = server["RequestTimeoutMs"].getInt32(0);
+    RequestCpuTimeoutMs = server["RequestCpuTimeoutMs"].getInt32(0);
     ServerMemoryHeadRoom = server["MemoryHeadRoom"].getInt64(0);
     RequestMemoryMaxBytes = server["RequestMemoryMaxBytes"].getInt64(-1);
     ResponseQueueCount = server["ResponseQueueCount"].getInt32(0);
@@ -670,6 +709,7 @@ void RuntimeOption::Load(Hdf &config, StringVec *overwrites /* = NULL */,
       ServerGracefulShutdownWait = ServerDanglingWait;
     }
     GzipCompressionLevel = server["GzipCompressionLevel"].getInt16(3);
+    CompressionThreadCount = server["CompressionThreadCount"].getInt32(0);
 
     ForceCompressionURL    = server["ForceCompression"]["URL"].getString();
     ForceCompressionCookie = server["ForceCompression"]["Cookie"].getString();
@@ -986,6 +1026,29 @@ void RuntimeOption::Load(Hdf &config, StringVec *overwrites /* = NULL */,
     MySQLKillOnTimeout = mysql["KillOnTimeout"].getBool();
     MySQLMaxRetryOpenOnFail = mysql["MaxRetryOpenOnFail"].getInt32(1);
     MySQLMaxRetryQueryOnFail = mysql["MaxRetryQueryOnFail"].getInt32(1);
+
+    Hdf pool = mysql["Pool"];
+    MySQLPool = pool["Enable"].getBool();
+    MySQLPoolMaxPerHost = pool["MaxPerHost"].getInt32(32);
+    MySQLPoolMinIdle = pool["MinIdle"].getInt32(0);
+    MySQLPoolMaxIdle = pool["MaxIdle"].getInt32(8);
+    MySQLPoolIdleTimeout = pool["IdleTimeout"].getInt32(60);
+    MySQLPoolPingInterval = pool["PingInterval"].getInt32(10);
+    MySQLPoolWaitTimeout = pool["WaitTimeout"].getInt32(1000);
+    Hdf hosts = pool["Hosts"];
+    for (Hdf hdf = hosts.firstChild(); hdf.exists(); hdf = hdf.next()) {
+      string host = hdf["Host"].getString();
+      if (host.empty()) continue;
+      if (hdf["MaxPerHost"].exists()) {
+        MySQLPoolHostMax[host] = hdf["MaxPerHost"].getInt32();
+      }
+      if (hdf["MinIdle"].exists()) {
+        MySQLPoolHostMinIdle[host] = hdf["MinIdle"].getInt32();
+      }
+      if (hdf["MaxIdle"].exists()) {
+        MySQLPoolHostMaxIdle[host] = hdf["MaxIdle"].getInt32();
+      }
+    }
   }
   {
     Hdf http = config["Http"];
@@ -1041,6 +1104,7 @@ void RuntimeOption::Load(Hdf &config, StringVec *overwrites /* = NULL */,
     EnableSQLStats = stats["SQL"].getBool();
     EnableSQLTableStats = stats["SQLTable"].getBool();
     EnableNetworkIOStatus = stats["NetworkIO"].getBool();
+    EnableHardwareCounterStats = stats["HardwareCounters"].getBool();
 
     if (EnableStats && EnableMallocStats) {
       LeakDetectable::EnableMallocStats(true);
@@ -1052,6 +1116,17 @@ void RuntimeOption::Load(Hdf &config, StringVec *overwrites /* = NULL */,
     StatsSlotDuration = stats["SlotDuration"].getInt32(10 * 60); // 10 minutes
     StatsMaxSlot = stats["MaxSlot"].getInt32(12 * 6); // 12 hours
 
+    {
+      Hdf ioTrace = stats["IOTrace"];
+      IOTraceSampleRate = ioTrace["SampleRate"].getInt32(0);
+      IOTraceSlowRequestMs = ioTrace["SlowRequestMs"].getInt32(1000);
+      IOTraceMaxEvents = ioTrace["MaxEvents"].getInt32(1024);
+      IOTraceKeepCount = ioTrace["KeepCount"].getInt32(32);
+    }
+    StackSamplerIntervalMs = stats["StackSampler"]["IntervalMs"].getInt32(0);
+    HeapProfilerSampleBytes =
+      stats["HeapProfiler"]["SampleBytes"].getInt64(0);
+
     {
       Hdf apcSize = stats["APCSize"];
       EnableAPCSizeStats = apcSize["Enable"].getBool();
@@ -1123,6 +1198,8 @@ void RuntimeOption::Load(Hdf &config, StringVec *overwrites /* = NULL */,
     EvalAllowHhas = eval["AllowHhas"].getBool(false);
     EvalJitNoGdb = eval["JitNoGdb"].getBool(false);
     EvalProfileBC = eval["ProfileBC"].getBool(false);
+    EvalPerfPidMap = eval["PerfPidMap"].getBool(true);
+    EvalPerfJitDump = eval["PerfJitDump"].getBool(false);
     EvalProfileHWEvents = eval["ProfileHWEvents"].getString();
     EvalJitTrampolines =
       eval["JitTrampolines"].getBool(JIT_TRAMPOLINES_DEFAULT);
@@ -1214,6 +1291,11 @@ void RuntimeOption::Load(Hdf &config, StringVec *overwrites /* = NULL */,
         RepoEvalMode = "readonly";
       }
     }
+    {
+      Hdf repoImage = repo["Image"];
+      // Repo.Image.Path: mmap()ed unit image that replaces SQLite lookups.
+      RepoImagePath = repoImage["Path"].getString();
+    }
     RepoCommit = repo["Commit"].getBool(true);
     RepoDebugInfo = repo["DebugInfo"].getBool(true);
     RepoAuthoritative = repo["Authoritative"].getBool(false);
@@ -1243,6 +1325,10 @@ void RuntimeOption::Load(Hdf &config, StringVec *overwrites /* = NULL */,
     PregBacktraceLimit = preg["BacktraceLimit"].getInt32(100000);
     PregRecursionLimit = preg["RecursionLimit"].getInt32(100000);
     EnablePregErrorLog = preg["ErrorLog"].getBool(true);
+    PregCacheSize = preg["CacheSize"].getInt32(4096);
+    PregJit = preg["JIT"].getBool(true);
+    PregJitStackSize = preg["JITStackSize"].getInt32(1024 * 1024);
+    preg["Preload"].get(PregPreload);
   }
 
   Extension::LoadModules(config);
@@ -75,6 +75,8 @@ public:
 
   static std::string AccessLogDefaultFormat;
   static std::vector<AccessLogFileData> AccessLogs;
+  static int AccessLogBufferKB;
+  static int AccessLogFlushMs;
 
   static std::string AdminLogFormat;
   static std::string AdminLogFile;
@@ -96,6 +98,7 @@ public:
   static bool ServerThreadDropStack;
   static bool ServerHttpSafeMode;
   static bool ServerStatCache;
+  static int ServerStatCacheRefreshMs;
   static int PageletServerThreadCount;
   static bool PageletServerThreadRoundRobin;
   static int PageletServerThreadDropCacheTimeoutSeconds;
@@ -104,6 +107,8 @@ public:
 
   static int FiberCount;
   static int RequestTimeoutSeconds;
+  static int RequestTimeoutMs;
+  static int RequestCpuTimeoutMs;
   static size_t ServerMemoryHeadRoom;
   static int64 RequestMemoryMaxBytes;
   static int64 ImageMemoryMaxBytes;
@@ -113,6 +118,7 @@ public:
   static bool ServerHarshShutdown;
   static bool ServerEvilShutdown;
   static int GzipCompressionLevel;
+  static int CompressionThreadCount;
   static std::string ForceCompressionURL;
   static std::string ForceCompressionCookie;
   static std::string ForceCompressionParam;
@@ -236,6 +242,17 @@ public:
   static bool MySQLKillOnTimeout;
   static int  MySQLMaxRetryOpenOnFail;
   static int  MySQLMaxRetryQueryOnFail;
+  static bool MySQLPool;       // share persistent connections process-wide
+  static int  MySQLPoolMaxPerHost;
+  static int  MySQLPoolMinIdle;
+  static int  MySQLPoolMaxIdle;
+  static int  MySQLPoolIdleTimeout;
+  static int  MySQLPoolPingInterval;
+  static int  MySQLPoolWaitTimeout;
+  // per-host overrides, keyed by "host" or "host:port"
+  static std::map<std::string, int> MySQLPoolHostMax;
+  static std::map<std::string, int> MySQLPoolHostMinIdle;
+  static std::map<std::string, int> MySQLPoolHostMaxIdle;
 
   static int  HttpDefaultTimeout;
   static int  HttpSlowQueryThreshold;
@@ -265,11 +282,20 @@ public:
   static bool EnableSQLStats;
   static bool EnableSQLTableStats;
   static bool EnableNetworkIOStatus;
+  static bool EnableHardwareCounterStats;
   static std::string StatsXSL;
   static std::string StatsXSLProxy;
   static int StatsSlotDuration;
   static int StatsMaxSlot;
 
+  static int IOTraceSampleRate;
+  static int IOTraceSlowRequestMs;
+  static int IOTraceMaxEvents;
+  static int IOTraceKeepCount;
+
+  static int StackSamplerIntervalMs;
+  static int64 HeapProfilerSampleBytes;
+
   static bool EnableAPCSizeStats;
   static bool EnableAPCSizeGroup;
   static std::vector<std::string> APCSizeSpecialPrefix;
@@ -378,6 +404,8 @@ public:
   static bool EvalAllowHhas;
   static bool EvalJitNoGdb;
   static bool EvalProfileBC;
+  static bool EvalPerfPidMap;
+  static bool EvalPerfJitDump;
   static std::string EvalProfileHWEvents;
   static bool EvalJitTrampolines;
   static string EvalJitProfilePath;
@@ -404,6 +432,7 @@ public:
   static std::string RepoLocalPath;
   static std::string RepoCentralPath;
   static std::string RepoEvalMode;
+  static std::string RepoImagePath;
   static bool RepoCommit;
   static bool RepoDebugInfo;
   static bool RepoAuthoritative;
@@ -440,6 +469,10 @@ public:
   static int PregBacktraceLimit;
   static int PregRecursionLimit;
   static bool EnablePregErrorLog;
+  static int PregCacheSize;
+  static bool PregJit;
+  static int PregJitStackSize;
+  static std::vector<std::string> PregPreload;
 
   // Convenience switch to turn on/off code alternatives via command-line
   // Do not commit code guarded by this flag, for evaluation only.
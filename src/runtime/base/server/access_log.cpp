@@ -22,18 +22,67 @@
 #include <runtime/base/server/server_stats.h>
 #include <runtime/base/server/request_uri.h>
 #include <util/process.h>
-#include <util/atomic.h>
+#include <util/async_func.h>
+#include <util/synchronizable.h>
 #include <util/compatibility.h>
 #include <util/util.h>
 #include <util/hardware_counter.h>
-
-using std::endl;
+#include <sys/uio.h>
+#include <limits.h>
 
 namespace HPHP {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+class AccessLogWriter : public Synchronizable {
+public:
+  AccessLogWriter(AccessLog *log)
+    : m_log(log), m_stopped(false), m_thread(this, &AccessLogWriter::run) {
+  }
+
+  void start() { m_thread.start(); }
+
+  void stop() {
+    {
+      Lock lock(this);
+      m_stopped = true;
+      notify();
+    }
+    m_thread.waitForEnd();
+  }
+
+  void run() {
+    Lock lock(this);
+    while (!m_stopped) {
+      int ms = RuntimeOption::AccessLogFlushMs;
+      wait(ms / 1000, (ms % 1000) * 1000000LL);
+      m_log->flush();
+    }
+  }
+
+private:
+  AccessLog *m_log;
+  bool m_stopped;
+  AsyncFunc<AccessLogWriter> m_thread;
+};
+
+AccessLog::ThreadData::~ThreadData() {
+  if (owner) owner->releaseThread(this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 AccessLog::~AccessLog() {
+  stop();
+  {
+    Lock lock(m_lock);
+    for (std::set<ThreadData*>::iterator iter = m_threads.begin();
+         iter != m_threads.end(); ++iter) {
+      (*iter)->owner = NULL;
+    }
+    m_threads.clear();
+  }
+
   signal(SIGCHLD, SIG_DFL);
   for (uint i = 0; i < m_output.size(); ++i) {
     if (m_output[i].log) {
@@ -53,6 +102,7 @@ void AccessLog::init(const string &defaultFormat,
   if (m_initialized) return;
   m_initialized = true;
   m_defaultFormat = defaultFormat;
+  compileFormat(m_defaultFormat, m_defaultFields);
   m_files = files;
   openFiles(username);
 }
@@ -65,6 +115,7 @@ void AccessLog::init(const string &format,
   if (m_initialized) return;
   m_initialized = true;
   m_defaultFormat = format;
+  compileFormat(m_defaultFormat, m_defaultFields);
   if (!file.empty() && !format.empty()) {
     m_files.push_back(AccessLogFileData(file, symLink, format));
   }
@@ -103,6 +154,14 @@ void AccessLog::openFiles(const string &username) {
       }
       m_output.push_back(LogFileData(fp));
     }
+    m_fields.push_back(Format());
+    compileFormat(it->format, m_fields.back());
+  }
+  m_orphans.resize(m_files.size());
+
+  if (RuntimeOption::AccessLogBufferKB > 0) {
+    m_writer = new AccessLogWriter(this);
+    m_writer->start();
   }
 }
 
@@ -111,163 +170,287 @@ void AccessLog::log(Transport *transport, const VirtualHost *vhost) {
   if (!m_initialized) return;
 
   AccessLog::ThreadData *threadData = m_fGetThreadData();
+  string &line = threadData->line;
   FILE *threadLog = threadData->log;
   if (threadLog) {
+    line.clear();
+    render(line, m_defaultFields, transport, vhost);
     threadData->bytesWritten +=
-      writeLog(transport, vhost, threadLog, m_defaultFormat.c_str());
+      fwrite(line.data(), 1, line.size(), threadLog);
+    fflush(threadLog);
     Logger::checkDropCache(threadData->bytesWritten,
                            threadData->prevBytesWritten,
                            threadLog);
   }
-  if (Logger::UseCronolog) {
-    for (uint i = 0; i < m_cronOutput.size(); ++i) {
-      Cronolog &cronOutput = *m_cronOutput[i];
-      FILE *outFile = cronOutput.getOutputFile();
-      if (!outFile) continue;
-      const char *format = m_files[i].format.c_str();
-      int bytes = writeLog(transport, vhost, outFile, format);
-      atomic_add(cronOutput.m_bytesWritten, bytes);
-      Logger::checkDropCache(cronOutput.m_bytesWritten,
-                             cronOutput.m_prevBytesWritten,
-                             outFile);
+  if (m_fields.empty()) return;
+
+  if (!m_writer) {
+    // no writer: this thread writes its own lines, and only those
+    vector<string> lines(1);
+    for (uint i = 0; i < m_fields.size(); ++i) {
+      lines[0].clear();
+      render(lines[0], m_fields[i], transport, vhost);
+      Lock flushLock(m_flushLock);
+      writeBatch(i, lines);
     }
-  } else {
-    for (uint i = 0; i < m_output.size(); ++i) {
-      LogFileData &output = m_output[i];
-      FILE *outFile = output.log;
-      if (!outFile) continue;
-      const char *format = m_files[i].format.c_str();
-      int bytes = writeLog(transport, vhost, outFile, format);
-      atomic_add(output.bytesWritten, bytes);
-      if (m_files[i].file[0] != '|') {
-        Logger::checkDropCache(output.bytesWritten,
-                               output.prevBytesWritten,
-                               outFile);
-      }
+    return;
+  }
+
+  if (!threadData->owner) registerThread(threadData);
+  unsigned int limit = RuntimeOption::AccessLogBufferKB * 1024;
+  for (uint i = 0; i < m_fields.size(); ++i) {
+    line.clear();
+    render(line, m_fields[i], transport, vhost);
+
+    Lock lock(threadData->lock);
+    string &pending = threadData->pending[i];
+    if (pending.size() + line.size() > limit) {
+      threadData->dropped++;
+    } else {
+      pending += line;
     }
   }
 }
 
-int AccessLog::writeLog(Transport *transport, const VirtualHost *vhost,
-                        FILE *outFile, const char *format) {
-   char c;
-   std::ostringstream out;
-   while (c = *format++) {
-     if (c != '%') {
-       out << c;
-       continue;
-     }
-
-     if (parseConditions(format, transport->getResponseCode())) {
-       string arg = parseArgument(format);
-       if (!genField(out, format, transport, vhost, arg)) {
-         out << "-";
-       }
-     } else {
-       skipField(format);
-       out << "-";
-     }
-   }
-   out << endl;
-   string output = out.str();
-   int nbytes = fprintf(outFile, "%s", output.c_str());
-   fflush(outFile);
-   return nbytes;
+void AccessLog::registerThread(ThreadData *threadData) {
+  Lock lock(m_lock);
+  threadData->owner = this;
+  threadData->pending.resize(m_fields.size());
+  m_threads.insert(threadData);
 }
 
-bool AccessLog::parseConditions(const char* &format, int code) {
-  bool wantMatch = true;
-  if (*format == '!') {
-    wantMatch = false;
-    format++;
-  } else if (!isdigit(*format)) {
-    // No conditions
-    return true;
+void AccessLog::releaseThread(ThreadData *threadData) {
+  Lock lock(m_lock);
+  m_threads.erase(threadData);
+  for (uint i = 0; i < threadData->pending.size(); ++i) {
+    m_orphans[i] += threadData->pending[i];
   }
-  char buf[4];
-  buf[3] = '\0';
-
-  bool matched = false;
-  while(isdigit(*format)) {
-    buf[0] = format[0];
-    buf[1] = format[1];
-    buf[2] = format[2];
-    int c = atoi(buf);
-    if (c == code) {
-      matched = true;
+  m_orphansDropped += threadData->dropped;
+}
+
+void AccessLog::flush() {
+  if (m_fields.empty()) return;
+  Lock flushLock(m_flushLock); // one batch at a time keeps files in order
+
+  vector<vector<string> > batches(m_fields.size());
+  int dropped = 0;
+  {
+    Lock lock(m_lock);
+    for (std::set<ThreadData*>::iterator iter = m_threads.begin();
+         iter != m_threads.end(); ++iter) {
+      ThreadData *threadData = *iter;
+      Lock l(threadData->lock);
+      for (uint i = 0; i < batches.size(); ++i) {
+        string &pending = threadData->pending[i];
+        if (pending.empty()) continue;
+        batches[i].push_back(string());
+        batches[i].back().swap(pending);
+      }
+      dropped += threadData->dropped;
+      threadData->dropped = 0;
+    }
+    for (uint i = 0; i < batches.size(); ++i) {
+      if (m_orphans[i].empty()) continue;
+      batches[i].push_back(string());
+      batches[i].back().swap(m_orphans[i]);
+    }
+    dropped += m_orphansDropped;
+    m_orphansDropped = 0;
+  }
+
+  for (uint i = 0; i < batches.size(); ++i) {
+    if (!batches[i].empty()) writeBatch(i, batches[i]);
+  }
+  if (dropped) {
+    Logger::Warning("Access log writer fell behind, %d lines dropped",
+                    dropped);
+  }
+}
+
+void AccessLog::writeBatch(int i, vector<string> &lines) {
+  FILE *outFile;
+  int *bytesWritten;
+  int *prevBytesWritten;
+  bool dropCache = true;
+  if (Logger::UseCronolog) {
+    Cronolog &cronOutput = *m_cronOutput[i];
+    outFile = cronOutput.getOutputFile();
+    bytesWritten = &cronOutput.m_bytesWritten;
+    prevBytesWritten = &cronOutput.m_prevBytesWritten;
+  } else {
+    LogFileData &output = m_output[i];
+    outFile = output.log;
+    bytesWritten = &output.bytesWritten;
+    prevBytesWritten = &output.prevBytesWritten;
+    dropCache = m_files[i].file[0] != '|';
+  }
+  if (!outFile) return;
+
+  vector<struct iovec> iov(lines.size());
+  for (uint j = 0; j < lines.size(); ++j) {
+    iov[j].iov_base = (void*)lines[j].data();
+    iov[j].iov_len = lines[j].size();
+  }
+  int fd = fileno(outFile);
+  uint next = 0;
+  while (next < iov.size()) {
+    int count = iov.size() - next;
+    if (count > IOV_MAX) count = IOV_MAX;
+    ssize_t n = writev(fd, &iov[next], count);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      Logger::Error("Unable to write access log %s: %s",
+                    m_files[i].file.c_str(),
+                    Util::safe_strerror(errno).c_str());
       break;
     }
-    format+=4;
+    *bytesWritten += n;
+    // skip what got written, which may end in the middle of a line
+    while (n > 0) {
+      if ((size_t)n >= iov[next].iov_len) {
+        n -= iov[next++].iov_len;
+      } else {
+        iov[next].iov_base = (char*)iov[next].iov_base + n;
+        iov[next].iov_len -= n;
+        n = 0;
+      }
+    }
   }
-  while (!(*format == '{' || isalpha(*format))) {
-    format++;
+  if (dropCache) {
+    Logger::checkDropCache(*bytesWritten, *prevBytesWritten, outFile);
   }
-  return wantMatch == matched;
 }
 
-string AccessLog::parseArgument(const char* &format) {
-  if (*format != '{') return string();
-  format++;
-  const char *start = format;
-  while (*format != '}') { format++; }
-  string res(start, format - start);
-  format++;
-  return res;
+void AccessLog::stop() {
+  AccessLogWriter *writer;
+  {
+    Lock lock(m_lock);
+    writer = m_writer;
+    m_writer = NULL;
+  }
+  if (writer) {
+    writer->stop();
+    delete writer;
+  }
+  flush();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// formats
+
+/*
+ * Apache's syntax: %[!][code,code...][{argument}][<|>]letter, e.g.
+ * %400,501{User-agent}i or %!200,304{Referer}i, and anything else is
+ * literal text.
+ */
+void AccessLog::compileFormat(const string &format, Format &fields) {
+  fields.clear();
+  const char *p = format.c_str();
+  while (*p) {
+    if (*p != '%') {
+      if (fields.empty() || fields.back().type) fields.push_back(Field());
+      fields.back().arg += *p++;
+      continue;
+    }
+    p++;
+
+    Field field;
+    if (*p == '!') {
+      field.negate = true;
+      p++;
+    }
+    while (isdigit(*p)) {
+      char *end;
+      field.codes.push_back(strtol(p, &end, 10));
+      p = end;
+      if (*p == ',') p++;
+    }
+    if (*p == '{') {
+      const char *end = strchr(p + 1, '}');
+      if (!end) break;
+      field.arg.assign(p + 1, end - p - 1);
+      p = end + 1;
+    }
+    while (*p && !isalpha(*p)) p++;
+    if (!*p) break;
+    field.type = *p++;
+    fields.push_back(field);
+  }
 }
 
-void AccessLog::skipField(const char* &format) {
-  // Skip argument
-  if (*format == '{') {
-    while (*format != '}') { format++; }
-    format++;
+void AccessLog::render(string &out, const Format &fields,
+                       Transport *transport, const VirtualHost *vhost) {
+  int code = transport->getResponseCode();
+  for (uint i = 0; i < fields.size(); ++i) {
+    const Field &field = fields[i];
+    if (!field.type) {
+      out += field.arg;
+      continue;
+    }
+    if (!field.codes.empty()) {
+      bool matched = std::find(field.codes.begin(), field.codes.end(),
+                               code) != field.codes.end();
+      if (matched == field.negate) {
+        out += '-';
+        continue;
+      }
+    }
+    if (!genField(out, field, transport, vhost)) {
+      out += '-';
+    }
   }
-  // Find control letter
-  while (!isalpha(*format)) { format++; }
-  // Skip it
-  format++;
+  out += '\n';
 }
 
-static void escape_data(std::ostringstream &out, const char *s, int len)
+static int s_pspInst = ServerStats::Register("page.inst.psp");
+static int s_pspWall = ServerStats::Register("page.wall.psp");
+static int s_pspCpu = ServerStats::Register("page.cpu.psp");
+
+static void append_int(string &out, int64 n) {
+  char buf[24];
+  int len = snprintf(buf, sizeof(buf), "%lld", (long long)n);
+  out.append(buf, len);
+}
+
+static void escape_data(string &out, const char *s, int len)
 {
   static const char digits[] = "0123456789abcdef";
 
   for (int i = 0; i < len; i++) {
     unsigned char uc = *s++;
     switch (uc) {
-      case '"':  out << "\\\""; break;
-      case '\\': out << "\\\\"; break;
-      case '\b': out << "\\b";  break;
-      case '\f': out << "\\f";  break;
-      case '\n': out << "\\n";  break;
-      case '\r': out << "\\r";  break;
-      case '\t': out << "\\t";  break;
+      case '"':  out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\b': out += "\\b";  break;
+      case '\f': out += "\\f";  break;
+      case '\n': out += "\\n";  break;
+      case '\r': out += "\\r";  break;
+      case '\t': out += "\\t";  break;
       default:
         if (uc >= ' ' && (uc & 127) == uc) {
-          out << (char)uc;
+          out += (char)uc;
         } else {
-          out << "\\x" << digits[(uc >> 4) & 15] << digits[(uc >> 0) & 15];
+          out += "\\x";
+          out += digits[(uc >> 4) & 15];
+          out += digits[(uc >> 0) & 15];
         }
         break;
     }
   }
 }
 
-bool AccessLog::genField(std::ostringstream &out, const char* &format,
-                         Transport *transport, const VirtualHost *vhost,
-                         const string &arg) {
+bool AccessLog::genField(string &out, const Field &field,
+                         Transport *transport, const VirtualHost *vhost) {
   int responseSize = transport->getResponseSize();
   int code = transport->getResponseCode();
+  const string &arg = field.arg;
 
-  while (!isalpha(*format)) { format++; }
-  char type = *format;
-  format++;
-
-  switch (type) {
+  switch (field.type) {
   case 'b':
     if (responseSize == 0) return false;
     // Fall through
   case 'B':
-    out << responseSize;
+    append_int(out, responseSize);
     break;
   case 'C':
     if (arg.empty()) {
@@ -282,18 +465,18 @@ bool AccessLog::genField(std::ostringstream &out, const char* &format,
     {
       struct timespec now;
       gettime(CLOCK_MONOTONIC, &now);
-      out << gettime_diff_us(transport->getWallTime(), now);
+      append_int(out, gettime_diff_us(transport->getWallTime(), now));
     }
     break;
   case 'd':
     {
       struct timespec now;
       gettime(CLOCK_THREAD_CPUTIME_ID, &now);
-      out << gettime_diff_us(transport->getCpuTime(), now);
+      append_int(out, gettime_diff_us(transport->getCpuTime(), now));
     }
     break;
   case 'h':
-    out << transport->getRemoteHost();
+    out += transport->getRemoteHost();
     break;
   case 'i':
     if (arg.empty()) return false;
@@ -303,9 +486,9 @@ bool AccessLog::genField(std::ostringstream &out, const char* &format,
 
       if (vhost && vhost->hasLogFilter() &&
           strcasecmp(arg.c_str(), "Referer") == 0) {
-        out << vhost->filterUrl(header);
+        out += vhost->filterUrl(header);
       } else {
-        out << header;
+        out += header;
       }
     }
     break;
@@ -314,7 +497,7 @@ bool AccessLog::genField(std::ostringstream &out, const char* &format,
     {
       String note = ServerNote::Get(arg);
       if (note.isNull()) return false;
-      out << note.c_str();
+      out += note.c_str();
     }
     break;
   case 'r':
@@ -327,28 +510,29 @@ bool AccessLog::genField(std::ostringstream &out, const char* &format,
       default: break;
       }
       if (!method) return false;
-      out << method << " ";
+      out += method;
+      out += ' ';
 
       const char *url = transport->getUrl();
       if (vhost && vhost->hasLogFilter()) {
-        out << vhost->filterUrl(url);
+        out += vhost->filterUrl(url);
       } else {
-        out << url;
+        out += url;
       }
 
-      string httpVersion = transport->getHTTPVersion();
-      out << " HTTP/" << httpVersion;
+      out += " HTTP/";
+      out += transport->getHTTPVersion();
     }
     break;
   case 's':
-    out << code;
+    append_int(out, code);
     break;
   case 'S':
     // %S is not defined in Apache, we grab it here
     {
       const std::string &info (transport->getResponseInfo());
       if (info.empty()) return false;
-      out << info;
+      out += info;
     }
     break;
   case 't':
@@ -361,21 +545,21 @@ bool AccessLog::genField(std::ostringstream &out, const char* &format,
       }
       char buf[256];
       time_t rawtime;
-      struct tm * timeinfo;
+      struct tm timeinfo;
       time(&rawtime);
-      timeinfo = localtime(&rawtime);
-      strftime(buf, 256, format, timeinfo);
-      out << buf;
+      localtime_r(&rawtime, &timeinfo);
+      strftime(buf, 256, format, &timeinfo);
+      out += buf;
     }
     break;
   case 'T':
-    out << TimeStamp::Current() - m_fGetThreadData()->startTime;
+    append_int(out, TimeStamp::Current() - m_fGetThreadData()->startTime);
     break;
   case 'U':
     {
       String b, q;
       RequestURI::splitURL(transport->getUrl(), b, q);
-      out << b;
+      out.append(b.data(), b.size());
     }
     break;
   case 'v':
@@ -383,27 +567,27 @@ bool AccessLog::genField(std::ostringstream &out, const char* &format,
       string host = transport->getHeader("Host");
       const string &sname = VirtualHost::GetCurrent()->serverName(host);
       if (sname.empty() || RuntimeOption::ForceServerNameToHeader) {
-        out << host;
+        out += host;
       } else {
-        out << sname;
+        out += sname;
       }
     }
     break;
   case 'Y':
     {
       int64 now = Util::HardwareCounter::GetInstructionCount();
-      out << now - transport->getInstructions();
+      append_int(out, now - transport->getInstructions());
     }
     break;
   case 'y':
-    out << ServerStats::Get("page.inst.psp");
+    append_int(out, ServerStats::Get(s_pspInst));
     break;
   case 'Z':
-     out << ServerStats::Get("page.wall.psp");
-     break;
+    append_int(out, ServerStats::Get(s_pspWall));
+    break;
   case 'z':
-     out << ServerStats::Get("page.cpu.psp");
-     break;
+    append_int(out, ServerStats::Get(s_pspCpu));
+    break;
   default:
     return false;
   }
@@ -36,19 +36,42 @@ public:
   std::string format;
 };
 
+class AccessLogWriter;
+
+/**
+ * Apache style access logs.
+ *
+ * Formats are compiled into a list of fields once, at init(). Each request
+ * thread renders its line into a buffer of its own, and a background writer
+ * swaps those buffers out every Log.AccessLogFlushMs and hands them to the
+ * files with writev(), so request threads never wait on the disk. A thread
+ * that gets more than Log.AccessLogBufferKB ahead of the writer drops lines,
+ * and the writer reports how many. With AccessLogBufferKB = 0 lines are
+ * written by the request thread itself.
+ */
 class AccessLog {
 public:
   class ThreadData {
   public:
-    ThreadData() : log(NULL), bytesWritten(0), prevBytesWritten(0) {}
+    ThreadData() : log(NULL), bytesWritten(0), prevBytesWritten(0),
+                   owner(NULL), dropped(0) {}
+    ~ThreadData();
     FILE *log;
     int64 startTime;
     int bytesWritten;
     int prevBytesWritten;
+
+    // lines waiting for the writer, one buffer per output
+    AccessLog *owner;
+    Mutex lock;
+    std::vector<std::string> pending;
+    int dropped;
+    std::string line;
   };
   typedef ThreadData* (*GetThreadDataFunc)();
   AccessLog(GetThreadDataFunc f) :
-      m_initialized(false), m_fGetThreadData(f) {}
+      m_initialized(false), m_fGetThreadData(f), m_orphansDropped(0),
+      m_writer(NULL) {}
   ~AccessLog();
   void init(const std::string &defaultFormat,
             std::vector<AccessLogFileData> &files,
@@ -61,15 +84,40 @@ public:
   void onNewRequest();
   std::string &defaultFormat() { return m_defaultFormat; }
   std::vector<AccessLogFileData> &files() { return m_files; }
+
+  /**
+   * Writes out whatever request threads have logged so far.
+   */
+  void flush();
+
+  /**
+   * Stops the background writer after a last flush. Lines logged after
+   * this are written by the logging thread.
+   */
+  void stop();
+
 private:
-  bool parseConditions(const char* &format, int code);
-  std::string parseArgument(const char* &format);
-  bool genField(std::ostringstream &out, const char* &format,
-                Transport *transport, const VirtualHost *vhost,
-                const std::string &arg);
-  void skipField(const char* &format);
-  int writeLog(Transport *transport, const VirtualHost *vhost,
-               FILE *outFile, const char *format);
+  /**
+   * One compiled %-directive, or a run of literal text when type is 0.
+   */
+  struct Field {
+    Field() : type(0), negate(false) {}
+    char type;
+    std::string arg;         // literal text, or the {argument}
+    std::vector<int> codes;  // only logged for these response codes
+    bool negate;             // ... or for any but these
+  };
+  typedef std::vector<Field> Format;
+
+  static void compileFormat(const std::string &format, Format &fields);
+  void render(std::string &out, const Format &fields,
+              Transport *transport, const VirtualHost *vhost);
+  bool genField(std::string &out, const Field &field,
+                Transport *transport, const VirtualHost *vhost);
+
+  void registerThread(ThreadData *threadData);
+  void releaseThread(ThreadData *threadData);
+  void writeBatch(int i, std::vector<std::string> &lines);
 
   std::vector<LogFileData> m_output;
   std::vector<CronologPtr> m_cronOutput;
@@ -77,9 +125,19 @@ private:
   GetThreadDataFunc m_fGetThreadData;
   std::string m_defaultFormat;
   std::vector<AccessLogFileData> m_files;
+  Format m_defaultFields;
+  std::vector<Format> m_fields;
 
   void openFiles(const std::string &username);
   Mutex m_lock;
+
+  // threads with lines pending, and what threads that exited left behind
+  std::set<ThreadData*> m_threads;
+  std::vector<std::string> m_orphans;
+  int m_orphansDropped;
+
+  Mutex m_flushLock;
+  AccessLogWriter *m_writer;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -22,6 +22,8 @@
 #include <runtime/base/server/pagelet_server.h>
 #include <runtime/base/util/http_client.h>
 #include <runtime/base/server/server_stats.h>
+#include <runtime/base/server/io_trace.h>
+#include <runtime/base/server/stack_sampler.h>
 #include <runtime/base/runtime_option.h>
 #include <util/process.h>
 #include <util/logger.h>
@@ -29,10 +31,12 @@
 #include <util/mutex.h>
 #include <runtime/base/time/datetime.h>
 #include <runtime/base/memory/memory_manager.h>
+#include <runtime/base/memory/heap_profiler.h>
 #include <runtime/base/program_functions.h>
 #include <runtime/base/shared/shared_store_base.h>
 #include <runtime/base/memory/leak_detectable.h>
 #include <runtime/ext/mysql_stats.h>
+#include <runtime/ext/mysql_pool.h>
 #include <runtime/base/shared/shared_store_stats.h>
 #include <runtime/vm/repo.h>
 #include <runtime/vm/translator/translator.h>
@@ -135,6 +139,8 @@ void AdminRequestHandler::handleRequest(Transport *transport) {
         "                  be handled\n"
         "/check-mem:       report memory quick statistics in log file\n"
         "/check-sql:       report SQL table statistics\n"
+        "/check-sql-pool:  report MySQL connection pool occupancy and\n"
+        "                  checkout wait times\n"
 
         "/status.xml:      show server status in XML\n"
         "/status.json:     show server status in JSON\n"
@@ -183,6 +189,29 @@ void AdminRequestHandler::handleRequest(Transport *transport) {
         "                  /tmp/const_map_dump\n"
         "/dump-file-repo:  dump file repository to /tmp/file_repo_dump\n"
 
+        "/prof-sample.folded:\n"
+        "                  sampled PHP stacks per URL, as folded stacks for\n"
+        "                  flamegraph.pl; needs Stats.StackSampler.IntervalMs\n"
+        "/prof-sample-clear:\n"
+        "                  start sampled stack counts over\n"
+        "/heap-alloc.folded:\n"
+        "                  sampled bytes allocated per URL and PHP stack,\n"
+        "                  as folded stacks; needs\n"
+        "                  Stats.HeapProfiler.SampleBytes\n"
+        "/heap-peak.folded:\n"
+        "                  same, for each request's heap at its peak\n"
+        "/heap-live.folded:\n"
+        "                  same, for what running requests hold now\n"
+        "/heap-profile.pprof:\n"
+        "                  live and allocated heap for pprof\n"
+        "/heap-profile-clear:\n"
+        "                  start allocated and peak heap over\n"
+
+        "/io-trace.json:   I/O timelines of kept slow requests, as Chrome\n"
+        "                  trace events\n"
+        "/io-trace.folded: the same as folded stacks for flamegraph.pl\n"
+        "/io-trace-clear:  drop the kept I/O timelines\n"
+
 #ifdef GOOGLE_CPU_PROFILER
         "/prof-cpu-on:     turn on CPU profiler\n"
         "/prof-cpu-off:    turn off CPU profiler\n"
@@ -321,6 +350,10 @@ void AdminRequestHandler::handleRequest(Transport *transport) {
         handleVMRequest(cmd, transport)) {
       break;
     }
+    if (strncmp(cmd.c_str(), "io-trace", 8) == 0 &&
+        handleIOTraceRequest(cmd, transport)) {
+      break;
+    }
 
 #ifndef NO_TCMALLOC
     if (MallocExtensionInstance) {
@@ -569,6 +602,14 @@ bool AdminRequestHandler::handleCheckRequest(const std::string &cmd,
     transport->sendString(stats);
     return true;
   }
+  if (cmd == "check-sql-pool") {
+    string stats = "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+    stats += "<SQLPool>\n";
+    stats += MySQLConnectionPool::ReportStats();
+    stats += "</SQLPool>\n";
+    transport->sendString(stats);
+    return true;
+  }
   return false;
 }
 
@@ -698,6 +739,37 @@ bool AdminRequestHandler::handleProfileRequest(const std::string &cmd,
 
     return true;
   }
+  if (cmd == "prof-sample.folded") {
+    string out;
+    StackSampler::Report(out);
+    transport->sendString(out);
+    return true;
+  }
+  if (cmd == "prof-sample-clear") {
+    StackSampler::Clear();
+    transport->sendString("OK\n");
+    return true;
+  }
+  if (cmd == "heap-alloc.folded" || cmd == "heap-peak.folded" ||
+      cmd == "heap-live.folded" || cmd == "heap-profile.pprof") {
+    string out;
+    if (cmd == "heap-alloc.folded") {
+      HeapProfiler::ReportAllocated(out);
+    } else if (cmd == "heap-peak.folded") {
+      HeapProfiler::ReportPeak(out);
+    } else if (cmd == "heap-live.folded") {
+      HeapProfiler::ReportLive(out);
+    } else {
+      HeapProfiler::ReportPprof(out);
+    }
+    transport->sendString(out);
+    return true;
+  }
+  if (cmd == "heap-profile-clear") {
+    HeapProfiler::Clear();
+    transport->sendString("OK\n");
+    return true;
+  }
 #ifdef GOOGLE_CPU_PROFILER
   if (handleCPUProfilerRequest(cmd, transport)) {
     return true;
@@ -945,6 +1017,32 @@ bool AdminRequestHandler::handleVMRequest(const std::string &cmd,
   return false;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// I/O traces
+
+bool AdminRequestHandler::handleIOTraceRequest(const std::string &cmd,
+                                               Transport *transport) {
+  if (cmd == "io-trace.json") {
+    string out;
+    IOTrace::ReportJSON(out);
+    transport->addHeader("Content-Type", "application/json");
+    transport->sendString(out);
+    return true;
+  }
+  if (cmd == "io-trace.folded") {
+    string out;
+    IOTrace::ReportFolded(out);
+    transport->sendString(out);
+    return true;
+  }
+  if (cmd == "io-trace-clear") {
+    IOTrace::Clear();
+    transport->sendString("OK\n");
+    return true;
+  }
+  return false;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Dump cache content
 
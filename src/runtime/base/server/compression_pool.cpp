@@ -0,0 +1,100 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include <runtime/base/server/compression_pool.h>
+#include <runtime/base/runtime_option.h>
+#include <util/job_queue.h>
+#include <util/compression.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+CompressionJob::CompressionJob(const void *data, int size, int level)
+  : m_size(size), m_level(level) {
+  m_data = (char *)malloc(size);
+  memcpy(m_data, data, size);
+}
+
+CompressionJob::~CompressionJob() {
+  free(m_data);
+}
+
+void CompressionJob::run() {
+  int len = m_size;
+  char *compressed = gzencode(m_data, len, m_level, CODING_GZIP);
+  if (compressed && len >= m_size) {
+    free(compressed);
+    compressed = NULL;
+  }
+  onCompressed(compressed, len);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+class CompressionWorker : public JobQueueWorker<CompressionJob*, true, true> {
+public:
+  virtual void doJob(CompressionJob *job) {
+    job->run();
+    delete job;
+  }
+};
+
+static JobQueueDispatcher<CompressionJob*, CompressionWorker> *s_dispatcher;
+
+void CompressionPool::Restart() {
+  Stop();
+
+  if (RuntimeOption::CompressionThreadCount > 0) {
+    s_dispatcher = new JobQueueDispatcher<CompressionJob*, CompressionWorker>
+      (RuntimeOption::CompressionThreadCount,
+       RuntimeOption::ServerThreadRoundRobin,
+       RuntimeOption::ServerThreadDropCacheTimeoutSeconds,
+       RuntimeOption::ServerThreadDropStack,
+       NULL);
+    s_dispatcher->start();
+  }
+}
+
+void CompressionPool::Stop() {
+  if (s_dispatcher) {
+    s_dispatcher->stop();
+    delete s_dispatcher;
+    s_dispatcher = NULL;
+  }
+}
+
+bool CompressionPool::Enabled() {
+  return s_dispatcher != NULL;
+}
+
+void CompressionPool::Enqueue(CompressionJob *job) {
+  ASSERT(job);
+  if (s_dispatcher) {
+    s_dispatcher->enqueue(job);
+  } else {
+    job->run();
+    delete job;
+  }
+}
+
+void CompressionPool::Drain() {
+  if (s_dispatcher) {
+    s_dispatcher->waitEmpty(false);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,79 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef __HPHP_COMPRESSION_POOL_H__
+#define __HPHP_COMPRESSION_POOL_H__
+
+#include <util/base.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Gzips a private copy of some content on a compression thread and hands
+ * the result to onCompressed(). Subclasses decide where it goes.
+ */
+class CompressionJob {
+public:
+  CompressionJob(const void *data, int size, int level);
+  virtual ~CompressionJob();
+
+  void run();
+
+protected:
+  /**
+   * Takes ownership of compressed, a malloc'd buffer of len bytes. It is
+   * NULL when gzip would not have made the content smaller, in which case
+   * m_data is what should be used.
+   */
+  virtual void onCompressed(char *compressed, int len) = 0;
+
+  char *m_data;
+  int m_size;
+  int m_level;
+};
+
+/**
+ * Threads that gzip finished responses and dynamic content cache entries,
+ * so request threads don't spend their time in zlib. Sized by
+ * Server.CompressionThreadCount; with no threads, jobs run right away on
+ * the calling thread.
+ */
+class CompressionPool {
+public:
+  /**
+   * Start or restart compression threads.
+   */
+  static void Restart();
+  static void Stop();
+
+  static bool Enabled();
+
+  /**
+   * Queues up job, which the pool then deletes after running it.
+   */
+  static void Enqueue(CompressionJob *job);
+
+  /**
+   * Waits until every job queued so far has run.
+   */
+  static void Drain();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif // __HPHP_COMPRESSION_POOL_H__
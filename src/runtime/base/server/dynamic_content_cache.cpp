@@ -15,14 +15,32 @@
 */
 
 #include <runtime/base/server/dynamic_content_cache.h>
+#include <runtime/base/server/compression_pool.h>
 #include <util/lock.h>
-#include <util/compression.h>
 
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 
 DynamicContentCache DynamicContentCache::TheCache;
 
+namespace {
+class CacheCompressionJob : public CompressionJob {
+public:
+  CacheCompressionJob(const std::string &name, const char *data, int size)
+    : CompressionJob(data, size, 9), m_name(name) {}
+
+protected:
+  virtual void onCompressed(char *compressed, int len) {
+    if (compressed) {
+      DynamicContentCache::TheCache.storeCompressed(m_name, compressed, len);
+    }
+  }
+
+private:
+  std::string m_name;
+};
+}
+
 DynamicContentCache::DynamicContentCache() {
 }
 
@@ -57,19 +75,22 @@ void DynamicContentCache::store(const std::string &name, const char *data,
   sb->append(data, size);
   f->file = sb;
 
-  int len = sb->size();
-  char *compressed = gzencode(sb->data(), len, 9, CODING_GZIP);
-  if (compressed) {
-    if (len < sb->size()) {
-      f->compressed = StringBufferPtr(new StringBuffer(compressed, len));
-    } else {
-      free(compressed);
-    }
+  {
+    WriteLock lock(m_mutex);
+    if (m_files.find(name) != m_files.end()) return;
+    m_files[name] = f;
   }
+  CompressionPool::Enqueue(new CacheCompressionJob(name, data, size));
+}
+
+void DynamicContentCache::storeCompressed(const std::string &name,
+                                          char *data, int len) {
+  StringBufferPtr sb(new StringBuffer(data, len));
 
   WriteLock lock(m_mutex);
-  if (m_files.find(name) == m_files.end()) {
-    m_files[name] = f;
+  StringToResourceFilePtrMap::iterator iter = m_files.find(name);
+  if (iter != m_files.end() && !iter->second->compressed) {
+    iter->second->compressed = sb;
   }
 }
 
@@ -37,10 +37,16 @@ public:
             bool &compressed);
 
   /**
-   * Store a file to cache.
+   * Store a file to cache. Its gzipped copy is made by CompressionPool and
+   * served once it's there.
    */
   void store(const std::string &name, const char *data, int size);
 
+  /**
+   * Attach name's gzipped copy, taking ownership of data.
+   */
+  void storeCompressed(const std::string &name, char *data, int len);
+
 private:
   ReadWriteMutex m_mutex;
 
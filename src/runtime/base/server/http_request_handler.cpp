@@ -22,6 +22,9 @@
 #include <runtime/base/server/static_content_cache.h>
 #include <runtime/base/server/dynamic_content_cache.h>
 #include <runtime/base/server/server_stats.h>
+#include <runtime/base/server/io_trace.h>
+#include <runtime/base/server/stack_sampler.h>
+#include <runtime/base/memory/heap_profiler.h>
 #include <util/network.h>
 #include <runtime/base/preg.h>
 #include <runtime/ext/ext_function.h>
@@ -113,7 +116,8 @@ void HttpRequestHandler::handleRequest(Transport *transport) {
   GetAccessLog().onNewRequest();
   transport->enableCompression();
 
-  ServerStatsHelper ssh("all", ServerStatsHelper::TRACK_MEMORY);
+  ServerStatsHelper ssh("all", ServerStatsHelper::TRACK_MEMORY |
+                        ServerStatsHelper::TRACK_HISTOGRAM);
   Logger::Verbose("receiving %s", transport->getCommand().c_str());
 
   // will clear all extra logging when this function goes out of scope
@@ -131,6 +135,10 @@ void HttpRequestHandler::handleRequest(Transport *transport) {
   ServerStats::StartRequest(transport->getCommand().c_str(),
                             transport->getRemoteHost(),
                             vhost->getName().c_str());
+  ServerStats::StartHardwareCounters();
+  IOTrace::StartRequest(transport->getCommand().c_str());
+  StackSampler::StartRequest(transport->getCommand().c_str());
+  HeapProfiler::StartRequest(transport->getCommand().c_str());
 
   // resolve source root
   string host = transport->getHeader("Host");
@@ -188,6 +196,7 @@ void HttpRequestHandler::handleRequest(Transport *transport) {
         }
         sendStaticContent(transport, data, len, 0, compressed, path, ext);
         StaticContentCache::TheFileCache->adviseOutMemory();
+        ServerStats::LogHardwareCounters();
         ServerStats::LogPage(path, 200);
         GetAccessLog().log(transport, vhost);
         return;
@@ -204,6 +213,7 @@ void HttpRequestHandler::handleRequest(Transport *transport) {
           stat(translated.data(), &st);
           sendStaticContent(transport, sb.data(), sb.size(), st.st_mtime,
                             false, path, ext);
+          ServerStats::LogHardwareCounters();
           ServerStats::LogPage(path, 200);
           GetAccessLog().log(transport, vhost);
           return;
@@ -218,6 +228,7 @@ void HttpRequestHandler::handleRequest(Transport *transport) {
       string key = path + transport->getUrl();
       if (DynamicContentCache::TheCache.find(key, data, len, compressed)) {
         sendStaticContent(transport, data, len, 0, compressed, path, ext);
+        ServerStats::LogHardwareCounters();
         ServerStats::LogPage(path, 200);
         GetAccessLog().log(transport, vhost);
         return;
@@ -247,7 +258,7 @@ void HttpRequestHandler::handleRequest(Transport *transport) {
 
   // main body
   hphp_session_init();
-  vhost->setRequestTimeoutSeconds();
+  vhost->setRequestTimeout();
 
   bool ret = false;
   try {
@@ -261,6 +272,9 @@ void HttpRequestHandler::handleRequest(Transport *transport) {
     Logger::Error("Unhandled exception in HPHP server engine.");
   }
   GetAccessLog().log(transport, vhost);
+  IOTrace::EndRequest();
+  StackSampler::EndRequest();
+  HeapProfiler::EndRequest();
   /*
    * HPHP logs may need to access data in ServerStats, so we have to
    * clear the hashtable after writing the log entry.
@@ -370,6 +384,7 @@ bool HttpRequestHandler::executePHPRequest(Transport *transport,
 
   transport->onSendEnd();
   hphp_context_exit(context, true, true, transport->getUrl());
+  ServerStats::LogHardwareCounters();
   ServerStats::LogPage(file, code);
   return ret;
 }
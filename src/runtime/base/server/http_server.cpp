@@ -22,6 +22,8 @@
 #include <runtime/base/server/admin_request_handler.h>
 #include <runtime/base/server/server_stats.h>
 #include <runtime/base/server/xbox_server.h>
+#include <runtime/base/server/compression_pool.h>
+#include <runtime/base/server/stack_sampler.h>
 #include <runtime/base/runtime_option.h>
 #include <runtime/base/server/static_content_cache.h>
 #include <runtime/base/class_info.h>
@@ -37,6 +39,7 @@
 #include <util/db_conn.h>
 #include <util/log_aggregator.h>
 #include <runtime/ext/ext_apc.h>
+#include <runtime/ext/mysql_pool.h>
 #include <sys/types.h>
 #include <signal.h>
 #include <util/ssl_init.h>
@@ -214,6 +217,9 @@ void HttpServer::run() {
 
   m_loggerThread.start();
   m_watchDog.start();
+  if (RuntimeOption::MySQLPool) {
+    MySQLConnectionPool::Start();
+  }
 
   for (unsigned int i = 0; i < m_serviceThreads.size(); i++) {
     m_serviceThreads[i]->start();
@@ -298,6 +304,11 @@ void HttpServer::run() {
     m_serviceThreads[i]->waitForEnd();
   }
 
+  MySQLConnectionPool::Stop();
+  CompressionPool::Stop();
+  StackSampler::Stop();
+  HttpRequestHandler::GetAccessLog().stop();
+  AdminRequestHandler::GetAccessLog().stop();
   hphp_process_exit();
   m_watchDog.waitForEnd();
   m_loggerThread.waitForEnd();
@@ -0,0 +1,280 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include <runtime/base/server/io_trace.h>
+#include <runtime/base/runtime_option.h>
+#include <runtime/base/array/array_init.h>
+#include <util/thread_local.h>
+#include <util/compatibility.h>
+#include <util/timer.h>
+#include <util/lock.h>
+#include <deque>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+static IMPLEMENT_THREAD_LOCAL(IOTrace, s_trace);
+
+namespace {
+struct SlowRequest {
+  std::string url;
+  int64 start;     // microseconds since the epoch
+  int64 duration;
+  int dropped;
+  std::vector<IOTrace::Event> events;
+};
+}
+
+// oldest first
+static Mutex s_slowLock;
+static std::deque<SlowRequest*> s_slow;
+
+IOTrace::IOTrace()
+  : m_enabled(false), m_start(0), m_dropped(0), m_requests(0) {
+}
+
+int64 IOTrace::Now() {
+  timespec ts;
+  gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+void IOTrace::StartRequest(const char *url) {
+  IOTrace *t = s_trace.get();
+  // whatever the last request left behind, if it wasn't kept as slow
+  t->m_enabled = false;
+  t->m_events.clear();
+  t->m_dropped = 0;
+  int rate = RuntimeOption::IOTraceSampleRate;
+  if (rate > 0 && ++t->m_requests >= rate) {
+    t->m_requests = 0;
+    t->Enable();
+  }
+  t->m_url = url;
+  t->m_start = Now();
+}
+
+void IOTrace::EndRequest() {
+  IOTrace *t = s_trace.get();
+  if (!t->m_enabled) return;
+  t->m_enabled = false;
+
+  int64 duration = Now() - t->m_start;
+  if (RuntimeOption::IOTraceKeepCount <= 0 ||
+      duration < RuntimeOption::IOTraceSlowRequestMs * 1000LL) {
+    return;
+  }
+  SlowRequest *slow = new SlowRequest();
+  slow->url = t->m_url;
+  slow->start = Timer::GetCurrentTimeMicros() - duration;
+  slow->duration = duration;
+  slow->dropped = t->m_dropped;
+  slow->events.swap(t->m_events);
+
+  Lock lock(s_slowLock);
+  s_slow.push_back(slow);
+  while ((int)s_slow.size() > RuntimeOption::IOTraceKeepCount) {
+    delete s_slow.front();
+    s_slow.pop_front();
+  }
+}
+
+bool IOTrace::Enabled() {
+  return s_trace->m_enabled;
+}
+
+void IOTrace::Enable() {
+  IOTrace *t = s_trace.get();
+  if (t->m_enabled) return;
+  t->m_enabled = true;
+  t->m_events.clear();
+  t->m_dropped = 0;
+  if (t->m_start == 0) {
+    // not serving a request, e.g. command line mode
+    t->m_start = Now();
+  }
+}
+
+int IOTrace::begin(const char *name, const char *peer, int port,
+                   int64 start) {
+  if ((int)m_events.size() >= RuntimeOption::IOTraceMaxEvents) {
+    m_dropped++;
+    return -1;
+  }
+  m_events.resize(m_events.size() + 1);
+  Event &e = m_events.back();
+  e.name = name;
+  if (!peer) {
+    e.peer[0] = '\0';
+  } else if (port) {
+    snprintf(e.peer, sizeof(e.peer), "%s:%d", peer, port);
+  } else {
+    snprintf(e.peer, sizeof(e.peer), "%s", peer);
+  }
+  e.start = start - m_start;
+  e.end = -1;
+  e.bytes = -1;
+  return m_events.size() - 1;
+}
+
+int IOTrace::Begin(const char *name, const char *peer, int port /* = 0 */) {
+  IOTrace *t = s_trace.get();
+  return t->begin(name, peer, port, Now());
+}
+
+void IOTrace::End(int id, int64 bytes /* = -1 */) {
+  IOTrace *t = s_trace.get();
+  if (id >= (int)t->m_events.size()) return; // the request started over
+  Event &e = t->m_events[id];
+  e.end = Now() - t->m_start;
+  e.bytes = bytes;
+}
+
+void IOTrace::Record(const char *name, const char *peer, int64 duration,
+                     int64 bytes) {
+  IOTrace *t = s_trace.get();
+  if (!t->m_enabled) return;
+  int64 now = Now();
+  int id = t->begin(name, peer, 0, now - duration);
+  if (id >= 0) {
+    t->m_events[id].end = now - t->m_start;
+    t->m_events[id].bytes = bytes;
+  }
+}
+
+Array IOTrace::GetEvents() {
+  IOTrace *t = s_trace.get();
+  Array ret = Array::Create();
+  if (!t->m_enabled) return ret;
+  for (unsigned int i = 0; i < t->m_events.size(); i++) {
+    const Event &e = t->m_events[i];
+    ret.append(ArrayInit(5)
+               .set("name", String(e.name, CopyString))
+               .set("peer", String(e.peer, CopyString))
+               .set("start", e.start)
+               .set("end", e.end)
+               .set("bytes", e.bytes)
+               .create());
+  }
+  return ret;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// reports
+
+static void append_json_string(std::string &out, const char *s) {
+  out += '"';
+  for (; *s; s++) {
+    unsigned char c = *s;
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (c < 0x20) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", c);
+      out += buf;
+    } else {
+      out += c;
+    }
+  }
+  out += '"';
+}
+
+static void append_json_event(std::string &out, const char *name, int tid,
+                              int64 ts, int64 dur) {
+  char buf[128];
+  out += "{\"name\":";
+  append_json_string(out, name);
+  snprintf(buf, sizeof(buf),
+           ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%lld,\"dur\":%lld",
+           tid, (long long)ts, (long long)dur);
+  out += buf;
+}
+
+/*
+ * Each kept request gets its own row, with the request itself on top and
+ * its I/O underneath. Timestamps are wall clock so requests line up.
+ */
+void IOTrace::ReportJSON(std::string &out) {
+  Lock lock(s_slowLock);
+  out += "{\"traceEvents\":[";
+  bool first = true;
+  for (unsigned int i = 0; i < s_slow.size(); i++) {
+    const SlowRequest &req = *s_slow[i];
+    if (!first) out += ',';
+    first = false;
+    append_json_event(out, req.url.c_str(), i + 1, req.start, req.duration);
+    char buf[64];
+    snprintf(buf, sizeof(buf), ",\"args\":{\"dropped\":%d}}", req.dropped);
+    out += buf;
+
+    for (unsigned int j = 0; j < req.events.size(); j++) {
+      const Event &e = req.events[j];
+      int64 end = e.end < 0 ? req.duration : e.end;
+      out += ',';
+      append_json_event(out, e.name, i + 1, req.start + e.start,
+                        end - e.start);
+      out += ",\"args\":{\"peer\":";
+      append_json_string(out, e.peer);
+      snprintf(buf, sizeof(buf), ",\"bytes\":%lld}}", (long long)e.bytes);
+      out += buf;
+    }
+  }
+  out += "]}\n";
+}
+
+/*
+ * Folded stacks are "frame;frame;frame weight". The request's own time
+ * outside of any I/O shows up as the bare url frame.
+ */
+void IOTrace::ReportFolded(std::string &out) {
+  Lock lock(s_slowLock);
+  char buf[32];
+  for (unsigned int i = 0; i < s_slow.size(); i++) {
+    const SlowRequest &req = *s_slow[i];
+    int64 io = 0;
+    for (unsigned int j = 0; j < req.events.size(); j++) {
+      const Event &e = req.events[j];
+      int64 dur = (e.end < 0 ? req.duration : e.end) - e.start;
+      io += dur;
+      out += req.url;
+      out += ';';
+      out += e.name;
+      if (e.peer[0]) {
+        out += ';';
+        out += e.peer;
+      }
+      snprintf(buf, sizeof(buf), " %lld\n", (long long)dur);
+      out += buf;
+    }
+    if (req.duration > io) {
+      out += req.url;
+      snprintf(buf, sizeof(buf), " %lld\n", (long long)(req.duration - io));
+      out += buf;
+    }
+  }
+}
+
+void IOTrace::Clear() {
+  Lock lock(s_slowLock);
+  for (unsigned int i = 0; i < s_slow.size(); i++) {
+    delete s_slow[i];
+  }
+  s_slow.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
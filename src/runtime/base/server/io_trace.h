@@ -0,0 +1,120 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef __HPHP_IO_TRACE_H__
+#define __HPHP_IO_TRACE_H__
+
+#include <runtime/base/types.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Per-request timeline of blocking I/O: every IOStatusHelper scope (MySQL,
+ * memcache, curl, sockets, DNS) and file reads and writes, each with its
+ * peer, bytes moved, and start and end time.
+ *
+ * Tracing is off unless the request is sampled (Stats.IOTrace.SampleRate)
+ * or the page calls hphp_io_trace_start(). A traced request that takes
+ * longer than Stats.IOTrace.SlowRequestMs is kept, and the admin server's
+ * /io-trace.json and /io-trace.folded hand those out as Chrome trace events
+ * or as folded stacks for flamegraph.pl.
+ */
+class IOTrace {
+public:
+  struct Event {
+    const char *name;  // always a string literal
+    char peer[64];
+    int64 start;       // microseconds since the request started
+    int64 end;         // -1 while still going on
+    int64 bytes;       // -1 if not known
+  };
+
+  /**
+   * Request boundaries. StartRequest() decides whether to trace; when
+   * EndRequest() finds the request slow, its trace is kept.
+   */
+  static void StartRequest(const char *url);
+  static void EndRequest();
+
+  static bool Enabled();
+  static void Enable();
+
+  /**
+   * Returns an id for End(), or -1 when the event can't be recorded.
+   */
+  static int Begin(const char *name, const char *peer, int port = 0);
+  static void End(int id, int64 bytes = -1);
+
+  /**
+   * Records something that has just finished after taking duration
+   * microseconds, e.g. a curl transfer that went on in the background.
+   */
+  static void Record(const char *name, const char *peer, int64 duration,
+                     int64 bytes);
+
+  static int64 Now();
+
+  /**
+   * Current request's events so far, for PHP; empty when not tracing.
+   */
+  static Array GetEvents();
+
+  /**
+   * Kept slow requests, either as {"traceEvents": [...]} or as one
+   * "url;name;peer microseconds" line per event.
+   */
+  static void ReportJSON(std::string &out);
+  static void ReportFolded(std::string &out);
+  static void Clear();
+
+public:
+  IOTrace();
+
+private:
+  bool m_enabled;
+  std::string m_url;
+  int64 m_start;
+  std::vector<Event> m_events;
+  int m_dropped;
+  int m_requests;
+
+  int begin(const char *name, const char *peer, int port, int64 start);
+};
+
+/**
+ * Traces one I/O operation in a scoped manner, when tracing is on.
+ */
+class IOTraceHelper {
+public:
+  IOTraceHelper(const char *name, const char *peer = NULL, int port = 0)
+    : m_id(IOTrace::Enabled() ? IOTrace::Begin(name, peer, port) : -1),
+      m_bytes(-1) {}
+  ~IOTraceHelper() {
+    if (m_id >= 0) IOTrace::End(m_id, m_bytes);
+  }
+
+  void setBytes(int64 bytes) { m_bytes = bytes; }
+
+private:
+  int m_id;
+  int64 m_bytes;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif // __HPHP_IO_TRACE_H__
@@ -19,6 +19,7 @@
 #include <runtime/base/memory/memory_manager.h>
 #include <runtime/base/server/server_stats.h>
 #include <runtime/base/server/http_protocol.h>
+#include <runtime/base/server/compression_pool.h>
 #include <runtime/eval/debugger/debugger.h>
 #include <util/compatibility.h>
 #include <util/logger.h>
@@ -48,6 +49,12 @@ namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 // LibEventJob
 
+static int s_queuing = ServerStats::Register("page.wall.queuing");
+static int s_queuingHistogram =
+  ServerStats::RegisterHistogram("page.wall.queuing");
+static int s_requestReadTime =
+  ServerStats::Register("page.wall.request_read_time");
+
 LibEventJob::LibEventJob(evhttp_request *req) : request(req) {
   gettime(CLOCK_MONOTONIC, &start);
 }
@@ -59,7 +66,8 @@ void LibEventJob::stopTimer() {
     time_t dsec = end.tv_sec - start.tv_sec;
     long dnsec = end.tv_nsec - start.tv_nsec;
     int64 dusec = dsec * 1000000 + dnsec / 1000;
-    ServerStats::Log("page.wall.queuing", dusec);
+    ServerStats::Log(s_queuing, dusec);
+    ServerStats::LogHistogram(s_queuingHistogram, dusec);
 
 #ifdef EVHTTP_CONNECTION_GET_START
     struct timespec evstart;
@@ -67,7 +75,7 @@ void LibEventJob::stopTimer() {
     dsec = start.tv_sec - evstart.tv_sec;
     dnsec = start.tv_nsec - evstart.tv_nsec;
     dusec = dsec * 1000000 + dnsec / 1000;
-    ServerStats::Log("page.wall.request_read_time", dusec);
+    ServerStats::Log(s_requestReadTime, dusec);
 #endif
   }
 }
@@ -281,6 +289,9 @@ void LibEventServer::stop() {
   // stop JobQueue processing
   m_dispatcher.stop();
 
+  // responses still being compressed need the event loop to go out
+  CompressionPool::Drain();
+
   // stop event loop
   setStatus(STOPPED);
   if (write(m_pipeStop.getIn(), "", 1) < 0) {
@@ -380,8 +391,10 @@ void LibEventServer::onResponse(int worker, evhttp_request *request,
 #endif
     gettime(CLOCK_MONOTONIC, &end);
     int64 delay = gettime_diff_us(begin, end);
-    transport->onFlushBegin(totalSize);
-    transport->onFlushProgress(nwritten, delay);
+    if (transport) {
+      transport->onFlushBegin(totalSize);
+      transport->onFlushProgress(nwritten, delay);
+    }
   }
   m_responseQueue.enqueue(worker, request, code, nwritten);
 }
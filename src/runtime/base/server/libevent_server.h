@@ -149,7 +149,8 @@ public:
   void onChunkedRead();
 
   /**
-   * Called by LibEventTransport when a response is fully prepared.
+   * Called by LibEventTransport when a response is fully prepared, or from
+   * a compression thread with no transport once it's done compressing.
    */
   void onResponse(int worker, evhttp_request *request, int code,
                   LibEventTransport* transport);
@@ -17,6 +17,7 @@
 #include <runtime/base/server/libevent_transport.h>
 #include <runtime/base/server/libevent_server.h>
 #include <runtime/base/server/server.h>
+#include <runtime/base/server/compression_pool.h>
 #include <runtime/base/runtime_option.h>
 #include <util/util.h>
 #include <util/logger.h>
@@ -280,6 +281,54 @@ void LibEventTransport::sendImpl(const void *data, int size, int code,
   m_sendStarted = true;
 }
 
+namespace {
+/*
+ * The rest of a response whose body is being gzipped off the worker
+ * thread. By now the worker has moved on; only the evhttp_request, which
+ * stays around until the reply goes out, is left to write to.
+ */
+class ResponseCompressionJob : public CompressionJob {
+public:
+  ResponseCompressionJob(LibEventServer *server, evhttp_request *request,
+                         int workerId, int code, const void *data, int size)
+    : CompressionJob(data, size, RuntimeOption::GzipCompressionLevel),
+      m_server(server), m_request(request), m_workerId(workerId),
+      m_code(code) {}
+
+protected:
+  virtual void onCompressed(char *compressed, int len) {
+    if (compressed) {
+      evbuffer_add(m_request->output_buffer, compressed, len);
+      free(compressed);
+    } else {
+      evhttp_remove_header(m_request->output_headers, "Content-Encoding");
+      evbuffer_add(m_request->output_buffer, m_data, m_size);
+    }
+    m_server->onResponse(m_workerId, m_request, m_code, NULL);
+  }
+
+private:
+  LibEventServer *m_server;
+  evhttp_request *m_request;
+  int m_workerId;
+  int m_code;
+};
+}
+
+bool LibEventTransport::supportsAsyncCompression() {
+  return m_method != HEAD;
+}
+
+void LibEventTransport::sendAsyncImpl(const void *data, int size, int code) {
+  ASSERT(data);
+  ASSERT(!m_sendStarted);
+  CompressionPool::Enqueue(new ResponseCompressionJob(m_server, m_request,
+                                                      m_workerId, code,
+                                                      data, size));
+  m_sendStarted = true;
+  m_sendEnded = true;
+}
+
 void LibEventTransport::onSendEndImpl() {
   if (m_chunkedEncoding) {
     m_server->onChunkedResponseEnd(m_workerId, m_request);
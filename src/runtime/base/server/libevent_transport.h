@@ -48,6 +48,8 @@ public:
   virtual void addRequestHeaderImpl(const char *name, const char *value);
   virtual void removeRequestHeaderImpl(const char *name);
   virtual void sendImpl(const void *data, int size, int code, bool chunked);
+  virtual bool supportsAsyncCompression();
+  virtual void sendAsyncImpl(const void *data, int size, int code);
   virtual void onSendEndImpl();
   virtual bool isServerStopping();
 
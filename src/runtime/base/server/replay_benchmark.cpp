@@ -0,0 +1,169 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include <runtime/base/server/replay_benchmark.h>
+#include <runtime/base/server/replay_transport.h>
+#include <runtime/base/server/http_request_handler.h>
+#include <runtime/base/shared/shared_store_stats.h>
+#include <runtime/base/memory/memory_manager.h>
+#include <runtime/base/runtime_option.h>
+#include <runtime/vm/translator/translator.h>
+#include <util/async_func.h>
+#include <util/compatibility.h>
+#include <util/hdf.h>
+
+#include <sys/resource.h>
+#include <algorithm>
+#include <boost/scoped_array.hpp>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+static int64 now_us() {
+  timespec ts;
+  gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+/*
+ * Plays requests index, index + threads, ... Hdf isn't safe to share
+ * between threads, so each worker loads the files itself.
+ */
+class ReplayBenchmark::Worker {
+public:
+  Worker(const ReplayBenchmark &bench, int index)
+    : m_errors(0), m_peakMemory(0), m_bench(bench), m_index(index),
+      m_start(0), m_thread(this, &Worker::run) {
+  }
+
+  void start(int64 start) {
+    m_start = start;
+    m_thread.start();
+  }
+  void waitForEnd() { m_thread.waitForEnd(); }
+
+  void run() {
+    const std::vector<std::string> &files = m_bench.m_files;
+    // not a vector: copies of an Hdf share its tree
+    boost::scoped_array<Hdf> corpus(new Hdf[files.size()]);
+    for (unsigned int i = 0; i < files.size(); i++) {
+      corpus[i].open(files[i].c_str());
+    }
+
+    HttpRequestHandler handler;
+    for (int i = m_index; i < m_bench.m_total; i += m_bench.m_threads) {
+      int64 due = now_us();
+      if (m_bench.m_rate > 0) {
+        due = m_start + i * 1000000LL / m_bench.m_rate;
+        int64 now = now_us();
+        if (due > now) usleep(due - now);
+      }
+
+      ReplayTransport rt;
+      rt.replayInput(corpus[i % files.size()]);
+      handler.handleRequest(&rt);
+
+      m_latencies.push_back(now_us() - due);
+      if (rt.getResponseCode() != 200) m_errors++;
+      // the stats are reset by now; this is what the request left behind
+      int64 peak = MemoryManager::TheMemoryManager()->getLastPeakUsage();
+      if (peak > m_peakMemory) m_peakMemory = peak;
+    }
+  }
+
+  std::vector<int64> m_latencies;
+  int m_errors;
+  int64 m_peakMemory;
+
+private:
+  const ReplayBenchmark &m_bench;
+  int m_index;
+  int64 m_start;
+  AsyncFunc<Worker> m_thread;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+ReplayBenchmark::ReplayBenchmark(const std::vector<std::string> &files,
+                                 int threads, int rate, int count)
+  : m_files(files), m_threads(threads > 0 ? threads : 1), m_rate(rate),
+    m_total(files.size() * (count > 0 ? count : 1)), m_elapsed(0),
+    m_errors(0), m_peakRequestMemory(0) {
+}
+
+void ReplayBenchmark::run() {
+  m_latencies.clear();
+  m_errors = 0;
+  m_peakRequestMemory = 0;
+  if (m_files.empty()) return;
+
+  std::vector<Worker*> workers;
+  for (int i = 0; i < m_threads; i++) {
+    workers.push_back(new Worker(*this, i));
+  }
+  int64 start = now_us();
+  for (int i = 0; i < m_threads; i++) {
+    workers[i]->start(start);
+  }
+  for (int i = 0; i < m_threads; i++) {
+    Worker *w = workers[i];
+    w->waitForEnd();
+    m_latencies.insert(m_latencies.end(), w->m_latencies.begin(),
+                       w->m_latencies.end());
+    m_errors += w->m_errors;
+    m_peakRequestMemory = std::max(m_peakRequestMemory, w->m_peakMemory);
+    delete w;
+  }
+  m_elapsed = now_us() - start;
+  std::sort(m_latencies.begin(), m_latencies.end());
+}
+
+std::string ReplayBenchmark::report() const {
+  std::ostringstream out;
+  int n = m_latencies.size();
+  double seconds = m_elapsed / 1000000.0;
+  out << "requests: " << n << " on " << m_threads << " threads";
+  if (m_rate > 0) out << " at " << m_rate << "/s";
+  out << "\n";
+  out << "errors: " << m_errors << "\n";
+  out << "elapsed: " << seconds << " s\n";
+  if (n) {
+    out << "throughput: " << n / seconds << " requests/s\n";
+    static const double percentiles[] = { 50, 90, 99, 99.9 };
+    out << "latency (ms):";
+    for (unsigned int i = 0; i < sizeof(percentiles) / sizeof(double); i++) {
+      int at = std::min(n - 1, (int)(n * percentiles[i] / 100));
+      out << " p" << percentiles[i] << " " << m_latencies[at] / 1000.0;
+    }
+    out << " max " << m_latencies[n - 1] / 1000.0 << "\n";
+  }
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  out << "peak request memory: " << m_peakRequestMemory << " bytes\n";
+  out << "peak RSS: " << usage.ru_maxrss << " KB\n";
+
+  if (hhvm && RuntimeOption::EvalJit) {
+    out << VM::Transl::Translator::Get()->getUsage();
+  }
+  if (RuntimeOption::EnableAPCStats) {
+    out << SharedStoreStats::report_basic();
+  }
+  return out.str();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
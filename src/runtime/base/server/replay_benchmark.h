@@ -0,0 +1,70 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef __HPHP_REPLAY_BENCHMARK_H__
+#define __HPHP_REPLAY_BENCHMARK_H__
+
+#include <util/base.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Load generator for requests recorded with Debug.RecordInput, for checking
+ * a build's performance offline: "--mode replay --replay-threads N" plays
+ * the given files through HttpRequestHandler on N threads, the way
+ * ServiceThread plays its documents, instead of printing their responses.
+ *
+ * With an arrival rate, request i is due at start + i / rate no matter how
+ * the earlier ones went, and its latency counts from then, so a server
+ * falling behind shows up as latency rather than as fewer requests sent.
+ * Without one, every thread goes as fast as it can.
+ */
+class ReplayBenchmark {
+public:
+  /**
+   * Each of the files is played count times. rate is in requests per
+   * second over all threads, 0 for as fast as possible.
+   */
+  ReplayBenchmark(const std::vector<std::string> &files, int threads,
+                  int rate, int count);
+
+  void run();
+
+  /**
+   * Throughput, latency percentiles, errors, memory high-water marks, and
+   * JIT and APC usage, as text.
+   */
+  std::string report() const;
+
+private:
+  class Worker;
+
+  std::vector<std::string> m_files;
+  int m_threads;
+  int m_rate;
+  int m_total;
+
+  int64 m_elapsed;                 // microseconds
+  std::vector<int64> m_latencies;  // microseconds, sorted
+  int m_errors;
+  int64 m_peakRequestMemory;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif // __HPHP_REPLAY_BENCHMARK_H__
@@ -18,6 +18,7 @@
 #include <runtime/base/server/rpc_request_handler.h>
 #include <runtime/base/program_functions.h>
 #include <runtime/base/runtime_option.h>
+#include <runtime/base/timeout_thread.h>
 #include <runtime/base/server/server_stats.h>
 #include <runtime/base/server/http_protocol.h>
 #include <runtime/base/server/access_log.h>
@@ -70,7 +71,8 @@ void RPCRequestHandler::handleRequest(Transport *transport) {
   m_context->setTransport(transport);
   transport->enableCompression();
 
-  ServerStatsHelper ssh("all", ServerStatsHelper::TRACK_MEMORY);
+  ServerStatsHelper ssh("all", ServerStatsHelper::TRACK_MEMORY |
+                        ServerStatsHelper::TRACK_HISTOGRAM);
   Logger::Verbose("receiving %s", transport->getCommand().c_str());
 
   // will clear all extra logging when this function goes out of scope
@@ -122,7 +124,9 @@ void RPCRequestHandler::handleRequest(Transport *transport) {
     HttpRequestHandler::GetAccessLog().log(transport, vhost);
     return;
   }
-  vhost->setRequestTimeoutSeconds();
+  // reset timeout counter, then apply the virtual host's limits
+  TimeoutThread::ResetTimeout(ThreadInfo::s_threadInfo->m_reqInjectionData);
+  vhost->setRequestTimeout();
 
   // resolve source root
   string host = transport->getHeader("Host");
@@ -154,9 +158,6 @@ void RPCRequestHandler::handleRequest(Transport *transport) {
 
 bool RPCRequestHandler::executePHPFunction(Transport *transport,
                                            SourceRootInfo &sourceRootInfo) {
-  // reset timeout counter
-  ThreadInfo::s_threadInfo->m_reqInjectionData.started = time(0);
-
   string rpcFunc = transport->getCommand();
   {
     ServerStatsHelper ssh("input");
@@ -25,6 +25,9 @@
 #include <util/json.h>
 #include <util/compatibility.h>
 #include <util/hardware_counter.h>
+#include <util/atomic.h>
+#include <util/logger.h>
+#include <math.h>
 
 using std::list;
 using std::set;
@@ -32,6 +35,218 @@ using std::map;
 using std::ostream;
 
 namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+// registered counters and histograms
+
+namespace {
+struct Registry {
+  Registry() : counterCount(0), histogramCount(0) {}
+
+  Mutex lock;
+  hphp_string_map<int> counters;
+  hphp_string_map<int> histograms;
+
+  // published by the counts, so readers need no lock
+  std::string counterNames[ServerStats::MaxCounters];
+  std::string histogramNames[ServerStats::MaxHistograms];
+
+  // interned on first use, as registering can happen before the intern
+  // table is constructed
+  SharedString counterKeys[ServerStats::MaxCounters];
+  int counterCount;
+  int histogramCount;
+};
+}
+
+// handles get registered from static initializers all over the place
+static Registry &registry() {
+  static Registry s_registry;
+  return s_registry;
+}
+
+/*
+ * Values below 16 get a bucket each; above that, every power of two is cut
+ * into 16 buckets, so a bucket's midpoint is within 1/32 of what went in.
+ * Values of 2^48 and up all land in the last bucket. Two more slots at the
+ * end keep the count and the maximum.
+ */
+#define HISTOGRAM_SUB_BITS 4
+#define HISTOGRAM_MAX_BITS 48
+#define HISTOGRAM_BUCKETS \
+  ((HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BITS + 1) << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_COUNT HISTOGRAM_BUCKETS
+#define HISTOGRAM_MAX (HISTOGRAM_BUCKETS + 1)
+#define HISTOGRAM_SLOTS (HISTOGRAM_BUCKETS + 2)
+
+static int histogram_bucket(int64 value) {
+  const int sub = 1 << HISTOGRAM_SUB_BITS;
+  if (value < sub) return value < 0 ? 0 : value;
+  int msb = 63 - __builtin_clzll(value);
+  if (msb >= HISTOGRAM_MAX_BITS) return HISTOGRAM_BUCKETS - 1;
+  int shift = msb - HISTOGRAM_SUB_BITS;
+  return ((shift + 1) << HISTOGRAM_SUB_BITS) + ((value >> shift) & (sub - 1));
+}
+
+static int64 histogram_midpoint(int bucket) {
+  const int sub = 1 << HISTOGRAM_SUB_BITS;
+  if (bucket < sub) return bucket;
+  int shift = (bucket >> HISTOGRAM_SUB_BITS) - 1;
+  int64 low = (int64)(sub + (bucket & (sub - 1))) << shift;
+  return low + ((1LL << shift) >> 1);
+}
+
+static int64 histogram_percentile(const std::vector<int64> &buckets,
+                                  double percentile) {
+  int64 count = buckets[HISTOGRAM_COUNT];
+  if (count <= 0) return 0;
+  int64 rank = (int64)ceil(percentile / 100 * count);
+  if (rank < 1) rank = 1;
+  int64 seen = 0;
+  for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return std::min(histogram_midpoint(i), buckets[HISTOGRAM_MAX]);
+    }
+  }
+  return buckets[HISTOGRAM_MAX];
+}
+
+static const SharedString &counter_key(Registry &r, int counter) {
+  SharedString &key = r.counterKeys[counter];
+  if (!key.get()) {
+    Lock lock(r.lock);
+    if (!key.get()) key = r.counterNames[counter];
+  }
+  return key;
+}
+
+static void *alloc_cache_aligned(size_t size) {
+  void *p;
+  if (posix_memalign(&p, 64, size)) throw std::bad_alloc();
+  memset(p, 0, size);
+  return p;
+}
+
+static int s_ioWallHistogram = ServerStats::RegisterHistogram("io.wall");
+
+int ServerStats::Register(const char *name) {
+  Registry &r = registry();
+  Lock lock(r.lock);
+  hphp_string_map<int>::const_iterator iter = r.counters.find(name);
+  if (iter != r.counters.end()) return iter->second;
+  if (r.counterCount == MaxCounters) {
+    Logger::Warning("Too many stats counters, not counting %s", name);
+    return -1;
+  }
+  int counter = r.counterCount;
+  r.counterNames[counter] = name;
+  r.counters[name] = counter;
+  atomic_release_store(&r.counterCount, counter + 1);
+  return counter;
+}
+
+int ServerStats::RegisterHistogram(const char *name) {
+  Registry &r = registry();
+  Lock lock(r.lock);
+  hphp_string_map<int>::const_iterator iter = r.histograms.find(name);
+  if (iter != r.histograms.end()) return iter->second;
+  if (r.histogramCount == MaxHistograms) {
+    Logger::Warning("Too many stats histograms, not keeping %s", name);
+    return -1;
+  }
+  int histogram = r.histogramCount;
+  r.histogramNames[histogram] = name;
+  r.histograms[name] = histogram;
+  atomic_release_store(&r.histogramCount, histogram + 1);
+  return histogram;
+}
+
+void ServerStats::Log(int counter, int64 value) {
+  if (RuntimeOption::EnableStats && RuntimeOption::EnableWebStats &&
+      counter >= 0) {
+    ServerStats::s_logger->m_counters[counter] += value;
+  }
+}
+
+int64 ServerStats::Get(int counter) {
+  if (counter < 0) return 0;
+  return ServerStats::s_logger->m_counters[counter];
+}
+
+void ServerStats::LogHistogram(int histogram, int64 value) {
+  if (!RuntimeOption::EnableStats || !RuntimeOption::EnableWebStats ||
+      histogram < 0) {
+    return;
+  }
+  ServerStats *ss = ServerStats::s_logger.getNoCheck();
+  int64 *buckets = ss->m_histograms[histogram];
+  if (!buckets) {
+    buckets = (int64*)alloc_cache_aligned(HISTOGRAM_SLOTS * sizeof(int64));
+    atomic_release_store(&ss->m_histograms[histogram], buckets);
+  }
+  buckets[histogram_bucket(value)]++;
+  buckets[HISTOGRAM_COUNT]++;
+  if (value > buckets[HISTOGRAM_MAX]) buckets[HISTOGRAM_MAX] = value;
+}
+
+/*
+ * Other threads' buckets are read while they may be bumping them, which at
+ * worst leaves the count a little off from the buckets' sum.
+ */
+void ServerStats::MergeHistogram(int histogram, std::vector<int64> &buckets) {
+  buckets.assign(HISTOGRAM_SLOTS, 0);
+  if (histogram < 0) return;
+  Lock lock(s_lock, false);
+  for (unsigned int i = 0; i < s_loggers.size(); i++) {
+    const int64 *src =
+      atomic_acquire_load(&s_loggers[i]->m_histograms[histogram]);
+    if (!src) continue;
+    for (int j = 0; j < HISTOGRAM_MAX; j++) {
+      buckets[j] += src[j];
+    }
+    if (src[HISTOGRAM_MAX] > buckets[HISTOGRAM_MAX]) {
+      buckets[HISTOGRAM_MAX] = src[HISTOGRAM_MAX];
+    }
+  }
+}
+
+int64 ServerStats::GetPercentile(int histogram, double percentile) {
+  std::vector<int64> buckets;
+  MergeHistogram(histogram, buckets);
+  return histogram_percentile(buckets, percentile);
+}
+
+int64 ServerStats::GetCount(int histogram) {
+  std::vector<int64> buckets;
+  MergeHistogram(histogram, buckets);
+  return buckets[HISTOGRAM_COUNT];
+}
+
+static const char *s_percentileSuffixes[] = {".p50", ".p99", ".p999"};
+static const double s_percentiles[] = {50, 99, 99.9};
+
+void ServerStats::GetHistogramKeys(map<string, int64> &values,
+                                   const map<string, int> &wantedKeys) {
+  Registry &r = registry();
+  int count = atomic_acquire_load(&r.histogramCount);
+  std::vector<int64> buckets;
+  for (int i = 0; i < count; i++) {
+    const string &name = r.histogramNames[i];
+    bool merged = false;
+    for (int j = 0; j < 5; j++) {
+      string key = name;
+      key += j < 3 ? s_percentileSuffixes[j] : j == 3 ? ".max" : ".count";
+      if (wantedKeys.find(key) == wantedKeys.end()) continue;
+      if (!merged) {
+        MergeHistogram(i, buckets);
+        merged = true;
+      }
+      values[key] = j < 3 ? histogram_percentile(buckets, s_percentiles[j]) :
+        buckets[j == 3 ? HISTOGRAM_MAX : HISTOGRAM_COUNT];
+    }
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // helpers
 
@@ -114,6 +329,17 @@ void ServerStats::GetAllKeys(set<string> &allKeys,
   allKeys.insert("load");
   allKeys.insert("idle");
   allKeys.insert("queued");
+
+  Registry &r = registry();
+  int count = atomic_acquire_load(&r.histogramCount);
+  for (int i = 0; i < count; i++) {
+    const string &name = r.histogramNames[i];
+    for (int j = 0; j < 3; j++) {
+      allKeys.insert(name + s_percentileSuffixes[j]);
+    }
+    allKeys.insert(name + ".max");
+    allKeys.insert(name + ".count");
+  }
 }
 
 void ServerStats::Filter(list<TimeSlot*> &slots, const std::string &keys,
@@ -247,6 +473,8 @@ void ServerStats::Aggregate(list<TimeSlot*> &slots, const std::string &agg,
   int load = HttpServer::Server->getPageServer()->getActiveWorker();
   int idle = RuntimeOption::ServerThreadCount - load;
   int queued = HttpServer::Server->getPageServer()->getQueuedJobs();
+  map<string, int64> histogramKeys;
+  GetHistogramKeys(histogramKeys, wantedKeys);
 
   for (list<TimeSlot*>::const_iterator iter = slots.begin();
        iter != slots.end(); ++iter) {
@@ -271,6 +499,10 @@ void ServerStats::Aggregate(list<TimeSlot*> &slots, const std::string &agg,
       if (wantedKeys.find("queued") != wantedKeys.end()) {
         values["queued"] = queued;
       }
+      for (map<string, int64>::const_iterator iter = histogramKeys.begin();
+           iter != histogramKeys.end(); ++iter) {
+        values[iter->first] = iter->second;
+      }
 
       for (map<string, int>::const_iterator iter = udfKeys.begin();
            iter != udfKeys.end(); ++iter) {
@@ -655,7 +887,13 @@ void ServerStats::Reset() {
 void ServerStats::Clear() {
   Lock lock(s_lock, false);
   for (unsigned int i = 0; i < s_loggers.size(); i++) {
-    s_loggers[i]->clear();
+    ServerStats *ss = s_loggers[i];
+    ss->clear();
+    for (int j = 0; j < MaxHistograms; j++) {
+      if (ss->m_histograms[j]) {
+        memset(ss->m_histograms[j], 0, HISTOGRAM_SLOTS * sizeof(int64));
+      }
+    }
   }
 }
 
@@ -965,7 +1203,10 @@ ServerStats::ThreadStatus::ThreadStatus()
   memset(m_vhost, 0, sizeof(m_vhost));
 }
 
-ServerStats::ServerStats() : m_last(0), m_min(0), m_max(0) {
+ServerStats::ServerStats()
+    : m_last(0), m_min(0), m_max(0), m_hwStarted(false) {
+  m_counters = (int64*)alloc_cache_aligned(MaxCounters * sizeof(int64));
+  memset(m_histograms, 0, sizeof(m_histograms));
   m_slots.resize(RuntimeOption::StatsMaxSlot);
   clear();
 
@@ -992,6 +1233,11 @@ ServerStats::~ServerStats() {
     s_loggers[pos] = s_loggers.back();
     s_loggers.pop_back();
   }
+
+  free(m_counters);
+  for (int i = 0; i < MaxHistograms; i++) {
+    free(m_histograms[i]);
+  }
 }
 
 void ServerStats::log(const string &name, int64 value) {
@@ -999,11 +1245,19 @@ void ServerStats::log(const string &name, int64 value) {
 }
 
 int64 ServerStats::get(const std::string &name) {
+  int64 ret = 0;
   CounterMap::const_iterator iter = m_values.find(name);
   if (iter != m_values.end()) {
-    return iter->second;
+    ret = iter->second;
   }
-  return 0;
+
+  Registry &r = registry();
+  Lock lock(r.lock);
+  hphp_string_map<int>::const_iterator citer = r.counters.find(name);
+  if (citer != r.counters.end()) {
+    ret += m_counters[citer->second];
+  }
+  return ret;
 }
 
 void ServerStats::logPage(const string &url, int code) {
@@ -1032,6 +1286,12 @@ void ServerStats::logPage(const string &url, int code) {
     ps.m_code = code;
     ps.m_hit++;
     Merge(ps.m_values, m_values);
+
+    Registry &r = registry();
+    int count = atomic_acquire_load(&r.counterCount);
+    for (int i = 0; i < count; i++) {
+      if (m_counters[i]) ps.m_values[counter_key(r, i)] += m_counters[i];
+    }
   }
 
   m_last = now;
@@ -1048,6 +1308,8 @@ void ServerStats::logPage(const string &url, int code) {
 
 void ServerStats::reset() {
   m_values.clear();
+  int count = atomic_acquire_load(&registry().counterCount);
+  memset(m_counters, 0, count * sizeof(int64));
 }
 
 void ServerStats::clear() {
@@ -1106,6 +1368,68 @@ void ServerStats::setThreadMode(ThreadMode mode) {
   m_threadStatus.m_mode = mode;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// hardware counters
+
+using Util::HardwareCounter;
+
+namespace {
+struct HardwareCounterKeys {
+  int counters[HardwareCounter::RequestEventCount];
+};
+typedef hphp_string_map<HardwareCounterKeys> VHostCounterKeys;
+}
+
+static HardwareCounterKeys register_hw_keys(const std::string &prefix) {
+  HardwareCounterKeys keys;
+  for (int i = 0; i < HardwareCounter::RequestEventCount; i++) {
+    keys.counters[i] =
+      ServerStats::Register((prefix + HardwareCounter::RequestEventNames[i])
+                            .c_str());
+  }
+  return keys;
+}
+
+static Mutex s_hwKeysLock;
+static VHostCounterKeys s_vhostHwKeys;
+
+void ServerStats::StartHardwareCounters() {
+  if (RuntimeOption::EnableStats && RuntimeOption::EnableWebStats &&
+      RuntimeOption::EnableHardwareCounterStats) {
+    ServerStats *ss = ServerStats::s_logger.getNoCheck();
+    ss->m_hwStarted = HardwareCounter::GetRequestCounters(ss->m_hwStart);
+  }
+}
+
+void ServerStats::LogHardwareCounters() {
+  ServerStats *ss = ServerStats::s_logger.getNoCheck();
+  if (!ss->m_hwStarted) return;
+  ss->m_hwStarted = false;
+
+  int64 values[HardwareCounter::RequestEventCount];
+  if (!HardwareCounter::GetRequestCounters(values)) return;
+
+  static HardwareCounterKeys s_pageKeys = register_hw_keys("hw.");
+  HardwareCounterKeys vhostKeys;
+  {
+    Lock lock(s_hwKeysLock);
+    const char *vhost = ss->m_threadStatus.m_vhost;
+    VHostCounterKeys::const_iterator iter = s_vhostHwKeys.find(vhost);
+    if (iter == s_vhostHwKeys.end()) {
+      iter = s_vhostHwKeys.insert(VHostCounterKeys::value_type
+        (vhost, register_hw_keys(std::string("hw.") + vhost + "."))).first;
+    }
+    vhostKeys = iter->second;
+  }
+
+  for (int i = 0; i < HardwareCounter::RequestEventCount; i++) {
+    if (values[i] < 0 || ss->m_hwStart[i] < 0) continue;
+    int64 delta = values[i] - ss->m_hwStart[i];
+    Log(s_pageKeys.counters[i], delta);
+    Log(vhostKeys.counters[i], delta);
+  }
+}
+
 void ServerStats::setThreadIOStatusAddress(const char *name) {
   if (name) {
     safe_copy(m_threadStatus.m_ioLogicalName, name,
@@ -1136,10 +1460,17 @@ void ServerStats::setThreadIOStatus(const char *name, const char *addr,
   }
 
   if (!starting || usWallTime >= 0) {
+    int64 wt = usWallTime;
+    if (wt < 0 && m_threadStatus.m_ioInProcess) {
+      // only scoped I/O, not the overlapping curl phases
+      timespec now;
+      gettime(CLOCK_MONOTONIC, &now);
+      wt = gettime_diff_us(m_threadStatus.m_ioStart, now);
+      ServerStats::LogHistogram(s_ioWallHistogram, wt);
+    }
     m_threadStatus.m_ioInProcess = false;
 
     if (RuntimeOption::EnableNetworkIOStatus || s_profile_network) {
-      int64 wt = usWallTime;
       if (wt < 0) {
         timespec now;
         gettime(CLOCK_MONOTONIC, &now);
@@ -1200,10 +1531,71 @@ Array ServerStats::getThreadIOStatuses() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+struct ServerStatsHelper::Section {
+  const char *name;
+  int wall;
+  int cpu;
+  int inst;
+  int mem;
+  int wallHistogram;
+  int cpuHistogram;
+  int memHistogram;
+};
+
+#define STATS_MAX_SECTIONS 32
+
+static Mutex s_sectionLock;
+static ServerStatsHelper::Section s_sections[STATS_MAX_SECTIONS];
+static int s_sectionCount;
+
+/*
+ * Sections are a handful of literals, so a scan finds them quicker than
+ * hashing would.
+ */
+ServerStatsHelper::Section *ServerStatsHelper::GetSection(const char *name) {
+  int count = atomic_acquire_load(&s_sectionCount);
+  for (int i = 0; i < count; i++) {
+    if (s_sections[i].name == name || !strcmp(s_sections[i].name, name)) {
+      return &s_sections[i];
+    }
+  }
+
+  Lock lock(s_sectionLock);
+  for (int i = count; i < s_sectionCount; i++) {
+    if (!strcmp(s_sections[i].name, name)) return &s_sections[i];
+  }
+  if (s_sectionCount == STATS_MAX_SECTIONS) {
+    static Section s_dropped = { "", -1, -1, -1, -1, -1, -1, -1 };
+    return &s_dropped;
+  }
+  Section &s = s_sections[s_sectionCount];
+  string section = name;
+  s.name = name;
+  s.wall = ServerStats::Register(("page.wall." + section).c_str());
+  s.cpu = ServerStats::Register(("page.cpu." + section).c_str());
+  s.inst = ServerStats::Register(("page.inst." + section).c_str());
+  s.mem = ServerStats::Register(("mem." + section).c_str());
+  s.wallHistogram = s.cpuHistogram = s.memHistogram = -1;
+  atomic_release_store(&s_sectionCount, s_sectionCount + 1);
+  return &s;
+}
+
 ServerStatsHelper::ServerStatsHelper(const char *section,
                                      uint32 track /* = false */)
-  : m_section(section), m_instStart(0), m_track(track) {
+  : m_section(section), m_counters(NULL), m_instStart(0), m_track(track) {
   if (RuntimeOption::EnableStats && RuntimeOption::EnableWebStats) {
+    m_counters = GetSection(section);
+    if ((m_track & TRACK_HISTOGRAM) && m_counters->wall >= 0 &&
+        m_counters->memHistogram < 0) {
+      // registering twice hands back the same ones, so no need to lock
+      string name = section;
+      m_counters->wallHistogram =
+        ServerStats::RegisterHistogram(("page.wall." + name).c_str());
+      m_counters->cpuHistogram =
+        ServerStats::RegisterHistogram(("page.cpu." + name).c_str());
+      m_counters->memHistogram =
+        ServerStats::RegisterHistogram(("mem." + name).c_str());
+    }
     gettime(CLOCK_MONOTONIC, &m_wallStart);
     gettime(CLOCK_THREAD_CPUTIME_ID, &m_cpuStart);
     if (m_track & TRACK_HWINST) {
@@ -1213,43 +1605,42 @@ ServerStatsHelper::ServerStatsHelper(const char *section,
 }
 
 ServerStatsHelper::~ServerStatsHelper() {
-  if (RuntimeOption::EnableStats && RuntimeOption::EnableWebStats) {
+  if (m_counters) {
     timespec wallEnd, cpuEnd;
     gettime(CLOCK_MONOTONIC, &wallEnd);
     gettime(CLOCK_THREAD_CPUTIME_ID, &cpuEnd);
 
-    logTime("page.wall.", m_wallStart, wallEnd);
-    logTime("page.cpu.", m_cpuStart, cpuEnd);
+    int64 wall = gettime_diff_us(m_wallStart, wallEnd);
+    int64 cpu = gettime_diff_us(m_cpuStart, cpuEnd);
+    ServerStats::Log(m_counters->wall, wall);
+    ServerStats::Log(m_counters->cpu, cpu);
+    if (m_track & TRACK_HISTOGRAM) {
+      ServerStats::LogHistogram(m_counters->wallHistogram, wall);
+      ServerStats::LogHistogram(m_counters->cpuHistogram, cpu);
+    }
 
     if (m_track & TRACK_MEMORY) {
       MemoryManager *mm = MemoryManager::TheMemoryManager().getNoCheck();
       int64 mem = mm->getStats(true).peakUsage;
-      ServerStats::Log(string("mem.") + m_section, mem);
+      ServerStats::Log(m_counters->mem, mem);
+      if (m_track & TRACK_HISTOGRAM) {
+        ServerStats::LogHistogram(m_counters->memHistogram, mem);
+      }
     }
 
     if (m_track & TRACK_HWINST) {
       int64 instEnd = Util::HardwareCounter::GetInstructionCount();
-      logTime("page.inst.", m_instStart, instEnd);
+      ServerStats::Log(m_counters->inst, instEnd - m_instStart);
     }
   }
 }
 
-void ServerStatsHelper::logTime(const std::string &prefix,
-                                const timespec &start, const timespec &end) {
-  ServerStats::Log(prefix + m_section, gettime_diff_us(start, end));
-}
-
-void ServerStatsHelper::logTime(const std::string &prefix,
-                                const int64 &start, const int64 &end) {
-  ServerStats::Log(prefix + m_section, end - start);
-}
-
 ///////////////////////////////////////////////////////////////////////////////
 
 IOStatusHelper::IOStatusHelper(const char *name,
                                const char *address /* = NULL */,
                                int port /* = 0 */)
-    : m_exeProfiler(ThreadInfo::NetworkIO) {
+    : m_exeProfiler(ThreadInfo::NetworkIO), m_trace(name, address, port) {
   ASSERT(name && *name);
 
   if (ServerStats::s_profile_network ||
@@ -1289,6 +1680,7 @@ void set_curl_statuses(CURL *cp, const char *url) {
   set_curl_status(cp, CURLINFO_CONNECT_TIME,       "curl-connect",       url);
   set_curl_status(cp, CURLINFO_STARTTRANSFER_TIME, "curl-starttransfer", url);
   set_curl_status(cp, CURLINFO_PRETRANSFER_TIME,   "curl-pretransfer",   url);
+  set_curl_status(cp, CURLINFO_TOTAL_TIME,         "curl-total",         url);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
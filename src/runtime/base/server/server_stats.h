@@ -23,6 +23,8 @@
 #include <time.h>
 #include <runtime/base/shared/shared_string.h>
 #include <runtime/base/types.h>
+#include <runtime/base/server/io_trace.h>
+#include <util/hardware_counter.h>
 
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
@@ -55,6 +57,29 @@ public:
                      const std::string &url, int code,
                      const std::string &prefix);
 
+  /**
+   * Counters named up front. Register() hands out a handle once, and Log()
+   * with it bumps a slot in this thread's own array instead of hashing the
+   * name into a map. The values join the page's other name-value pairs in
+   * LogPage(), so reports can't tell the two apart. Registering a name
+   * twice returns the same handle; -1 means the registry is full.
+   */
+  static const int MaxCounters = 512;
+  static int Register(const char *name);
+  static void Log(int counter, int64 value);
+  static int64 Get(int counter);
+
+  /**
+   * Log-linear histograms, good to about 3%, kept per thread since the last
+   * Clear(). Reports know "<name>.p50", ".p99", ".p999", ".max" and
+   * ".count" as special keys, the way they know "load" or "queued".
+   */
+  static const int MaxHistograms = 32;
+  static int RegisterHistogram(const char *name);
+  static void LogHistogram(int histogram, int64 value);
+  static int64 GetPercentile(int histogram, double percentile);
+  static int64 GetCount(int histogram);
+
   // thread status functions
   static void LogBytes(int64 bytes);
   static void StartRequest(const char *url, const char *clientIP,
@@ -62,6 +87,15 @@ public:
   static void SetThreadMode(ThreadMode mode);
   static void ReportStatus(std::string &out, Format format);
 
+  /**
+   * Hardware counters over a request, with Stats.HardwareCounters on:
+   * "hw.cycles", "hw.instructions", "hw.llc_misses", "hw.branch_misses" and
+   * "hw.context_switches" go to the page like other keys, and the same
+   * under "hw.<vhost>." for the virtual host. Log before LogPage().
+   */
+  static void StartHardwareCounters();
+  static void LogHardwareCounters();
+
   // io status functions
   static void SetThreadIOStatusAddress(const char *name);
   static void SetThreadIOStatus(const char *name, const char *addr,
@@ -119,6 +153,9 @@ private:
 
   static void GetAllKeys(std::set<std::string> &allKeys,
                          const std::list<TimeSlot*> &slots);
+  static void GetHistogramKeys(std::map<std::string, int64> &values,
+                               const std::map<std::string, int> &wantedKeys);
+  static void MergeHistogram(int histogram, std::vector<int64> &buckets);
   static void Report(std::string &out, Format format,
                      const std::list<TimeSlot*> &slots,
                      const std::string &prefix);
@@ -129,6 +166,8 @@ private:
   int64 m_min;  // earliest timepoint
   int64 m_max;  // latest timepoint
   CounterMap m_values;  // current page's name value pairs
+  int64 *m_counters;    // registered ones, on cache lines of their own
+  int64 *m_histograms[MaxHistograms]; // allocated on first use
 
   void log(const std::string &name, int64 value);
   int64 get(const std::string &name);
@@ -144,6 +183,9 @@ private:
   void startRequest(const char *url, const char *clientIP, const char *vhost);
   void setThreadMode(ThreadMode mode);
 
+  int64 m_hwStart[Util::HardwareCounter::RequestEventCount];
+  bool m_hwStarted;
+
   void setThreadIOStatusAddress(const char *name);
   void setThreadIOStatus(const char *name, const char *addr,
                          int64 usWallTime = -1);
@@ -201,23 +243,24 @@ private:
 class ServerStatsHelper {
 public:
   enum {
-    TRACK_MEMORY = 0x00000001,
-    TRACK_HWINST = 0x00000002,
+    TRACK_MEMORY    = 0x00000001,
+    TRACK_HWINST    = 0x00000002,
+    TRACK_HISTOGRAM = 0x00000004, // wall, cpu and memory percentiles too
   };
   ServerStatsHelper(const char *section, uint32 track = 0);
   ~ServerStatsHelper();
 
+  struct Section; // registered counters for a section
+
 private:
   const char *m_section;
+  Section *m_counters;
   timespec m_wallStart;
   timespec m_cpuStart;
   int64 m_instStart;
   uint32 m_track;
 
-  void logTime(const std::string &prefix, const timespec &start,
-               const timespec &end);
-  void logTime(const std::string &prefix, const int64 &start,
-               const int64 &end);
+  static Section *GetSection(const char *section);
 };
 
 /**
@@ -228,8 +271,11 @@ public:
   IOStatusHelper(const char *name, const char *address = NULL, int port = 0);
   ~IOStatusHelper();
 
+  void setBytes(int64 bytes) { m_trace.setBytes(bytes); }
+
 private:
   ExecutionProfiler m_exeProfiler;
+  IOTraceHelper m_trace;
 };
 
 /**
@@ -0,0 +1,320 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include <runtime/base/server/stack_sampler.h>
+#include <runtime/base/runtime_option.h>
+#include <runtime/base/execution_context.h>
+#include <runtime/base/frame_injection.h>
+#include <runtime/vm/translator/translator-inline.h>
+#include <util/async_func.h>
+#include <util/synchronizable.h>
+#include <util/thread_local.h>
+#include <util/atomic.h>
+#include <util/logger.h>
+#include <util/lock.h>
+
+#include <signal.h>
+#include <time.h>
+#include <sys/syscall.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+#define SAMPLER_MAX_URL 128
+#define SAMPLER_MAX_STACKS 20000
+
+namespace {
+
+struct StackSample {
+  char url[SAMPLER_MAX_URL];
+  int depth;
+  const char *frames[StackSampler::MaxDepth]; // innermost first
+};
+
+/*
+ * Written only by its request thread and read only by the aggregator, so
+ * each side just publishes its own index.
+ */
+class SampleRing {
+public:
+  SampleRing();
+  ~SampleRing();
+
+  StackSample samples[StackSampler::RingSize];
+  uint32 head; // next one to write
+  uint32 tail; // next one to read
+  int dropped;
+
+  char url[SAMPLER_MAX_URL];
+  timer_t timer;
+  bool armed;
+};
+
+class SampleAggregator : public Synchronizable {
+public:
+  SampleAggregator()
+    : m_stopped(false), m_thread(this, &SampleAggregator::run),
+      m_dropped(0) {
+  }
+
+  void start() { m_thread.start(); }
+  void stop();
+  void run();
+
+  void drain();
+  void report(std::string &out);
+  void clear();
+
+private:
+  bool m_stopped;
+  AsyncFunc<SampleAggregator> m_thread;
+
+  Mutex m_countsLock;
+  hphp_string_map<int64> m_counts;
+  int64 m_dropped;
+};
+
+}
+
+static Mutex s_ringsLock;
+static std::set<SampleRing*> s_rings;
+static SampleAggregator *s_aggregator;
+
+static IMPLEMENT_THREAD_LOCAL(SampleRing, s_ring);
+
+// what the signal handler can touch
+static __thread RequestInjectionData *t_sampleTarget;
+static __thread bool t_inRequest;
+
+///////////////////////////////////////////////////////////////////////////////
+// per-thread rings
+
+SampleRing::SampleRing() : head(0), tail(0), dropped(0), armed(false) {
+  url[0] = '\0';
+
+  struct sigevent ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.sigev_notify = SIGEV_THREAD_ID;
+  ev.sigev_signo = SIGPROF;
+  ev.sigev_notify_thread_id = syscall(SYS_gettid);
+  if (timer_create(CLOCK_THREAD_CPUTIME_ID, &ev, &timer) == 0) {
+    int ms = RuntimeOption::StackSamplerIntervalMs;
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = ms / 1000;
+    spec.it_interval.tv_nsec = (ms % 1000) * 1000000;
+    spec.it_value = spec.it_interval;
+    armed = timer_settime(timer, 0, &spec, NULL) == 0;
+    if (!armed) timer_delete(timer);
+  }
+  if (!armed) {
+    Logger::Warning("stack sampler: unable to set up a timer: %s",
+                    strerror(errno));
+  }
+  t_sampleTarget = &ThreadInfo::s_threadInfo->m_reqInjectionData;
+
+  Lock lock(s_ringsLock);
+  s_rings.insert(this);
+}
+
+SampleRing::~SampleRing() {
+  t_sampleTarget = NULL;
+  if (armed) timer_delete(timer);
+
+  Lock lock(s_ringsLock);
+  s_rings.erase(this);
+}
+
+static void on_sigprof(int sig) {
+  RequestInjectionData *data = t_sampleTarget;
+  if (data && t_inRequest) data->setSampleFlag();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// aggregator
+
+void SampleAggregator::stop() {
+  {
+    Lock lock(this);
+    m_stopped = true;
+    notify();
+  }
+  m_thread.waitForEnd();
+}
+
+void SampleAggregator::run() {
+  Lock lock(this);
+  while (!m_stopped) {
+    wait(1);
+    drain();
+  }
+}
+
+void SampleAggregator::drain() {
+  std::string stack;
+  Lock lock(s_ringsLock);
+  Lock countsLock(m_countsLock);
+  for (std::set<SampleRing*>::iterator iter = s_rings.begin();
+       iter != s_rings.end(); ++iter) {
+    SampleRing *ring = *iter;
+    uint32 head = atomic_acquire_load(&ring->head);
+    uint32 tail = ring->tail;
+    for (; tail != head; tail++) {
+      const StackSample &s = ring->samples[tail % StackSampler::RingSize];
+      stack = s.url;
+      for (int i = s.depth - 1; i >= 0; i--) {
+        stack += ';';
+        stack += s.frames[i];
+      }
+      hphp_string_map<int64>::iterator it = m_counts.find(stack);
+      if (it != m_counts.end()) {
+        it->second++;
+      } else if (m_counts.size() < SAMPLER_MAX_STACKS) {
+        m_counts[stack] = 1;
+      } else {
+        m_dropped++;
+      }
+    }
+    atomic_release_store(&ring->tail, tail);
+    m_dropped += ring->dropped;
+    ring->dropped = 0; // a lost update or two here is fine
+  }
+}
+
+void SampleAggregator::report(std::string &out) {
+  char buf[32];
+  Lock lock(m_countsLock);
+  for (hphp_string_map<int64>::const_iterator iter = m_counts.begin();
+       iter != m_counts.end(); ++iter) {
+    out += iter->first;
+    snprintf(buf, sizeof(buf), " %lld\n", (long long)iter->second);
+    out += buf;
+  }
+  if (m_dropped) {
+    snprintf(buf, sizeof(buf), "[dropped] %lld\n", (long long)m_dropped);
+    out += buf;
+  }
+}
+
+void SampleAggregator::clear() {
+  Lock lock(m_countsLock);
+  m_counts.clear();
+  m_dropped = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void StackSampler::Restart() {
+  Stop();
+  if (RuntimeOption::StackSamplerIntervalMs <= 0) return;
+
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = on_sigprof;
+  sa.sa_flags = SA_RESTART;
+  sigemptyset(&sa.sa_mask);
+  sigaction(SIGPROF, &sa, NULL);
+
+  s_aggregator = new SampleAggregator();
+  s_aggregator->start();
+}
+
+void StackSampler::Stop() {
+  if (s_aggregator) {
+    s_aggregator->stop();
+    delete s_aggregator;
+    s_aggregator = NULL;
+  }
+}
+
+void StackSampler::StartRequest(const char *url) {
+  if (!s_aggregator) return;
+  SampleRing *ring = s_ring.get();
+  strncpy(ring->url, url, sizeof(ring->url) - 1);
+  ring->url[sizeof(ring->url) - 1] = '\0';
+  t_inRequest = true;
+}
+
+void StackSampler::EndRequest() {
+  t_inRequest = false;
+}
+
+void StackSampler::Sample(ThreadInfo *info) {
+  if (!s_aggregator || !t_inRequest) return;
+  SampleRing *ring = s_ring.get();
+  uint32 head = ring->head;
+  if (head - atomic_acquire_load(&ring->tail) >= (uint32)RingSize) {
+    ring->dropped++;
+    return;
+  }
+
+  StackSample &s = ring->samples[head % RingSize];
+  memcpy(s.url, ring->url, sizeof(s.url));
+  s.depth = CollectFrames(info, s.frames, MaxDepth);
+  atomic_release_store(&ring->head, head + 1);
+}
+
+int StackSampler::CollectFrames(ThreadInfo *info, const char **frames,
+                                int max) {
+  if (hhvm) {
+    VMExecutionContext *context = g_vmContext;
+    if (!context->m_fp) return CollectFrames((VM::ActRec *)NULL, frames, max);
+    VM::Transl::VMRegAnchor _;
+    return CollectFrames(context->getFP(), frames, max);
+  }
+  int depth = 0;
+  for (FrameInjection *fi = info->m_top; fi && depth < max;
+       fi = fi->getPrev()) {
+    frames[depth++] = fi->getFunction();
+  }
+  if (depth == 0) {
+    frames[depth++] = "[no frames]";
+  }
+  return depth;
+}
+
+int StackSampler::CollectFrames(const VM::ActRec *fp, const char **frames,
+                                int max) {
+  VMExecutionContext *context = g_vmContext;
+  int depth = 0;
+  for (; fp && depth < max; fp = context->getPrevVMState(fp)) {
+    const VM::Func *func = fp->m_func;
+    // function names and file paths are static strings, so these
+    // pointers stay good for the aggregator
+    frames[depth++] = func->isPseudoMain() ?
+      func->unit()->filepath()->data() : func->fullName()->data();
+  }
+  if (depth == 0) {
+    frames[depth++] = "[no frames]";
+  }
+  return depth;
+}
+
+void StackSampler::Report(std::string &out) {
+  if (!s_aggregator) return;
+  s_aggregator->drain();
+  s_aggregator->report(out);
+}
+
+void StackSampler::Clear() {
+  if (s_aggregator) s_aggregator->clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,86 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef __HPHP_STACK_SAMPLER_H__
+#define __HPHP_STACK_SAMPLER_H__
+
+#include <util/base.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+class ThreadInfo;
+namespace VM { struct ActRec; }
+
+/**
+ * Always-on sampling profiler for PHP stacks.
+ *
+ * Every request thread gets a timer on its own CPU clock that sends it
+ * SIGPROF every Stats.StackSampler.IntervalMs of CPU time. The signal
+ * handler only raises a surprise flag: the VM's registers can't be trusted
+ * in the middle of translated code, so the thread takes the sample itself
+ * at its next surprise check (a function entry or a backward jump), walking
+ * its ActRec chain, or its FrameInjection chain when compiled, into a
+ * preallocated ring. Nothing is pinned to a CPU and no function entry or
+ * exit is hooked.
+ *
+ * A background thread drains the rings and counts stacks per URL, which
+ * the admin server's /prof-sample.folded hands out for flamegraph.pl.
+ */
+class StackSampler {
+public:
+  static const int MaxDepth = 48;
+  static const int RingSize = 64;
+
+  /**
+   * Installs the signal handler and starts the aggregating thread, when
+   * sampling is configured.
+   */
+  static void Restart();
+  static void Stop();
+
+  static void StartRequest(const char *url);
+  static void EndRequest();
+
+  /**
+   * Called from check_request_surprise() when the sample flag is up.
+   */
+  static void Sample(ThreadInfo *info);
+
+  /**
+   * Current PHP stack, innermost first, into frames. The names are static
+   * strings. Returns how many there are, at least one.
+   */
+  static int CollectFrames(ThreadInfo *info, const char **frames, int max);
+
+  /**
+   * Same, from the VM frame fp outwards, for callers that found the
+   * innermost frame without syncing the VM registers.
+   */
+  static int CollectFrames(const VM::ActRec *fp, const char **frames,
+                           int max);
+
+  /**
+   * One "url;outermost;...;innermost count" line per distinct stack.
+   */
+  static void Report(std::string &out);
+  static void Clear();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif // __HPHP_STACK_SAMPLER_H__
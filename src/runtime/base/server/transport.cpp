@@ -24,6 +24,7 @@
 #include <runtime/base/zend/zend_url.h>
 #include <runtime/base/runtime_option.h>
 #include <runtime/base/server/access_log.h>
+#include <runtime/base/server/compression_pool.h>
 #include <runtime/ext/ext_openssl.h>
 #include <util/compression.h>
 #include <util/util.h>
@@ -34,6 +35,9 @@
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 
+static int s_uncompressed = ServerStats::Register("network.uncompressed");
+static int s_compressed = ServerStats::Register("network.compressed");
+
 Transport::Transport()
   : m_instructions(0), m_url(NULL), m_postData(NULL), m_postDataParsed(false),
     m_chunkedEncoding(false), m_headerSent(false),
@@ -434,9 +438,42 @@ bool Transport::acceptEncoding(const char *encoding) {
   ASSERT(encoding && *encoding);
   string header = getHeader("Accept-Encoding");
 
-  // This is testing a substring than a word match, but in practice, this
-  // always works.
-  return header.find(encoding) != string::npos;
+  // Each comma separated item is a coding with an optional ";q=" weight.
+  // The coding is acceptable if it's listed, or failing that "*" is, with
+  // a non-zero weight. "x-gzip" is the same as "gzip".
+  int len = strlen(encoding);
+  int any = 0;  // "*": 0 not listed, 1 accepted, -1 refused
+  size_t pos = 0;
+  while (pos < header.size()) {
+    size_t end = header.find(',', pos);
+    if (end == string::npos) end = header.size();
+    while (pos < end && isspace(header[pos])) pos++;
+    size_t tokenEnd = pos;
+    while (tokenEnd < end && header[tokenEnd] != ';' &&
+           !isspace(header[tokenEnd])) {
+      tokenEnd++;
+    }
+    const char *token = header.c_str() + pos;
+    int tokenLen = tokenEnd - pos;
+    if (tokenLen > 2 && strncasecmp(token, "x-", 2) == 0) {
+      token += 2;
+      tokenLen -= 2;
+    }
+
+    bool accepted = true;
+    size_t q = header.find("q=", tokenEnd);
+    if (q < end) {
+      accepted = strtod(header.c_str() + q + 2, NULL) > 0;
+    }
+    if (tokenLen == len && strncasecmp(token, encoding, len) == 0) {
+      return accepted;
+    }
+    if (tokenLen == 1 && *token == '*') {
+      any = accepted ? 1 : -1;
+    }
+    pos = end + 1;
+  }
+  return any > 0;
 }
 
 bool Transport::cookieExists(const char *name) {
@@ -704,6 +741,20 @@ String Transport::prepareResponse(const void *data, int size, bool &compressed,
   return response;
 }
 
+/*
+ * Whether a response of size bytes should be gzipped by CompressionPool
+ * instead of on this thread. Only the common case goes there: a whole,
+ * sizable response to a client that asked for gzip.
+ */
+bool Transport::compressAsync(int size) {
+  if (m_compressionDecision == NotDecidedYet) {
+    decideCompression();
+  }
+  return m_compressionDecision == ShouldCompress && size > 1000 &&
+    !m_chunkedEncoding && !m_headerSent && isCompressionEnabled() &&
+    CompressionPool::Enabled() && supportsAsyncCompression();
+}
+
 bool Transport::setHeaderCallback(CVarRef callback) {
   if (m_headerCallback) {
     // return false if a callback has already been set.
@@ -747,7 +798,10 @@ void Transport::sendRawLocked(void *data, int size, int code /* = 200 */,
 
   // compression handling
   ServerStatsHelper ssh("send");
-  String response = prepareResponse(data, size, compressed, !chunked);
+  bool async = !chunked && !compressed && compressAsync(size);
+  String response = async ?
+    String((const char *)data, size, AttachLiteral) :
+    prepareResponse(data, size, compressed, !chunked);
 
   if (m_responseCode < 0) {
     m_responseCode = code;
@@ -756,19 +810,26 @@ void Transport::sendRawLocked(void *data, int size, int code /* = 200 */,
 
   // HTTP header handling
   if (!m_headerSent) {
-    prepareHeaders(compressed, data, size);
+    prepareHeaders(compressed || async, data, size);
     m_headerSent = true;
   }
 
+  // with async compression, the compressed size is never known here
   m_responseSize += response.size();
   ServerStats::SetThreadMode(ServerStats::Writing);
-  sendImpl(response.data(), response.size(), m_responseCode, chunked);
+  if (async) {
+    sendAsyncImpl(response.data(), response.size(), m_responseCode);
+  } else {
+    sendImpl(response.data(), response.size(), m_responseCode, chunked);
+  }
   ServerStats::SetThreadMode(ServerStats::Processing);
 
   ServerStats::LogBytes(size);
   if (RuntimeOption::EnableStats && RuntimeOption::EnableWebStats) {
-    ServerStats::Log("network.uncompressed", size);
-    ServerStats::Log("network.compressed", response.size());
+    ServerStats::Log(s_uncompressed, size);
+    if (!async) {
+      ServerStats::Log(s_compressed, response.size());
+    }
   }
 }
 
@@ -189,6 +189,17 @@ public:
   virtual void sendImpl(const void *data, int size, int code,
                         bool chunked) = 0;
 
+  /**
+   * Transports that can finish a response from another thread may take it
+   * uncompressed and have CompressionPool gzip it. By then its headers,
+   * including "Content-Encoding: gzip", are already added; sendAsyncImpl()
+   * only has to get the compressed body out.
+   */
+  virtual bool supportsAsyncCompression() { return false; }
+  virtual void sendAsyncImpl(const void *data, int size, int code) {
+    ASSERT(false);
+  }
+
   /**
    * Override to implement more send end logic.
    */
@@ -413,6 +424,7 @@ protected:
 
   String prepareResponse(const void *data, int size, bool &compressed,
                          bool last);
+  bool compressAsync(int size);
   bool moveUploadedFileHelper(CStrRef filename, CStrRef destination);
 
 private:
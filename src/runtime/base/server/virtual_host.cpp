@@ -76,6 +76,10 @@ const vector<string> &VirtualHost::GetAllowedDirectories() {
 void VirtualHost::initRuntimeOption(Hdf overwrite) {
   int requestTimeoutSeconds =
     overwrite["Server.RequestTimeoutSeconds"].getInt32(-1);
+  int requestTimeoutMs =
+    overwrite["Server.RequestTimeoutMs"].getInt32(-1);
+  int requestCpuTimeoutMs =
+    overwrite["Server.RequestCpuTimeoutMs"].getInt32(-1);
   int64 maxPostSize =
     overwrite["Server.MaxPostSize"].getInt32(-1);
   if (maxPostSize != -1) maxPostSize *= (1LL << 20);
@@ -85,13 +89,25 @@ void VirtualHost::initRuntimeOption(Hdf overwrite) {
   overwrite["Server.AllowedDirectories"].
     get(m_runtimeOption.allowedDirectories);
   m_runtimeOption.requestTimeoutSeconds = requestTimeoutSeconds;
+  m_runtimeOption.requestTimeoutMs = requestTimeoutMs;
+  m_runtimeOption.requestCpuTimeoutMs = requestCpuTimeoutMs;
   m_runtimeOption.maxPostSize = maxPostSize;
   m_runtimeOption.uploadMaxFileSize = uploadMaxFileSize;
 }
 
-void VirtualHost::setRequestTimeoutSeconds() const {
-  if (m_runtimeOption.requestTimeoutSeconds != -1) {
+void VirtualHost::setRequestTimeout() const {
+  if (m_runtimeOption.requestTimeoutMs != -1) {
+    TimeoutThread::SetTimeoutMs(m_runtimeOption.requestTimeoutMs);
+  } else if (m_runtimeOption.requestTimeoutSeconds != -1) {
     TimeoutThread::DeferTimeout(m_runtimeOption.requestTimeoutSeconds);
+  } else if (RuntimeOption::RequestTimeoutMs > 0) {
+    TimeoutThread::SetTimeoutMs(RuntimeOption::RequestTimeoutMs);
+  }
+
+  int cpuTimeoutMs = m_runtimeOption.requestCpuTimeoutMs;
+  if (cpuTimeoutMs == -1) cpuTimeoutMs = RuntimeOption::RequestCpuTimeoutMs;
+  if (cpuTimeoutMs > 0) {
+    TimeoutThread::SetCpuTimeoutMs(cpuTimeoutMs);
   }
 }
 
@@ -40,7 +40,7 @@ public:
   VirtualHost(Hdf vh);
 
   void init(Hdf vh);
-  void setRequestTimeoutSeconds() const;
+  void setRequestTimeout() const;
 
   const std::string &getName() const { return m_name;}
   const std::string &getPathTranslation() const { return m_pathTranslation;}
@@ -93,6 +93,8 @@ private:
   struct VhostRuntimeOption {
   public:
     int requestTimeoutSeconds;
+    int requestTimeoutMs;
+    int requestCpuTimeoutMs;
     int64 maxPostSize;
     int64 uploadMaxFileSize;
     std::vector<std::string> allowedDirectories;
@@ -27,9 +27,15 @@ namespace HPHP {
 
 // helpers
 
-static void log_apc(const string& name) {
+static int s_apcHit = ServerStats::Register("apc.hit");
+static int s_apcMiss = ServerStats::Register("apc.miss");
+static int s_apcCas = ServerStats::Register("apc.cas");
+static int s_apcNew = ServerStats::Register("apc.new");
+static int s_apcUpdate = ServerStats::Register("apc.update");
+
+static void log_apc(int counter) {
   if (RuntimeOption::EnableStats && RuntimeOption::EnableAPCStats) {
-    ServerStats::Log(name, 1);
+    ServerStats::Log(counter, 1);
   }
 }
 
@@ -243,7 +249,7 @@ bool ConcurrentTableSharedStore::get(CStrRef key, Variant &value) {
   {
     Map::const_accessor acc;
     if (!m_vars.find(acc, key.data())) {
-      log_apc("apc.miss");
+      log_apc(s_apcMiss);
       return false;
     } else {
       sval = &acc->second;
@@ -272,11 +278,11 @@ bool ConcurrentTableSharedStore::get(CStrRef key, Variant &value) {
     }
   }
   if (expired) {
-    log_apc("apc.miss");
+    log_apc(s_apcMiss);
     eraseImpl(key, true);
     return false;
   }
-  log_apc("apc.hit");
+  log_apc(s_apcHit);
 
   if (update) {
     bool updated = handleUpdate(key, svar);
@@ -323,7 +329,7 @@ int64 ConcurrentTableSharedStore::inc(CStrRef key, int64 step, bool &found) {
         sval->var->decRef();
         sval->var = svar;
         found = true;
-        log_apc("apc.hit");
+        log_apc(s_apcHit);
       }
     }
   }
@@ -344,7 +350,7 @@ bool ConcurrentTableSharedStore::cas(CStrRef key, int64 old, int64 val) {
         sval->var->decRef();
         sval->var = var;
         success = true;
-        log_apc("apc.cas");
+        log_apc(s_apcCas);
       }
     }
   }
@@ -359,7 +365,7 @@ bool ConcurrentTableSharedStore::exists(CStrRef key) {
   {
     Map::const_accessor acc;
     if (!m_vars.find(acc, key.data())) {
-      log_apc("apc.miss");
+      log_apc(s_apcMiss);
       return false;
     } else {
       sval = &acc->second;
@@ -376,11 +382,11 @@ bool ConcurrentTableSharedStore::exists(CStrRef key) {
     }
   }
   if (expired) {
-    log_apc("apc.miss");
+    log_apc(s_apcMiss);
     eraseImpl(key, true);
     return false;
   }
-  log_apc("apc.hit");
+  log_apc(s_apcHit);
   return true;
 }
 
@@ -445,9 +451,9 @@ bool ConcurrentTableSharedStore::store(CStrRef key, CVarRef value, int64 ttl,
     purgeExpired();
   }
   if (present) {
-    log_apc("apc.update");
+    log_apc(s_apcUpdate);
   } else {
-    log_apc("apc.new");
+    log_apc(s_apcNew);
     if (RuntimeOption::EnableStats && RuntimeOption::EnableAPCKeyStats) {
       string prefix = "apc.new.";
       prefix += GetSkeleton(key);
@@ -0,0 +1,152 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include <runtime/base/shared/shared_session_store.h>
+#include <util/lock.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+SharedSessionStore s_shared_session_store;
+
+SharedSessionStore::Entry *
+SharedSessionStore::Entry::Create(const char *data, int len, int64 version) {
+  Entry *e = (Entry *)malloc(sizeof(Entry) + len);
+  e->count = 1;
+  e->version = version;
+  e->mtime = time(NULL);
+  e->len = len;
+  memcpy(e->data, data, len);
+  e->data[len] = '\0';
+  return e;
+}
+
+SharedSessionStore::SharedSessionStore() : m_version(0) {
+}
+
+SharedSessionStore::~SharedSessionStore() {
+  for (Map::iterator iter = m_map.begin(); iter != m_map.end(); ++iter) {
+    iter->second->decRef();
+  }
+}
+
+int64 SharedSessionStore::read(const std::string &key, int maxlifetime,
+                               std::string &value) {
+  Entry *e = NULL;
+  {
+    Map::const_accessor acc;
+    if (m_map.find(acc, key)) {
+      e = acc->second;
+      e->incRef();
+    }
+  }
+  if (!e) return 0;
+
+  int64 version = 0;
+  if (!e->expired(time(NULL), maxlifetime)) {
+    value.assign(e->data, e->len);
+    version = e->version;
+  }
+  e->decRef();
+  return version;
+}
+
+SharedSessionStore::WriteResult
+SharedSessionStore::write(const std::string &key, const char *value, int len,
+                          int64 readVersion, int maxlifetime) {
+  time_t now = time(NULL);
+  Entry *old = NULL;
+  bool inserted;
+  {
+    Map::accessor acc;
+    inserted = m_map.insert(acc, key);
+    Entry *cur = inserted ? NULL : acc->second;
+    bool live = cur && !cur->expired(now, maxlifetime);
+
+    if (live && cur->len == len && !memcmp(cur->data, value, len)) {
+      cur->mtime = now;
+      return Unchanged;
+    }
+    if (readVersion >= 0 && (live ? cur->version : 0) != readVersion) {
+      if (inserted) m_map.erase(acc);
+      return Conflict;
+    }
+
+    old = cur;
+    int64 version = atomic_add(m_version, (int64)1) + 1;
+    acc->second = Entry::Create(value, len, version);
+  }
+  if (old) old->decRef();
+
+  if (inserted) {
+    Lock lock(m_expiryLock);
+    m_expiry.push(Expiry(now, key));
+  }
+  return Written;
+}
+
+bool SharedSessionStore::touch(const std::string &key, int maxlifetime) {
+  time_t now = time(NULL);
+  Map::accessor acc;
+  if (!m_map.find(acc, key) || acc->second->expired(now, maxlifetime)) {
+    return false;
+  }
+  acc->second->mtime = now;
+  return true;
+}
+
+bool SharedSessionStore::erase(const std::string &key) {
+  Entry *e;
+  {
+    Map::accessor acc;
+    if (!m_map.find(acc, key)) return false;
+    e = acc->second;
+    m_map.erase(acc);
+  }
+  e->decRef();
+  return true;
+}
+
+int SharedSessionStore::gc(int maxlifetime) {
+  time_t now = time(NULL);
+  int dropped = 0;
+
+  Lock lock(m_expiryLock);
+  while (!m_expiry.empty() && now - m_expiry.top().first > maxlifetime) {
+    std::string key = m_expiry.top().second;
+    m_expiry.pop();
+
+    Entry *dead = NULL;
+    {
+      Map::accessor acc;
+      if (!m_map.find(acc, key)) continue;  // destroyed
+      if (acc->second->expired(now, maxlifetime)) {
+        dead = acc->second;
+        m_map.erase(acc);
+      } else {
+        m_expiry.push(Expiry(acc->second->mtime, key));
+      }
+    }
+    if (dead) {
+      dead->decRef();
+      dropped++;
+    }
+  }
+  return dropped;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
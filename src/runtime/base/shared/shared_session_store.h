@@ -0,0 +1,123 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef __HPHP_SHARED_SESSION_STORE_H__
+#define __HPHP_SHARED_SESSION_STORE_H__
+
+#include <util/base.h>
+#include <util/atomic.h>
+#include <util/mutex.h>
+#include <tbb/concurrent_hash_map.h>
+#include <queue>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Process-wide session table behind the "shm" session save handler.
+ *
+ * Every stored session is an immutable, reference counted copy of its
+ * data, and a write swaps in a new one. A read only holds the table
+ * bucket long enough to take a reference, then copies the data out with
+ * no lock held, so readers never wait for each other and wait for a
+ * writer only for a pointer swap.
+ *
+ * Each copy gets a version number from a process-wide counter. A write
+ * can name the version it read; if another write has landed in between,
+ * and the data differs from what is stored now, the write is refused
+ * rather than clobbering the other request's changes.
+ *
+ * A session expires maxlifetime seconds after its last write. Expired
+ * sessions read as missing and are dropped by gc().
+ */
+class SharedSessionStore {
+public:
+  enum WriteResult {
+    Written,
+    Unchanged,  // same bytes as stored; only the expiry was pushed back
+    Conflict
+  };
+
+  SharedSessionStore();
+  ~SharedSessionStore();
+
+  /**
+   * Copies out key's data. Returns the version read, or 0 if there is no
+   * live session under key.
+   */
+  int64 read(const std::string &key, int maxlifetime, std::string &value);
+
+  /**
+   * Stores value under key. The write only goes through if the session is
+   * still at readVersion (0 meaning there was none), or already holds
+   * value. A negative readVersion skips the check.
+   */
+  WriteResult write(const std::string &key, const char *value, int len,
+                    int64 readVersion, int maxlifetime);
+
+  /**
+   * Pushes back the expiry of key's live session without touching its data
+   * or version. Returns false if there is none.
+   */
+  bool touch(const std::string &key, int maxlifetime);
+
+  bool erase(const std::string &key);
+
+  /**
+   * Drops sessions whose last write is more than maxlifetime seconds ago.
+   * Returns how many were dropped.
+   */
+  int gc(int maxlifetime);
+
+  int size() const { return m_map.size(); }
+
+private:
+  class Entry {
+  public:
+    static Entry *Create(const char *data, int len, int64 version);
+    void incRef() { atomic_inc(count); }
+    void decRef() { if (atomic_dec(count) == 0) free(this); }
+
+    bool expired(time_t now, int maxlifetime) const {
+      return now - mtime > maxlifetime;
+    }
+
+    int count;
+    int64 version;
+    time_t mtime;  // bumped in place by touch() and unchanged writes
+    int len;
+    char data[1];
+  };
+
+  typedef tbb::concurrent_hash_map<std::string, Entry*> Map;
+  typedef std::pair<time_t, std::string> Expiry;
+
+  Map m_map;
+  int64 m_version;
+
+  // One entry per live session, oldest mtime on top; a session that has
+  // been written since it was queued just goes back in with its new mtime.
+  Mutex m_expiryLock;
+  std::priority_queue<Expiry, std::vector<Expiry>,
+                      std::greater<Expiry> > m_expiry;
+};
+
+extern SharedSessionStore s_shared_session_store;
+
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif // __HPHP_SHARED_SESSION_STORE_H__
@@ -57,6 +57,15 @@ StringData *StringData::GetStaticString(const StringData *str) {
   return const_cast<StringData*>(acc->first);
 }
 
+StringData *StringData::LookupStaticString(const StringData *str) {
+  StringDataMap::const_accessor acc;
+  if (!s_stringDataMap) return NULL;
+  if (s_stringDataMap->find(acc, str)) {
+    return const_cast<StringData*>(acc->first);
+  }
+  return NULL;
+}
+
 StringData *StringData::GetStaticString(const std::string &str) {
   StringData sd(str.c_str(), str.size(), AttachLiteral);
   return GetStaticString(&sd);
@@ -256,6 +256,13 @@ class StringData {
   static StringData *GetStaticString(const char *str);
   static StringData *GetStaticString(char c);
 
+  /**
+   * Returns the static copy of str if one already exists, or NULL. Unlike
+   * GetStaticString() this never adds to the table, so it is safe to call
+   * with request data.
+   */
+  static StringData *LookupStaticString(const StringData *str);
+
   /**
    * The order of the data members is significant. The _count field must
    * be exactly FAST_REFCOUNT_OFFSET bytes from the beginning of the object.
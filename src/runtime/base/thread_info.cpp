@@ -16,6 +16,7 @@
 #include <runtime/base/types.h>
 #include <runtime/base/hphp_system.h>
 #include <runtime/base/code_coverage.h>
+#include <runtime/base/timeout_thread.h>
 #include <runtime/base/memory/smart_allocator.h>
 #include <util/lock.h>
 #include <util/alloc.h>
@@ -115,7 +116,7 @@ void ThreadInfo::onSessionExit() {
 
 void RequestInjectionData::onSessionInit() {
   reset();
-  started = time(0);
+  TimeoutThread::ResetTimeout(*this);
 }
 
 void RequestInjectionData::reset() {
@@ -146,6 +147,10 @@ void RequestInjectionData::clearEventHookFlag() {
   __sync_fetch_and_and(&conditionFlags, ~RequestInjectionData::EventHookFlag);
 }
 
+void RequestInjectionData::setSampleFlag() {
+  __sync_fetch_and_or(&conditionFlags, RequestInjectionData::SampleFlag);
+}
+
 ssize_t RequestInjectionData::fetchAndClearFlags() {
   ssize_t flags;
   for (;;) {
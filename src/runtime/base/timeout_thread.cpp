@@ -15,9 +15,11 @@
 */
 
 #include <sys/mman.h>
+#include <pthread.h>
 
 #include <runtime/base/timeout_thread.h>
 #include <runtime/base/runtime_option.h>
+#include <util/compatibility.h>
 #include <util/lock.h>
 #include <util/logger.h>
 
@@ -25,37 +27,102 @@ namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 // statics
 
-// class defined in runtime/base/types.h
-static void on_timer(int fd, short events, void *context) {
-  ((TimeoutThread*)context)->onTimer(fd);
+int64 TimeoutThread::Now() {
+  timespec ts;
+  gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000LL + ts.tv_nsec / 1000000;
 }
 
-static void on_thread_stop(int fd, short events, void *context) {
-  event_base_loopbreak((struct event_base *)context);
+int64 TimeoutThread::CpuNow(clockid_t clock) {
+  timespec ts;
+  if (clock_gettime(clock, &ts) != 0) return -1;
+  return ts.tv_sec * 1000LL + ts.tv_nsec / 1000000;
 }
 
-///////////////////////////////////////////////////////////////////////////////
+/*
+ * A worker writes its deadline and then reads nextCheck, and the timeout
+ * thread writes nextCheck and then reads the deadline again, so one of
+ * them always sees what the other did.
+ */
+static void check_soon(RequestInjectionData &data, int64 when) {
+  __sync_synchronize();
+  int64 next = data.nextCheck;
+  if (data.timeoutThread && (next == 0 || when < next)) {
+    data.timeoutThread->wakeUp(when);
+  }
+}
+
+static void set_deadline(RequestInjectionData &data, int64 ms) {
+  data.limitMs = ms;
+  if (ms <= 0) {
+    data.deadline = 0;
+    return;
+  }
+  data.deadline = TimeoutThread::Now() + ms;
+  check_soon(data, data.deadline);
+}
+
+void TimeoutThread::ResetTimeout(RequestInjectionData &data) {
+  data.cpuDeadline = 0;
+  data.cpuLimitMs = 0;
+  set_deadline(data, data.timeoutMs);
+}
 
 void TimeoutThread::DeferTimeout(int seconds) {
+  SetTimeoutMs(seconds > 0 ? seconds * 1000LL : 0);
+}
+
+void TimeoutThread::SetTimeoutMs(int64 ms) {
+  set_deadline(ThreadInfo::s_threadInfo->m_reqInjectionData, ms);
+}
+
+void TimeoutThread::SetCpuTimeoutMs(int64 ms) {
   RequestInjectionData &data = ThreadInfo::s_threadInfo->m_reqInjectionData;
-  if (seconds > 0) {
-    // cheating by resetting started to desired timestamp
-    data.started = time(0) + (seconds - data.timeoutSeconds);
-  } else {
-    data.started = 0;
+  data.cpuLimitMs = ms;
+  int64 now = ms > 0 ? CpuNow(data.cpuClock) : -1;
+  if (now < 0) {
+    data.cpuDeadline = 0;
+    return;
   }
+  data.cpuDeadline = now + ms;
+  check_soon(data, Now() + ms);
+}
+
+int64 TimeoutThread::GetRemainingMs() {
+  RequestInjectionData &data = ThreadInfo::s_threadInfo->m_reqInjectionData;
+  int64 deadline = data.deadline;
+  if (deadline <= 0 || !data.timeoutThread) return -1;
+  int64 left = deadline - Now();
+  return left > 0 ? left : 0;
+}
+
+int64 TimeoutThread::GetCpuRemainingMs() {
+  RequestInjectionData &data = ThreadInfo::s_threadInfo->m_reqInjectionData;
+  int64 deadline = data.cpuDeadline;
+  if (deadline <= 0 || !data.timeoutThread) return -1;
+  int64 left = deadline - CpuNow(data.cpuClock);
+  return left > 0 ? left : 0;
+}
+
+int64 TimeoutThread::ClampTimeoutMs(int64 ms) {
+  int64 left = GetRemainingMs();
+  if (left < 0) return ms;
+  // out of time: fail fast rather than turn it into no timeout at all
+  if (left == 0) left = 1;
+  return ms > 0 && ms < left ? ms : left;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 TimeoutThread::TimeoutThread(int timerCount, int timeoutSeconds)
-  : m_numWorkers(0), m_numTimers(0), m_stopped(false),
-    m_timeoutSeconds(timeoutSeconds) {
+  : m_numWorkers(0), m_stopped(false),
+    m_timeoutMs(timeoutSeconds > 0 ? timeoutSeconds * 1000LL : 0),
+    m_wheel(WheelSlots, -1), m_tick(Now()), m_nextWake(0),
+    m_rescheduled(0) {
   ASSERT(timerCount > 0);
 
-  m_eventBase = event_base_new();
-  m_eventTimeouts.resize(timerCount);
   m_timeoutData.resize(timerCount);
+  m_timers.reserve(timerCount);
 
   // We need to open the pipe here because worker threads can start
   // before the timeout thread starts
@@ -63,12 +130,16 @@ TimeoutThread::TimeoutThread(int timerCount, int timeoutSeconds)
 }
 
 TimeoutThread::~TimeoutThread() {
-  event_base_free(m_eventBase);
 }
 
 void TimeoutThread::registerRequestThread(RequestInjectionData* data) {
   ASSERT(data);
-  data->timeoutSeconds = m_timeoutSeconds;
+  data->timeoutMs = m_timeoutMs;
+  data->timeoutThread = this;
+  // called on the worker itself, and the thread id is the clock to watch
+  if (pthread_getcpuclockid(pthread_self(), &data->cpuClock) != 0) {
+    data->cpuClock = CLOCK_THREAD_CPUTIME_ID;
+  }
 
   // Add the new worker to the timeout thread's list of workers
   {
@@ -85,29 +156,31 @@ void TimeoutThread::registerRequestThread(RequestInjectionData* data) {
   }
 }
 
-void TimeoutThread::checkForNewWorkers() {
-  // If m_timeoutSeconds is not a positive number, then workers threads
-  // are allowed to run forever, so don't bother creating timers for the
-  // workers
-  if (m_timeoutSeconds <= 0) {
-    return;
+/*
+ * Same handshake as check_soon(): the worker flags itself and then reads
+ * m_nextWake, and run() writes m_nextWake and then reads the flag, so a
+ * worker that doesn't write to the pipe is always picked up in time.
+ */
+void TimeoutThread::wakeUp(int64 when) {
+  m_rescheduled = 1;
+  __sync_synchronize();
+  int64 next = m_nextWake;
+  if (next != 0 && next <= when) return;
+  if (write(m_pipe.getIn(), "", 1) < 0) {
+    Logger::Warning("Error notifying the timeout thread of a new deadline");
   }
+}
+
+void TimeoutThread::checkForNewWorkers() {
   Lock lock(this);
-  // If there are new workers, create timers for them
-  if (m_numWorkers > m_numTimers) {
-    struct timeval timeout;
-    timeout.tv_usec = 0;
-    // +2 to make sure when it times out, this equation always holds:
-    //   time(0) - RequestInjection::s_reqInjectionData->started >=
-    //     m_timeoutSeconds
-    timeout.tv_sec = m_timeoutSeconds + 2;
-    for (int i = m_numTimers; i < m_numWorkers; ++i) {
-      event *e = &m_eventTimeouts[i];
-      event_set(e, i, 0, on_timer, this);
-      event_base_set(m_eventBase, e);
-      event_add(e, &timeout);
-    }
-    m_numTimers = m_numWorkers;
+  while ((int)m_timers.size() < m_numWorkers) {
+    Timer t;
+    t.data = m_timeoutData[m_timers.size()];
+    t.when = 0;
+    t.slot = -1;
+    t.prev = t.next = -1;
+    t.expired = t.cpuExpired = 0;
+    m_timers.push_back(t);
   }
 }
 
@@ -122,21 +195,31 @@ void TimeoutThread::drainPipe() {
 }
 
 void TimeoutThread::run() {
-  event_set(&m_eventPipe, m_pipe.getOut(), EV_READ|EV_PERSIST,
-            on_thread_stop, m_eventBase);
-  event_base_set(m_eventBase, &m_eventPipe);
-  event_add(&m_eventPipe, NULL);
+  struct pollfd fdArray[1];
+  fdArray[0].fd = m_pipe.getOut();
+  fdArray[0].events = POLLIN;
 
+  m_tick = Now();
   while (!m_stopped) {
-    checkForNewWorkers();
-    event_base_loop(m_eventBase, EVLOOP_ONCE);
-    drainPipe();
-  }
-
-  for (int i = 0; i < m_numTimers; ++i) {
-    event_del(&m_eventTimeouts[i]);
+    int64 now = Now();
+    int ms = sleepMs(now);
+    m_nextWake = ms < 0 ? 0 : now + ms;
+    __sync_synchronize();
+    if (m_rescheduled) ms = 0;
+    int ready = poll(fdArray, 1, ms);
+    if (m_stopped) break;
+    now = Now();
+    bool rescheduled = __sync_lock_test_and_set(&m_rescheduled, 0);
+    if (ready > 0 || rescheduled) {
+      // a new worker or an earlier deadline, but we don't know whose
+      if (ready > 0) drainPipe();
+      checkForNewWorkers();
+      for (unsigned int i = 0; i < m_timers.size(); i++) {
+        schedule(i, now);
+      }
+    }
+    advance(now);
   }
-  event_del(&m_eventPipe);
 }
 
 void TimeoutThread::stop() {
@@ -146,45 +229,118 @@ void TimeoutThread::stop() {
   }
 }
 
-void TimeoutThread::onTimer(int index) {
-  ASSERT(index >= 0 && index < (int)m_eventTimeouts.size());
+///////////////////////////////////////////////////////////////////////////////
+// timer wheel
 
-  event *e = &m_eventTimeouts[index];
-  event_del(e);
+void TimeoutThread::schedule(int index, int64 now) {
+  Timer &t = m_timers[index];
+  unlink(index);
+  RequestInjectionData *data = t.data;
+  int64 when;
+  while (true) {
+    int64 deadline = data->deadline;
+    int64 cpuDeadline = data->cpuDeadline;
+    when = check(t, deadline, cpuDeadline, now);
+    data->nextCheck = when;
+    __sync_synchronize();
+    if (data->deadline == deadline && data->cpuDeadline == cpuDeadline) {
+      break;
+    }
+  }
+  if (when) link(index, when);
+}
 
-  RequestInjectionData *data = m_timeoutData[index];
-  ASSERT(data);
-  struct timeval timeout;
-  timeout.tv_usec = 0;
-  if (data->started > 0) {
-    time_t now = time(0);
-    int delta = now - data->started;
-    if (delta >= m_timeoutSeconds) {
-      timeout.tv_sec = m_timeoutSeconds + 2;
-      if (hhvm) {
-        Lock l(data->surpriseLock);
-        data->setTimedOutFlag();
-        if (data->surprisePage) {
-          mprotect(data->surprisePage, sizeof(void*), PROT_NONE);
-        }
-      } else {
-        data->setTimedOutFlag();
-      }
+/*
+ * Times out the request if one of its deadlines has passed, and returns
+ * when to look again, or 0 if it has no deadline left to watch.
+ */
+int64 TimeoutThread::check(Timer &t, int64 deadline, int64 cpuDeadline,
+                           int64 now) {
+  int64 when = 0;
+  if (deadline > 0 && deadline != t.expired) {
+    if (deadline <= now) {
+      t.expired = deadline;
+      timeOut(t.data);
     } else {
-      // Negative delta means start time was adjusted forward to give more time
-      if (delta < 0) delta = 0;
+      when = deadline;
+    }
+  }
+  if (cpuDeadline > 0 && cpuDeadline != t.cpuExpired) {
+    int64 cpu = CpuNow(t.data->cpuClock);
+    if (cpu >= 0) {
+      if (cpu >= cpuDeadline) {
+        t.cpuExpired = cpuDeadline;
+        timeOut(t.data);
+      } else if (!when || now + cpuDeadline - cpu < when) {
+        when = now + cpuDeadline - cpu;
+      }
+    }
+  }
+  return when;
+}
 
-      // otherwise, a new request started after we started the timer
-      timeout.tv_sec = m_timeoutSeconds - delta + 2;
+void TimeoutThread::timeOut(RequestInjectionData *data) {
+  if (hhvm) {
+    Lock l(data->surpriseLock);
+    data->setTimedOutFlag();
+    if (data->surprisePage) {
+      mprotect(data->surprisePage, sizeof(void*), PROT_NONE);
     }
   } else {
-    // Another cycle of m_timeoutSeconds
-    timeout.tv_sec = m_timeoutSeconds;
+    data->setTimedOutFlag();
+  }
+}
+
+void TimeoutThread::link(int index, int64 when) {
+  Timer &t = m_timers[index];
+  t.when = when;
+  // a slot the wheel has just gone over would wait a whole turn
+  if (when <= m_tick) when = m_tick + 1;
+  t.slot = when % WheelSlots;
+  t.prev = -1;
+  t.next = m_wheel[t.slot];
+  if (t.next >= 0) m_timers[t.next].prev = index;
+  m_wheel[t.slot] = index;
+}
+
+void TimeoutThread::unlink(int index) {
+  Timer &t = m_timers[index];
+  if (t.slot < 0) return;
+  if (t.prev >= 0) {
+    m_timers[t.prev].next = t.next;
+  } else {
+    m_wheel[t.slot] = t.next;
   }
+  if (t.next >= 0) m_timers[t.next].prev = t.prev;
+  t.slot = -1;
+}
+
+/*
+ * Goes over every slot up to now, and only fires the timers that are due:
+ * the others are for a later turn of the wheel.
+ */
+void TimeoutThread::advance(int64 now) {
+  int64 from = m_tick + 1;
+  if (now - from >= WheelSlots) from = now - WheelSlots + 1;
+  m_tick = now;
+  for (int64 tick = from; tick <= now; tick++) {
+    int i = m_wheel[tick % WheelSlots];
+    while (i >= 0) {
+      int next = m_timers[i].next;
+      if (m_timers[i].when <= now) schedule(i, now);
+      i = next;
+    }
+  }
+}
 
-  event_set(e, index, 0, on_timer, this);
-  event_base_set(m_eventBase, e);
-  event_add(e, &timeout);
+int TimeoutThread::sleepMs(int64 now) {
+  for (int i = 1; i <= WheelSlots; i++) {
+    if (m_wheel[(m_tick + i) % WheelSlots] >= 0) {
+      int64 ms = m_tick + i - now;
+      return ms > 0 ? ms : 0;
+    }
+  }
+  return -1;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
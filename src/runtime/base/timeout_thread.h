@@ -21,14 +21,61 @@
 #include <util/base.h>
 #include <util/process.h>
 #include <util/synchronizable.h>
-#include <event.h>
 
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 
+/**
+ * Times out requests on the worker threads of one server.
+ *
+ * Each request has a wall clock deadline in milliseconds, and optionally a
+ * budget of its thread's own CPU time, so a request blocked on I/O isn't
+ * cut off for it. Workers just write their deadlines into their
+ * RequestInjectionData. This thread keeps one timer per worker on a timer
+ * wheel, and when one is due, it looks at the worker's current deadlines
+ * and either flags the request as timed out or files the timer again. A
+ * worker that moves a deadline earlier than its timer only wakes it up when
+ * it would otherwise sleep past the new deadline; if it is due to wake up
+ * before that anyway, it files the worker's timer again then.
+ *
+ * A CPU budget can't run out before the same amount of wall time passes,
+ * so it is checked that far in the future, and again for whatever is left.
+ */
 class TimeoutThread : public Synchronizable {
 public:
+  /**
+   * CLOCK_MONOTONIC, and a thread's CPU time, in milliseconds.
+   */
+  static int64 Now();
+  static int64 CpuNow(clockid_t clock);
+
+  /**
+   * Starts a request off with its thread's configured time limit, and no
+   * CPU time limit.
+   */
+  static void ResetTimeout(RequestInjectionData &data);
+
+  /**
+   * The current request times out this long from now. Zero or less means
+   * it never does.
+   */
   static void DeferTimeout(int seconds);
+  static void SetTimeoutMs(int64 ms);
+  static void SetCpuTimeoutMs(int64 ms);
+
+  /**
+   * What is left of the current request's limits, or -1 without one, or
+   * if no TimeoutThread watches this thread (the CLI, for one), as nothing
+   * would enforce it.
+   */
+  static int64 GetRemainingMs();
+  static int64 GetCpuRemainingMs();
+
+  /**
+   * A timeout for blocking I/O, cut down to what is left of the current
+   * request's deadline. Zero or less means no timeout.
+   */
+  static int64 ClampTimeoutMs(int64 ms);
 
 public:
   TimeoutThread(int timerCount, int timeoutSeconds);
@@ -38,23 +85,53 @@ public:
   void run();
   void stop();
 
-  void onTimer(int index);
+  /**
+   * For a worker whose deadline just got earlier than data->nextCheck, so
+   * its timer has to be looked at by when.
+   */
+  void wakeUp(int64 when);
 
 private:
+  static const int WheelSlots = 1024; // one per millisecond
+
+  struct Timer {
+    RequestInjectionData *data;
+    int64 when;       // when to look at data again
+    int slot;         // -1 when not on the wheel
+    int prev;         // neighbors in the slot, by index
+    int next;
+    int64 expired;    // deadlines already acted on
+    int64 cpuExpired;
+  };
+
   void checkForNewWorkers();
   void drainPipe();
 
+  void schedule(int index, int64 now);
+  int64 check(Timer &t, int64 deadline, int64 cpuDeadline, int64 now);
+  void timeOut(RequestInjectionData *data);
+  void link(int index, int64 when);
+  void unlink(int index);
+  void advance(int64 now);
+  int sleepMs(int64 now);
+
   int m_numWorkers;
-  int m_numTimers;
   bool m_stopped;
 
-  event_base *m_eventBase;
-  std::vector<event> m_eventTimeouts;
   std::vector<RequestInjectionData*> m_timeoutData;
-  int m_timeoutSeconds;
+  int64 m_timeoutMs;
+
+  // only touched by this thread
+  std::vector<Timer> m_timers;
+  std::vector<int> m_wheel;  // first timer in each slot, or -1
+  int64 m_tick;              // last millisecond the wheel went over
+
+  // when this thread next looks at the wheel, 0 for never, and whether a
+  // worker wants its timer filed again by then
+  volatile int64 m_nextWake;
+  volatile int m_rescheduled;
 
   // signal to wake up the thread
-  event m_eventPipe;
   CPipe m_pipe;
 };
 
@@ -30,6 +30,8 @@
 #include <runtime/base/runtime_option.h>
 #include <runtime/ext/ext_iconv.h>
 #include <unicode/coll.h> // icu
+#include <algorithm>
+#include <cmath>
 #include <util/parser/hphp.tab.hpp>
 
 namespace HPHP {
@@ -1005,7 +1007,12 @@ void Array::unserialize(VariableUnserializer *uns) {
     operator=(Create());
   } else {
     // Pre-allocate an ArrayData of the given size, to avoid escalation in
-    // the middle, which breaks references.
+    // the middle, which breaks references. Every element takes at least
+    // six bytes ("i:0;N;"), so a size the rest of the buffer could not
+    // possibly hold is a bad payload; don't allocate for it.
+    if (size < 0 || (uint64)size > uns->remaining() / 6 + 1) {
+      throw Exception("Array size %ld exceeds remaining input", size);
+    }
     operator=(ArrayInit(size).create());
     bool isAPC = (uns->getType() == VariableUnserializer::APCSerialize);
     for (int64 i = 0; i < size; i++) {
@@ -1076,6 +1083,245 @@ static int multi_compare_func(const void *n1, const void *n2, const void *op) {
   return 0;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// type-specialized sorting
+//
+// Before falling back to zend_qsort() with a Variant comparator, scan the
+// keys (or values) being sorted.  If they are all ints, all ints/doubles, or
+// all strings, and the comparator is one of the builtin ones whose result on
+// that type is known, pull the unboxed keys out into a flat array and sort
+// indices over that instead.  Ties are broken by original position so the
+// result is deterministic; zend_qsort gives no ordering guarantee for ties,
+// so this is still a valid result for the generic comparator.
+
+namespace {
+
+class SortKeys {
+public:
+  enum Kind {
+    Generic,
+    Int,       // int64 compare
+    Double,    // double compare, no NaNs
+    Binary,    // memcmp with length; no numeric strings
+    CString    // strcmp(), as SortStringAscending/Descending do
+  };
+
+  SortKeys() : m_kind(Generic), m_desc(false) {}
+
+  Kind kind() const { return m_kind; }
+
+  bool extract(const Array::SortData &opaque) {
+    Array::PFUNC_CMP cmp = opaque.cmp_func;
+    bool regular = false, numeric = false, str = false;
+    if (cmp == Array::SortRegularAscending ||
+        cmp == Array::SortRegularDescending) {
+      regular = true;
+      m_desc = cmp == Array::SortRegularDescending;
+    } else if (cmp == Array::SortNumericAscending ||
+               cmp == Array::SortNumericDescending) {
+      numeric = true;
+      m_desc = cmp == Array::SortNumericDescending;
+    } else if (cmp == Array::SortStringAscending ||
+               cmp == Array::SortStringDescending) {
+      str = true;
+      m_desc = cmp == Array::SortStringDescending;
+    } else {
+      return false;
+    }
+
+    CArrRef arr = *opaque.array;
+    const vector<ssize_t> &positions = opaque.positions;
+    int count = positions.size();
+    if (count == 0) return false;
+
+    bool sawInt = false, sawDouble = false, sawString = false;
+    for (int i = 0; i < count; i++) {
+      DataType t = opaque.by_key ? arr->getKey(positions[i]).getType() :
+        arr->getValueRef(positions[i]).getType();
+      switch (t) {
+      case KindOfInt64:        sawInt = true; break;
+      case KindOfDouble:       sawDouble = true; break;
+      case KindOfStaticString:
+      case KindOfString:       sawString = true; break;
+      default:                 return false;
+      }
+      if (sawString && (sawInt || sawDouble)) return false;
+    }
+
+    if (sawString) {
+      if (numeric) return false;
+      m_strs.reserve(count);
+      for (int i = 0; i < count; i++) {
+        StringData *sd = opaque.by_key ?
+          arr->getKey(positions[i]).getStringData() :
+          arr->getValueRef(positions[i]).getStringData();
+        if (regular) {
+          // StringData::compare() treats numeric strings as numbers.
+          int64 lval;
+          double dval;
+          DataType nt = sd->isNumericWithVal(lval, dval, 0);
+          if (nt == KindOfInt64 || (nt == KindOfDouble && finite(dval))) {
+            return false;
+          }
+        }
+        m_strs.push_back(sd);
+      }
+      m_kind = regular ? Binary : CString;
+      return true;
+    }
+
+    if (str) return false; // ints compare as their decimal strings
+
+    if (sawInt && !sawDouble) {
+      m_ints.reserve(count);
+      for (int i = 0; i < count; i++) {
+        m_ints.push_back(opaque.by_key ?
+                         arr->getKey(positions[i]).toInt64() :
+                         arr->getValueRef(positions[i]).toInt64());
+      }
+      m_kind = Int;
+      return true;
+    }
+
+    m_dbls.reserve(count);
+    for (int i = 0; i < count; i++) {
+      double d = opaque.by_key ?
+        arr->getKey(positions[i]).toDouble() :
+        arr->getValueRef(positions[i]).toDouble();
+      if (std::isnan(d)) return false; // comparator is not a total order
+      m_dbls.push_back(d);
+    }
+    m_kind = Double;
+    return true;
+  }
+
+  // Three-way compare of the keys at i and j, honouring the direction.
+  int compare(int i, int j) const {
+    int r;
+    switch (m_kind) {
+    case Int:
+      r = m_ints[i] < m_ints[j] ? -1 : m_ints[i] != m_ints[j];
+      break;
+    case Double:
+      r = m_dbls[i] < m_dbls[j] ? -1 : m_dbls[i] != m_dbls[j];
+      break;
+    case Binary: {
+      const StringData *s1 = m_strs[i];
+      const StringData *s2 = m_strs[j];
+      int len1 = s1->size();
+      int len2 = s2->size();
+      r = memcmp(s1->data(), s2->data(), len1 < len2 ? len1 : len2);
+      if (!r) r = len1 < len2 ? -1 : len1 != len2;
+      break;
+    }
+    case CString:
+      r = strcmp(m_strs[i]->data(), m_strs[j]->data());
+      break;
+    default:
+      ASSERT(false);
+      r = 0;
+    }
+    return m_desc ? -r : r;
+  }
+
+  /*
+   * LSD radix sort of indices by int key, eight bits per pass.  Passes in
+   * which every key has the same byte are skipped, so small ranges of
+   * values only cost a couple of passes.
+   */
+  void radixSort(vector<int> &indices) const {
+    ASSERT(m_kind == Int);
+    int count = indices.size();
+    vector<uint64> keys(count);
+    vector<uint64> tmpKeys(count);
+    vector<int> tmp(count);
+    for (int i = 0; i < count; i++) {
+      // Flip the sign bit so signed order matches unsigned order, then
+      // invert everything for descending sorts.
+      uint64 k = (uint64)m_ints[indices[i]] ^ (1ULL << 63);
+      keys[i] = m_desc ? ~k : k;
+    }
+    for (int shift = 0; shift < 64; shift += 8) {
+      size_t counts[256];
+      memset(counts, 0, sizeof(counts));
+      for (int i = 0; i < count; i++) {
+        counts[(keys[i] >> shift) & 0xff]++;
+      }
+      if (counts[(keys[0] >> shift) & 0xff] == (size_t)count) continue;
+      size_t sum = 0;
+      for (int b = 0; b < 256; b++) {
+        size_t c = counts[b];
+        counts[b] = sum;
+        sum += c;
+      }
+      for (int i = 0; i < count; i++) {
+        size_t dst = counts[(keys[i] >> shift) & 0xff]++;
+        tmpKeys[dst] = keys[i];
+        tmp[dst] = indices[i];
+      }
+      keys.swap(tmpKeys);
+      indices.swap(tmp);
+    }
+  }
+
+private:
+  Kind m_kind;
+  bool m_desc;
+  vector<int64> m_ints;
+  vector<double> m_dbls;
+  vector<const StringData*> m_strs;
+};
+
+struct SortKeysLess {
+  explicit SortKeysLess(const SortKeys &keys) : m_keys(keys) {}
+  bool operator()(int i, int j) const {
+    int r = m_keys.compare(i, j);
+    return r < 0 || (r == 0 && i < j);
+  }
+  const SortKeys &m_keys;
+};
+
+struct MultiSortKeysLess {
+  explicit MultiSortKeysLess(const vector<SortKeys> &keys) : m_keys(keys) {}
+  bool operator()(int i, int j) const {
+    for (unsigned int k = 0; k < m_keys.size(); k++) {
+      int r = m_keys[k].compare(i, j);
+      if (r) return r < 0;
+    }
+    return i < j;
+  }
+  const vector<SortKeys> &m_keys;
+};
+
+// Below this, std::sort beats the fixed cost of eight counting passes.
+const int kRadixSortThreshold = 1024;
+
+}
+
+static bool specialized_sort(vector<int> &indices,
+                             const Array::SortData &opaque) {
+  SortKeys keys;
+  if (!keys.extract(opaque)) return false;
+  if (keys.kind() == SortKeys::Int &&
+      (int)indices.size() >= kRadixSortThreshold) {
+    keys.radixSort(indices);
+  } else {
+    std::sort(indices.begin(), indices.end(), SortKeysLess(keys));
+  }
+  return true;
+}
+
+static bool specialized_multi_sort(vector<int> &indices,
+                                   const vector<Array::SortData> &data) {
+  if (data.size() == 1) return specialized_sort(indices, data[0]);
+  vector<SortKeys> keys(data.size());
+  for (unsigned int k = 0; k < data.size(); k++) {
+    if (!keys[k].extract(data[k])) return false;
+  }
+  std::sort(indices.begin(), indices.end(), MultiSortKeysLess(keys));
+  return true;
+}
+
 void Array::SortImpl(vector<int> &indices, CArrRef source,
                      Array::SortData &opaque, Array::PFUNC_CMP cmp_func,
                      bool by_key, const void *data /* = NULL */) {
@@ -1099,6 +1345,7 @@ void Array::SortImpl(vector<int> &indices, CArrRef source,
        pos = source->iter_advance(pos)) {
     opaque.positions.push_back(pos);
   }
+  if (specialized_sort(indices, opaque)) return;
   zend_qsort(&indices[0], count, sizeof(int), array_compare_func, &opaque);
 }
 
@@ -1151,12 +1398,16 @@ bool Array::MultiSort(std::vector<SortData> &data, bool renumber) {
     return true;
   }
 
-  int *indices = (int *)malloc(sizeof(int) * count);
+  vector<int> indices;
+  indices.reserve(count);
   for (int i = 0; i < count; i++) {
-    indices[i] = i;
+    indices.push_back(i);
   }
 
-  zend_qsort(indices, count, sizeof(int), multi_compare_func, (void *)&data);
+  if (!specialized_multi_sort(indices, data)) {
+    zend_qsort(&indices[0], count, sizeof(int), multi_compare_func,
+               (void *)&data);
+  }
 
   for (unsigned int k = 0; k < data.size(); k++) {
     SortData &opaque = data[k];
@@ -1175,7 +1426,6 @@ bool Array::MultiSort(std::vector<SortData> &data, bool renumber) {
     *opaque.original = sorted;
   }
 
-  free(indices);
   return true;
 }
 
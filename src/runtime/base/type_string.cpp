@@ -711,14 +711,20 @@ void String::unserialize(VariableUnserializer *uns,
     throw Exception("Expected '%c' but got '%c'", delimiter0, ch);
   }
 
-  char *buf = (char*)malloc(size + 1);
-  uns->read(buf, size);
-  buf[size] = '\0';
-  if (m_px && m_px->decRefCount() == 0) {
-    m_px->release();
+  // Values are copied out of the payload once, straight into the buffer
+  // the StringData takes over. Pointing into the payload instead
+  // (AttachLiteral) isn't safe: nothing keeps the caller's serialized
+  // string alive as long as the values unserialized from it.
+  if (!uns->readKey(*this, size)) {
+    char *buf = (char*)malloc(size + 1);
+    uns->read(buf, size);
+    buf[size] = '\0';
+    if (m_px && m_px->decRefCount() == 0) {
+      m_px->release();
+    }
+    m_px = NEW(StringData)(buf, size, AttachString);
+    m_px->setRefCount(1);
   }
-  m_px = NEW(StringData)(buf, size, AttachString);
-  m_px->setRefCount(1);
 
   ch = uns->readChar();
   if (ch != delimiter1) {
@@ -22,6 +22,7 @@
 #include <util/mutex.h>
 #include <util/case_insensitive.h>
 #include <vector>
+#include <time.h>
 #include <runtime/base/macros.h>
 #include <runtime/base/memory/memory_manager.h>
 
@@ -232,15 +233,20 @@ namespace VM {
 ///////////////////////////////////////////////////////////////////////////////
 // code injection classes
 
+class TimeoutThread;
+
 class RequestInjectionData {
 public:
   static const ssize_t MemExceededFlag = 1;
   static const ssize_t TimedOutFlag = 2;
   static const ssize_t SignaledFlag = 4;
   static const ssize_t EventHookFlag = 8;
+  static const ssize_t SampleFlag = 16;
 
   RequestInjectionData()
-    : conditionFlags(0), surprisePage(NULL), started(0), timeoutSeconds(-1),
+    : conditionFlags(0), surprisePage(NULL), timeoutMs(0), deadline(0),
+      limitMs(0), cpuDeadline(0), cpuLimitMs(0), nextCheck(0),
+      cpuClock(CLOCK_THREAD_CPUTIME_ID), timeoutThread(NULL),
       debugger(false), debuggerIdle(0), dummySandbox(false),
       debuggerIntr(false), coverage(false) {
   }
@@ -252,8 +258,15 @@ public:
                                    // protect for error conditions
   Mutex surpriseLock;              // mutex controlling access to surprisePage
 
-  time_t started;      // when a request was started
-  int timeoutSeconds;  // how many seconds to timeout
+  // request deadlines, see TimeoutThread
+  int64 timeoutMs;              // wall time limit each request starts with
+  volatile int64 deadline;      // monotonic ms to time out at, 0 for none
+  int64 limitMs;                // what deadline was set from
+  volatile int64 cpuDeadline;   // thread CPU ms to time out at, 0 for none
+  int64 cpuLimitMs;             // what cpuDeadline was set from
+  volatile int64 nextCheck;     // when TimeoutThread looks at us, 0 for never
+  clockid_t cpuClock;           // this thread's CPU clock
+  TimeoutThread *timeoutThread; // who is watching us, if anyone
 
   bool debugger;       // whether there is a DebuggerProxy attached to me
   int  debuggerIdle;   // skipping this many interrupts while proxy is idle
@@ -269,6 +282,7 @@ public:
   void setSignaledFlag();
   void setEventHookFlag();
   void clearEventHookFlag();
+  void setSampleFlag();
   ssize_t fetchAndClearFlags();
 
   void onSessionInit();
@@ -24,6 +24,8 @@
 #include <runtime/base/file/file.h>
 #include <runtime/base/zend/zend_functions.h>
 #include <runtime/base/zend/utf8_decode.h>
+#include <runtime/base/zend/utf8_validate.h>
+#include <util/byte_scan.h>
 #include <runtime/base/taint/taint_observer.h>
 #include <runtime/ext/ext_json.h>
 
@@ -287,107 +289,182 @@ void StringBuffer::appendHelper(const char *s, int len) {
   (((us & 0xf) << 12)      | (((us >> 4) & 0xf) << 8) |   \
   (((us >> 8) & 0xf) << 4) | ((us >> 12) & 0xf))          \
 
+/**
+ * Bytes appendJsonEscape() has to look at one at a time for a given set of
+ * options: anything that may be escaped, plus control and non-ASCII bytes.
+ * The options that matter are folded into a 5-bit index.
+ */
+class JsonEscapeSets {
+public:
+  JsonEscapeSets() {
+    for (int i = 0; i < 32; i++) {
+      ByteSet &set = m_sets[i];
+      set.add('"').add('\\').addControl().addHigh();
+      if (!(i & 1)) set.add('/');
+      if (i & 2) set.add('<').add('>');
+      if (i & 4) set.add('&');
+      if (i & 8) set.add('\'');
+      if (i & 16) set.add('<').add('@').add('%');
+    }
+  }
+  const ByteSet &get(int options) const {
+    return m_sets[((options & k_JSON_UNESCAPED_SLASHES) ? 1 : 0) |
+                  ((options & k_JSON_HEX_TAG) ? 2 : 0) |
+                  ((options & k_JSON_HEX_AMP) ? 4 : 0) |
+                  ((options & k_JSON_HEX_APOS) ? 8 : 0) |
+                  ((options & k_JSON_FB_EXTRA_ESCAPES) ? 16 : 0)];
+  }
+private:
+  ByteSet m_sets[32];
+};
+
+static const JsonEscapeSets &json_escape_sets() {
+  static const JsonEscapeSets s_sets;
+  return s_sets;
+}
+
+static void append_json_char(StringBuffer &sb, unsigned short us,
+                             int options) {
+  static const char digits[] = "0123456789abcdef";
+
+  switch (us) {
+  case '"':
+    if (options & k_JSON_HEX_QUOT) {
+      sb.append("\\u0022", 6);
+    } else {
+      sb.append("\\\"", 2);
+    }
+    break;
+  case '\\': sb.append("\\\\", 2); break;
+  case '/':
+    if (options & k_JSON_UNESCAPED_SLASHES) {
+      sb.append('/');
+    } else {
+      sb.append("\\/", 2);
+    }
+    break;
+  case '\b': sb.append("\\b", 2);  break;
+  case '\f': sb.append("\\f", 2);  break;
+  case '\n': sb.append("\\n", 2);  break;
+  case '\r': sb.append("\\r", 2);  break;
+  case '\t': sb.append("\\t", 2);  break;
+  case '<':
+    if (options & k_JSON_HEX_TAG || options & k_JSON_FB_EXTRA_ESCAPES) {
+      sb.append("\\u003C", 6);
+    } else {
+      sb.append('<');
+    }
+    break;
+  case '>':
+    if (options & k_JSON_HEX_TAG) {
+      sb.append("\\u003E", 6);
+    } else {
+      sb.append('>');
+    }
+    break;
+  case '&':
+    if (options & k_JSON_HEX_AMP) {
+      sb.append("\\u0026", 6);
+    } else {
+      sb.append('&');
+    }
+    break;
+  case '\'':
+    if (options & k_JSON_HEX_APOS) {
+      sb.append("\\u0027", 6);
+    } else {
+      sb.append('\'');
+    }
+    break;
+  case '@':
+    if (options & k_JSON_FB_EXTRA_ESCAPES) {
+      sb.append("\\u0040", 6);
+    } else {
+      sb.append('@');
+    }
+    break;
+  case '%':
+   	if (options & k_JSON_FB_EXTRA_ESCAPES) {
+      sb.append("\\u0025", 6);
+   	} else {
+      sb.append('%');
+    }
+    break;
+  default:
+    if (us >= ' ' && (us & 127) == us) {
+      sb.append((char)us);
+    } else {
+      sb.append("\\u", 2);
+      us = REVERSE16(us);
+      sb.append(digits[us & ((1 << 4) - 1)]); us >>= 4;
+      sb.append(digits[us & ((1 << 4) - 1)]); us >>= 4;
+      sb.append(digits[us & ((1 << 4) - 1)]); us >>= 4;
+      sb.append(digits[us & ((1 << 4) - 1)]);
+    }
+    break;
+  }
+}
+
 void StringBuffer::appendJsonEscape(const char *s, int len, int options) {
   if (len == 0) {
     append("\"\"", 2);
-  } else {
-    static const char digits[] = "0123456789abcdef";
+    return;
+  }
 
-    int start = size();
-    append('"');
+  int start = size();
+  append('"');
+
+  const ByteSet &special = json_escape_sets().get(options);
+  const char *p = s;
+  const char *end = s + len;
+  const char *validEnd = s;
+  for (;;) {
+    // Plain ASCII that needs no escaping is copied in one go.
+    const char *next = byte_scan(p, end, special);
+    if (next > p) {
+      append(p, next - p);
+      p = next;
+    }
+    if (p == end) {
+      append('"');
+      break;
+    }
+    if (!(*p & 0x80)) {
+      append_json_char(*this, (unsigned char)*p, options);
+      p++;
+      continue;
+    }
 
-    UTF8To16Decoder decoder(s, len, options & k_JSON_FB_LOOSE);
-    for (;;) {
-      int c = decoder.decode();
-      if (c == UTF8_END) {
-        append('"');
-        break;
-      }
-      if (c == UTF8_ERROR) {
-        // discard the part that has been already decoded.
-        resize(start);
-        append("null", 4);
-        break;
-      }
-      ASSERT(c >= 0);
-      unsigned short us = (unsigned short)c;
-      switch (us) {
-      case '"':
-        if (options & k_JSON_HEX_QUOT) {
-          append("\\u0022", 6);
-        } else {
-          append("\\\"", 2);
-        }
-        break;
-      case '\\': append("\\\\", 2); break;
-      case '/':
-        if (options & k_JSON_UNESCAPED_SLASHES) {
-          append('/');
-        } else {
-          append("\\/", 2);
-        }
-        break;
-      case '\b': append("\\b", 2);  break;
-      case '\f': append("\\f", 2);  break;
-      case '\n': append("\\n", 2);  break;
-      case '\r': append("\\r", 2);  break;
-      case '\t': append("\\t", 2);  break;
-      case '<':
-        if (options & k_JSON_HEX_TAG || options & k_JSON_FB_EXTRA_ESCAPES) {
-          append("\\u003C", 6);
-        } else {
-          append('<');
-        }
-        break;
-      case '>':
-        if (options & k_JSON_HEX_TAG) {
-          append("\\u003E", 6);
-        } else {
-          append('>');
-        }
-        break;
-      case '&':
-        if (options & k_JSON_HEX_AMP) {
-          append("\\u0026", 6);
-        } else {
-          append('&');
-        }
-        break;
-      case '\'':
-        if (options & k_JSON_HEX_APOS) {
-          append("\\u0027", 6);
-        } else {
-          append('\'');
-        }
-        break;
-      case '@':
-        if (options & k_JSON_FB_EXTRA_ESCAPES) {
-          append("\\u0040", 6);
-        } else {
-          append('@');
-        }
-        break;
-      case '%':
-       	if (options & k_JSON_FB_EXTRA_ESCAPES) {
-          append("\\u0025", 6);
-       	} else {
-          append('%');
-        }
-        break;
-      default:
-        if (us >= ' ' && (us & 127) == us) {
-          append((char)us);
-        } else {
-          append("\\u", 2);
-          us = REVERSE16(us);
-          append(digits[us & ((1 << 4) - 1)]); us >>= 4;
-          append(digits[us & ((1 << 4) - 1)]); us >>= 4;
-          append(digits[us & ((1 << 4) - 1)]); us >>= 4;
-          append(digits[us & ((1 << 4) - 1)]);
-        }
-        break;
+    // Non-ASCII. Sequences before validEnd are known to be well-formed and
+    // are decoded directly; validation runs again only after an invalid
+    // sequence, which can only be skipped over in loose mode.
+    if (p >= validEnd) {
+      validEnd = p + utf8_validate(p, end - p);
+    }
+    if (p < validEnd) {
+      int c = utf8_decode_valid(p);
+      if (c >= 0x10000) {
+        c -= 0x10000;
+        append_json_char(*this, (unsigned short)(0xD800 | (c >> 10)), options);
+        append_json_char(*this, (unsigned short)(0xDC00 | (c & 0x3FF)),
+                         options);
+      } else {
+        append_json_char(*this, (unsigned short)c, options);
       }
+      continue;
+    }
+    if (!(options & k_JSON_FB_LOOSE)) {
+      // discard the part that has been already decoded.
+      resize(start);
+      append("null", 4);
+      break;
     }
+    // Let the decoder decide how many bytes the bad sequence covers.
+    UTF8To16Decoder decoder(p, end - p, true);
+    int c = decoder.decode();
+    ASSERT(c >= 0);
+    append_json_char(*this, (unsigned short)c, options);
+    p += decoder.consumed();
   }
 }
 
@@ -18,6 +18,7 @@
 #include <runtime/base/execution_context.h>
 #include <runtime/base/complex_types.h>
 #include <util/exception.h>
+#include <util/byte_scan.h>
 #include <runtime/base/zend/zend_printf.h>
 #include <runtime/base/zend/zend_functions.h>
 #include <runtime/base/zend/zend_string.h>
@@ -245,6 +246,12 @@ void VariableSerializer::write(double v) {
   }
 }
 
+// Bytes var_export() has to escape inside a single-quoted string.
+static const ByteSet &var_export_set() {
+  static const ByteSet s_set = ByteSet().add('\0').add('\'').add('\\');
+  return s_set;
+}
+
 void VariableSerializer::write(const char *v, int len /* = -1 */,
                                bool isArrayKey /* = false */) {
   switch (m_type) {
@@ -257,8 +264,16 @@ void VariableSerializer::write(const char *v, int len /* = -1 */,
   case VarExport: {
     if (len < 0) len = strlen(v);
     m_buf->append('\'');
+    const ByteSet &special = var_export_set();
     const char *p = v;
-    for (int i = 0; i < len; i++, p++) {
+    const char *end = v + len;
+    for (; p < end; p++) {
+      const char *next = byte_scan(p, end, special);
+      if (next > p) {
+        m_buf->append(p, next - p);
+        p = next;
+        if (p == end) break;
+      }
       const char c = *p;
       // adapted from Zend php_var_export and php_addcslashes
       if (c == '\0') {
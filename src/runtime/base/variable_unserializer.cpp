@@ -17,6 +17,7 @@
 #include <runtime/base/variable_unserializer.h>
 #include <runtime/base/complex_types.h>
 #include <runtime/base/zend/zend_strtod.h>
+#include <util/hash.h>
 
 
 namespace HPHP {
@@ -36,16 +37,92 @@ Variant VariableUnserializer::unserializeKey() {
   return v;
 }
 
+static inline bool is_digit(char c) {
+  return (unsigned char)(c - '0') <= 9;
+}
+
 int64 VariableUnserializer::readInt() {
   check();
+
+  // serialize() writes an optional '-' and the digits; anything else, or a
+  // number long enough to overflow, goes to strtoll() as before.
+  const char *p = m_buf;
+  bool neg = (*p == '-');
+  if (neg) p++;
+  const char *digits = p;
+  uint64 r = 0;
+  while (p < m_end && p - digits < 18 && is_digit(*p)) {
+    r = r * 10 + (*p++ - '0');
+  }
+  if (p > digits && (p == m_end || !is_digit(*p))) {
+    m_buf = p;
+    return neg ? -(int64)r : (int64)r;
+  }
+
   char *newBuf;
-  int64 r = strtoll(m_buf, &newBuf, 10);
+  int64 v = strtoll(m_buf, &newBuf, 10);
   m_buf = newBuf;
-  return r;
+  return v;
 }
 
+/*
+ * Powers of ten that are exact in a double. A decimal with at most 15
+ * significant digits is then converted with one correctly rounded multiply
+ * or divide (Clinger's fast path), which covers everything serialize()
+ * writes at its precision of 14.
+ */
+static const double s_exactPowersOf10[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const int MaxExactPowerOf10 = 22;
+static const int MaxFastDigits = 15;
+
 double VariableUnserializer::readDouble() {
   check();
+
+  const char *p = m_buf;
+  bool neg = (*p == '-');
+  if (neg) p++;
+  uint64 mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool ok = true;
+  for (; p < m_end && is_digit(*p); p++) {
+    if (++digits > MaxFastDigits) ok = false;
+    mantissa = mantissa * 10 + (*p - '0');
+  }
+  if (p < m_end && *p == '.') {
+    for (p++; p < m_end && is_digit(*p); p++) {
+      if (++digits > MaxFastDigits) ok = false;
+      mantissa = mantissa * 10 + (*p - '0');
+      exponent--;
+    }
+  }
+  if (p < m_end && (*p == 'E' || *p == 'e')) {
+    p++;
+    bool negExp = false;
+    if (p < m_end && (*p == '+' || *p == '-')) negExp = (*p++ == '-');
+    int e = 0;
+    const char *start = p;
+    for (; p < m_end && is_digit(*p) && p - start < 4; p++) {
+      e = e * 10 + (*p - '0');
+    }
+    if (p == start) ok = false;
+    exponent += negExp ? -e : e;
+  }
+  if (ok && digits && p < m_end && *p == ';' &&
+      exponent >= -MaxExactPowerOf10 && exponent <= MaxExactPowerOf10) {
+    double r = (double)mantissa;
+    if (exponent < 0) {
+      r /= s_exactPowersOf10[-exponent];
+    } else {
+      r *= s_exactPowersOf10[exponent];
+    }
+    m_buf = p;
+    return neg ? -r : r;
+  }
+
   char *newBuf;
   double r = zend_strtod(m_buf, &newBuf);
   m_buf = newBuf;
@@ -65,6 +142,27 @@ void VariableUnserializer::read(char *buf, uint n) {
   m_buf += BUFFER_LIMIT;
 }
 
+bool VariableUnserializer::readKey(String &s, int64 size) {
+  if (!m_key || size > MaxKeyLength || (int64)remaining() < size) {
+    return false;
+  }
+  if (!m_keyCache) m_keyCache = new KeyCache();
+  int64 h = hash_string(m_buf, size);
+  int slot = h & (KeyCacheSize - 1);
+  String &key = m_keyCache->keys[slot];
+  if (m_keyCache->hashes[slot] != h || key.isNull() || key.size() != size ||
+      memcmp(key.data(), m_buf, size)) {
+    key = String(m_buf, size, CopyString);
+    if (StringData *sd = StringData::LookupStaticString(key.get())) {
+      key = sd;
+    }
+    m_keyCache->hashes[slot] = h;
+  }
+  s = key;
+  m_buf += size;
+  return true;
+}
+
 Variant &VariableUnserializer::addVar() {
   m_vars.push_back(null);
   return m_vars.back();
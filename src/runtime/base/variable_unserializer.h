@@ -18,6 +18,7 @@
 #define __HPHP_VARIABLE_UNSERIALIZER_H__
 
 #include <runtime/base/types.h>
+#include <runtime/base/type_string.h>
 
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
@@ -36,11 +37,18 @@ public:
   VariableUnserializer(const char *str, size_t len, Type type,
                        bool allowUnknownSerializableClass = false)
       : m_type(type), m_buf(str), m_end(str + len), m_key(false),
-        m_unknownSerializable(allowUnknownSerializableClass) {}
+        m_unknownSerializable(allowUnknownSerializableClass),
+        m_keyCache(NULL) {
+  }
   VariableUnserializer(const char *str, const char *end, Type type,
                        bool allowUnknownSerializableClass = false)
       : m_type(type), m_buf(str), m_end(end), m_key(false),
-        m_unknownSerializable(allowUnknownSerializableClass) {}
+        m_unknownSerializable(allowUnknownSerializableClass),
+        m_keyCache(NULL) {
+  }
+  ~VariableUnserializer() {
+    delete m_keyCache;
+  }
 
   Type getType() const { return m_type;}
   bool allowUnknownSerializableClass() const { return m_unknownSerializable;}
@@ -63,11 +71,19 @@ public:
     return *(m_buf++);
   }
   void read(char *buf, uint n);
+  /**
+   * While reading an array key or property name, reads the next size bytes
+   * into s and returns true. Short keys are shared within one payload,
+   * since a list of records repeats the same field names in every record.
+   * Returns false without consuming anything when not reading a key.
+   */
+  bool readKey(String &s, int64 size);
   char peek() {
     check();
     return *m_buf;
   }
   const char *head() { return m_buf; }
+  size_t remaining() const { return m_end - m_buf; }
   Variant &addVar();
 
  private:
@@ -79,6 +95,15 @@ public:
   bool m_key;
   bool m_unknownSerializable;
 
+  static const int KeyCacheSize = 32;
+  static const int MaxKeyLength = 32;
+  struct KeyCache {
+    KeyCache() { memset(hashes, 0, sizeof(hashes)); }
+    int64 hashes[KeyCacheSize];
+    String keys[KeyCacheSize];
+  };
+  KeyCache *m_keyCache; // allocated by the first readKey()
+
   void check() {
     if (m_buf >= m_end) {
       throw Exception("Unexpected end of buffer during unserialization");
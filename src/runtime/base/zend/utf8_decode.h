@@ -37,6 +37,8 @@ class UTF8To16Decoder {
 public:
   UTF8To16Decoder(const char *utf8, int length, bool loose);
   int decode();
+  // Input bytes consumed so far.
+  int consumed() const { return m_decode.the_index; }
 
 private:
   json_utf8_decode m_decode;
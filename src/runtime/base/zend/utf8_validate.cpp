@@ -0,0 +1,94 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include <runtime/base/zend/utf8_validate.h>
+#include <util/byte_scan.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+static const ByteSet &non_ascii_set(bool allowNul) {
+  static const ByteSet s_nonAscii = ByteSet().addHigh();
+  static const ByteSet s_nonAsciiOrNul = ByteSet().addHigh().add('\0');
+  return allowNul ? s_nonAscii : s_nonAsciiOrNul;
+}
+
+/*
+ * Length of the well-formed multi-byte sequence starting at p, or 0 if it
+ * is not one. Second-byte ranges follow the Unicode "well-formed UTF-8 byte
+ * sequences" table; that is what rules out overlongs (C0, C1, E0 80-9F,
+ * F0 80-8F), surrogates (ED A0-BF) and values past U+10FFFF (F4 90-BF,
+ * F5-FF).
+ */
+static inline int sequence_length(const unsigned char *p,
+                                  const unsigned char *end) {
+  unsigned char c = p[0];
+  int n;
+  unsigned char lo = 0x80, hi = 0xBF;
+  if (c < 0xC2) {
+    return 0;
+  } else if (c < 0xE0) {
+    n = 2;
+  } else if (c < 0xF0) {
+    n = 3;
+    if (c == 0xE0) lo = 0xA0;
+    else if (c == 0xED) hi = 0x9F;
+  } else if (c < 0xF5) {
+    n = 4;
+    if (c == 0xF0) lo = 0x90;
+    else if (c == 0xF4) hi = 0x8F;
+  } else {
+    return 0;
+  }
+  if (end - p < n) return 0;
+  if (p[1] < lo || p[1] > hi) return 0;
+  for (int i = 2; i < n; i++) {
+    if ((p[i] & 0xC0) != 0x80) return 0;
+  }
+  return n;
+}
+
+int utf8_validate(const char *s, int len, int *count /* = NULL */,
+                  bool allowNul /* = true */) {
+  const ByteSet &special = non_ascii_set(allowNul);
+  const unsigned char *p = (const unsigned char *)s;
+  const unsigned char *end = p + len;
+  int n = 0;
+
+  while (p < end) {
+    const unsigned char *q = (const unsigned char *)
+      byte_scan((const char *)p, (const char *)end, special);
+    n += q - p;
+    p = q;
+
+    // Multi-byte text tends to come in runs; stay here until the next
+    // ASCII byte rather than going back through byte_scan() per character.
+    while (p < end && *p >= 0x80) {
+      int l = sequence_length(p, end);
+      if (!l) goto done;
+      p += l;
+      n++;
+    }
+    if (p < end && !*p && !allowNul) break;
+  }
+
+done:
+  if (count) *count = n;
+  return (const char *)p - s;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
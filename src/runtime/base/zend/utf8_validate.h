@@ -0,0 +1,67 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef __HPHP_ZEND_UTF8_VALIDATE_H__
+#define __HPHP_ZEND_UTF8_VALIDATE_H__
+
+#include <stddef.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Returns the offset of the first byte in s[0, len) that does not start a
+ * well-formed UTF-8 sequence, or len if the whole string is well-formed.
+ * Well-formed follows RFC 3629, the same rules as utf8_decode.cpp and ICU's
+ * U8_NEXT: no overlong forms, no surrogates, nothing above U+10FFFF.
+ *
+ * If count is not NULL it receives the number of code points before the
+ * returned offset. If allowNul is false a NUL byte is treated as invalid.
+ *
+ * ASCII runs are skipped 16 or 32 bytes at a time with byte_scan(); only
+ * multi-byte sequences are looked at one by one.
+ */
+int utf8_validate(const char *s, int len, int *count = NULL,
+                  bool allowNul = true);
+
+/**
+ * Decodes the sequence at p, which must be known to be well-formed (i.e. be
+ * before the offset utf8_validate() returned), and advances p past it.
+ */
+inline int utf8_decode_valid(const char *&p) {
+  const unsigned char *u = (const unsigned char *)p;
+  int c = u[0];
+  if (c < 0x80) {
+    p += 1;
+    return c;
+  }
+  if (c < 0xE0) {
+    p += 2;
+    return ((c & 0x1F) << 6) | (u[1] & 0x3F);
+  }
+  if (c < 0xF0) {
+    p += 3;
+    return ((c & 0x0F) << 12) | ((u[1] & 0x3F) << 6) | (u[2] & 0x3F);
+  }
+  p += 4;
+  return ((c & 0x07) << 18) | ((u[1] & 0x3F) << 12) |
+    ((u[2] & 0x3F) << 6) | (u[3] & 0x3F);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif // __HPHP_ZEND_UTF8_VALIDATE_H__
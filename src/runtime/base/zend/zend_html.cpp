@@ -18,6 +18,7 @@
 #include <runtime/base/zend/zend_html.h>
 #include <runtime/base/complex_types.h>
 #include <util/lock.h>
+#include <util/byte_scan.h>
 #include <unicode/uchar.h>
 #include <unicode/utf8.h>
 
@@ -498,6 +499,34 @@ static void init_entity_table() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/**
+ * Bytes string_html_encode() may have to rewrite, for each combination of
+ * its flags. Everything else is copied through untouched.
+ */
+class HtmlEncodeSets {
+public:
+  HtmlEncodeSets() {
+    for (int i = 0; i < 16; i++) {
+      ByteSet &set = m_sets[i];
+      set.add('<').add('>').add('&');
+      if (i & 1) set.add('"');
+      if (i & 2) set.add('\'');
+      if (i & 8) set.add((i & 4) ? '\xc2' : '\xa0');
+    }
+  }
+  const ByteSet &get(bool dq, bool sq, bool utf8, bool nbsp) const {
+    return m_sets[(dq ? 1 : 0) | (sq ? 2 : 0) | (utf8 ? 4 : 0) |
+                  (nbsp ? 8 : 0)];
+  }
+private:
+  ByteSet m_sets[16];
+};
+
+static const HtmlEncodeSets &html_encode_sets() {
+  static const HtmlEncodeSets s_sets;
+  return s_sets;
+}
+
 char *string_html_encode(const char *input, int &len, bool encode_double_quote,
                          bool encode_single_quote, bool utf8, bool nbsp) {
   ASSERT(input);
@@ -519,8 +548,18 @@ char *string_html_encode(const char *input, int &len, bool encode_double_quote,
   if (!ret) {
     return NULL;
   }
+  const ByteSet &special = html_encode_sets().get(encode_double_quote,
+                                                  encode_single_quote,
+                                                  utf8, nbsp);
   char *q = ret;
   for (const char *p = input, *end = input + len; p < end; p++) {
+    // Copy the run of bytes that need no encoding in one go.
+    const char *next = byte_scan(p, end, special);
+    memcpy(q, p, next - p);
+    q += next - p;
+    p = next;
+    if (p == end) break;
+
     char c = *p;
     switch (c) {
     case '"':
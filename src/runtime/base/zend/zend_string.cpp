@@ -20,6 +20,7 @@
 #include <runtime/base/zend/zend_math.h>
 
 #include <util/lock.h>
+#include <util/byte_scan.h>
 #include <math.h>
 #include <monetary.h>
 
@@ -1302,6 +1303,12 @@ char *string_stripcslashes(const char *input, int &nlen) {
   return str;
 }
 
+static const ByteSet &addslashes_set() {
+  static const ByteSet s_set =
+    ByteSet().add('\0').add('\'').add('"').add('\\');
+  return s_set;
+}
+
 char *string_addslashes(const char *str, int &length) {
   ASSERT(str);
   if (length == 0) {
@@ -1312,8 +1319,15 @@ char *string_addslashes(const char *str, int &length) {
   const char *source = str;
   const char *end = source + length;
   char *target = new_str;
+  const ByteSet &special = addslashes_set();
 
   while (source < end) {
+    const char *next = byte_scan(source, end, special);
+    memcpy(target, source, next - source);
+    target += next - source;
+    source = next;
+    if (source == end) break;
+
     switch (*source) {
     case '\0':
       *target++ = '\\';
@@ -36,6 +36,7 @@
 #include <runtime/vm/peephole.h>
 #include <runtime/vm/pendq.h>
 #include <runtime/vm/repo.h>
+#include <runtime/vm/repo_image.h>
 #include <runtime/vm/runtime.h>
 
 using std::endl;
@@ -153,7 +154,7 @@ bool FileRepository::fileDump(const char *filename) {
     out << it->first->data() << endl;
   }
   {
-    ReadLock lock(s_md5Lock);
+    WriteLock lock(s_md5Lock);
     out << "s_md5Files: " << s_md5Files.size() << endl;
     for (Md5FileMap::const_iterator it = s_md5Files.begin();
          it != s_md5Files.end(); it++) {
@@ -168,8 +169,11 @@ bool FileRepository::fileDump(const char *filename) {
 void FileRepository::onDelete(PhpFile *f) {
   ASSERT(f->getRef() == 0);
   if (md5Enabled()) {
-    WriteLock lock(s_md5Lock);
-    s_md5Files.erase(f->getMd5());
+    ReadLock lock(s_md5Lock);
+    Md5FileMap::accessor acc;
+    if (s_md5Files.find(acc, f->getMd5()) && acc->second == f) {
+      s_md5Files.erase(acc);
+    }
   }
   delete f;
 }
@@ -215,8 +219,8 @@ PhpFile *FileRepository::checkoutFile(StringData *rname,
     if (isChanged && ret == acc->second->getPhpFile()) {
       // The file changed but had the same contents.
       if (debug && md5Enabled()) {
-        ReadLock lock(s_md5Lock);
-        ASSERT(s_md5Files.find(ret->getMd5())->second == ret);
+        Md5FileMap::const_accessor acc;
+        ASSERT(s_md5Files.find(acc, ret->getMd5()) && acc->second == ret);
       }
       ret->incRef();
       return ret;
@@ -267,23 +271,36 @@ PhpFile *FileRepository::checkoutFile(StringData *rname,
   }
 
   if (md5Enabled()) {
-    WriteLock lock(s_md5Lock);
+    ReadLock lock(s_md5Lock);
     // make sure intercepts are enabled for the functions within the
     // new units
-    // Since we have the write lock on s_md5lock, s_interceptsEnabled
-    // can't change, and we are serialized wrt enableIntercepts
-    // (i.e., this will execute either before or after
-    // enableIntercepts).
+    // Since we have s_md5lock shared, s_interceptsEnabled can't change,
+    // and we are serialized wrt enableIntercepts (i.e., this will execute
+    // either before or after enableIntercepts).
     if (interceptsEnabled != s_interceptsEnabled) {
       // intercepts were enabled since the time we created the unit
       ret->unit()->enableIntercepts();
     }
-    s_md5Files[ret->getMd5()] = ret;
+    Md5FileMap::accessor acc;
+    s_md5Files.insert(acc, ret->getMd5());
+    acc->second = ret;
   }
   ret->incRef();
   return ret;
 }
 
+/*
+ * When a repo image is mapped it is authoritative: lookups never fall
+ * through to (or even open) the SQLite repo.
+ */
+static bool findRepoFile(const char* path, MD5& md5) {
+  const std::string& root = SourceRootInfo::GetCurrentSourceRoot();
+  if (const VM::RepoImage* image = VM::RepoImage::Get()) {
+    return image->findFile(path, root, md5);
+  }
+  return VM::Repo::get().findFile(path, root, md5);
+}
+
 bool FileRepository::findFile(const StringData *path, struct stat *s) {
   if (isAuthoritativeRepo()) {
     {
@@ -296,8 +313,7 @@ bool FileRepository::findFile(const StringData *path, struct stat *s) {
     const StringData* spath = StringData::GetStaticString(path);
     UnitMd5Map::accessor acc;
     if (s_unitMd5Map.insert(acc, spath)) {
-      bool present = VM::Repo::get().findFile(
-        path->data(), SourceRootInfo::GetCurrentSourceRoot(), md5);
+      bool present = findRepoFile(path->data(), md5);
       acc->second.m_present = present;
       acc->second.m_unitMd5 = md5;
     }
@@ -366,10 +382,9 @@ void FileRepository::setFileInfo(const StringData *name,
     }
   }
 
-  ReadLock lock(s_md5Lock);
-  Md5FileMap::iterator it = s_md5Files.find(fileInfo.m_md5);
-  if (it != s_md5Files.end()) {
-    PhpFile *f = it->second;
+  Md5FileMap::const_accessor acc;
+  if (s_md5Files.find(acc, fileInfo.m_md5)) {
+    PhpFile *f = acc->second;
     if (!fileInfo.m_relPath.empty() &&
         fileInfo.m_relPath == f->getRelPath()) {
       ASSERT(fileInfo.m_md5 == f->getMd5());
@@ -422,9 +437,7 @@ bool FileRepository::readRepoMd5(const StringData *path,
     UnitMd5Map::accessor acc;
     path = StringData::GetStaticString(path);
     if (s_unitMd5Map.insert(acc, path)) {
-      if (!VM::Repo::get().findFile(path->data(),
-                                    SourceRootInfo::GetCurrentSourceRoot(),
-                                    md5)) {
+      if (!findRepoFile(path->data(), md5)) {
         acc->second.m_present = false;
         return false;
       }
@@ -458,7 +471,9 @@ PhpFile *FileRepository::readHhbc(const std::string &name,
   const_assert(hhvm);
 
   MD5 md5 = MD5(fileInfo.m_unitMd5.c_str());
-  VM::Unit* u = VM::Repo::get().loadUnit(name, md5);
+  const VM::RepoImage* image = VM::RepoImage::Get();
+  VM::Unit* u = image ? image->loadUnit(name, md5)
+                      : VM::Repo::get().loadUnit(name, md5);
   if (u != NULL) {
     PhpFile *p = new PhpFile(name, fileInfo.m_srcRoot, fileInfo.m_relPath,
                              fileInfo.m_md5, u);
@@ -509,11 +524,11 @@ bool FileRepository::fileStat(const string &name, struct stat *s) {
 }
 
 void FileRepository::enableIntercepts() {
-  ReadLock lock(s_md5Lock);
+  WriteLock lock(s_md5Lock);
   s_interceptsEnabled = true; // write protected by s_mutex in intercept
 
-  for (hphp_hash_map<string, PhpFile*, string_hash>::const_iterator it =
-       s_md5Files.begin(); it != s_md5Files.end(); it++) {
+  for (Md5FileMap::const_iterator it = s_md5Files.begin();
+       it != s_md5Files.end(); it++) {
     it->second->unit()->enableIntercepts();
   }
 }
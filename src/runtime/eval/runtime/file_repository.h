@@ -129,7 +129,8 @@ typedef tbb::concurrent_hash_map<const StringData *, struct UnitMd5Val,
                                  StringDataHashCompare> UnitMd5Map;
 typedef RankedCHM<const StringData*, HPHP::Eval::PhpFileWrapper*,
                   StringDataHashCompare, RankFileRepo> ParsedFilesMap;
-typedef hphp_hash_map<std::string, PhpFile*, string_hash> Md5FileMap;
+typedef tbb::concurrent_hash_map<std::string, PhpFile*,
+                                 stringHashCompare> Md5FileMap;
 
 /**
  * FileRepository is global.
@@ -170,6 +171,8 @@ public:
 private:
   static ParsedFilesMap s_files;
   static UnitMd5Map s_unitMd5Map;
+  // Lookups in s_md5Files take no lock. Changes to it take this shared,
+  // and only walking it takes it exclusively.
   static ReadWriteMutex s_md5Lock;
   static Md5FileMap s_md5Files;
 
@@ -33,9 +33,15 @@ SOFTWARE.
 #include <runtime/base/type_conversions.h>
 #include <runtime/base/builtin_functions.h>
 #include <runtime/base/zend/utf8_decode.h>
+#include <runtime/base/zend/utf8_validate.h>
+#include <runtime/base/array/array_init.h>
+#include <util/byte_scan.h>
+#include <util/hash.h>
 
 #include <system/lib/systemlib.h>
 
+#include <limits.h>
+
 #define MAX_LENGTH_OF_LONG 20
 static const char long_min_digits[] = "9223372036854775808";
 
@@ -355,6 +361,34 @@ static int dehexchar(char c) {
   return -1;
 }
 
+/**
+ * p must be NUL-terminated and hold len bytes of a JSON number. Integers
+ * that do not fit in an int64 come back as doubles, like PHP's.
+ */
+static void json_create_number(Variant &z, const char *p, int len,
+                               bool isDouble) {
+  if (isDouble) {
+    z = strtod(p, NULL);
+    return;
+  }
+
+  bool neg = (*p == '-');
+  if (neg) len--;
+  if (len >= MAX_LENGTH_OF_LONG - 1) {
+    if (len == MAX_LENGTH_OF_LONG - 1) {
+      int cmp = strcmp(p + (neg ? 1 : 0), long_min_digits);
+      if (!(cmp < 0 || (cmp == 0 && neg))) {
+        z = strtod(p, NULL);
+        return;
+      }
+    } else {
+      z = strtod(p, NULL);
+      return;
+    }
+  }
+  z = strtoll(p, NULL, 10);
+}
+
 static void json_create_zval(Variant &z, StringBuffer &buf, int type) {
   switch (type) {
   case KindOfInt64:
@@ -365,24 +399,7 @@ static void json_create_zval(Variant &z, StringBuffer &buf, int type) {
         z = 0LL;
         return;
       }
-
-      bool neg = (buf.charAt(0) == '-');
-
-      int len = buf.size();
-      if (neg) len--;
-      if (len >= MAX_LENGTH_OF_LONG - 1) {
-        if (len == MAX_LENGTH_OF_LONG - 1) {
-          int cmp = strcmp(p + (neg ? 1 : 0), long_min_digits);
-          if (!(cmp < 0 || (cmp == 0 && neg))) {
-            z = strtod(p, NULL);
-            return;
-          }
-        } else {
-          z = strtod(p, NULL);
-          return;
-        }
-      }
-      z = strtoll(buf.data(), NULL, 10);
+      json_create_number(z, p, buf.size(), false);
     }
     break;
   case KindOfDouble:
@@ -473,6 +490,383 @@ static void attach_zval(json_parser *json, int up, int cur, StringBuffer &key,
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// fast path
+
+/*
+ * Strict-mode documents whose top level is an object or array are first
+ * tried with a two-pass decoder instead of the PDA below:
+ *
+ *  1. json_index() runs over the text with byte_scan() (32 bytes at a time
+ *     on AVX2 machines) stopping only at { } [ ] , and quotes. It records
+ *     where each string ends and how many elements each container has.
+ *  2. JsonBuilder then walks the text once more and builds the value, with
+ *     every array sized exactly from the index and object keys shared
+ *     through a small per-document cache (and the static string table, for
+ *     keys the program itself uses as literals).
+ *
+ * The fast path only ever accepts a subset of what the PDA accepts and
+ * builds the same value for it; on anything it does not like, including
+ * every syntax error, it gives up and JSON_parser() runs the PDA, so error
+ * behavior is unchanged.
+ */
+
+static const ByteSet &json_structural_set() {
+  static const ByteSet s_set =
+    ByteSet().add('{').add('}').add('[').add(']').add(',').add('"');
+  return s_set;
+}
+
+static const ByteSet &json_string_special_set() {
+  static const ByteSet s_set = ByteSet().add('"').add('\\').addControl();
+  return s_set;
+}
+
+static StaticString s__empty_("_empty_");
+
+static inline bool json_is_space(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static inline const char *json_skip_space(const char *p, const char *end) {
+  while (p < end && json_is_space(*p)) p++;
+  return p;
+}
+
+struct JsonIndex {
+  std::vector<int> counts;  // elements in each container, in opening order
+  std::vector<int> strings; // (closing quote offset << 1) | has escapes
+};
+
+static bool json_index(JsonIndex &index, const char *begin, const char *end) {
+  const ByteSet &structural = json_structural_set();
+  const ByteSet &stringSpecial = json_string_special_set();
+  std::vector<int> open;
+  const char *p = begin;
+  for (;;) {
+    p = byte_scan(p, end, structural);
+    if (p == end) break;
+    switch (*p) {
+    case '"':
+      {
+        const char *q = p + 1;
+        int escaped = 0;
+        for (;;) {
+          q = byte_scan(q, end, stringSpecial);
+          if (q == end) return false;
+          if (*q == '"') break;
+          if (*q != '\\' || end - q < 2) return false; // raw control byte
+          escaped = 1;
+          q += 2;
+        }
+        index.strings.push_back(((q - begin) << 1) | escaped);
+        p = q + 1;
+      }
+      break;
+    case '{':
+    case '[':
+      {
+        // The PDA's stack has the MODE_DONE entry at the bottom.
+        if ((int)open.size() >= JSON_PARSER_MAX_DEPTH - 1) return false;
+        const char *q = json_skip_space(p + 1, end);
+        char close = (*p == '{') ? '}' : ']';
+        open.push_back(index.counts.size());
+        index.counts.push_back(q < end && *q != close ? 1 : 0);
+        p++;
+      }
+      break;
+    case '}':
+    case ']':
+      if (open.empty()) return false;
+      open.pop_back();
+      p++;
+      break;
+    case ',':
+      if (open.empty()) return false;
+      index.counts[open.back()]++;
+      p++;
+      break;
+    }
+  }
+  return open.empty();
+}
+
+class JsonBuilder {
+public:
+  JsonBuilder(const JsonIndex &index, const char *begin, const char *end,
+              bool assoc)
+    : m_index(index), m_begin(begin), m_end(end), m_p(begin),
+      m_assoc(assoc), m_nextCount(0), m_nextString(0) {
+    memset(m_keyHashes, 0, sizeof(m_keyHashes));
+  }
+
+  bool parseDocument(Variant &z) {
+    m_p = json_skip_space(m_p, m_end);
+    if (m_p == m_end || (*m_p != '{' && *m_p != '[')) return false;
+    if (!parseValue(z)) return false;
+    return json_skip_space(m_p, m_end) == m_end;
+  }
+
+private:
+  static const int KeyCacheSize = 64;
+  static const int MaxInternLength = 64;
+
+  const JsonIndex &m_index;
+  const char *m_begin;
+  const char *m_end;
+  const char *m_p;
+  bool m_assoc;
+  unsigned m_nextCount;
+  unsigned m_nextString;
+  int64 m_keyHashes[KeyCacheSize];
+  String m_keys[KeyCacheSize];
+
+  bool parseValue(Variant &out) {
+    if (m_p == m_end) return false;
+    switch (*m_p) {
+    case '{': return parseObject(out);
+    case '[': return parseArray(out);
+    case '"':
+      {
+        String s;
+        if (!parseString(s, false)) return false;
+        out = s;
+        return true;
+      }
+    case 't':
+      if (!parseLiteral("true", 4)) return false;
+      out = true;
+      return true;
+    case 'f':
+      if (!parseLiteral("false", 5)) return false;
+      out = false;
+      return true;
+    case 'n':
+      if (!parseLiteral("null", 4)) return false;
+      out = null;
+      return true;
+    default:
+      return parseNumber(out);
+    }
+  }
+
+  bool nextCount(int &n) {
+    if (m_nextCount >= m_index.counts.size()) return false;
+    n = m_index.counts[m_nextCount++];
+    return true;
+  }
+
+  bool parseArray(Variant &out) {
+    int n;
+    if (!nextCount(n)) return false;
+    ArrayInit arr(n);
+    m_p = json_skip_space(m_p + 1, m_end);
+    if (m_p < m_end && *m_p == ']') {
+      m_p++;
+      out = Array(arr.create());
+      return true;
+    }
+    if (!n) return false;
+    for (;;) {
+      Variant v;
+      if (!parseValue(v)) return false;
+      arr.set(v);
+      m_p = json_skip_space(m_p, m_end);
+      if (m_p == m_end) return false;
+      if (*m_p == ']') break;
+      if (*m_p != ',') return false;
+      m_p = json_skip_space(m_p + 1, m_end);
+    }
+    m_p++;
+    out = Array(arr.create());
+    return true;
+  }
+
+  bool parseObject(Variant &out) {
+    int n;
+    if (!nextCount(n)) return false;
+    ArrayInit arr(m_assoc ? n : 0);
+    Object obj;
+    if (!m_assoc) obj = SystemLib::AllocStdClassObject();
+    m_p = json_skip_space(m_p + 1, m_end);
+    if (m_p < m_end && *m_p == '}') {
+      m_p++;
+    } else {
+      if (!n) return false;
+      for (;;) {
+        if (m_p == m_end || *m_p != '"') return false;
+        String key;
+        if (!parseString(key, true)) return false;
+        m_p = json_skip_space(m_p, m_end);
+        if (m_p == m_end || *m_p != ':') return false;
+        m_p = json_skip_space(m_p + 1, m_end);
+        Variant v;
+        if (!parseValue(v)) return false;
+        if (m_assoc) {
+          arr.set(key, v);
+        } else if (key.empty()) {
+          obj->o_setPublic(s__empty_, v);
+        } else {
+          // We know it is stdClass, and everything is public (and dynamic).
+          obj->o_setPublic(key, v);
+        }
+        m_p = json_skip_space(m_p, m_end);
+        if (m_p == m_end) return false;
+        if (*m_p == '}') break;
+        if (*m_p != ',') return false;
+        m_p = json_skip_space(m_p + 1, m_end);
+      }
+      m_p++;
+    }
+    if (m_assoc) {
+      out = Array(arr.create());
+    } else {
+      out = obj;
+    }
+    return true;
+  }
+
+  bool parseString(String &out, bool isKey) {
+    if (m_nextString >= m_index.strings.size()) return false;
+    int info = m_index.strings[m_nextString++];
+    const char *s = m_p + 1;
+    const char *e = m_begin + (info >> 1);
+    if (e < s) return false;
+    m_p = e + 1;
+    if (!(info & 1)) {
+      if (isKey && e - s <= MaxInternLength) {
+        out = internKey(s, e - s);
+      } else {
+        out = String(s, e - s, CopyString);
+      }
+      return true;
+    }
+
+    StringBuffer buf(e - s);
+    while (s < e) {
+      const char *b = (const char *)memchr(s, '\\', e - s);
+      if (!b) b = e;
+      buf.append(s, b - s);
+      if (b == e) break;
+      s = b + 2;
+      switch (b[1]) {
+      case '"':  buf.append('"');  break;
+      case '\\': buf.append('\\'); break;
+      case '/':  buf.append('/');  break;
+      case 'b':  buf.append('\b'); break;
+      case 'f':  buf.append('\f'); break;
+      case 'n':  buf.append('\n'); break;
+      case 'r':  buf.append('\r'); break;
+      case 't':  buf.append('\t'); break;
+      case 'u':
+        {
+          if (e - s < 4) return false;
+          int utf16 = 0;
+          for (int i = 0; i < 4; i++) {
+            int h = dehexchar(s[i]);
+            if (h < 0) return false;
+            utf16 = (utf16 << 4) | h;
+          }
+          utf16_to_utf8(buf, utf16);
+          s += 4;
+        }
+        break;
+      default:
+        return false;
+      }
+    }
+    out = buf.detach();
+    return true;
+  }
+
+  /**
+   * Documents are mostly lists of records with the same field names, so a
+   * key is usually one seen a few objects ago. Handing out the same String
+   * each time saves the allocation and lets arrays reuse the cached hash.
+   */
+  String internKey(const char *s, int len) {
+    int64 h = hash_string(s, len);
+    int slot = h & (KeyCacheSize - 1);
+    String &key = m_keys[slot];
+    if (m_keyHashes[slot] == h && !key.isNull() && key.size() == len &&
+        !memcmp(key.data(), s, len)) {
+      return key;
+    }
+    key = String(s, len, CopyString);
+    if (StringData *sd = StringData::LookupStaticString(key.get())) {
+      key = sd;
+    }
+    m_keyHashes[slot] = h;
+    return key;
+  }
+
+  bool parseLiteral(const char *lit, int len) {
+    if (m_end - m_p < len || memcmp(m_p, lit, len)) return false;
+    m_p += len;
+    return true;
+  }
+
+  /**
+   * The PDA's number grammar: RFC 4627's, except that "1." is allowed, and
+   * so is an exponent straight after it, but not after a bare 0 ("0e1").
+   */
+  bool parseNumber(Variant &out) {
+    const char *s = m_p;
+    const char *p = s;
+    bool isDouble = false;
+    if (*p == '-') p++;
+    if (p == m_end) return false;
+    bool zero = (*p == '0');
+    if (zero) {
+      p++;
+    } else if (*p >= '1' && *p <= '9') {
+      while (p < m_end && *p >= '0' && *p <= '9') p++;
+    } else {
+      return false;
+    }
+    if (p < m_end && *p == '.') {
+      isDouble = true;
+      p++;
+      while (p < m_end && *p >= '0' && *p <= '9') p++;
+    }
+    if (p < m_end && (*p == 'e' || *p == 'E')) {
+      if (zero && !isDouble) return false;
+      isDouble = true;
+      p++;
+      if (p < m_end && (*p == '+' || *p == '-')) p++;
+      if (p == m_end || *p < '0' || *p > '9') return false;
+      while (p < m_end && *p >= '0' && *p <= '9') p++;
+    }
+    m_p = p;
+
+    int len = p - s;
+    char small[64];
+    if (len < (int)sizeof(small)) {
+      memcpy(small, s, len);
+      small[len] = '\0';
+      json_create_number(out, small, len, isDouble);
+    } else {
+      std::string big(s, len);
+      json_create_number(out, big.c_str(), len, isDouble);
+    }
+    return true;
+  }
+};
+
+static bool json_fast_parse(Variant &z, const char *p, int length,
+                            bool assoc) {
+  // The index packs a flag into the low bit of each string offset.
+  if (length > INT_MAX / 2) return false;
+  if (utf8_validate(p, length) != length) return false;
+  JsonIndex index;
+  if (!json_index(index, p, p + length)) return false;
+  Variant v;
+  JsonBuilder builder(index, p, p + length, assoc);
+  if (!builder.parseDocument(v)) return false;
+  z = v;
+  return true;
+}
+
 #define SWAP_BUFFERS(from, to) do { \
     StringBuffer *tmp = from;       \
     from = to;                      \
@@ -490,6 +884,10 @@ static void attach_zval(json_parser *json, int up, int cur, StringBuffer &key,
  */
 bool JSON_parser(Variant &z, const char *p, int length, bool assoc/*<fb>*/,
                  bool loose/*</fb>*/) {
+  if (!loose && json_fast_parse(z, p, length, assoc)) {
+    return true;
+  }
+
   int b;  /* the next character */
   int c;  /* the next character class */
   int s;  /* the next state */
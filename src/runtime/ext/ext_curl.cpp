@@ -20,8 +20,13 @@
 #include <runtime/base/util/string_buffer.h>
 #include <runtime/base/util/libevent_http_client.h>
 #include <runtime/base/runtime_option.h>
+#include <runtime/base/timeout_thread.h>
 #include <runtime/base/server/server_stats.h>
 #include <runtime/vm/translator/translator-inline.h>
+#include <util/timer.h>
+
+#include <sys/epoll.h>
+#include <unistd.h>
 
 #define CURLOPT_RETURNTRANSFER 19913
 #define CURLOPT_BINARYTRANSFER 19914
@@ -121,6 +126,8 @@ public:
                      RuntimeOption::HttpDefaultTimeout);
     curl_easy_setopt(m_cp, CURLOPT_CONNECTTIMEOUT,
                      RuntimeOption::HttpDefaultTimeout);
+    m_timeoutMs = RuntimeOption::HttpDefaultTimeout * 1000LL;
+    m_connectTimeoutMs = m_timeoutMs;
 
     if (!url.empty()) {
 #if LIBCURL_VERSION_NUM >= 0x071100
@@ -162,6 +169,8 @@ public:
 
     m_to_free = src->m_to_free;
     m_emptyPost = src->m_emptyPost;
+    m_timeoutMs = src->m_timeoutMs;
+    m_connectTimeoutMs = src->m_connectTimeoutMs;
   }
 
   ~CurlResource() {
@@ -195,10 +204,12 @@ public:
     m_header.clear();
     memset(m_error_str, 0, sizeof(m_error_str));
 
+    clampTimeouts();
     {
       IOStatusHelper io("curl_easy_perform", m_url.data());
       SYNC_VM_REGS_SCOPED();
       m_error_no = curl_easy_perform(m_cp);
+      if (IOTrace::Enabled()) io.setBytes(transferred());
     }
     set_curl_statuses(m_cp, m_url.data());
 
@@ -227,6 +238,13 @@ public:
     return m_url;
   }
 
+  int64 transferred() {
+    double down = 0, up = 0;
+    curl_easy_getinfo(m_cp, CURLINFO_SIZE_DOWNLOAD, &down);
+    curl_easy_getinfo(m_cp, CURLINFO_SIZE_UPLOAD, &up);
+    return (int64)(down + up);
+  }
+
   String getHeader() {
     return m_header;
   }
@@ -241,12 +259,47 @@ public:
     return String();
   }
 
+  /**
+   * Cuts the transfer's timeouts down to what is left of the request's
+   * deadline, right before it starts.
+   */
+  void clampTimeouts() {
+    int64 timeout = TimeoutThread::ClampTimeoutMs(m_timeoutMs);
+    int64 connectTimeout = TimeoutThread::ClampTimeoutMs(m_connectTimeoutMs);
+#if LIBCURL_VERSION_NUM >= 0x071002
+    curl_easy_setopt(m_cp, CURLOPT_TIMEOUT_MS, (long)timeout);
+    curl_easy_setopt(m_cp, CURLOPT_CONNECTTIMEOUT_MS, (long)connectTimeout);
+#else
+    curl_easy_setopt(m_cp, CURLOPT_TIMEOUT, (long)((timeout + 999) / 1000));
+    curl_easy_setopt(m_cp, CURLOPT_CONNECTTIMEOUT,
+                     (long)((connectTimeout + 999) / 1000));
+#endif
+  }
+
   bool setOption(long option, CVarRef value) {
     if (m_cp == NULL) {
       return false;
     }
     m_error_no = CURLE_OK;
 
+    // remembered for clampTimeouts()
+    switch (option) {
+    case CURLOPT_TIMEOUT:
+      m_timeoutMs = value.toInt64() * 1000;
+      break;
+    case CURLOPT_CONNECTTIMEOUT:
+      m_connectTimeoutMs = value.toInt64() * 1000;
+      break;
+#if LIBCURL_VERSION_NUM >= 0x071002
+    case CURLOPT_TIMEOUT_MS:
+      m_timeoutMs = value.toInt64();
+      break;
+    case CURLOPT_CONNECTTIMEOUT_MS:
+      m_connectTimeoutMs = value.toInt64();
+      break;
+#endif
+    }
+
     switch (option) {
     case CURLOPT_INFILESIZE:
     case CURLOPT_VERBOSE:
@@ -671,6 +724,10 @@ private:
   ReadHandler  m_read;
 
   bool m_emptyPost;
+
+  // as set, before clampTimeouts() cuts them down
+  int64 m_timeoutMs;
+  int64 m_connectTimeoutMs;
 };
 IMPLEMENT_OBJECT_ALLOCATION_NO_DEFAULT_SWEEP(CurlResource);
 void CurlResource::sweep() {
@@ -917,6 +974,13 @@ Variant f_curl_close(CObjRef ch) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/**
+ * A multi handle's sockets are registered with an epoll instance of its own
+ * through CURLMOPT_SOCKETFUNCTION, as curl opens and closes them, rather
+ * than being collected into fd_sets on every curl_multi_select(). Waiting
+ * then costs the same however many transfers are in flight, and fds above
+ * FD_SETSIZE work.
+ */
 class CurlMultiResource : public SweepableResourceData {
 public:
   DECLARE_OBJECT_ALLOCATION(CurlMultiResource)
@@ -925,8 +989,12 @@ public:
   // overriding ResourceData
   CStrRef o_getClassNameHook() const { return s_class_name; }
 
-  CurlMultiResource() {
+  CurlMultiResource() : m_still_running(0), m_epoll(-1), m_timer_at(-1) {
     m_multi = curl_multi_init();
+    curl_multi_setopt(m_multi, CURLMOPT_SOCKETFUNCTION, curl_socket);
+    curl_multi_setopt(m_multi, CURLMOPT_SOCKETDATA, this);
+    curl_multi_setopt(m_multi, CURLMOPT_TIMERFUNCTION, curl_timer);
+    curl_multi_setopt(m_multi, CURLMOPT_TIMERDATA, this);
   }
 
   ~CurlMultiResource() {
@@ -935,9 +1003,8 @@ public:
 
   void close() {
     if (m_multi) {
-      curl_multi_cleanup(m_multi);
+      cleanup();
       m_easyh.clear();
-      m_multi = NULL;
     }
   }
 
@@ -971,15 +1038,212 @@ public:
     return m_multi;
   }
 
+  void setStillRunning(int running) {
+    m_still_running = running;
+  }
+
+  /**
+   * Waits up to timeout seconds, or less if curl's own timer is due
+   * sooner, for any of the handle's sockets to become ready. Returns the
+   * number of ready sockets, 0 on timeout, -1 on error.
+   */
+  int select(double timeout) {
+    if (m_sockets.empty()) {
+      // nothing registered yet, e.g. before the first curl_multi_exec()
+      int ret;
+      curl_multi_select(m_multi, (unsigned long)(timeout * 1000.0), &ret);
+      return ret;
+    }
+    return wait(waitMs((int64)(timeout * 1000.0)), NULL);
+  }
+
+  /**
+   * Drives the transfers with curl_multi_socket_action() until at least
+   * one handle finishes or timeout seconds pass, and returns the finished
+   * ones in curl_multi_info_read() form. Only sockets that are ready get
+   * looked at.
+   */
+  Array await(double timeout) {
+    int64 deadline = Timer::GetCurrentTimeMicros() + (int64)(timeout * 1e6);
+    while (true) {
+      if (m_timer_at >= 0 && m_timer_at <= Timer::GetCurrentTimeMicros()) {
+        // also how handles added since the last call get started
+        socketAction(CURL_SOCKET_TIMEOUT, 0);
+      }
+      Array done = readInfo(true);
+      if (!done.empty() || m_still_running == 0) return done;
+
+      int64 left = (deadline - Timer::GetCurrentTimeMicros()) / 1000;
+      if (left <= 0) return done;
+      if (wait(waitMs(left), &CurlMultiResource::socketReady) < 0) {
+        return done;
+      }
+    }
+  }
+
+  /**
+   * Pops one or, with all, every finished handle off curl's queue. Each
+   * handle's timings go to ServerStats like curl_exec()'s do, and to the
+   * request's I/O trace.
+   */
+  Array readInfo(bool all, int *queued = NULL) {
+    Array ret = Array::Create();
+    int left;
+    CURLMsg *msg;
+    while ((msg = curl_multi_info_read(m_multi, &left)) != NULL) {
+      Array info;
+      info.set("msg", msg->msg);
+      info.set("result", msg->data.result);
+      Object curle = find(msg->easy_handle);
+      if (!curle.isNull()) {
+        info.set("handle", curle);
+        CurlResource *cr = curle.getTyped<CurlResource>();
+        set_curl_statuses(msg->easy_handle, cr->getUrl().data());
+        if (IOTrace::Enabled()) {
+          // taken as ending now, though it may have finished a little
+          // before this got around to reading it
+          double total = 0;
+          curl_easy_getinfo(msg->easy_handle, CURLINFO_TOTAL_TIME, &total);
+          IOTrace::Record("curl::transfer", cr->getUrl().data(),
+                          (int64)(total * 1000000), cr->transferred());
+        }
+      }
+      ret.append(info);
+      if (queued) *queued = left;
+      if (!all) break;
+    }
+    return ret;
+  }
+
 private:
+  struct Socket {
+    curl_socket_t fd;
+  };
+  typedef std::map<curl_socket_t, Socket*> SocketMap;
+
   int m_still_running;
   CURLM *m_multi;
   Array m_easyh;
+
+  int m_epoll;
+  SocketMap m_sockets;
+  int64 m_timer_at; // from CURLMOPT_TIMERFUNCTION, -1 for none
+
+  void cleanup() {
+    for (SocketMap::iterator iter = m_sockets.begin();
+         iter != m_sockets.end(); ++iter) {
+      delete iter->second;
+    }
+    m_sockets.clear();
+    curl_multi_setopt(m_multi, CURLMOPT_SOCKETFUNCTION, NULL);
+    curl_multi_setopt(m_multi, CURLMOPT_TIMERFUNCTION, NULL);
+    curl_multi_cleanup(m_multi);
+    m_multi = NULL;
+    if (m_epoll >= 0) {
+      ::close(m_epoll);
+      m_epoll = -1;
+    }
+  }
+
+  int waitMs(int64 ms) const {
+    if (m_timer_at >= 0) {
+      int64 timer = (m_timer_at - Timer::GetCurrentTimeMicros() + 999) / 1000;
+      if (timer < ms) ms = timer;
+    }
+    return ms < 0 ? 0 : ms;
+  }
+
+  int wait(int ms, void (CurlMultiResource::*ready)(curl_socket_t, int)) {
+    if (m_epoll < 0) {
+      // No sockets yet, e.g. curl is still resolving the host or backing
+      // off before a retry: only its timer can move things along.
+      {
+        IOStatusHelper io("curl_multi_select");
+        usleep(ms * 1000);
+      }
+      if (ready) socketAction(CURL_SOCKET_TIMEOUT, 0);
+      return 0;
+    }
+    struct epoll_event events[64];
+    int n;
+    {
+      IOStatusHelper io("curl_multi_select");
+      do {
+        n = epoll_wait(m_epoll, events, sizeof(events) / sizeof(events[0]),
+                       ms);
+      } while (n < 0 && errno == EINTR);
+    }
+    if (ready) {
+      for (int i = 0; i < n; i++) {
+        (this->*ready)(events[i].data.fd, events[i].events);
+      }
+    }
+    return n;
+  }
+
+  void socketAction(curl_socket_t fd, int mask) {
+    IOStatusHelper io("curl_multi_exec");
+    SYNC_VM_REGS_SCOPED();
+    while (curl_multi_socket_action(m_multi, fd, mask, &m_still_running) ==
+           CURLM_CALL_MULTI_PERFORM) {}
+  }
+
+  void socketReady(curl_socket_t fd, int events) {
+    int mask = 0;
+    if (events & EPOLLIN) mask |= CURL_CSELECT_IN;
+    if (events & EPOLLOUT) mask |= CURL_CSELECT_OUT;
+    if (events & (EPOLLERR | EPOLLHUP)) mask |= CURL_CSELECT_ERR;
+    socketAction(fd, mask);
+  }
+
+  void updateSocket(curl_socket_t fd, int what, Socket *sock) {
+    if (what == CURL_POLL_REMOVE) {
+      if (sock) {
+        // curl may already have closed it, which drops it from the set
+        epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, NULL);
+        m_sockets.erase(fd);
+        delete sock;
+      }
+      return;
+    }
+    if (m_epoll < 0) {
+      m_epoll = epoll_create(64);
+      if (m_epoll < 0) return;
+    }
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.data.fd = fd;
+    if (what & CURL_POLL_IN) ev.events |= EPOLLIN;
+    if (what & CURL_POLL_OUT) ev.events |= EPOLLOUT;
+    if (!sock) {
+      sock = new Socket();
+      sock->fd = fd;
+      m_sockets[fd] = sock;
+      curl_multi_assign(m_multi, fd, sock);
+      if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &ev) < 0 && errno == EEXIST) {
+        epoll_ctl(m_epoll, EPOLL_CTL_MOD, fd, &ev);
+      }
+    } else {
+      epoll_ctl(m_epoll, EPOLL_CTL_MOD, fd, &ev);
+    }
+  }
+
+  static int curl_socket(CURL *easy, curl_socket_t fd, int what,
+                         void *userp, void *socketp) {
+    ((CurlMultiResource*)userp)->updateSocket(fd, what, (Socket*)socketp);
+    return 0;
+  }
+
+  static int curl_timer(CURLM *multi, long timeout_ms, void *userp) {
+    ((CurlMultiResource*)userp)->m_timer_at = timeout_ms < 0 ? -1 :
+      Timer::GetCurrentTimeMicros() + timeout_ms * 1000;
+    return 0;
+  }
 };
 IMPLEMENT_OBJECT_ALLOCATION_NO_DEFAULT_SWEEP(CurlMultiResource);
 void CurlMultiResource::sweep() {
   if (m_multi) {
-    curl_multi_cleanup(m_multi);
+    cleanup();
   }
 }
 
@@ -1002,6 +1266,7 @@ Variant f_curl_multi_add_handle(CObjRef mh, CObjRef ch) {
   CHECK_MULTI_RESOURCE(curlm);
   CurlResource *curle = ch.getTyped<CurlResource>();
   curlm->add(ch);
+  curle->clampTimeouts();
   return curl_multi_add_handle(curlm->get(), curle->get());
 }
 
@@ -1018,17 +1283,19 @@ Variant f_curl_multi_exec(CObjRef mh, VRefParam still_running) {
   IOStatusHelper io("curl_multi_exec");
   SYNC_VM_REGS_SCOPED();
   int result = curl_multi_perform(curlm->get(), &running);
+  curlm->setStillRunning(running);
   still_running = running;
   return result;
 }
 
 Variant f_curl_multi_select(CObjRef mh, double timeout /* = 1.0 */) {
   CHECK_MULTI_RESOURCE(curlm);
-  int ret;
-  unsigned long timeout_ms = (unsigned long)(timeout * 1000.0);
-  IOStatusHelper io("curl_multi_select");
-  curl_multi_select(curlm->get(), timeout_ms, &ret);
-  return ret;
+  return curlm->select(timeout);
+}
+
+Variant f_fb_curl_multi_await(CObjRef mh, double timeout /* = 1.0 */) {
+  CHECK_MULTI_RESOURCE(curlm);
+  return curlm->await(timeout);
 }
 
 Variant f_curl_multi_getcontent(CObjRef ch) {
@@ -1076,21 +1343,13 @@ Variant f_curl_multi_info_read(CObjRef mh,
                                VRefParam msgs_in_queue /* = null */) {
   CHECK_MULTI_RESOURCE(curlm);
 
-  int queued_msgs;
-  CURLMsg *tmp_msg = curl_multi_info_read(curlm->get(), &queued_msgs);
-  if (tmp_msg == NULL) {
+  int queued_msgs = 0;
+  Array msgs = curlm->readInfo(false, &queued_msgs);
+  if (msgs.empty()) {
     return false;
   }
   msgs_in_queue = queued_msgs;
-
-  Array ret;
-  ret.set("msg", tmp_msg->msg);
-  ret.set("result", tmp_msg->data.result);
-  Object curle = curlm->find(tmp_msg->easy_handle);
-  if (!curle.isNull()) {
-    ret.set("handle", curle);
-  }
-  return ret;
+  return msgs[0];
 }
 
 Variant f_curl_multi_close(CObjRef mh) {
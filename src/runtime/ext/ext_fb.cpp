@@ -28,6 +28,7 @@
 #include <runtime/base/code_coverage.h>
 #include <runtime/base/runtime_option.h>
 #include <runtime/base/array/zend_array.h>
+#include <runtime/base/zend/utf8_validate.h>
 #include <runtime/base/intercept.h>
 #include <runtime/base/taint/taint_data.h>
 #include <runtime/base/taint/taint_trace.h>
@@ -635,23 +636,8 @@ bool f_fb_utf8ize(VRefParam input) {
   }
 
   // Preflight to avoid malloc() if the entire input is valid.
-  int32_t srcPosBytes;
-  for (srcPosBytes = 0; srcPosBytes < srcLenBytes; /* U8_NEXT increments */) {
-    // This is lame, but gcc doesn't optimize U8_NEXT very well
-    if (srcBuf[srcPosBytes] > 0 && srcBuf[srcPosBytes] <= 0x7f) {
-      srcPosBytes++; // U8_NEXT would increment this
-      continue;
-    }
-    UChar32 curCodePoint;
-    // U8_NEXT() always advances srcPosBytes; save in case curCodePoint invalid
-    int32_t savedSrcPosBytes = srcPosBytes;
-    U8_NEXT(srcBuf, srcPosBytes, srcLenBytes, curCodePoint);
-    if (curCodePoint <= 0) {
-      // curCodePoint invalid; back up so we'll fix it in the loop below.
-      srcPosBytes = savedSrcPosBytes;
-      break;
-    }
-  }
+  // N.B. We consider a null byte an invalid sequence.
+  int32_t srcPosBytes = utf8_validate(srcBuf, srcLenBytes, NULL, false);
 
   if (srcPosBytes == srcLenBytes) {
     // it's all valid
@@ -681,13 +667,17 @@ bool f_fb_utf8ize(VRefParam input) {
   // Iterate through the remaining bytes.
   int32_t dstPosBytes = srcPosBytes; // already copied srcPosBytes
   for (/* already init'd */; srcPosBytes < srcLenBytes; /* see U8_NEXT */) {
+    // Copy the next well-formed run as one block too; srcPosBytes is then
+    // at an invalid sequence (or the end).
+    int32_t validBytes = utf8_validate(srcBuf + srcPosBytes,
+                                       srcLenBytes - srcPosBytes, NULL, false);
+    memcpy(dstBuf + dstPosBytes, srcBuf + srcPosBytes, validBytes);
+    dstPosBytes += validBytes;
+    srcPosBytes += validBytes;
+    if (srcPosBytes == srcLenBytes) break;
+
     UChar32 curCodePoint;
-    // This is lame, but gcc doesn't optimize U8_NEXT very well
-    if (srcBuf[srcPosBytes] > 0 && srcBuf[srcPosBytes] <= 0x7f) {
-      curCodePoint = srcBuf[srcPosBytes++]; // U8_NEXT would increment
-    } else {
-      U8_NEXT(srcBuf, srcPosBytes, srcLenBytes, curCodePoint);
-    }
+    U8_NEXT(srcBuf, srcPosBytes, srcLenBytes, curCodePoint);
     if (curCodePoint <= 0) {
       // Invalid UTF-8 sequence.
       // N.B. We consider a null byte an invalid sequence.
@@ -716,9 +706,20 @@ static int f_fb_utf8_strlen_impl(CStrRef input, bool deprecated) {
   // Count, don't modify.
   int32_t sourceLength = input.size();
   const char* const sourceBuffer = input.data();
-  int64_t num_code_points = 0;
+  // Well-formed input (the common case) is counted in one pass; only the
+  // part from the first invalid sequence on goes through U8_NEXT.
+  int validCodePoints;
+  int32_t validBytes = utf8_validate(sourceBuffer, sourceLength,
+                                     &validCodePoints);
+  if (validBytes == sourceLength) {
+    return validCodePoints;
+  }
+  if (deprecated) {
+    return sourceLength; // return byte count on invalid sequence
+  }
+  int64_t num_code_points = validCodePoints;
 
-  for (int32_t sourceOffset = 0; sourceOffset < sourceLength; ) {
+  for (int32_t sourceOffset = validBytes; sourceOffset < sourceLength; ) {
     UChar32 sourceCodePoint;
     // U8_NEXT() is guaranteed to advance sourceOffset by 1-4 each time it's
     // invoked.
@@ -23,6 +23,7 @@
 #include <runtime/ext/ext_process.h>
 #include <runtime/base/zend/zend_url.h>
 #include <runtime/base/zend/zend_string.h>
+#include <runtime/base/zend/utf8_validate.h>
 #include <runtime/base/ini_setting.h>
 
 extern "C" {
@@ -1138,6 +1139,13 @@ bool f_mb_check_encoding(CStrRef var /* = null_string */,
     }
   }
 
+  // Well-formed UTF-8 is accepted by libmbfl as well, so only strings that
+  // fail the strict check need the converter's verdict.
+  if (no_encoding == mbfl_no_encoding_utf8 &&
+      utf8_validate(var.data(), var.size()) == var.size()) {
+    return true;
+  }
+
   convd = mbfl_buffer_converter_new(no_encoding, no_encoding, 0);
   if (convd == NULL) {
     raise_warning("Unable to create converter");
@@ -18,6 +18,9 @@
 #include <runtime/ext/ext_memcache.h>
 #include <runtime/base/util/request_local.h>
 #include <runtime/base/ini_setting.h>
+#include <runtime/base/server/server_stats.h>
+#include <runtime/base/timeout_thread.h>
+#include <util/compression.h>
 
 #include <system/lib/systemlib.h>
 
@@ -34,8 +37,9 @@ class MEMCACHEGlobals : public RequestEventHandler {
 public:
   std::string hash_strategy;
   std::string hash_function;
+  bool parallel_get;
 
-  MEMCACHEGlobals() {}
+  MEMCACHEGlobals() : parallel_get(true) {}
 
   virtual void requestInit() {
     hash_strategy = "standard";
@@ -45,6 +49,8 @@ public:
                      ini_on_update_hash_strategy,  &hash_strategy);
     IniSetting::Bind("memcache.hash_function",     "crc32",
                      ini_on_update_hash_function,  &hash_function);
+    IniSetting::Bind("memcache.parallel_get",      "1",
+                     ini_on_update_bool,           &parallel_get);
   }
 
   virtual void requestShutdown() {
@@ -84,6 +90,10 @@ c_Memcache::c_Memcache(const ObjectStaticCallbacks *cb) :
     m_min_compress_savings(0.2) {
   CPP_BUILTIN_CLASS_INIT(Memcache);
   memcached_create(&m_memcache);
+  m_connect_timeout_ms =
+    memcached_behavior_get(&m_memcache, MEMCACHED_BEHAVIOR_CONNECT_TIMEOUT);
+  m_op_timeout_ms =
+    memcached_behavior_get(&m_memcache, MEMCACHED_BEHAVIOR_POLL_TIMEOUT);
 
   if (MEMCACHEG(hash_strategy) == "consistent") {
     // need to hook up a global variable to set this
@@ -118,6 +128,11 @@ bool c_Memcache::t_connect(CStrRef host, int port /*= 0*/,
   INSTANCE_METHOD_INJECTION_BUILTIN(Memcache, Memcache::connect);
   memcached_return_t ret;
 
+  if (timeoutms > 0) {
+    m_connect_timeout_ms = timeoutms;
+  } else if (timeout > 0) {
+    m_connect_timeout_ms = timeout * 1000LL;
+  }
   if (!host.empty() && host[0] == '/') {
     ret = memcached_server_add_unix_socket(&m_memcache, host.c_str());
   } else {
@@ -134,6 +149,34 @@ bool c_Memcache::t_pconnect(CStrRef host, int port /*= 0*/,
   return t_connect(host, port, timeout, timeoutms);
 }
 
+/*
+ * Which server key lives on, for the I/O trace. Finding it costs a hash, so
+ * this only bothers when the request is being traced.
+ */
+static memcached_server_instance_st memcache_server(memcached_st *mc,
+                                                    CStrRef key) {
+  if (!IOTrace::Enabled() || key.empty()) return NULL;
+  memcached_return_t rc;
+  return memcached_server_by_key(mc, key.data(), key.size(), &rc);
+}
+
+/*
+ * libmemcached connects lazily, so both timeouts get cut down to what is
+ * left of the request's deadline before every operation.
+ */
+void c_Memcache::clampTimeouts() {
+  memcached_behavior_set(&m_memcache, MEMCACHED_BEHAVIOR_CONNECT_TIMEOUT,
+                         TimeoutThread::ClampTimeoutMs(m_connect_timeout_ms));
+  memcached_behavior_set(&m_memcache, MEMCACHED_BEHAVIOR_POLL_TIMEOUT,
+                         TimeoutThread::ClampTimeoutMs(m_op_timeout_ms));
+}
+
+#define MEMCACHE_IO_STATUS(name, key)                                   \
+  clampTimeouts();                                                      \
+  memcached_server_instance_st server_ = memcache_server(&m_memcache, key); \
+  IOStatusHelper io(name, server_ ? memcached_server_name(server_) : NULL, \
+                    server_ ? memcached_server_port(server_) : 0)
+
 String static memcache_prepare_for_storage(CVarRef var, int &flag) {
   if (var.isString()) {
     return var.toString();
@@ -151,8 +194,19 @@ Variant static memcache_fetch_from_storage(const char *payload,
   Variant ret = null;
 
   if (flags & MMC_COMPRESSED) {
-    raise_warning("Unable to handle compressed values yet");
-    return null;
+    int len = payload_len;
+    char *data = gzuncompress(payload, len);
+    if (data == NULL) {
+      raise_warning("Unable to uncompress value");
+      return null;
+    }
+    String uncompressed(data, len, AttachString);
+    if (flags & MMC_SERIALIZED) {
+      ret = f_unserialize(uncompressed);
+    } else {
+      ret = uncompressed;
+    }
+    return ret;
   }
 
   if (flags & MMC_SERIALIZED) {
@@ -175,6 +229,8 @@ bool c_Memcache::t_add(CStrRef key, CVarRef var, int flag /*= 0*/,
 
   String serialized = memcache_prepare_for_storage(var, flag);
 
+  MEMCACHE_IO_STATUS("memcache::add", key);
+  io.setBytes(serialized.length());
   memcached_return_t ret = memcached_add(&m_memcache,
                                         key.c_str(), key.length(),
                                         serialized.c_str(),
@@ -194,6 +250,8 @@ bool c_Memcache::t_set(CStrRef key, CVarRef var, int flag /*= 0*/,
 
   String serialized = memcache_prepare_for_storage(var, flag);
 
+  MEMCACHE_IO_STATUS("memcache::set", key);
+  io.setBytes(serialized.length());
   memcached_return_t ret = memcached_set(&m_memcache,
                                         key.c_str(), key.length(),
                                         serialized.c_str(),
@@ -217,6 +275,8 @@ bool c_Memcache::t_replace(CStrRef key, CVarRef var, int flag /*= 0*/,
 
   String serialized = memcache_prepare_for_storage(var, flag);
 
+  MEMCACHE_IO_STATUS("memcache::replace", key);
+  io.setBytes(serialized.length());
   memcached_return_t ret = memcached_replace(&m_memcache,
                                              key.c_str(), key.length(),
                                              serialized.c_str(),
@@ -229,19 +289,46 @@ Variant c_Memcache::t_get(CVarRef key, VRefParam flags /*= null*/) {
   INSTANCE_METHOD_INJECTION_BUILTIN(Memcache, Memcache::get);
   TAINT_OBSERVER(TAINT_BIT_ALL, TAINT_BIT_NONE);
   if (key.is(KindOfArray)) {
+    Array keyArr = key.toArray();
+    int count = keyArr.size();
+    // Keep the key strings alive; converting them in place would leave
+    // real_keys pointing at temporaries.
+    std::vector<String> key_strs;
     std::vector<const char *> real_keys;
     std::vector<size_t> key_len;
-    Array keyArr = key.toArray();
 
-    real_keys.reserve(keyArr.size());
-    key_len.reserve(keyArr.size());
+    key_strs.reserve(count);
+    real_keys.reserve(count);
+    key_len.reserve(count);
 
     for (ArrayIter iter(keyArr); iter; ++iter) {
-      real_keys.push_back(const_cast<char *>(iter.second().toString().c_str()));
-      key_len.push_back(iter.second().toString().length());
+      key_strs.push_back(iter.second().toString());
+      real_keys.push_back(key_strs.back().data());
+      key_len.push_back(key_strs.back().size());
     }
 
     if (!real_keys.empty()) {
+      clampTimeouts();
+      IOStatusHelper io("memcache::mget");
+      if (MEMCACHEG(parallel_get) &&
+          m_mget.fetch(&m_memcache, &real_keys[0], &key_len[0], count)) {
+        // Nothing is decoded until every server has answered, so
+        // unserializing or uncompressing one reply never holds up reading
+        // the others.
+        ArrayInit return_val(count);
+        int64 bytes = 0;
+        for (int i = 0; i < m_mget.size(); i++) {
+          MemcacheMultiGet::Item item = m_mget.get(i);
+          bytes += item.valueLen;
+          return_val.set(String(item.key, item.keyLen, CopyString),
+                         memcache_fetch_from_storage(item.value,
+                                                     item.valueLen,
+                                                     item.flags));
+        }
+        io.setBytes(bytes);
+        return return_val.create();
+      }
+
       const char *payload = NULL;
       size_t payload_len = 0;
       uint32_t flags = 0;
@@ -254,6 +341,7 @@ Variant c_Memcache::t_get(CVarRef key, VRefParam flags /*= null*/) {
                                               &key_len[0], real_keys.size());
       memcached_result_create(&m_memcache, &result);
       Array return_val;
+      int64 bytes = 0;
 
       while ((memcached_fetch_result(&m_memcache, &result, &ret)) != NULL) {
         if (ret != MEMCACHED_SUCCESS) {
@@ -266,12 +354,14 @@ Variant c_Memcache::t_get(CVarRef key, VRefParam flags /*= null*/) {
         flags       = memcached_result_flags(&result);
         res_key     = memcached_result_key_value(&result);
         res_key_len = memcached_result_key_length(&result);
+        bytes += payload_len;
 
         return_val.set(String(res_key, res_key_len, CopyString),
                        memcache_fetch_from_storage(payload,
                                                    payload_len, flags));
       }
       memcached_result_free(&result);
+      io.setBytes(bytes);
 
       return return_val;
     }
@@ -287,8 +377,10 @@ Variant c_Memcache::t_get(CVarRef key, VRefParam flags /*= null*/) {
       return false;
     }
 
+    MEMCACHE_IO_STATUS("memcache::get", skey);
     payload = memcached_get(&m_memcache, skey.c_str(), skey.length(),
                             &payload_len, &flags, &ret);
+    io.setBytes(payload_len);
 
     /* This is for historical reasons from libmemcached*/
     if (ret == MEMCACHED_END) {
@@ -314,6 +406,7 @@ bool c_Memcache::t_delete(CStrRef key, int expire /*= 0*/) {
     return false;
   }
 
+  MEMCACHE_IO_STATUS("memcache::delete", key);
   memcached_return_t ret = memcached_delete(&m_memcache,
                                             key.c_str(), key.length(),
                                             expire);
@@ -328,6 +421,7 @@ int64 c_Memcache::t_increment(CStrRef key, int offset /*= 1*/) {
   }
 
   uint64_t value;
+  MEMCACHE_IO_STATUS("memcache::increment", key);
   memcached_return_t ret = memcached_increment(&m_memcache, key.c_str(),
                                               key.length(), offset, &value);
 
@@ -346,6 +440,7 @@ int64 c_Memcache::t_decrement(CStrRef key, int offset /*= 1*/) {
   }
 
   uint64_t value;
+  MEMCACHE_IO_STATUS("memcache::decrement", key);
   memcached_return_t ret = memcached_decrement(&m_memcache, key.c_str(),
                                               key.length(), offset, &value);
 
@@ -359,6 +454,7 @@ int64 c_Memcache::t_decrement(CStrRef key, int offset /*= 1*/) {
 bool c_Memcache::t_close() {
   INSTANCE_METHOD_INJECTION_BUILTIN(Memcache, Memcache::close);
   memcached_quit(&m_memcache);
+  m_mget.close();
   return true;
 }
 
@@ -399,9 +495,7 @@ bool c_Memcache::t_setoptimeout(int64 timeoutms) {
   if (timeoutms < 1) {
     timeoutms = 1000; // make default
   }
-
-  /* intentionally doing nothing for now */
-
+  m_op_timeout_ms = timeoutms;
   return true;
 }
 
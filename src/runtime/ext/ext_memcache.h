@@ -22,6 +22,7 @@
 
 #include <runtime/base/base_includes.h>
 #include <libmemcached/memcached.h>
+#include <runtime/ext/memcache_mget.h>
 namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -105,9 +106,14 @@ class c_Memcache : public ExtObjectData, public Sweepable {
 
 
  private:
+  void clampTimeouts();
+
   memcached_st m_memcache;
+  MemcacheMultiGet m_mget;
   int m_compress_threshold;
   double m_min_compress_savings;
+  int64 m_connect_timeout_ms; // as set, before the request's deadline
+  int64 m_op_timeout_ms;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
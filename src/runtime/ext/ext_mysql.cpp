@@ -19,7 +19,9 @@
 #include <runtime/ext/ext_preg.h>
 #include <runtime/ext/ext_network.h>
 #include <runtime/ext/mysql_stats.h>
+#include <runtime/ext/mysql_pool.h>
 #include <runtime/base/runtime_option.h>
+#include <runtime/base/timeout_thread.h>
 #include <runtime/base/server/server_stats.h>
 #include <runtime/base/util/request_local.h>
 #include <runtime/base/util/extended_logger.h>
@@ -27,6 +29,7 @@
 #include <util/db_mysql.h>
 #include <netinet/in.h>
 #include <netdb.h>
+#include <poll.h>
 
 #include <system/lib/systemlib.h>
 
@@ -100,20 +103,42 @@ public:
 };
 static MySQLStaticInitializer s_mysql_initializer;
 
+static void php_mysql_async_abandon(MySQL *mySQL, int timeout_ms);
+
+// how long request shutdown waits for an unfetched async result when there
+// is no read timeout to go by
+#define MYSQL_ASYNC_DRAIN_MS 1000
+
+// how long mysql_async_wait_actionable() waits by default without one
+#define MYSQL_ASYNC_WAIT_MS 60000
+
 class MySQLRequestData : public RequestEventHandler {
 public:
   virtual void requestInit() {
     defaultConn.reset();
+    asyncConns.reset();
     readTimeout = RuntimeOption::MySQLReadTimeout;
     totalRowCount = 0;
   }
 
   virtual void requestShutdown() {
+    // Links may be persistent, so an unfetched async result must not be
+    // left on the wire for the next request to trip over. The request is
+    // over, so the wait is always bounded.
+    int timeout_ms = readTimeout > 0 ? readTimeout :
+      RuntimeOption::MySQLReadTimeout > 0 ? RuntimeOption::MySQLReadTimeout :
+      MYSQL_ASYNC_DRAIN_MS;
+    for (ArrayIter iter(asyncConns); iter; ++iter) {
+      MySQL *mySQL = iter.second().toObject().getTyped<MySQL>(true, true);
+      if (mySQL) php_mysql_async_abandon(mySQL, timeout_ms);
+    }
+    asyncConns.reset();
     defaultConn.reset();
     totalRowCount = 0;
   }
 
   Object defaultConn;
+  Array asyncConns; // links with an async query in flight, by resource id
   int readTimeout;
   int totalRowCount; // from all queries in current request
 };
@@ -134,7 +159,8 @@ MySQL *MySQL::Get(CVarRef link_identifier) {
   return mysql;
 }
 
-MYSQL *MySQL::GetConn(CVarRef link_identifier, MySQL **rconn /* = NULL */) {
+MYSQL *MySQL::GetConn(CVarRef link_identifier, MySQL **rconn /* = NULL */,
+                      bool asyncOk /* = false */) {
   MySQL *mySQL = Get(link_identifier);
   MYSQL *ret = NULL;
   if (mySQL) {
@@ -142,6 +168,10 @@ MYSQL *MySQL::GetConn(CVarRef link_identifier, MySQL **rconn /* = NULL */) {
   }
   if (ret == NULL) {
     raise_warning("supplied argument is not a valid MySQL-Link resource");
+  } else if (!asyncOk && mySQL->isAsyncPending()) {
+    raise_warning("MySQL link has an async query in flight; "
+                  "call mysql_async_query_result() first");
+    ret = NULL;
   }
   if (rconn) {
     *rconn = mySQL;
@@ -225,10 +255,44 @@ static MYSQL *create_new_conn() {
   return ret;
 }
 
+/*
+ * Connect, read and write timeouts are all cut down to what is left of the
+ * request's deadline, and set again every time so a persistent link doesn't
+ * keep the last request's.
+ */
+static void php_mysql_set_connect_timeout(MYSQL *conn, int connect_timeout) {
+  if (connect_timeout < 0) connect_timeout = RuntimeOption::MySQLConnectTimeout;
+  MySQLUtil::set_mysql_timeout(conn, MySQLUtil::ConnectTimeout,
+                               TimeoutThread::ClampTimeoutMs(connect_timeout));
+}
+
+/*
+ * Only a client built with MYSQL_MILLISECOND_TIMEOUT clamps to the
+ * millisecond. The stock one counts in whole seconds, so there the
+ * timeouts get rounded up and a request can overrun its deadline by up to
+ * a second waiting on MySQL.
+ */
+static void php_mysql_set_query_timeouts(MYSQL *conn) {
+  int ms = TimeoutThread::ClampTimeoutMs(s_mysql_data->readTimeout);
+  // for when the link connects again
+  MySQLUtil::set_mysql_timeout(conn, MySQLUtil::ReadTimeout, ms);
+  MySQLUtil::set_mysql_timeout(conn, MySQLUtil::WriteTimeout, ms);
+#ifndef MYSQL_MILLISECOND_TIMEOUT
+  // The stock client only applies the options when it connects; this sets
+  // them on the open socket too.
+  if (conn->net.vio) {
+    unsigned int seconds = ms > 0 ? (ms + 999) / 1000 : 0;
+    my_net_set_read_timeout(&conn->net, seconds);
+    my_net_set_write_timeout(&conn->net, seconds);
+  }
+#endif
+}
+
 MySQL::MySQL(const char *host, int port, const char *username,
              const char *password, const char *database)
     : m_port(port), m_last_error_set(false), m_last_errno(0),
-      m_xaction_count(0), m_multi_query(false) {
+      m_xaction_count(0), m_multi_query(false), m_async_pending(false),
+      m_async_skipped(false), m_async_start(0) {
   if (host) m_host = host;
   if (username) m_username = username;
   if (password) m_password = password;
@@ -250,13 +314,36 @@ void MySQL::setLastError(const char *func) {
   raise_warning("%s(): %s", func, m_last_error.c_str());
 }
 
+int MySQL::getSocket() const {
+  return m_conn ? m_conn->net.fd : -1;
+}
+
 void MySQL::close() {
   if (m_conn) {
+    if (isPooled()) {
+      if (m_async_pending) {
+        // a reply is still on its way; nobody else can use this one
+        mysql_close(m_conn);
+        MySQLConnectionPool::Discard(m_pool_host);
+      } else {
+        if (m_multi_query) {
+          mysql_set_server_option(m_conn, MYSQL_OPTION_MULTI_STATEMENTS_OFF);
+          m_multi_query = false;
+        }
+        MySQLConnectionPool::Checkin(m_pool_host, m_pool_key, m_conn);
+      }
+      m_pool_host.clear();
+      m_pool_key.clear();
+    } else {
+      mysql_close(m_conn);
+    }
     m_last_error_set = false;
     m_last_errno = 0;
     m_xaction_count = 0;
+    m_async_pending = false;
+    m_async_skipped = false;
+    m_async_query.clear();
     m_last_error.clear();
-    mysql_close(m_conn);
     m_conn = NULL;
   }
 }
@@ -267,10 +354,7 @@ bool MySQL::connect(CStrRef host, int port, CStrRef socket, CStrRef username,
   if (m_conn == NULL) {
     m_conn = create_new_conn();
   }
-  if (connect_timeout >= 0) {
-    MySQLUtil::set_mysql_timeout(m_conn, MySQLUtil::ConnectTimeout,
-                                 connect_timeout);
-  }
+  php_mysql_set_connect_timeout(m_conn, connect_timeout);
   if (RuntimeOption::EnableStats && RuntimeOption::EnableSQLStats) {
     ServerStats::Log("sql.conn", 1);
   }
@@ -298,10 +382,7 @@ bool MySQL::reconnect(CStrRef host, int port, CStrRef socket, CStrRef username,
                       int client_flags, int connect_timeout) {
   if (m_conn == NULL) {
     m_conn = create_new_conn();
-    if (connect_timeout >= 0) {
-      MySQLUtil::set_mysql_timeout(m_conn, MySQLUtil::ConnectTimeout,
-                                   connect_timeout);
-    }
+    php_mysql_set_connect_timeout(m_conn, connect_timeout);
     if (RuntimeOption::EnableStats && RuntimeOption::EnableSQLStats) {
       ServerStats::Log("sql.reconn_new", 1);
     }
@@ -322,10 +403,7 @@ bool MySQL::reconnect(CStrRef host, int port, CStrRef socket, CStrRef username,
     return true;
   }
 
-  if (connect_timeout >= 0) {
-    MySQLUtil::set_mysql_timeout(m_conn, MySQLUtil::ConnectTimeout,
-                                 connect_timeout);
-  }
+  php_mysql_set_connect_timeout(m_conn, connect_timeout);
   if (RuntimeOption::EnableStats && RuntimeOption::EnableSQLStats) {
     ServerStats::Log("sql.reconn_old", 1);
   }
@@ -337,6 +415,59 @@ bool MySQL::reconnect(CStrRef host, int port, CStrRef socket, CStrRef username,
                             port, socket.data(), client_flags);
 }
 
+bool MySQL::checkoutPooled(CStrRef host, int port, CStrRef socket,
+                           CStrRef username, CStrRef password,
+                           CStrRef database, int client_flags,
+                           int connect_timeout) {
+  ASSERT(!isPooled());
+  std::string poolHost = std::string(host.data()) + ":" +
+    boost::lexical_cast<std::string>(port);
+  std::string key = GetHash(host, port, socket, username, password,
+                            client_flags).data();
+  key += ":";
+  key += database.data();
+
+  bool slot;
+  MYSQL *conn;
+  {
+    IOStatusHelper io("mysql::pool_checkout", host.data(), port);
+    conn = MySQLConnectionPool::Checkout(poolHost, key, slot);
+  }
+  if (!conn && !slot) {
+    m_last_error_set = true;
+    m_last_errno = 2003; // CR_CONN_HOST_ERROR
+    m_last_error = "Too many pooled connections to " + poolHost;
+    raise_warning("mysql_connect(): %s", m_last_error.c_str());
+    return false;
+  }
+
+  if (conn) {
+    if (m_conn) mysql_close(m_conn);
+    m_conn = conn;
+    m_pool_host = poolHost;
+    m_pool_key = key;
+    m_xaction_count = 0;
+    // the previous borrower may have switched databases
+    if (!database.empty() && (!conn->db || strcmp(conn->db, database.data()))) {
+      mysql_select_db(conn, database.data());
+    }
+    if (RuntimeOption::EnableStats && RuntimeOption::EnableSQLStats) {
+      ServerStats::Log("sql.reconn_ok", 1);
+    }
+    return true;
+  }
+
+  if (!connect(host, port, socket, username, password, database,
+               client_flags, connect_timeout)) {
+    MySQLConnectionPool::Discard(poolHost);
+    setLastError("mysql_connect");
+    return false;
+  }
+  m_pool_host = poolHost;
+  m_pool_key = key;
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // helpers
 
@@ -543,6 +674,18 @@ static Variant php_mysql_do_connect(String server, String username,
 
   Object ret;
   MySQL *mySQL = NULL;
+  if (persistent && RuntimeOption::MySQLPool) {
+    // Borrowed from the process-wide pool; the link itself only lives for
+    // this request and gives the connection back when it goes away.
+    mySQL = new MySQL(host, port, username, password, database);
+    ret = mySQL;
+    MySQL::SetDefaultConn(mySQL);
+    if (!mySQL->checkoutPooled(host, port, socket, username, password,
+                               database, client_flags, connect_timeout_ms)) {
+      return false;
+    }
+    return ret;
+  }
   if (persistent) {
     mySQL = MySQL::GetPersistent(host, port, socket, username, password,
                                  client_flags);
@@ -799,19 +942,17 @@ static Variant php_mysql_localize_result(MYSQL *mysql) {
   return result;
 }
 
-static Variant php_mysql_do_query_general(CStrRef query, CVarRef link_id,
-                                          bool use_store) {
+static bool php_mysql_read_only_skip(CStrRef query) {
   if (RuntimeOption::MySQLReadOnly &&
       same(f_preg_match("/^((\\/\\*.*?\\*\\/)|\\(|\\s)*select/i", query), 0)) {
     raise_notice("runtime/ext_mysql: write query not executed [%s]",
                     query.data());
-    return true; // pretend it worked
+    return true;
   }
+  return false;
+}
 
-  MySQL *rconn = NULL;
-  MYSQL *conn = MySQL::GetConn(link_id, &rconn);
-  if (!conn || !rconn) return false;
-
+static void php_mysql_record_query_stats(CStrRef query, MySQL *rconn) {
   if (RuntimeOption::EnableStats && RuntimeOption::EnableSQLStats) {
     ServerStats::Log("sql.query", 1);
 
@@ -868,10 +1009,58 @@ static Variant php_mysql_do_query_general(CStrRef query, CVarRef link_id,
       }
     }
   }
+}
+
+static Variant php_mysql_get_result(MYSQL *conn, CStrRef query,
+                                    bool use_store) {
+  MYSQL_RES *mysql_result;
+  if (use_store) {
+    if (RuntimeOption::MySQLLocalize) {
+      return php_mysql_localize_result(conn);
+    }
+    mysql_result = mysql_store_result(conn);
+  } else {
+    mysql_result = mysql_use_result(conn);
+  }
+  if (!mysql_result) {
+    if (mysql_field_count(conn) > 0) {
+      raise_warning("Unable to save result set");
+      return false;
+    }
+    return true;
+  }
+
+  MySQLResult *r = NEWOBJ(MySQLResult)(mysql_result);
+  Object ret(r);
+
+  if (RuntimeOption::MaxSQLRowCount > 0 &&
+      (s_mysql_data->totalRowCount += r->getRowCount())
+      > RuntimeOption::MaxSQLRowCount) {
+    ExtendedLogger::Error
+      ("MaxSQLRowCount is over: fetching at least %d rows: %s",
+       s_mysql_data->totalRowCount, query.data());
+    s_mysql_data->totalRowCount = 0; // so no repetitive logging
+  }
+
+  return ret;
+}
+
+static Variant php_mysql_do_query_general(CStrRef query, CVarRef link_id,
+                                          bool use_store) {
+  if (php_mysql_read_only_skip(query)) {
+    return true; // pretend it worked
+  }
+
+  MySQL *rconn = NULL;
+  MYSQL *conn = MySQL::GetConn(link_id, &rconn);
+  if (!conn || !rconn) return false;
+
+  php_mysql_record_query_stats(query, rconn);
 
   SlowTimer timer(RuntimeOption::MySQLSlowQueryThreshold,
                   "runtime/ext_mysql: slow query", query.data());
   IOStatusHelper io("mysql::query", rconn->m_host.c_str(), rconn->m_port);
+  io.setBytes(query.size());
   unsigned long tid = mysql_thread_id(conn);
 
   // disable explicitly
@@ -880,6 +1069,7 @@ static Variant php_mysql_do_query_general(CStrRef query, CVarRef link_id,
     mySQL->m_multi_query = false;
   }
 
+  php_mysql_set_query_timeouts(conn);
   if (mysql_real_query(conn, query.data(), query.size())) {
     raise_notice("runtime/ext_mysql: failed executing [%s] [%s]", query.data(),
                  mysql_error(conn));
@@ -917,36 +1107,7 @@ static Variant php_mysql_do_query_general(CStrRef query, CVarRef link_id,
   Logger::Verbose("runtime/ext_mysql: successfully executed [%dms] [%s]",
                   (int)timer.getTime(), query.data());
 
-  MYSQL_RES *mysql_result;
-  if (use_store) {
-    if (RuntimeOption::MySQLLocalize) {
-      return php_mysql_localize_result(conn);
-    }
-    mysql_result = mysql_store_result(conn);
-  } else {
-    mysql_result = mysql_use_result(conn);
-  }
-  if (!mysql_result) {
-    if (mysql_field_count(conn) > 0) {
-      raise_warning("Unable to save result set");
-      return false;
-    }
-    return true;
-  }
-
-  MySQLResult *r = NEWOBJ(MySQLResult)(mysql_result);
-  Object ret(r);
-
-  if (RuntimeOption::MaxSQLRowCount > 0 &&
-      (s_mysql_data->totalRowCount += r->getRowCount())
-      > RuntimeOption::MaxSQLRowCount) {
-    ExtendedLogger::Error
-      ("MaxSQLRowCount is over: fetching at least %d rows: %s",
-       s_mysql_data->totalRowCount, query.data());
-    s_mysql_data->totalRowCount = 0; // so no repetitive logging
-  }
-
-  return ret;
+  return php_mysql_get_result(conn, query, use_store);
 }
 
 Variant f_mysql_query(CStrRef query, CVarRef link_identifier /* = null */) {
@@ -954,12 +1115,14 @@ Variant f_mysql_query(CStrRef query, CVarRef link_identifier /* = null */) {
 }
 
 Variant f_mysql_multi_query(CStrRef query, CVarRef link_identifier /* = null */) {
-  MYSQL *conn = MySQL::GetConn(link_identifier);
-  MySQL *mySQL = MySQL::Get(link_identifier);
+  MySQL *mySQL = NULL;
+  MYSQL *conn = MySQL::GetConn(link_identifier, &mySQL);
+  if (!conn || !mySQL) return false;
   if (!mySQL->m_multi_query && !mysql_set_server_option(conn, MYSQL_OPTION_MULTI_STATEMENTS_ON)) {
     mySQL->m_multi_query = true;
   }
 
+  php_mysql_set_query_timeouts(conn);
   if (mysql_real_query(conn, query.data(), query.size())) {
     raise_notice("runtime/ext_mysql: failed executing [%s] [%s]", query.data(),
                   mysql_error(conn));
@@ -974,6 +1137,7 @@ Variant f_mysql_multi_query(CStrRef query, CVarRef link_identifier /* = null */)
 
 bool f_mysql_next_result(CVarRef link_identifier /* = null */) {
   MYSQL *conn = MySQL::GetConn(link_identifier);
+  if (!conn) return false;
   if (!mysql_more_results(conn)) {
     raise_strict_warning("There is no next result set. "
       "Please, call mysql_more_results() to check "
@@ -984,11 +1148,13 @@ bool f_mysql_next_result(CVarRef link_identifier /* = null */) {
 
 bool f_mysql_more_results(CVarRef link_identifier /* = null */) {
   MYSQL *conn = MySQL::GetConn(link_identifier);
+  if (!conn) return false;
   return mysql_more_results(conn);
 }
 
 Variant f_mysql_fetch_result(CVarRef link_identifier /* = null */) {
     MYSQL *conn = MySQL::GetConn(link_identifier);
+    if (!conn) return false;
     MYSQL_RES *mysql_result;
 
     mysql_result = mysql_store_result(conn);
@@ -1009,6 +1175,189 @@ Variant f_mysql_unbuffered_query(CStrRef query,
   return php_mysql_do_query_general(query, link_identifier, false);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// async queries
+//
+// mysql_send_query() writes the query and returns without waiting for the
+// server. The reply is only read, with mysql_read_query_result(), once
+// poll() says the link's socket is readable, so the worker never blocks on
+// the server's execution time; a page can start queries on several links,
+// keep running PHP, and collect whatever is ready with a single wait.
+
+static int php_mysql_async_poll(struct pollfd *fds, int nfds, int timeout_ms) {
+  int64 deadline = timeout_ms > 0 ?
+    Timer::GetCurrentTimeMicros() + timeout_ms * 1000LL : 0;
+  while (true) {
+    int ret = poll(fds, nfds, timeout_ms);
+    if (ret >= 0 || errno != EINTR) return ret;
+    if (timeout_ms > 0) {
+      timeout_ms = (deadline - Timer::GetCurrentTimeMicros()) / 1000;
+      if (timeout_ms <= 0) return 0;
+    }
+  }
+}
+
+static bool php_mysql_async_ready(MySQL *mySQL, int timeout_ms) {
+  if (!mySQL->isAsyncPending()) return true;
+  struct pollfd fd;
+  fd.fd = mySQL->getSocket();
+  fd.events = POLLIN;
+  fd.revents = 0;
+  return php_mysql_async_poll(&fd, 1, timeout_ms) > 0;
+}
+
+static void php_mysql_async_abandon(MySQL *mySQL, int timeout_ms) {
+  if (!mySQL->isAsyncPending()) return;
+  MYSQL *conn = mySQL->get();
+  if (php_mysql_async_ready(mySQL, timeout_ms) &&
+      !mysql_read_query_result(conn)) {
+    mySQL->m_async_pending = false;
+    mySQL->m_async_query.clear();
+    do {
+      MYSQL_RES *res = mysql_store_result(conn);
+      if (res) mysql_free_result(res);
+    } while (!mysql_next_result(conn));
+    return;
+  }
+  // Still running or broken: the connection can't be reused either way.
+  ServerStats::Log("sql.async.abandoned", 1);
+  mySQL->close();
+}
+
+bool f_mysql_async_query_start(CStrRef query,
+                               CVarRef link_identifier /* = null */) {
+  MySQL *rconn = NULL;
+  MYSQL *conn = MySQL::GetConn(link_identifier, &rconn, true);
+  if (!conn || !rconn) return false;
+  if (rconn->isAsyncPending()) {
+    raise_warning("MySQL link already has an async query in flight");
+    return false;
+  }
+  // like mysql_query(), pretend it worked; the result is ready right away
+  rconn->m_async_skipped = php_mysql_read_only_skip(query);
+  if (rconn->m_async_skipped) return true;
+
+  php_mysql_record_query_stats(query, rconn);
+  if (RuntimeOption::EnableStats && RuntimeOption::EnableSQLStats) {
+    ServerStats::Log("sql.async.start", 1);
+  }
+
+  if (rconn->m_multi_query &&
+      !mysql_set_server_option(conn, MYSQL_OPTION_MULTI_STATEMENTS_OFF)) {
+    rconn->m_multi_query = false;
+  }
+
+  IOStatusHelper io("mysql::async_start", rconn->m_host.c_str(),
+                    rconn->m_port);
+  php_mysql_set_query_timeouts(conn);
+  if (mysql_send_query(conn, query.data(), query.size())) {
+    raise_notice("runtime/ext_mysql: failed sending [%s] [%s]", query.data(),
+                 mysql_error(conn));
+    return false;
+  }
+
+  rconn->m_async_pending = true;
+  rconn->m_async_query = std::string(query.data(), query.size());
+  rconn->m_async_start = Timer::GetCurrentTimeMicros();
+  s_mysql_data->asyncConns.set(rconn->o_getId(), Object(rconn));
+  return true;
+}
+
+bool f_mysql_async_query_completed(CVarRef link_identifier /* = null */) {
+  MySQL *rconn = NULL;
+  MYSQL *conn = MySQL::GetConn(link_identifier, &rconn, true);
+  if (!conn || !rconn) return false;
+  return php_mysql_async_ready(rconn, 0);
+}
+
+Variant f_mysql_async_query_result(CVarRef link_identifier /* = null */) {
+  MySQL *rconn = NULL;
+  MYSQL *conn = MySQL::GetConn(link_identifier, &rconn, true);
+  if (!conn || !rconn) return false;
+  if (!rconn->isAsyncPending()) {
+    if (rconn->m_async_skipped) {
+      rconn->m_async_skipped = false;
+      return true;
+    }
+    raise_warning("MySQL link has no async query in flight");
+    return false;
+  }
+
+  String query(rconn->m_async_query);
+  rconn->m_async_pending = false;
+  rconn->m_async_query.clear();
+  s_mysql_data->asyncConns.remove(rconn->o_getId());
+
+  IOStatusHelper io("mysql::async_result", rconn->m_host.c_str(),
+                    rconn->m_port);
+  int ret = mysql_read_query_result(conn);
+  int64 msec = (Timer::GetCurrentTimeMicros() - rconn->m_async_start) / 1000;
+  if (msec >= RuntimeOption::MySQLSlowQueryThreshold) {
+    Logger::Error("SlowTimer [%dms] at runtime/ext_mysql: slow async query: "
+                  "%s", (int)msec, query.data());
+  }
+  if (ret) {
+    raise_notice("runtime/ext_mysql: failed executing [%s] [%s]", query.data(),
+                 mysql_error(conn));
+    return false;
+  }
+  Logger::Verbose("runtime/ext_mysql: successfully executed [%dms] [%s]",
+                  (int)msec, query.data());
+
+  return php_mysql_get_result(conn, query, true);
+}
+
+Array f_mysql_async_wait_actionable(CArrRef links /* = null */,
+                                    double timeout /* = -1.0 */) {
+  CArrRef pending = links.empty() ? s_mysql_data->asyncConns : links;
+  Array ret = Array::Create();
+
+  std::vector<struct pollfd> fds;
+  std::vector<Variant> keys;
+  fds.reserve(pending.size());
+  keys.reserve(pending.size());
+  for (ArrayIter iter(pending); iter; ++iter) {
+    CVarRef link = iter.secondRef();
+    if (!link.isObject()) continue;
+    MySQL *mySQL = link.toObject().getTyped<MySQL>(true, true);
+    if (!mySQL || !mySQL->get()) continue;
+    if (!mySQL->isAsyncPending()) {
+      ret.set(iter.first(), link);
+      continue;
+    }
+    struct pollfd fd;
+    fd.fd = mySQL->getSocket();
+    fd.events = POLLIN;
+    fd.revents = 0;
+    fds.push_back(fd);
+    keys.push_back(iter.first());
+  }
+  if (fds.empty()) return ret;
+
+  // Something is already actionable: report it without sleeping. Otherwise
+  // "until something is ready" still stops at the read timeout, and nothing
+  // waits past the request's own time limit.
+  int64 timeout_ms = 0;
+  if (ret.empty()) {
+    timeout_ms = timeout >= 0 ? (int64)(timeout * 1000) :
+      s_mysql_data->readTimeout > 0 ? s_mysql_data->readTimeout :
+      MYSQL_ASYNC_WAIT_MS;
+    if (timeout_ms > 0) {
+      timeout_ms = TimeoutThread::ClampTimeoutMs(timeout_ms);
+    }
+  }
+  IOStatusHelper io("mysql::async_wait");
+  if (php_mysql_async_poll(&fds[0], fds.size(), timeout_ms) <= 0) {
+    return ret;
+  }
+  for (unsigned int i = 0; i < fds.size(); i++) {
+    if (fds[i].revents) ret.set(keys[i], pending[keys[i]]);
+  }
+  return ret;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 Variant f_mysql_list_dbs(CVarRef link_identifier /* = null */) {
   MYSQL *conn = MySQL::GetConn(link_identifier);
   if (!conn) return false;
@@ -919,6 +919,206 @@ TypedValue* fg_mysql_unbuffered_query(HPHP::VM::ActRec *ar) {
 
 
 
+/*
+bool HPHP::f_mysql_async_query_start(HPHP::String const&, HPHP::Variant const&)
+_ZN4HPHP25f_mysql_async_query_startERKNS_6StringERKNS_7VariantE
+
+(return value) => rax
+query => rdi
+link_identifier => rsi
+*/
+
+bool fh_mysql_async_query_start(Value* query, TypedValue* link_identifier) asm("_ZN4HPHP25f_mysql_async_query_startERKNS_6StringERKNS_7VariantE");
+
+TypedValue * fg1_mysql_async_query_start(TypedValue* rv, HPHP::VM::ActRec* ar, long long count) __attribute__((noinline,cold));
+TypedValue * fg1_mysql_async_query_start(TypedValue* rv, HPHP::VM::ActRec* ar, long long count) {
+  TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+  rv->_count = 0;
+  rv->m_type = KindOfBoolean;
+  tvCastToStringInPlace(args-0);
+  Variant defVal1;
+  rv->m_data.num = (fh_mysql_async_query_start((Value*)(args-0), (count > 1) ? (args-1) : (TypedValue*)(&defVal1))) ? 1LL : 0LL;
+  return rv;
+}
+
+TypedValue* fg_mysql_async_query_start(HPHP::VM::ActRec *ar) {
+  EXCEPTION_GATE_ENTER();
+    TypedValue rv;
+    long long count = ar->numArgs();
+    TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+    if (count >= 1LL && count <= 2LL) {
+      if (IS_STRING_TYPE((args-0)->m_type)) {
+        rv._count = 0;
+        rv.m_type = KindOfBoolean;
+        Variant defVal1;
+        rv.m_data.num = (fh_mysql_async_query_start((Value*)(args-0), (count > 1) ? (args-1) : (TypedValue*)(&defVal1))) ? 1LL : 0LL;
+        frame_free_locals_no_this_inl(ar, 2);
+        memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+        return &ar->m_r;
+      } else {
+        fg1_mysql_async_query_start(&rv, ar, count);
+        frame_free_locals_no_this_inl(ar, 2);
+        memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+        return &ar->m_r;
+      }
+    } else {
+      throw_wrong_arguments_nr("mysql_async_query_start", count, 1, 2, 1);
+    }
+    rv.m_data.num = 0LL;
+    rv._count = 0;
+    rv.m_type = KindOfNull;
+    frame_free_locals_no_this_inl(ar, 2);
+    memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+    return &ar->m_r;
+  EXCEPTION_GATE_RETURN(&ar->m_r);
+}
+
+
+
+/*
+bool HPHP::f_mysql_async_query_completed(HPHP::Variant const&)
+_ZN4HPHP29f_mysql_async_query_completedERKNS_7VariantE
+
+(return value) => rax
+link_identifier => rdi
+*/
+
+bool fh_mysql_async_query_completed(TypedValue* link_identifier) asm("_ZN4HPHP29f_mysql_async_query_completedERKNS_7VariantE");
+
+TypedValue* fg_mysql_async_query_completed(HPHP::VM::ActRec *ar) {
+  EXCEPTION_GATE_ENTER();
+    TypedValue rv;
+    long long count = ar->numArgs();
+    TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+    if (count <= 1LL) {
+      rv._count = 0;
+      rv.m_type = KindOfBoolean;
+      Variant defVal0;
+      rv.m_data.num = (fh_mysql_async_query_completed((count > 0) ? (args-0) : (TypedValue*)(&defVal0))) ? 1LL : 0LL;
+      frame_free_locals_no_this_inl(ar, 1);
+      memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+      return &ar->m_r;
+    } else {
+      throw_toomany_arguments_nr("mysql_async_query_completed", 1, 1);
+    }
+    rv.m_data.num = 0LL;
+    rv._count = 0;
+    rv.m_type = KindOfNull;
+    frame_free_locals_no_this_inl(ar, 1);
+    memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+    return &ar->m_r;
+  EXCEPTION_GATE_RETURN(&ar->m_r);
+}
+
+
+
+/*
+HPHP::Variant HPHP::f_mysql_async_query_result(HPHP::Variant const&)
+_ZN4HPHP26f_mysql_async_query_resultERKNS_7VariantE
+
+(return value) => rax
+_rv => rdi
+link_identifier => rsi
+*/
+
+TypedValue* fh_mysql_async_query_result(TypedValue* _rv, TypedValue* link_identifier) asm("_ZN4HPHP26f_mysql_async_query_resultERKNS_7VariantE");
+
+TypedValue* fg_mysql_async_query_result(HPHP::VM::ActRec *ar) {
+  EXCEPTION_GATE_ENTER();
+    TypedValue rv;
+    long long count = ar->numArgs();
+    TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+    if (count <= 1LL) {
+      Variant defVal0;
+      fh_mysql_async_query_result((&(rv)), (count > 0) ? (args-0) : (TypedValue*)(&defVal0));
+      if (rv.m_type == KindOfUninit) rv.m_type = KindOfNull;
+      frame_free_locals_no_this_inl(ar, 1);
+      memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+      return &ar->m_r;
+    } else {
+      throw_toomany_arguments_nr("mysql_async_query_result", 1, 1);
+    }
+    rv.m_data.num = 0LL;
+    rv._count = 0;
+    rv.m_type = KindOfNull;
+    frame_free_locals_no_this_inl(ar, 1);
+    memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+    return &ar->m_r;
+  EXCEPTION_GATE_RETURN(&ar->m_r);
+}
+
+
+
+/*
+HPHP::Array HPHP::f_mysql_async_wait_actionable(HPHP::Array const&, double)
+_ZN4HPHP29f_mysql_async_wait_actionableERKNS_5ArrayEd
+
+(return value) => rax
+_rv => rdi
+links => rsi
+timeout => xmm0
+*/
+
+Value* fh_mysql_async_wait_actionable(Value* _rv, Value* links, double timeout) asm("_ZN4HPHP29f_mysql_async_wait_actionableERKNS_5ArrayEd");
+
+TypedValue * fg1_mysql_async_wait_actionable(TypedValue* rv, HPHP::VM::ActRec* ar, long long count) __attribute__((noinline,cold));
+TypedValue * fg1_mysql_async_wait_actionable(TypedValue* rv, HPHP::VM::ActRec* ar, long long count) {
+  TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+  rv->_count = 0;
+  rv->m_type = KindOfArray;
+  switch (count) {
+  default: // count >= 2
+    if ((args-1)->m_type != KindOfDouble) {
+      tvCastToDoubleInPlace(args-1);
+    }
+  case 1:
+    if ((args-0)->m_type != KindOfArray) {
+      tvCastToArrayInPlace(args-0);
+    }
+  case 0:
+    break;
+  }
+  Array defVal0 = null;
+  fh_mysql_async_wait_actionable((Value*)(rv), (count > 0) ? (Value*)(args-0) : (Value*)(&defVal0), (count > 1) ? (args[-1].m_data.dbl) : (double)(-1.0));
+  if (rv->m_data.num == 0LL) rv->m_type = KindOfNull;
+  return rv;
+}
+
+TypedValue* fg_mysql_async_wait_actionable(HPHP::VM::ActRec *ar) {
+  EXCEPTION_GATE_ENTER();
+    TypedValue rv;
+    long long count = ar->numArgs();
+    TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+    if (count <= 2LL) {
+      if ((count <= 1 || (args-1)->m_type == KindOfDouble) && (count <= 0 || (args-0)->m_type == KindOfArray)) {
+        rv._count = 0;
+        rv.m_type = KindOfArray;
+        Array defVal0 = null;
+        fh_mysql_async_wait_actionable((Value*)(&(rv)), (count > 0) ? (Value*)(args-0) : (Value*)(&defVal0), (count > 1) ? (args[-1].m_data.dbl) : (double)(-1.0));
+        if (rv.m_data.num == 0LL) rv.m_type = KindOfNull;
+        frame_free_locals_no_this_inl(ar, 2);
+        memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+        return &ar->m_r;
+      } else {
+        fg1_mysql_async_wait_actionable(&rv, ar, count);
+        frame_free_locals_no_this_inl(ar, 2);
+        memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+        return &ar->m_r;
+      }
+    } else {
+      throw_toomany_arguments_nr("mysql_async_wait_actionable", 2, 1);
+    }
+    rv.m_data.num = 0LL;
+    rv._count = 0;
+    rv.m_type = KindOfNull;
+    frame_free_locals_no_this_inl(ar, 2);
+    memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+    return &ar->m_r;
+  EXCEPTION_GATE_RETURN(&ar->m_r);
+}
+
+
+
 /*
 HPHP::Variant HPHP::f_mysql_list_dbs(HPHP::Variant const&)
 _ZN4HPHP16f_mysql_list_dbsERKNS_7VariantE
@@ -36,7 +36,13 @@ public:
   /**
    * Operations on a resource object.
    */
-  static MYSQL *GetConn(CVarRef link_identifier, MySQL **rconn = NULL);
+  /**
+   * Fails with a warning while the link has an async query in flight,
+   * since anything else sent down it would be read as the query's reply.
+   * Only the mysql_async_* functions pass asyncOk.
+   */
+  static MYSQL *GetConn(CVarRef link_identifier, MySQL **rconn = NULL,
+                        bool asyncOk = false);
   static MySQL *Get(CVarRef link_identifier);
   static bool CloseConn(CVarRef link_identifier);
 
@@ -106,10 +112,30 @@ public:
                  CStrRef password, CStrRef database, int client_flags,
                  int connect_timeout);
 
+  /**
+   * With MySQL.Pool.Enable, pconnect links borrow their connection from
+   * MySQLConnectionPool instead, and close() hands it back.
+   */
+  bool checkoutPooled(CStrRef host, int port, CStrRef socket,
+                      CStrRef username, CStrRef password, CStrRef database,
+                      int client_flags, int connect_timeout);
+  bool isPooled() const { return !m_pool_key.empty(); }
+
   MYSQL *get() { return m_conn;}
 
+  /**
+   * Async queries: the query is sent right away and the result is read once
+   * the socket turns readable. A connection with a query in flight can't be
+   * used for anything else until its result has been fetched. A write
+   * skipped because of MySQLReadOnly is never sent; its "result" is TRUE.
+   */
+  bool isAsyncPending() const { return m_async_pending; }
+  int getSocket() const;
+
 private:
   MYSQL *m_conn;
+  std::string m_pool_host;
+  std::string m_pool_key;
 
 public:
   std::string m_host;
@@ -122,6 +148,10 @@ public:
   std::string m_last_error;
   int m_xaction_count;
   bool m_multi_query;
+  bool m_async_pending;
+  bool m_async_skipped;
+  std::string m_async_query;
+  int64 m_async_start;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -351,6 +381,15 @@ Variant f_mysql_fetch_result(CVarRef link_identifier = null);
 
 Variant f_mysql_unbuffered_query(CStrRef query,
                                  CVarRef link_identifier = null);
+
+bool f_mysql_async_query_start(CStrRef query, CVarRef link_identifier = null);
+
+bool f_mysql_async_query_completed(CVarRef link_identifier = null);
+
+Variant f_mysql_async_query_result(CVarRef link_identifier = null);
+
+Array f_mysql_async_wait_actionable(CArrRef links = null,
+                                    double timeout = -1.0);
 inline Variant f_mysql_db_query(CStrRef database, CStrRef query,
                                 CVarRef link_identifier = null) {
   throw NotSupportedException
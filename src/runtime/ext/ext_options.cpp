@@ -759,6 +759,23 @@ void f_set_time_limit(int seconds) {
   }
 }
 
+void f_hphp_set_time_limit_ms(int milliseconds) {
+  TimeoutThread::SetTimeoutMs(milliseconds);
+  g_context->setRequestTimeLimit((milliseconds + 999) / 1000);
+}
+
+void f_hphp_set_cpu_time_limit_ms(int milliseconds) {
+  TimeoutThread::SetCpuTimeoutMs(milliseconds);
+}
+
+int64 f_hphp_get_time_remaining_ms() {
+  return TimeoutThread::GetRemainingMs();
+}
+
+int64 f_hphp_get_cpu_time_remaining_ms() {
+  return TimeoutThread::GetCpuRemainingMs();
+}
+
 String f_sys_get_temp_dir() {
   char *env = getenv("TMPDIR");
   if (env && *env) return String(env, CopyString);
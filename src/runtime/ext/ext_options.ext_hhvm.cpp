@@ -2189,6 +2189,184 @@ TypedValue* fg_set_time_limit(HPHP::VM::ActRec *ar) {
 
 
 
+/*
+void HPHP::f_hphp_set_time_limit_ms(int)
+_ZN4HPHP24f_hphp_set_time_limit_msEi
+
+milliseconds => rdi
+*/
+
+void fh_hphp_set_time_limit_ms(int milliseconds) asm("_ZN4HPHP24f_hphp_set_time_limit_msEi");
+
+TypedValue * fg1_hphp_set_time_limit_ms(TypedValue* rv, HPHP::VM::ActRec* ar, long long count) __attribute__((noinline,cold));
+TypedValue * fg1_hphp_set_time_limit_ms(TypedValue* rv, HPHP::VM::ActRec* ar, long long count) {
+  TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+  rv->m_data.num = 0LL;
+  rv->_count = 0;
+  rv->m_type = KindOfNull;
+  tvCastToInt64InPlace(args-0);
+  fh_hphp_set_time_limit_ms((int)(args[-0].m_data.num));
+  return rv;
+}
+
+TypedValue* fg_hphp_set_time_limit_ms(HPHP::VM::ActRec *ar) {
+  EXCEPTION_GATE_ENTER();
+    TypedValue rv;
+    long long count = ar->numArgs();
+    TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+    if (count == 1LL) {
+      if ((args-0)->m_type == KindOfInt64) {
+        rv.m_data.num = 0LL;
+        rv._count = 0;
+        rv.m_type = KindOfNull;
+        fh_hphp_set_time_limit_ms((int)(args[-0].m_data.num));
+        frame_free_locals_no_this_inl(ar, 1);
+        memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+        return &ar->m_r;
+      } else {
+        fg1_hphp_set_time_limit_ms(&rv, ar, count);
+        frame_free_locals_no_this_inl(ar, 1);
+        memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+        return &ar->m_r;
+      }
+    } else {
+      throw_wrong_arguments_nr("hphp_set_time_limit_ms", count, 1, 1, 1);
+    }
+    rv.m_data.num = 0LL;
+    rv._count = 0;
+    rv.m_type = KindOfNull;
+    frame_free_locals_no_this_inl(ar, 1);
+    memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+    return &ar->m_r;
+  EXCEPTION_GATE_RETURN(&ar->m_r);
+}
+
+
+
+/*
+void HPHP::f_hphp_set_cpu_time_limit_ms(int)
+_ZN4HPHP28f_hphp_set_cpu_time_limit_msEi
+
+milliseconds => rdi
+*/
+
+void fh_hphp_set_cpu_time_limit_ms(int milliseconds) asm("_ZN4HPHP28f_hphp_set_cpu_time_limit_msEi");
+
+TypedValue * fg1_hphp_set_cpu_time_limit_ms(TypedValue* rv, HPHP::VM::ActRec* ar, long long count) __attribute__((noinline,cold));
+TypedValue * fg1_hphp_set_cpu_time_limit_ms(TypedValue* rv, HPHP::VM::ActRec* ar, long long count) {
+  TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+  rv->m_data.num = 0LL;
+  rv->_count = 0;
+  rv->m_type = KindOfNull;
+  tvCastToInt64InPlace(args-0);
+  fh_hphp_set_cpu_time_limit_ms((int)(args[-0].m_data.num));
+  return rv;
+}
+
+TypedValue* fg_hphp_set_cpu_time_limit_ms(HPHP::VM::ActRec *ar) {
+  EXCEPTION_GATE_ENTER();
+    TypedValue rv;
+    long long count = ar->numArgs();
+    TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+    if (count == 1LL) {
+      if ((args-0)->m_type == KindOfInt64) {
+        rv.m_data.num = 0LL;
+        rv._count = 0;
+        rv.m_type = KindOfNull;
+        fh_hphp_set_cpu_time_limit_ms((int)(args[-0].m_data.num));
+        frame_free_locals_no_this_inl(ar, 1);
+        memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+        return &ar->m_r;
+      } else {
+        fg1_hphp_set_cpu_time_limit_ms(&rv, ar, count);
+        frame_free_locals_no_this_inl(ar, 1);
+        memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+        return &ar->m_r;
+      }
+    } else {
+      throw_wrong_arguments_nr("hphp_set_cpu_time_limit_ms", count, 1, 1, 1);
+    }
+    rv.m_data.num = 0LL;
+    rv._count = 0;
+    rv.m_type = KindOfNull;
+    frame_free_locals_no_this_inl(ar, 1);
+    memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+    return &ar->m_r;
+  EXCEPTION_GATE_RETURN(&ar->m_r);
+}
+
+
+
+/*
+long long HPHP::f_hphp_get_time_remaining_ms()
+_ZN4HPHP28f_hphp_get_time_remaining_msEv
+
+(return value) => rax
+*/
+
+long long fh_hphp_get_time_remaining_ms() asm("_ZN4HPHP28f_hphp_get_time_remaining_msEv");
+
+TypedValue* fg_hphp_get_time_remaining_ms(HPHP::VM::ActRec *ar) {
+  EXCEPTION_GATE_ENTER();
+    TypedValue rv;
+    long long count = ar->numArgs();
+    TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+    if (count == 0LL) {
+      rv._count = 0;
+      rv.m_type = KindOfInt64;
+      rv.m_data.num = (long long)fh_hphp_get_time_remaining_ms();
+      frame_free_locals_no_this_inl(ar, 0);
+      memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+      return &ar->m_r;
+    } else {
+      throw_toomany_arguments_nr("hphp_get_time_remaining_ms", 0, 1);
+    }
+    rv.m_data.num = 0LL;
+    rv._count = 0;
+    rv.m_type = KindOfNull;
+    frame_free_locals_no_this_inl(ar, 0);
+    memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+    return &ar->m_r;
+  EXCEPTION_GATE_RETURN(&ar->m_r);
+}
+
+
+
+/*
+long long HPHP::f_hphp_get_cpu_time_remaining_ms()
+_ZN4HPHP32f_hphp_get_cpu_time_remaining_msEv
+
+(return value) => rax
+*/
+
+long long fh_hphp_get_cpu_time_remaining_ms() asm("_ZN4HPHP32f_hphp_get_cpu_time_remaining_msEv");
+
+TypedValue* fg_hphp_get_cpu_time_remaining_ms(HPHP::VM::ActRec *ar) {
+  EXCEPTION_GATE_ENTER();
+    TypedValue rv;
+    long long count = ar->numArgs();
+    TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+    if (count == 0LL) {
+      rv._count = 0;
+      rv.m_type = KindOfInt64;
+      rv.m_data.num = (long long)fh_hphp_get_cpu_time_remaining_ms();
+      frame_free_locals_no_this_inl(ar, 0);
+      memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+      return &ar->m_r;
+    } else {
+      throw_toomany_arguments_nr("hphp_get_cpu_time_remaining_ms", 0, 1);
+    }
+    rv.m_data.num = 0LL;
+    rv._count = 0;
+    rv.m_type = KindOfNull;
+    frame_free_locals_no_this_inl(ar, 0);
+    memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+    return &ar->m_r;
+  EXCEPTION_GATE_RETURN(&ar->m_r);
+}
+
+
+
 /*
 HPHP::String HPHP::f_sys_get_temp_dir()
 _ZN4HPHP18f_sys_get_temp_dirEv
@@ -72,6 +72,10 @@ String f_phpversion(CStrRef extension = null_string);
 bool f_putenv(CStrRef setting);
 bool f_set_magic_quotes_runtime(bool new_setting);
 void f_set_time_limit(int seconds);
+void f_hphp_set_time_limit_ms(int milliseconds);
+void f_hphp_set_cpu_time_limit_ms(int milliseconds);
+int64 f_hphp_get_time_remaining_ms();
+int64 f_hphp_get_cpu_time_remaining_ms();
 String f_sys_get_temp_dir();
 Variant f_version_compare(CStrRef version1, CStrRef version2, CStrRef sop = null_string);
 String f_zend_logo_guid();
@@ -17,6 +17,7 @@
 
 #include <runtime/ext/ext_output.h>
 #include <runtime/ext/ext_json.h>
+#include <runtime/base/server/io_trace.h>
 #include <runtime/base/runtime_option.h>
 #include <util/hardware_counter.h>
 #include <util/lock.h>
@@ -153,6 +154,14 @@ Array f_hphp_get_status() {
   return f_json_decode(String(out));
 }
 
+void f_hphp_io_trace_start() {
+  IOTrace::Enable();
+}
+
+Array f_hphp_get_io_trace() {
+  return IOTrace::GetEvents();
+}
+
 static double ts_float(const timespec &ts) {
   return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000;
 }
@@ -165,6 +165,78 @@ TypedValue* fg_hphp_get_status(HPHP::VM::ActRec *ar) {
 
 
 
+/*
+void HPHP::f_hphp_io_trace_start()
+_ZN4HPHP21f_hphp_io_trace_startEv
+
+*/
+
+void fh_hphp_io_trace_start() asm("_ZN4HPHP21f_hphp_io_trace_startEv");
+
+TypedValue* fg_hphp_io_trace_start(HPHP::VM::ActRec *ar) {
+  EXCEPTION_GATE_ENTER();
+    TypedValue rv;
+    long long count = ar->numArgs();
+    TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+    if (count == 0LL) {
+      rv.m_data.num = 0LL;
+      rv._count = 0;
+      rv.m_type = KindOfNull;
+      fh_hphp_io_trace_start();
+      frame_free_locals_no_this_inl(ar, 0);
+      memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+      return &ar->m_r;
+    } else {
+      throw_toomany_arguments_nr("hphp_io_trace_start", 0, 1);
+    }
+    rv.m_data.num = 0LL;
+    rv._count = 0;
+    rv.m_type = KindOfNull;
+    frame_free_locals_no_this_inl(ar, 0);
+    memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+    return &ar->m_r;
+  EXCEPTION_GATE_RETURN(&ar->m_r);
+}
+
+
+
+/*
+HPHP::Array HPHP::f_hphp_get_io_trace()
+_ZN4HPHP19f_hphp_get_io_traceEv
+
+(return value) => rax
+_rv => rdi
+*/
+
+Value* fh_hphp_get_io_trace(Value* _rv) asm("_ZN4HPHP19f_hphp_get_io_traceEv");
+
+TypedValue* fg_hphp_get_io_trace(HPHP::VM::ActRec *ar) {
+  EXCEPTION_GATE_ENTER();
+    TypedValue rv;
+    long long count = ar->numArgs();
+    TypedValue* args UNUSED = ((TypedValue*)ar) - 1;
+    if (count == 0LL) {
+      rv._count = 0;
+      rv.m_type = KindOfArray;
+      fh_hphp_get_io_trace((Value*)(&(rv)));
+      if (rv.m_data.num == 0LL) rv.m_type = KindOfNull;
+      frame_free_locals_no_this_inl(ar, 0);
+      memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+      return &ar->m_r;
+    } else {
+      throw_toomany_arguments_nr("hphp_get_io_trace", 0, 1);
+    }
+    rv.m_data.num = 0LL;
+    rv._count = 0;
+    rv.m_type = KindOfNull;
+    frame_free_locals_no_this_inl(ar, 0);
+    memcpy(&ar->m_r, &rv, sizeof(TypedValue));
+    return &ar->m_r;
+  EXCEPTION_GATE_RETURN(&ar->m_r);
+}
+
+
+
 /*
 HPHP::Variant HPHP::f_hphp_get_timers(bool)
 _ZN4HPHP17f_hphp_get_timersEb
@@ -97,6 +97,8 @@ inline int64 f_hphp_get_stats(CStrRef name) {
   return ServerStats::Get(name.data());
 }
 Array f_hphp_get_status();
+void f_hphp_io_trace_start();
+Array f_hphp_get_io_trace();
 inline Array f_hphp_get_iostatus() {
   return ServerStats::GetThreadIOStatuses();
 }
@@ -27,9 +27,12 @@
 #include <runtime/base/time/datetime.h>
 #include <runtime/base/variable_unserializer.h>
 #include <runtime/base/array/array_iterator.h>
+#include <runtime/base/shared/shared_session_store.h>
+#include <runtime/base/server/server_stats.h>
 #include <util/lock.h>
 #include <util/logger.h>
 #include <util/compatibility.h>
+#include <util/hash.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -753,6 +756,98 @@ public:
 };
 static UserSessionModule s_user_session_module;
 
+///////////////////////////////////////////////////////////////////////////////
+// SharedMemorySessionModule
+
+/**
+ * "shm": sessions live in s_shared_session_store, shared by every request
+ * thread in the process, instead of one file each. Good for a single box;
+ * sessions don't survive a restart and aren't seen by other machines.
+ *
+ * Writes are checked against the version this request read, so a request
+ * that didn't see another one's changes can't overwrite them. Such a
+ * write fails and session_write_close() warns, as with any failed write.
+ * A request that leaves the data as it read it only pushes back the
+ * expiry, so it never conflicts.
+ */
+class SharedMemorySessionData {
+public:
+  SharedMemorySessionData() : m_version(-1), m_readLen(0), m_readHash(0) {}
+
+  void reset() {
+    m_key.clear();
+    m_version = -1;
+  }
+
+  bool read(const char *key, String &value) {
+    std::string data;
+    m_key = key;
+    m_version = s_shared_session_store.read(m_key, PS(gc_maxlifetime), data);
+    m_readLen = data.size();
+    m_readHash = hash_string_cs(data.data(), data.size());
+    value = String(data.data(), data.size(), CopyString);
+    return true;
+  }
+
+  bool write(const char *key, CStrRef value) {
+    bool readKey = m_key == key;
+    if (readKey && m_version > 0 && value.size() == m_readLen &&
+        hash_string_cs(value.data(), value.size()) == m_readHash) {
+      // unmodified; whatever was written since is newer, so leave it be
+      s_shared_session_store.touch(key, PS(gc_maxlifetime));
+      return true;
+    }
+    // a key this request never read, e.g. after session_regenerate_id(),
+    // has nothing to be checked against
+    int64 version = readKey ? m_version : -1;
+    SharedSessionStore::WriteResult ret =
+      s_shared_session_store.write(key, value.data(), value.size(), version,
+                                   PS(gc_maxlifetime));
+    if (ret == SharedSessionStore::Conflict) {
+      ServerStats::Log("session.shm.conflict", 1);
+      return false;
+    }
+    return true;
+  }
+
+private:
+  std::string m_key;
+  int64 m_version; // what read() saw, -1 if nothing was read
+  int m_readLen;
+  int64 m_readHash; // of the bytes read() returned
+};
+IMPLEMENT_THREAD_LOCAL(SharedMemorySessionData, s_shm_session_data);
+
+class SharedMemorySessionModule : public SessionModule {
+public:
+  SharedMemorySessionModule() : SessionModule("shm") {}
+
+  virtual bool open(const char *save_path, const char *session_name) {
+    s_shm_session_data->reset();
+    return true;
+  }
+  virtual bool close() {
+    s_shm_session_data->reset();
+    return true;
+  }
+  virtual bool read(const char *key, String &value) {
+    return s_shm_session_data->read(key, value);
+  }
+  virtual bool write(const char *key, CStrRef value) {
+    return s_shm_session_data->write(key, value);
+  }
+  virtual bool destroy(const char *key) {
+    s_shared_session_store.erase(key);
+    s_shm_session_data->reset();
+    return true;
+  }
+  virtual bool gc(int maxlifetime, int *nrdels) {
+    *nrdels = s_shared_session_store.gc(maxlifetime);
+    return true;
+  }
+};
+static SharedMemorySessionModule s_shm_session_module;
+
 ///////////////////////////////////////////////////////////////////////////////
 // session serializers
 
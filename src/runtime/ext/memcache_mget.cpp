@@ -0,0 +1,372 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include <runtime/ext/memcache_mget.h>
+#include <util/timer.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <poll.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+#define MGET_MAX_KEY_LENGTH 250
+#define MGET_READ_SIZE (64 * 1024)
+
+struct MemcacheMultiGet::Conn {
+  Conn(const std::string &h, int p)
+    : host(h), port(p), fd(-1), connecting(false), reused(false), sent(0),
+      parsed(0), done(false), failed(false) {}
+  ~Conn() { disconnect(); }
+
+  std::string host;
+  int port;
+  int fd;
+  bool connecting;
+  bool reused;
+
+  std::string out;
+  size_t sent;
+  std::string in;
+  size_t parsed;
+  bool done;
+  bool failed;
+
+  void disconnect() {
+    if (fd >= 0) {
+      ::close(fd);
+      fd = -1;
+    }
+    connecting = false;
+  }
+
+  bool connect() {
+    struct addrinfo hints, *res;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    char service[16];
+    snprintf(service, sizeof(service), "%d", port);
+    if (getaddrinfo(host.c_str(), service, &hints, &res) != 0) {
+      return false;
+    }
+    fd = socket(res->ai_family, SOCK_STREAM, 0);
+    if (fd >= 0) {
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+      int one = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      if (::connect(fd, res->ai_addr, res->ai_addrlen) == 0) {
+        connecting = false;
+      } else if (errno == EINPROGRESS) {
+        connecting = true;
+      } else {
+        disconnect();
+      }
+    }
+    freeaddrinfo(res);
+    return fd >= 0;
+  }
+
+  /*
+   * A kept-alive socket the server has since closed only shows up once we
+   * use it, so that gets one fresh connection before counting as a failure.
+   */
+  void fail() {
+    if (reused && in.empty()) {
+      reused = false;
+      disconnect();
+      sent = 0;
+      if (connect()) return;
+    }
+    abandon();
+  }
+
+  /*
+   * Gives up on the server for this call without any retry, e.g. once the
+   * deadline has passed.
+   */
+  void abandon() {
+    failed = true;
+    done = true;
+    disconnect();
+  }
+};
+
+MemcacheMultiGet::MemcacheMultiGet() {
+}
+
+MemcacheMultiGet::~MemcacheMultiGet() {
+  close();
+}
+
+void MemcacheMultiGet::close() {
+  for (unsigned int i = 0; i < m_conns.size(); i++) {
+    delete m_conns[i];
+  }
+  m_conns.clear();
+  m_items.clear();
+}
+
+MemcacheMultiGet::Item MemcacheMultiGet::get(int i) const {
+  const ItemPos &pos = m_items[i];
+  const std::string &in = m_conns[pos.conn]->in;
+  Item item;
+  item.key = in.data() + pos.keyOff;
+  item.keyLen = pos.keyLen;
+  item.value = in.data() + pos.valueOff;
+  item.valueLen = pos.valueLen;
+  item.flags = pos.flags;
+  return item;
+}
+
+MemcacheMultiGet::Conn *
+MemcacheMultiGet::getConn(memcached_server_instance_st instance, int pos) {
+  if ((int)m_conns.size() <= pos) {
+    m_conns.resize(pos + 1, NULL);
+  }
+  std::string host = memcached_server_name(instance);
+  int port = memcached_server_port(instance);
+  Conn *&conn = m_conns[pos];
+  if (conn && (conn->host != host || conn->port != port)) {
+    // the server list changed under us
+    delete conn;
+    conn = NULL;
+  }
+  if (!conn) {
+    conn = new Conn(host, port);
+  }
+  return conn;
+}
+
+static bool valid_key(const char *key, size_t len) {
+  if (len == 0 || len > MGET_MAX_KEY_LENGTH) return false;
+  for (size_t i = 0; i < len; i++) {
+    unsigned char c = key[i];
+    if (c <= ' ' || c == 0x7f) return false;
+  }
+  return true;
+}
+
+/*
+ * Consumes whole replies from conn's buffer. Each VALUE line is only taken
+ * once its data block is all there; on END the connection is done and can
+ * be reused by the next fetch().
+ */
+bool MemcacheMultiGet::parse(int idx) {
+  Conn &conn = *m_conns[idx];
+  const char *base = conn.in.data();
+  size_t size = conn.in.size();
+
+  while (conn.parsed < size) {
+    const char *line = base + conn.parsed;
+    const char *eol = (const char *)memchr(line, '\n', size - conn.parsed);
+    if (!eol) return true;
+    size_t lineLen = eol - line + 1;
+
+    if (lineLen >= 5 && !strncmp(line, "END\r\n", 5)) {
+      conn.parsed += lineLen;
+      conn.done = true;
+      return true;
+    }
+    if (lineLen < 6 || strncmp(line, "VALUE ", 6)) {
+      // ERROR, CLIENT_ERROR or SERVER_ERROR: the stream is of no more use
+      return false;
+    }
+
+    const char *p = line + 6;
+    const char *key = p;
+    while (p < eol && *p != ' ') p++;
+    int keyLen = p - key;
+    char *q;
+    unsigned long flags = strtoul(p, &q, 10);
+    long bytes = strtol(q, &q, 10);
+    if (keyLen == 0 || q == p || bytes < 0) return false;
+
+    size_t need = conn.parsed + lineLen + bytes + 2;
+    if (need > size) {
+      // make room for the rest of the value in one go
+      if (conn.in.capacity() < need + MGET_READ_SIZE) {
+        conn.in.reserve(need + MGET_READ_SIZE);
+      }
+      return true;
+    }
+
+    ItemPos pos;
+    pos.conn = idx;
+    pos.keyOff = key - base;
+    pos.keyLen = keyLen;
+    pos.valueOff = conn.parsed + lineLen;
+    pos.valueLen = bytes;
+    pos.flags = flags;
+    m_items.push_back(pos);
+    conn.parsed = need;
+  }
+  return true;
+}
+
+bool MemcacheMultiGet::fetch(memcached_st *mc, const char *const *keys,
+                             const size_t *lens, int count) {
+  m_items.clear();
+
+  int server_count = memcached_server_count(mc);
+  if (server_count == 0) return false;
+  for (int i = 0; i < server_count; i++) {
+    memcached_server_instance_st instance =
+      memcached_server_instance_by_position(mc, i);
+    if (instance->type != MEMCACHED_CONNECTION_TCP) return false;
+  }
+  for (int i = 0; i < count; i++) {
+    if (!valid_key(keys[i], lens[i])) return false;
+  }
+
+  // group the keys by server, in one "get" command each
+  std::vector<int> active;
+  for (int i = 0; i < count; i++) {
+    int pos = memcached_generate_hash(mc, keys[i], lens[i]);
+    Conn *conn = getConn(memcached_server_instance_by_position(mc, pos), pos);
+    if (conn->out.empty()) {
+      conn->out.reserve(count * (lens[i] + 1) / server_count + 16);
+      conn->out.append("get");
+      conn->sent = 0;
+      conn->in.clear();
+      conn->parsed = 0;
+      conn->done = conn->failed = false;
+      active.push_back(pos);
+    }
+    conn->out.push_back(' ');
+    conn->out.append(keys[i], lens[i]);
+  }
+
+  int64 timeout = memcached_behavior_get(mc, MEMCACHED_BEHAVIOR_POLL_TIMEOUT);
+  bool connecting = false;
+  for (unsigned int i = 0; i < active.size(); i++) {
+    Conn *conn = m_conns[active[i]];
+    conn->out.append("\r\n");
+    conn->reused = conn->fd >= 0;
+    if (conn->fd < 0) {
+      if (!conn->connect()) {
+        conn->fail();
+      } else {
+        connecting = true;
+      }
+    }
+  }
+  if (connecting) {
+    timeout += memcached_behavior_get(mc, MEMCACHED_BEHAVIOR_CONNECT_TIMEOUT);
+  }
+  int64 deadline = Timer::GetCurrentTimeMicros() + timeout * 1000;
+
+  std::vector<struct pollfd> fds;
+  std::vector<int> polled;
+  fds.reserve(active.size());
+  polled.reserve(active.size());
+  while (true) {
+    fds.clear();
+    polled.clear();
+    for (unsigned int i = 0; i < active.size(); i++) {
+      Conn *conn = m_conns[active[i]];
+      if (conn->done) continue;
+      struct pollfd pfd;
+      pfd.fd = conn->fd;
+      pfd.events = (conn->connecting || conn->sent < conn->out.size()) ?
+        POLLOUT : POLLIN;
+      pfd.revents = 0;
+      fds.push_back(pfd);
+      polled.push_back(active[i]);
+    }
+    if (fds.empty()) break;
+
+    int64 left = deadline - Timer::GetCurrentTimeMicros();
+    if (left <= 0) break;
+    int n = poll(&fds[0], fds.size(), (left + 999) / 1000);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+
+    for (unsigned int i = 0; i < fds.size(); i++) {
+      if (!fds[i].revents) continue;
+      Conn *conn = m_conns[polled[i]];
+      if (fds[i].revents & (POLLERR | POLLNVAL)) {
+        conn->fail();
+        continue;
+      }
+      if (conn->connecting) {
+        int err = 0;
+        socklen_t errlen = sizeof(err);
+        if (getsockopt(conn->fd, SOL_SOCKET, SO_ERROR, &err, &errlen) < 0 ||
+            err) {
+          conn->fail();
+          continue;
+        }
+        conn->connecting = false;
+      }
+      if (conn->sent < conn->out.size()) {
+        ssize_t w = send(conn->fd, conn->out.data() + conn->sent,
+                         conn->out.size() - conn->sent, MSG_NOSIGNAL);
+        if (w < 0) {
+          if (errno != EAGAIN && errno != EINTR) conn->fail();
+          continue;
+        }
+        conn->sent += w;
+        continue;
+      }
+
+      size_t size = conn->in.size();
+      size_t room = conn->in.capacity() - size;
+      if (room < MGET_READ_SIZE / 4) room = MGET_READ_SIZE;
+      conn->in.resize(size + room);
+      ssize_t r = recv(conn->fd, &conn->in[size], room, 0);
+      conn->in.resize(size + (r > 0 ? r : 0));
+      if (r == 0 || (r < 0 && errno != EAGAIN && errno != EINTR)) {
+        conn->fail();
+        continue;
+      }
+      if (r > 0 && !parse(polled[i])) {
+        conn->fail();
+      }
+    }
+  }
+
+  for (unsigned int i = 0; i < active.size(); i++) {
+    Conn *conn = m_conns[active[i]];
+    conn->out.clear();
+    if (!conn->done) {
+      // timed out, maybe half way through a reply; the stream can't be
+      // reused, and it is too late to try a fresh one
+      conn->abandon();
+    }
+  }
+
+  // A failed server's items stay in its buffer, but a partial reply is
+  // not something to hand back.
+  unsigned int kept = 0;
+  for (unsigned int i = 0; i < m_items.size(); i++) {
+    if (!m_conns[m_items[i].conn]->failed) {
+      m_items[kept++] = m_items[i];
+    }
+  }
+  m_items.resize(kept);
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,88 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef __HPHP_MEMCACHE_MGET_H__
+#define __HPHP_MEMCACHE_MGET_H__
+
+#include <util/base.h>
+#include <libmemcached/memcached.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Multi-key get for Memcache::get(array). Keys are split by the server
+ * libmemcached would send them to, one text protocol "get" goes out to
+ * every server at once, and all replies are read under a single poll()
+ * loop, so the call takes about as long as the slowest server rather than
+ * the sum of them.
+ *
+ * Values are left in the receive buffers; the caller decodes them (and
+ * decompresses or unserializes them) once all servers have answered. They
+ * stay valid until the next fetch() or close().
+ *
+ * Sockets are kept open between calls, one per server.
+ */
+class MemcacheMultiGet {
+public:
+  struct Item {
+    const char *key;
+    int keyLen;
+    const char *value;
+    int valueLen;
+    uint32 flags;
+  };
+
+  MemcacheMultiGet();
+  ~MemcacheMultiGet();
+
+  /**
+   * Fetches keys[0, count). Returns false without sending anything if this
+   * can't be done here (a unix socket or UDP server, or a key the text
+   * protocol can't carry); the caller then goes through memcached_mget().
+   * A server that fails or times out is dropped from this call, so its
+   * keys read as misses, same as with libmemcached.
+   */
+  bool fetch(memcached_st *mc, const char *const *keys, const size_t *lens,
+             int count);
+
+  int size() const { return m_items.size(); }
+  Item get(int i) const;
+
+  void close();
+
+private:
+  struct Conn;
+
+  std::vector<Conn*> m_conns;  // by server position
+  struct ItemPos {
+    int conn;
+    int keyOff;
+    int keyLen;
+    int valueOff;
+    int valueLen;
+    uint32 flags;
+  };
+  std::vector<ItemPos> m_items;
+
+  Conn *getConn(memcached_server_instance_st instance, int pos);
+  bool parse(int idx);
+};
+
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif // __HPHP_MEMCACHE_MGET_H__
@@ -0,0 +1,397 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include <runtime/ext/mysql_pool.h>
+#include <runtime/base/runtime_option.h>
+#include <runtime/base/server/server_stats.h>
+#include <util/lock.h>
+#include <util/logger.h>
+#include <util/timer.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+static MySQLConnectionPool s_pool;
+
+MYSQL *MySQLConnectionPool::Checkout(const std::string &host,
+                                     const std::string &key, bool &slot) {
+  return s_pool.checkout(host, key, slot);
+}
+
+void MySQLConnectionPool::Checkin(const std::string &host,
+                                  const std::string &key, MYSQL *conn) {
+  s_pool.checkin(host, key, conn);
+}
+
+void MySQLConnectionPool::Discard(const std::string &host) {
+  s_pool.discard(host);
+}
+
+void MySQLConnectionPool::Start() {
+  s_pool.start();
+}
+
+void MySQLConnectionPool::Stop() {
+  s_pool.stop();
+}
+
+void MySQLConnectionPool::HealthCheck(time_t now) {
+  s_pool.healthCheck(now);
+}
+
+std::string MySQLConnectionPool::ReportStats() {
+  return s_pool.reportStats();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static int host_limit(const std::map<std::string, int> &overrides,
+                      const std::string &name, int def) {
+  std::map<std::string, int>::const_iterator iter = overrides.find(name);
+  if (iter == overrides.end()) {
+    // "host:port" falls back to a setting for the bare host
+    size_t pos = name.rfind(':');
+    if (pos != std::string::npos) {
+      iter = overrides.find(name.substr(0, pos));
+    }
+  }
+  return iter != overrides.end() ? iter->second : def;
+}
+
+/*
+ * Puts the session back the way a fresh connection would have it, as far
+ * as the next user could notice without asking: no open transaction,
+ * autocommit on. Other session state (user variables, SET) is left alone,
+ * the same as with thread-local persistent connections.
+ */
+static bool reset_conn(MYSQL *conn) {
+  if (conn->status != MYSQL_STATUS_READY ||
+      (conn->server_status & SERVER_MORE_RESULTS_EXISTS)) {
+    return false;
+  }
+  if ((conn->server_status & SERVER_STATUS_IN_TRANS) &&
+      mysql_rollback(conn)) {
+    return false;
+  }
+  if (!(conn->server_status & SERVER_STATUS_AUTOCOMMIT) &&
+      mysql_autocommit(conn, 1)) {
+    return false;
+  }
+  return true;
+}
+
+MySQLConnectionPool::MySQLConnectionPool()
+  : m_reaper(this, &MySQLConnectionPool::reaper),
+    m_started(false), m_stopped(false) {
+}
+
+MySQLConnectionPool::Host &
+MySQLConnectionPool::getHost(const std::string &name) {
+  HostMap::iterator iter = m_hosts.find(name);
+  if (iter != m_hosts.end()) return *iter->second;
+
+  Host *host = new Host();
+  host->maxOpen = host_limit(RuntimeOption::MySQLPoolHostMax, name,
+                             RuntimeOption::MySQLPoolMaxPerHost);
+  host->minIdle = host_limit(RuntimeOption::MySQLPoolHostMinIdle, name,
+                             RuntimeOption::MySQLPoolMinIdle);
+  host->maxIdle = host_limit(RuntimeOption::MySQLPoolHostMaxIdle, name,
+                             RuntimeOption::MySQLPoolMaxIdle);
+  m_hosts[name] = host;
+  return *host;
+}
+
+MYSQL *MySQLConnectionPool::checkout(const std::string &name,
+                                     const std::string &key, bool &slot) {
+  slot = false;
+  MYSQL *ret = NULL;
+  MYSQL *victim = NULL;
+  int64 waitStart = 0;
+  int64 waited = 0;
+  {
+    Lock lock(this);
+    Host &host = getHost(name);
+    ++host.checkouts;
+    while (true) {
+      hphp_string_map<IdleList>::iterator iter = host.conns.find(key);
+      if (iter != host.conns.end() && !iter->second.empty()) {
+        ret = iter->second.back().conn;
+        iter->second.pop_back();
+        --host.idle;
+        ++host.reused;
+        break;
+      }
+      if (host.open < host.maxOpen) {
+        ++host.open;
+        ++host.created;
+        slot = true;
+        break;
+      }
+      if (host.idle > 0) {
+        // Full, but some of it is idle under other credentials or another
+        // database: close the least recently used of those and take over
+        // its slot.
+        IdleList *oldest = NULL;
+        for (iter = host.conns.begin(); iter != host.conns.end(); ++iter) {
+          if (!iter->second.empty() &&
+              (!oldest ||
+               iter->second.front().since < oldest->front().since)) {
+            oldest = &iter->second;
+          }
+        }
+        ASSERT(oldest);
+        victim = oldest->front().conn;
+        oldest->pop_front();
+        --host.idle;
+        ++host.discarded;
+        ++host.created;
+        slot = true;
+        break;
+      }
+
+      int64 now = Timer::GetCurrentTimeMicros();
+      if (!waitStart) {
+        waitStart = now;
+        ++host.waits;
+      }
+      int64 left = RuntimeOption::MySQLPoolWaitTimeout * 1000LL -
+        (now - waitStart);
+      if (left <= 0) {
+        ++host.waitTimeouts;
+        break;
+      }
+      wait(left / 1000000, (left % 1000000) * 1000);
+    }
+    if (waitStart) {
+      waited = Timer::GetCurrentTimeMicros() - waitStart;
+      host.waitUs += waited;
+      if (waited > host.maxWaitUs) host.maxWaitUs = waited;
+    }
+  }
+
+  if (victim) mysql_close(victim);
+  if (RuntimeOption::EnableStats && RuntimeOption::EnableSQLStats) {
+    ServerStats::Log(ret ? "sql.pool.reused" :
+                     slot ? "sql.pool.created" : "sql.pool.timeout", 1);
+    if (waitStart) ServerStats::Log("sql.pool.wait_us", waited);
+  }
+  return ret;
+}
+
+void MySQLConnectionPool::checkin(const std::string &name,
+                                  const std::string &key, MYSQL *conn) {
+  ASSERT(conn);
+  bool keep = reset_conn(conn);
+  {
+    Lock lock(this);
+    Host &host = getHost(name);
+    if (keep && host.idle < host.maxIdle) {
+      time_t now = time(0);
+      host.conns[key].push_back(IdleConn(conn, now, now));
+      ++host.idle;
+      conn = NULL;
+    } else {
+      --host.open;
+      ++host.discarded;
+    }
+    notifyAll();
+  }
+  if (conn) mysql_close(conn);
+}
+
+void MySQLConnectionPool::discard(const std::string &name) {
+  Lock lock(this);
+  Host &host = getHost(name);
+  --host.open;
+  ++host.discarded;
+  notifyAll();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// health check thread
+
+void MySQLConnectionPool::start() {
+  Lock lock(this);
+  if (m_started) return;
+  m_started = true;
+  m_stopped = false;
+  m_reaper.start();
+}
+
+void MySQLConnectionPool::stop() {
+  {
+    Lock lock(this);
+    if (!m_started) return;
+    m_started = false;
+  }
+  {
+    Lock lock(&m_reaperSleep);
+    m_stopped = true;
+    m_reaperSleep.notify();
+  }
+  m_reaper.waitForEnd();
+
+  std::vector<MYSQL*> conns;
+  {
+    Lock lock(this);
+    for (HostMap::iterator iter = m_hosts.begin(); iter != m_hosts.end();
+         ++iter) {
+      Host &host = *iter->second;
+      for (hphp_string_map<IdleList>::iterator it = host.conns.begin();
+           it != host.conns.end(); ++it) {
+        for (unsigned int i = 0; i < it->second.size(); i++) {
+          conns.push_back(it->second[i].conn);
+        }
+        it->second.clear();
+      }
+      host.open -= host.idle;
+      host.idle = 0;
+    }
+  }
+  for (unsigned int i = 0; i < conns.size(); i++) {
+    mysql_close(conns[i]);
+  }
+}
+
+void MySQLConnectionPool::reaper() {
+  mysql_thread_init();
+  while (true) {
+    {
+      Lock lock(&m_reaperSleep);
+      if (m_stopped) break;
+      m_reaperSleep.wait(std::max(RuntimeOption::MySQLPoolPingInterval, 1));
+      if (m_stopped) break;
+    }
+    healthCheck(time(0));
+  }
+  mysql_thread_end();
+}
+
+namespace {
+struct Pinged {
+  Pinged(const std::string &h, const std::string &k, MYSQL *c, time_t s)
+    : host(h), key(k), conn(c), since(s) {}
+  std::string host;
+  std::string key;
+  MYSQL *conn;
+  time_t since;
+};
+}
+
+void MySQLConnectionPool::healthCheck(time_t now) {
+  std::vector<MYSQL*> expired;
+  std::vector<Pinged> stale;
+
+  {
+    Lock lock(this);
+    for (HostMap::iterator iter = m_hosts.begin(); iter != m_hosts.end();
+         ++iter) {
+      Host &host = *iter->second;
+      for (hphp_string_map<IdleList>::iterator it = host.conns.begin();
+           it != host.conns.end(); ++it) {
+        IdleList &list = it->second;
+        // oldest first, so the ones closed are the least recently used
+        while (!list.empty() && host.idle > host.minIdle &&
+               now - list.front().since >=
+               RuntimeOption::MySQLPoolIdleTimeout) {
+          expired.push_back(list.front().conn);
+          list.pop_front();
+          --host.idle;
+          --host.open;
+          ++host.reaped;
+        }
+        // Pinged ones are taken out so the ping runs without the lock; they
+        // count as checked out meanwhile.
+        for (IdleList::iterator c = list.begin(); c != list.end(); ) {
+          if (now - c->pinged >= RuntimeOption::MySQLPoolPingInterval) {
+            stale.push_back(Pinged(iter->first, it->first, c->conn,
+                                   c->since));
+            c = list.erase(c);
+            --host.idle;
+          } else {
+            ++c;
+          }
+        }
+      }
+    }
+  }
+
+  for (unsigned int i = 0; i < expired.size(); i++) {
+    mysql_close(expired[i]);
+  }
+  for (unsigned int i = 0; i < stale.size(); i++) {
+    Pinged &p = stale[i];
+    bool alive = !mysql_ping(p.conn);
+    {
+      Lock lock(this);
+      Host &host = getHost(p.host);
+      ++host.pinged;
+      if (alive) {
+        // Back where it was: it is no fresher for having been pinged, so it
+        // still expires IdleTimeout after it was checked in.
+        IdleList &list = host.conns[p.key];
+        IdleList::iterator pos = list.begin();
+        while (pos != list.end() && pos->since <= p.since) ++pos;
+        list.insert(pos, IdleConn(p.conn, p.since, now));
+        ++host.idle;
+      } else {
+        ++host.pingFailures;
+        --host.open;
+      }
+      notifyAll();
+    }
+    if (!alive) {
+      Logger::Verbose("MySQL pool: dropping dead connection to %s",
+                      p.host.c_str());
+      mysql_close(p.conn);
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::string MySQLConnectionPool::reportStats() {
+  std::ostringstream out;
+  Lock lock(this);
+  for (HostMap::const_iterator iter = m_hosts.begin(); iter != m_hosts.end();
+       ++iter) {
+    const Host &host = *iter->second;
+    out << "<host name=\"" << iter->first << "\">\n";
+    out << "  <max>" << host.maxOpen << "</max>\n";
+    out << "  <min_idle>" << host.minIdle << "</min_idle>\n";
+    out << "  <max_idle>" << host.maxIdle << "</max_idle>\n";
+    out << "  <open>" << host.open << "</open>\n";
+    out << "  <idle>" << host.idle << "</idle>\n";
+    out << "  <in_use>" << host.open - host.idle << "</in_use>\n";
+    out << "  <checkouts>" << host.checkouts << "</checkouts>\n";
+    out << "  <reused>" << host.reused << "</reused>\n";
+    out << "  <created>" << host.created << "</created>\n";
+    out << "  <waits>" << host.waits << "</waits>\n";
+    out << "  <wait_timeouts>" << host.waitTimeouts << "</wait_timeouts>\n";
+    out << "  <avg_wait_us>" << (host.waits ? host.waitUs / host.waits : 0)
+        << "</avg_wait_us>\n";
+    out << "  <max_wait_us>" << host.maxWaitUs << "</max_wait_us>\n";
+    out << "  <pinged>" << host.pinged << "</pinged>\n";
+    out << "  <ping_failures>" << host.pingFailures << "</ping_failures>\n";
+    out << "  <reaped>" << host.reaped << "</reaped>\n";
+    out << "  <discarded>" << host.discarded << "</discarded>\n";
+    out << "</host>\n";
+  }
+  return out.str();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,152 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef __HPHP_MYSQL_POOL_H__
+#define __HPHP_MYSQL_POOL_H__
+
+#include <util/base.h>
+#include <util/synchronizable.h>
+#include <util/async_func.h>
+#include <mysql/mysql.h>
+#include <deque>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Process-wide pool of MySQL connections, used for mysql_pconnect() when
+ * MySQL.Pool.Enable is on instead of each thread keeping its own
+ * persistent connections.
+ *
+ * Connections are grouped by host (host:port), which is what the limits
+ * apply to, and within a host by connection key (credentials, database and
+ * flags), which is what decides whether an idle connection can be reused.
+ * A host never has more than MaxPerHost connections open, counting both
+ * idle and checked out ones; when it is full, Checkout() waits up to
+ * WaitTimeout ms for one to come back.
+ *
+ * A background thread pings connections that have sat idle for
+ * PingInterval seconds and closes ones idle for IdleTimeout, never going
+ * below a host's MinIdle.
+ */
+class MySQLConnectionPool : public Synchronizable {
+public:
+  /**
+   * Takes an idle connection for key, or returns NULL. On NULL, slot says
+   * whether the caller got a free slot on the host and may open a new
+   * connection; it then has to give it back with Checkin() or Discard().
+   * If slot is false the host stayed full for the whole wait.
+   */
+  static MYSQL *Checkout(const std::string &host, const std::string &key,
+                         bool &slot);
+
+  /**
+   * Returns a connection from Checkout(). Open transactions are rolled
+   * back and autocommit is turned back on; a connection with unread
+   * results, or that fails the reset, is closed instead.
+   */
+  static void Checkin(const std::string &host, const std::string &key,
+                      MYSQL *conn);
+
+  /**
+   * Gives up a slot without returning a connection, e.g. after a failed
+   * connect. The caller closes the connection itself, if there is one.
+   */
+  static void Discard(const std::string &host);
+
+  /**
+   * Starts and stops the health check thread. Stop() also closes every
+   * idle connection.
+   */
+  static void Start();
+  static void Stop();
+
+  /**
+   * One round of what the health check thread does every PingInterval
+   * seconds, as of now.
+   */
+  static void HealthCheck(time_t now);
+
+  /**
+   * Per-host occupancy and checkout wait times, as XML for the admin
+   * server.
+   */
+  static std::string ReportStats();
+
+public:
+  MySQLConnectionPool();
+
+private:
+  struct IdleConn {
+    IdleConn(MYSQL *c, time_t s, time_t p) : conn(c), since(s), pinged(p) {}
+    MYSQL *conn;
+    time_t since;  // checked in; pings don't change it
+    time_t pinged; // last pinged, or checked in
+  };
+  typedef std::deque<IdleConn> IdleList; // oldest since at the front
+
+  struct Host {
+    Host() : maxOpen(0), minIdle(0), maxIdle(0), open(0), idle(0),
+             checkouts(0), reused(0), created(0), waits(0), waitTimeouts(0),
+             waitUs(0), maxWaitUs(0), pinged(0), pingFailures(0), reaped(0),
+             discarded(0) {}
+    int maxOpen;
+    int minIdle;
+    int maxIdle;
+
+    int open; // idle plus checked out
+    int idle;
+    hphp_string_map<IdleList> conns; // idle connections by key
+
+    int64 checkouts;
+    int64 reused;
+    int64 created;
+    int64 waits;
+    int64 waitTimeouts;
+    int64 waitUs;
+    int64 maxWaitUs;
+    int64 pinged;
+    int64 pingFailures;
+    int64 reaped;
+    int64 discarded;
+  };
+  typedef hphp_string_map<Host*> HostMap;
+
+  HostMap m_hosts;
+
+  Synchronizable m_reaperSleep;
+  AsyncFunc<MySQLConnectionPool> m_reaper;
+  bool m_started;
+  bool m_stopped;
+
+  Host &getHost(const std::string &name);
+  MYSQL *checkout(const std::string &host, const std::string &key,
+                  bool &slot);
+  void checkin(const std::string &host, const std::string &key,
+               MYSQL *conn);
+  void discard(const std::string &host);
+  void start();
+  void stop();
+  std::string reportStats();
+
+  void reaper();
+  void healthCheck(time_t now);
+};
+
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif // __HPHP_MYSQL_POOL_H__
@@ -189,6 +189,26 @@ inline Variant x_mysql_unbuffered_query(CStrRef query, CVarRef link_identifier =
   return f_mysql_unbuffered_query(query, link_identifier);
 }
 
+inline bool x_mysql_async_query_start(CStrRef query, CVarRef link_identifier = null) {
+  FUNCTION_INJECTION_BUILTIN(mysql_async_query_start);
+  return f_mysql_async_query_start(query, link_identifier);
+}
+
+inline bool x_mysql_async_query_completed(CVarRef link_identifier = null) {
+  FUNCTION_INJECTION_BUILTIN(mysql_async_query_completed);
+  return f_mysql_async_query_completed(link_identifier);
+}
+
+inline Variant x_mysql_async_query_result(CVarRef link_identifier = null) {
+  FUNCTION_INJECTION_BUILTIN(mysql_async_query_result);
+  return f_mysql_async_query_result(link_identifier);
+}
+
+inline Array x_mysql_async_wait_actionable(CArrRef links = null, double timeout = -1.0) {
+  FUNCTION_INJECTION_BUILTIN(mysql_async_wait_actionable);
+  return f_mysql_async_wait_actionable(links, timeout);
+}
+
 inline Variant x_mysql_db_query(CStrRef database, CStrRef query, CVarRef link_identifier = null) {
   FUNCTION_INJECTION_BUILTIN(mysql_db_query);
   return f_mysql_db_query(database, query, link_identifier);
@@ -263,6 +263,26 @@ inline void x_set_time_limit(int seconds) {
   f_set_time_limit(seconds);
 }
 
+inline void x_hphp_set_time_limit_ms(int milliseconds) {
+  FUNCTION_INJECTION_BUILTIN(hphp_set_time_limit_ms);
+  f_hphp_set_time_limit_ms(milliseconds);
+}
+
+inline void x_hphp_set_cpu_time_limit_ms(int milliseconds) {
+  FUNCTION_INJECTION_BUILTIN(hphp_set_cpu_time_limit_ms);
+  f_hphp_set_cpu_time_limit_ms(milliseconds);
+}
+
+inline int64 x_hphp_get_time_remaining_ms() {
+  FUNCTION_INJECTION_BUILTIN(hphp_get_time_remaining_ms);
+  return f_hphp_get_time_remaining_ms();
+}
+
+inline int64 x_hphp_get_cpu_time_remaining_ms() {
+  FUNCTION_INJECTION_BUILTIN(hphp_get_cpu_time_remaining_ms);
+  return f_hphp_get_cpu_time_remaining_ms();
+}
+
 inline String x_sys_get_temp_dir() {
   FUNCTION_INJECTION_BUILTIN(sys_get_temp_dir);
   return f_sys_get_temp_dir();
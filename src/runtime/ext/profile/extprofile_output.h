@@ -157,6 +157,18 @@ inline Array x_hphp_get_status() {
   return f_hphp_get_status();
 }
 
+inline void x_hphp_io_trace_start() {
+  FUNCTION_INJECTION_BUILTIN(hphp_io_trace_start);
+  TAINT_OBSERVER(TAINT_BIT_NONE, TAINT_BIT_NONE);
+  f_hphp_io_trace_start();
+}
+
+inline Array x_hphp_get_io_trace() {
+  FUNCTION_INJECTION_BUILTIN(hphp_get_io_trace);
+  TAINT_OBSERVER(TAINT_BIT_NONE, TAINT_BIT_NONE);
+  return f_hphp_get_io_trace();
+}
+
 inline Array x_hphp_get_iostatus() {
   FUNCTION_INJECTION_BUILTIN(hphp_get_iostatus);
   TAINT_OBSERVER(TAINT_BIT_NONE, TAINT_BIT_NONE);
@@ -196,6 +196,7 @@ TypedValue* fg_curl_multi_add_handle(VM::ActRec *ar);
 TypedValue* fg_curl_multi_remove_handle(VM::ActRec *ar);
 TypedValue* fg_curl_multi_exec(VM::ActRec *ar);
 TypedValue* fg_curl_multi_select(VM::ActRec *ar);
+TypedValue* fg_fb_curl_multi_await(VM::ActRec *ar);
 TypedValue* fg_fb_curl_multi_fdset(VM::ActRec *ar);
 TypedValue* fg_curl_multi_getcontent(VM::ActRec *ar);
 TypedValue* fg_curl_multi_info_read(VM::ActRec *ar);
@@ -1471,6 +1472,10 @@ TypedValue* fg_mysql_next_result(VM::ActRec *ar);
 TypedValue* fg_mysql_more_results(VM::ActRec *ar);
 TypedValue* fg_mysql_fetch_result(VM::ActRec *ar);
 TypedValue* fg_mysql_unbuffered_query(VM::ActRec *ar);
+TypedValue* fg_mysql_async_query_start(VM::ActRec *ar);
+TypedValue* fg_mysql_async_query_completed(VM::ActRec *ar);
+TypedValue* fg_mysql_async_query_result(VM::ActRec *ar);
+TypedValue* fg_mysql_async_wait_actionable(VM::ActRec *ar);
 TypedValue* fg_mysql_db_query(VM::ActRec *ar);
 TypedValue* fg_mysql_list_dbs(VM::ActRec *ar);
 TypedValue* fg_mysql_list_tables(VM::ActRec *ar);
@@ -1622,6 +1627,10 @@ TypedValue* fg_phpversion(VM::ActRec *ar);
 TypedValue* fg_putenv(VM::ActRec *ar);
 TypedValue* fg_set_magic_quotes_runtime(VM::ActRec *ar);
 TypedValue* fg_set_time_limit(VM::ActRec *ar);
+TypedValue* fg_hphp_set_time_limit_ms(VM::ActRec *ar);
+TypedValue* fg_hphp_set_cpu_time_limit_ms(VM::ActRec *ar);
+TypedValue* fg_hphp_get_time_remaining_ms(VM::ActRec *ar);
+TypedValue* fg_hphp_get_cpu_time_remaining_ms(VM::ActRec *ar);
 TypedValue* fg_sys_get_temp_dir(VM::ActRec *ar);
 TypedValue* fg_version_compare(VM::ActRec *ar);
 TypedValue* fg_zend_logo_guid(VM::ActRec *ar);
@@ -1649,6 +1658,8 @@ TypedValue* fg_hphp_crash_log(VM::ActRec *ar);
 TypedValue* fg_hphp_stats(VM::ActRec *ar);
 TypedValue* fg_hphp_get_stats(VM::ActRec *ar);
 TypedValue* fg_hphp_get_status(VM::ActRec *ar);
+TypedValue* fg_hphp_io_trace_start(VM::ActRec *ar);
+TypedValue* fg_hphp_get_io_trace(VM::ActRec *ar);
 TypedValue* fg_hphp_get_iostatus(VM::ActRec *ar);
 TypedValue* fg_hphp_set_iostatus_address(VM::ActRec *ar);
 TypedValue* fg_hphp_get_timers(VM::ActRec *ar);
@@ -2815,7 +2826,7 @@ TypedValue* tg_9XMLWriter_flush(VM::ActRec *ar);
 TypedValue* tg_9XMLWriter_outputMemory(VM::ActRec *ar);
 TypedValue* tg_9XMLWriter___destruct(VM::ActRec *ar);
 
-const long long hhbc_ext_funcs_count = 2165;
+const long long hhbc_ext_funcs_count = 2176;
 const HhbcExtFuncInfo hhbc_ext_funcs[] = {
   { "apache_note", fg_apache_note },
   { "apache_request_headers", fg_apache_request_headers },
@@ -3006,6 +3017,7 @@ const HhbcExtFuncInfo hhbc_ext_funcs[] = {
   { "curl_multi_remove_handle", fg_curl_multi_remove_handle },
   { "curl_multi_exec", fg_curl_multi_exec },
   { "curl_multi_select", fg_curl_multi_select },
+  { "fb_curl_multi_await", fg_fb_curl_multi_await },
   { "fb_curl_multi_fdset", fg_fb_curl_multi_fdset },
   { "curl_multi_getcontent", fg_curl_multi_getcontent },
   { "curl_multi_info_read", fg_curl_multi_info_read },
@@ -4281,6 +4293,10 @@ const HhbcExtFuncInfo hhbc_ext_funcs[] = {
   { "mysql_more_results", fg_mysql_more_results },
   { "mysql_fetch_result", fg_mysql_fetch_result },
   { "mysql_unbuffered_query", fg_mysql_unbuffered_query },
+  { "mysql_async_query_start", fg_mysql_async_query_start },
+  { "mysql_async_query_completed", fg_mysql_async_query_completed },
+  { "mysql_async_query_result", fg_mysql_async_query_result },
+  { "mysql_async_wait_actionable", fg_mysql_async_wait_actionable },
   { "mysql_db_query", fg_mysql_db_query },
   { "mysql_list_dbs", fg_mysql_list_dbs },
   { "mysql_list_tables", fg_mysql_list_tables },
@@ -4432,6 +4448,10 @@ const HhbcExtFuncInfo hhbc_ext_funcs[] = {
   { "putenv", fg_putenv },
   { "set_magic_quotes_runtime", fg_set_magic_quotes_runtime },
   { "set_time_limit", fg_set_time_limit },
+  { "hphp_set_time_limit_ms", fg_hphp_set_time_limit_ms },
+  { "hphp_set_cpu_time_limit_ms", fg_hphp_set_cpu_time_limit_ms },
+  { "hphp_get_time_remaining_ms", fg_hphp_get_time_remaining_ms },
+  { "hphp_get_cpu_time_remaining_ms", fg_hphp_get_cpu_time_remaining_ms },
   { "sys_get_temp_dir", fg_sys_get_temp_dir },
   { "version_compare", fg_version_compare },
   { "zend_logo_guid", fg_zend_logo_guid },
@@ -4459,6 +4479,8 @@ const HhbcExtFuncInfo hhbc_ext_funcs[] = {
   { "hphp_stats", fg_hphp_stats },
   { "hphp_get_stats", fg_hphp_get_stats },
   { "hphp_get_status", fg_hphp_get_status },
+  { "hphp_io_trace_start", fg_hphp_io_trace_start },
+  { "hphp_get_io_trace", fg_hphp_get_io_trace },
   { "hphp_get_iostatus", fg_hphp_get_iostatus },
   { "hphp_set_iostatus_address", fg_hphp_set_iostatus_address },
   { "hphp_get_timers", fg_hphp_get_timers },
@@ -166,6 +166,20 @@ struct BlobEncoder {
     return *this;
   }
 
+  /*
+   * Append an uninterpreted byte span (e.g. bytecode).  The matching
+   * BlobDecoder::decodeRaw hands back a pointer into the blob instead
+   * of copying it.
+   */
+  void encodeRaw(const void* vp, size_t sz) {
+    encode(uint64_t(sz));
+    if (!sz) return;
+    const size_t start = m_blob.size();
+    m_blob.resize(start + sz);
+    const unsigned char* pc = static_cast<const unsigned char*>(vp);
+    std::copy(pc, pc + sz, &m_blob[start]);
+  }
+
   size_t size() const { return m_blob.size(); }
   const void* data() const { return &m_blob[0]; }
 
@@ -280,6 +294,16 @@ struct BlobDecoder {
     return *this;
   }
 
+  const void* decodeRaw(size_t& sz) {
+    uint64_t sz64;
+    decode(sz64);
+    sz = sz64;
+    ASSERT(size_t(m_last - m_p) >= sz);
+    const void* vp = m_p;
+    m_p += sz;
+    return vp;
+  }
+
 private:
   String decodeString() {
     uint32_t sz;
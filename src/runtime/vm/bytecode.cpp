@@ -56,6 +56,7 @@
 #include <runtime/ext/ext_variable.h>
 #include <runtime/vm/exception_gate.h>
 #include <runtime/vm/stats.h>
+#include <runtime/vm/superinst.h>
 #include <runtime/vm/type-profile.h>
 #include <runtime/base/server/source_root_info.h>
 #include <runtime/base/util/extended_logger.h>
@@ -6501,6 +6502,17 @@ OPCODES
 #undef DECODE_JMP
 #undef DECODE
 
+/*
+ * Fused<a, b>::value is true for each superinstruction pair listed in
+ * superinst.h.  dispatchImpl tests it with constant arguments, so every
+ * non-fused (a, b) check folds away at compile time.
+ */
+template <Op a, Op b> struct Fused { static const bool value = false; };
+#define S(a, b) \
+  template <> struct Fused<Op##a, Op##b> { static const bool value = true; };
+SUPERINSTS
+#undef S
+
 template <int dispatchFlags>
 inline void VMExecutionContext::dispatchImpl(int numInstrs) {
   static const bool limInstrs = dispatchFlags & LimitInstrs;
@@ -6554,6 +6566,11 @@ inline void VMExecutionContext::dispatchImpl(int numInstrs) {
   };
 #endif /* HPHP_TRACE */
   bool isCtlFlow = false;
+  // Superinstructions bypass the pre-handler hooks and the instruction
+  // budget, so only fuse on the plain dispatch table.
+  const bool fuse = !limInstrs && optab == optabDirect;
+  const bool countSeqs = Stats::enableOpSeqCount();
+  Op seqPrev = OpLowInvalid, seqPrev2 = OpLowInvalid;
 
 #define DISPATCH() do {                                                       \
     if ((breakOnCtlFlow && isCtlFlow) ||                                      \
@@ -6601,9 +6618,23 @@ inline void VMExecutionContext::dispatchImpl(int numInstrs) {
         (Op##name == OpRetC || Op##name == OpCGetM)) {                        \
       recordType(TypeProfileKey(curFunc(), pc), m_stack.top()->m_type);       \
     }                                                                         \
+    if (UNLIKELY(countSeqs)) {                                                \
+      Stats::incOpSeq(seqPrev2, seqPrev, Op##name);                           \
+      seqPrev2 = seqPrev;                                                     \
+      seqPrev = Op##name;                                                     \
+    }                                                                         \
+    if (fuse && !(breakOnCtlFlow && isCtlFlow)) {                             \
+      const Op fuseOp = Op##name;                                             \
+      SUPERINST_SUCCS                                                         \
+    }                                                                         \
     DISPATCH();                                                               \
   }
+#define T(succ)                                                               \
+      if (Fused<fuseOp, Op##succ>::value && *pc == Op##succ) {                \
+        goto Label##succ;                                                     \
+      }
   OPCODES
+#undef T
 #undef O
 #undef DISPATCH
 }
@@ -341,6 +341,7 @@ class PreClassEmitter {
   const StringData* name() const { return m_name; }
   Attr attrs() const { return m_attrs; }
   void setHoistable(bool b) { m_hoistable = b; }
+  bool hoistable() const { return m_hoistable; }
   Id id() const { return m_id; }
   const MethodVec& methods() const { return m_methods; }
 
@@ -20,11 +20,16 @@
 #include "gdb-jit.h"
 #include "elfwriter.h"
 
+#include <util/compatibility.h>
+#include <util/process.h>
+
 #include <sys/types.h>
+#include <sys/mman.h>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
 #include <errno.h>
+#include <elf.h>
 
 using namespace HPHP::VM::Transl;
 
@@ -35,51 +40,210 @@ namespace Debug {
 /*
  * Stuff to output symbol names to /tmp/perf-%d.map files.  This stuff
  * can be read by perf top/record, etc.
+ *
+ * Both files are written under the write lease, through big stdio buffers
+ * that get flushed at most once a second while translating and at the end
+ * of any request after that, so a translation costs a formatted write into
+ * memory and nothing waits in the buffers once the JIT goes quiet.
  */
 static char perfMapName[64];
 FILE* perfMap;
+static FILE* jitDump;
+static void* jitDumpMarker;
+static uint64_t jitDumpIndex;
+static time_t lastFlush;
+static volatile int unflushed; // written since the last flush
+
+static const int kPerfBufferSize = 1 << 16;
+
+/*
+ * The jitdump format, as read by perf inject --jit.  See
+ * tools/perf/Documentation/jitdump-specification.txt in the kernel tree.
+ */
+static const uint32_t kJitDumpMagic = 0x4A695444;
+static const uint32_t kJitCodeLoad = 0;
+static const uint32_t kJitCodeClose = 3;
+
+struct JitDumpHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t totalSize;
+  uint32_t elfMach;
+  uint32_t pad1;
+  uint32_t pid;
+  uint64_t timestamp;
+  uint64_t flags;
+};
+
+struct JitDumpRecord {
+  uint32_t id;
+  uint32_t totalSize;
+  uint64_t timestamp;
+};
+
+struct JitDumpCodeLoad {
+  JitDumpRecord rec;
+  uint32_t pid;
+  uint32_t tid;
+  uint64_t vma;
+  uint64_t codeAddr;
+  uint64_t codeSize;
+  uint64_t codeIndex;
+  // followed by the name and the code itself
+};
+
+// perf has to be run with -k mono for these to line up with its samples
+static uint64_t jitDumpTimestamp() {
+  timespec ts;
+  gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
 
-static void deleteMap() {
-  if (perfMap) fclose(perfMap);
-  unlink(perfMapName);
-}
-
-static void openMap() {
-  snprintf(perfMapName, sizeof perfMapName, "/tmp/perf-%d.map", getpid());
-  perfMap = fopen(perfMapName, "w");
-  atexit(deleteMap);
-}
-
-void recordPerfMap(const DwarfChunk* chunk) {
-  if (!perfMap) return;
-  if (RuntimeOption::EvalProfileBC) return;
-  for (FuncPtrDB::const_iterator it = chunk->m_functions.begin();
-      it != chunk->m_functions.end();
-      ++it) {
-    if (!(*it)->perfSynced()) {
-      fprintf(perfMap, "%lx %x %s\n",
-        reinterpret_cast<uintptr_t>((*it)->start),
-        static_cast<uint32_t>((*it)->end - (*it)->start),
-        (*it)->name.c_str());
-      (*it)->setPerfSynced();
+static void closeMaps() {
+  if (perfMap) {
+    fclose(perfMap);
+    unlink(perfMapName);
+  }
+  if (jitDump) {
+    JitDumpRecord rec;
+    rec.id = kJitCodeClose;
+    rec.totalSize = sizeof(rec);
+    rec.timestamp = jitDumpTimestamp();
+    fwrite(&rec, sizeof(rec), 1, jitDump);
+    fclose(jitDump);
+  }
+}
+
+static void openMaps() {
+  if (RuntimeOption::EvalPerfPidMap || RuntimeOption::EvalProfileBC) {
+    snprintf(perfMapName, sizeof perfMapName, "/tmp/perf-%d.map", getpid());
+    perfMap = fopen(perfMapName, "w");
+    if (perfMap) setvbuf(perfMap, NULL, _IOFBF, kPerfBufferSize);
+  }
+  if (RuntimeOption::EvalPerfJitDump) {
+    char name[64];
+    snprintf(name, sizeof name, "/tmp/jit-%d.dump", getpid());
+    jitDump = fopen(name, "w+");
+    if (jitDump) {
+      // perf finds the file by this mapping showing up in its mmap events
+      jitDumpMarker = mmap(NULL, sysconf(_SC_PAGESIZE), PROT_READ | PROT_EXEC,
+                           MAP_PRIVATE, fileno(jitDump), 0);
+      setvbuf(jitDump, NULL, _IOFBF, kPerfBufferSize);
+      JitDumpHeader header;
+      memset(&header, 0, sizeof(header));
+      header.magic = kJitDumpMagic;
+      header.version = 1;
+      header.totalSize = sizeof(header);
+      header.elfMach = EM_X86_64;
+      header.pid = getpid();
+      header.timestamp = jitDumpTimestamp();
+      fwrite(&header, sizeof(header), 1, jitDump);
     }
   }
-  fflush(perfMap);
+  atexit(closeMaps);
+}
+
+// stdio's own locking keeps this safe against the lease holder's writes
+static void flushMaps() {
+  if (perfMap) fflush(perfMap);
+  if (jitDump) fflush(jitDump);
+}
+
+static void maybeFlushMaps() {
+  time_t now = time(NULL);
+  if (now == lastFlush) {
+    unflushed = 1;
+    return;
+  }
+  lastFlush = now;
+  unflushed = 0;
+  flushMaps();
+}
+
+/*
+ * Reused TC space gets a new entry. perf map readers let the later one win,
+ * and jitdump records carry timestamps, so samples from either generation
+ * of code get the right name.
+ */
+static void recordPerfCode(TCA start, TCA end, const std::string& name) {
+  if (start == end) return;
+  if (perfMap && !RuntimeOption::EvalProfileBC) {
+    fprintf(perfMap, "%lx %x %s\n", reinterpret_cast<uintptr_t>(start),
+            static_cast<uint32_t>(end - start), name.c_str());
+  }
+  if (jitDump) {
+    JitDumpCodeLoad load;
+    load.rec.id = kJitCodeLoad;
+    load.rec.totalSize = sizeof(load) + name.size() + 1 + (end - start);
+    load.rec.timestamp = jitDumpTimestamp();
+    load.pid = getpid();
+    load.tid = Process::GetThreadPid();
+    load.vma = reinterpret_cast<uintptr_t>(start);
+    load.codeAddr = reinterpret_cast<uintptr_t>(start);
+    load.codeSize = end - start;
+    load.codeIndex = jitDumpIndex++;
+    fwrite(&load, sizeof(load), 1, jitDump);
+    fwrite(name.c_str(), name.size() + 1, 1, jitDump);
+    fwrite(start, end - start, 1, jitDump);
+  }
+  maybeFlushMaps();
+}
+
+/*
+ * PHP::Class::method@offset, with the bytecode offset the tracelet starts
+ * at, or PHP::Class::method$prologue.
+ */
+static std::string perfCodeName(const Unit *unit, const Opcode *instr,
+                                bool exit, bool inPrologue) {
+  std::string name("PHP::");
+  const Func *f = unit ? unit->getFunc(unit->offsetOf(instr)) : NULL;
+  if (!f) {
+    name += "#anonFunc";
+    return name;
+  }
+  if (f->isPseudoMain()) {
+    name += f->unit()->filepath()->data();
+    name += exit ? "::__exit" : "::__pseudoMain";
+  } else {
+    name += f->fullName()->data();
+  }
+  if (inPrologue) {
+    name += "$prologue";
+  } else {
+    char buf[16];
+    snprintf(buf, sizeof buf, "@%d", unit->offsetOf(instr));
+    name += buf;
+  }
+  return name;
 }
 
 DebugInfo::DebugInfo() {
   ASSERT(!perfMap);
-  openMap();
+  openMaps();
 }
 
 void DebugInfo::recordStub(TCA start, TCA end, const char* name) {
-  m_dwarfInfo.addTracelet(start, end, name, NULL, NULL, false, false);
+  if (!RuntimeOption::EvalJitNoGdb) {
+    m_dwarfInfo.addTracelet(start, end, name, NULL, NULL, false, false);
+  }
+  if (perfMap || jitDump) {
+    recordPerfCode(start, end, name);
+  }
 }
 
 void DebugInfo::recordTracelet(TCA start, TCA end, const Unit *unit,
     const Opcode *instr, bool exit, bool inPrologue) {
-  m_dwarfInfo.addTracelet(start, end, NULL, unit, instr,
-                                              exit, inPrologue);
+  if (!RuntimeOption::EvalJitNoGdb) {
+    m_dwarfInfo.addTracelet(start, end, NULL, unit, instr,
+                                                exit, inPrologue);
+  }
+  if (perfMap || jitDump) {
+    recordPerfCode(start, end, perfCodeName(unit, instr, exit, inPrologue));
+  }
+}
+
+void DebugInfo::flushPerfMaps() {
+  if (__sync_lock_test_and_set(&unflushed, 0)) flushMaps();
 }
 
 void DebugInfo::debugSync() {
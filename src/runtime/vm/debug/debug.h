@@ -35,6 +35,12 @@ struct DebugInfo {
     const Opcode *instr, bool exit, bool inPrologue);
   void recordStub(TCA start, TCA end, const char* name);
   void debugSync();
+
+  /*
+   * Writes out perf map and jitdump entries still sitting in the buffers.
+   * For the end of a request, so they don't wait for the next translation.
+   */
+  void flushPerfMaps();
 };
 
 /*
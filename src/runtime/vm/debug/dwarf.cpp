@@ -251,7 +251,6 @@ DwarfChunk* DwarfInfo::addTracelet(TCA start, TCA end, const char* name,
       f = m_functions[end];
       ASSERT(f->m_chunk != NULL);
       f->m_chunk->clearSynced();
-      f->clearPerfSynced();
     } else {
       m_functions[end] = f;
     }
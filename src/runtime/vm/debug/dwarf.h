@@ -99,15 +99,11 @@ struct FunctionInfo {
   TCA start;
   TCA end;
   bool exit;
-  bool m_perfSynced;
   std::vector<LineEntry> m_lineTable;
   DwarfChunk* m_chunk;
   FunctionInfo() : m_chunk(NULL) {}
   FunctionInfo(TCA s, TCA e, bool ex)
-    : start(s), end(e), exit(ex), m_perfSynced(false), m_chunk(NULL) {}
-  void setPerfSynced() { m_perfSynced = true; }
-  void clearPerfSynced() { m_perfSynced = false; }
-  bool perfSynced() const { return m_perfSynced; }
+    : start(s), end(e), exit(ex), m_chunk(NULL) {}
 };
 
 struct DwarfChunk {
@@ -37,7 +37,6 @@ namespace Debug {
 
 static const Trace::Module TRACEMOD = Trace::debuginfo;
 
-extern void recordPerfMap(const DwarfChunk* chunk);
 
 void ElfWriter::logError(const string& msg) {
   perror("");
@@ -450,7 +449,6 @@ ElfWriter::ElfWriter(DwarfChunk* d):
     return;
   }
   register_gdb_hook(symfile, elf_size, d);
-  recordPerfMap(d);
   d->setSynced();
 }
 
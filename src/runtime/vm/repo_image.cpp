@@ -0,0 +1,374 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+
+#include "util/hash.h"
+#include "util/lock.h"
+#include "util/logger.h"
+#include "util/trace.h"
+#include "runtime/vm/repo.h"
+#include "runtime/vm/repo_image.h"
+#include "runtime/vm/blob_helper.h"
+
+namespace HPHP {
+namespace VM {
+
+static const Trace::Module TRACEMOD = Trace::hhbc;
+
+const char RepoImage::kMagic[8] = { 'H', 'H', 'B', 'C', 'I', 'M', 'G', 0 };
+RepoImage* RepoImage::s_image = NULL;
+
+static inline uint64_t alignUp(uint64_t n) {
+  return (n + 7) & ~uint64_t(7);
+}
+
+uint64_t RepoImage::PathHash(const char* path, uint32_t len) {
+  return hash_string_cs(path, len);
+}
+
+uint64_t RepoImage::Md5Hash(const MD5& md5) {
+  return hash_int64_pair(md5.q[0], md5.q[1]);
+}
+
+uint32_t RepoImage::Slot(uint64_t h, uint32_t seed, uint32_t n) {
+  return uint64_t(hash_int64_pair(h, seed)) % n;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// RepoImage.
+
+RepoImage::RepoImage(const char* base, size_t size)
+  : m_base(base), m_size(size), m_header((const Header*)base) {
+}
+
+bool RepoImage::Load(const std::string& path) {
+  ASSERT(s_image == NULL);
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    Logger::Error("Unable to open repo image %s", path.c_str());
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(Header)) {
+    Logger::Error("Repo image %s is truncated", path.c_str());
+    close(fd);
+    return false;
+  }
+  void* base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    Logger::Error("Unable to map repo image %s", path.c_str());
+    return false;
+  }
+
+  const Header* h = (const Header*)base;
+  if (memcmp(h->magic, kMagic, sizeof(kMagic)) ||
+      h->version != kVersion ||
+      h->size != uint64_t(st.st_size) ||
+      strncmp(h->schemaId, Repo::kSchemaId, sizeof(h->schemaId))) {
+    Logger::Error("Repo image %s is not compatible with this binary",
+                  path.c_str());
+    munmap(base, st.st_size);
+    return false;
+  }
+  // The whole index is touched on the first few lookups anyway; bring it
+  // in now rather than taking page faults on request threads.
+  madvise(base, h->blobsOff, MADV_WILLNEED);
+
+  s_image = new RepoImage((const char*)base, st.st_size);
+  TRACE(1, "Repo image %s: %u paths, %u units\n",
+           path.c_str(), h->nPaths, h->nUnits);
+  return true;
+}
+
+const RepoImage::PathEntry*
+RepoImage::findPath(const char* path, uint32_t len) const {
+  if (!m_header->nPaths) return NULL;
+  const uint32_t* disp = (const uint32_t*)(m_base + m_header->pathIndexOff);
+  const PathEntry* entries =
+    (const PathEntry*)(disp + alignUp(m_header->nPathBuckets * 4) / 4);
+  uint64_t h = PathHash(path, len);
+  uint32_t seed = disp[Slot(h, 0, m_header->nPathBuckets)];
+  const PathEntry* e = &entries[Slot(h, seed, m_header->nPaths)];
+  if (e->pathLen != len ||
+      memcmp(m_base + m_header->stringsOff + e->pathOff, path, len)) {
+    return NULL;
+  }
+  return e;
+}
+
+const RepoImage::UnitEntry* RepoImage::findUnit(const MD5& md5) const {
+  if (!m_header->nUnits) return NULL;
+  const uint32_t* disp = (const uint32_t*)(m_base + m_header->unitIndexOff);
+  const UnitEntry* entries =
+    (const UnitEntry*)(disp + alignUp(m_header->nUnitBuckets * 4) / 4);
+  uint64_t h = Md5Hash(md5);
+  uint32_t seed = disp[Slot(h, 0, m_header->nUnitBuckets)];
+  const UnitEntry* e = &entries[Slot(h, seed, m_header->nUnits)];
+  if (e->md5[0] != md5.q[0] || e->md5[1] != md5.q[1]) {
+    return NULL;
+  }
+  return e;
+}
+
+bool RepoImage::findFile(const char* path, const std::string& root,
+                         MD5& md5) const {
+  const PathEntry* e = NULL;
+  if (*path == '/' && !root.empty() &&
+      !strncmp(root.c_str(), path, root.size())) {
+    const char* rel = path + root.size();
+    e = findPath(rel, strlen(rel));
+  }
+  if (!e) {
+    e = findPath(path, strlen(path));
+  }
+  if (!e) {
+    TRACE(3, "Repo image: no entry for '%s'\n", path);
+    return false;
+  }
+  const UnitEntry* entries =
+    (const UnitEntry*)(m_base + m_header->unitIndexOff +
+                       alignUp(m_header->nUnitBuckets * 4));
+  const UnitEntry* u = &entries[e->unitIdx];
+  md5.q[0] = u->md5[0];
+  md5.q[1] = u->md5[1];
+  return true;
+}
+
+Unit* RepoImage::loadUnit(const std::string& name, const MD5& md5) const {
+  const UnitEntry* e = findUnit(md5);
+  if (!e) {
+    TRACE(3, "Repo image does not contain '%s' (0x%016llx%016llx)\n",
+             name.c_str(), md5.q[0], md5.q[1]);
+    return NULL;
+  }
+  UnitEmitter ue(md5);
+  ue.setFilepath(StringData::GetStaticString(name));
+  BlobDecoder blob(m_base + m_header->blobsOff + e->blobOff, e->blobLen);
+  ue.decodeImage(blob);
+  TRACE(3, "Repo image loaded '%s' (0x%016llx%016llx)\n",
+           name.c_str(), md5.q[0], md5.q[1]);
+  return ue.create();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// RepoImageBuilder.
+
+void RepoImageBuilder::add(const UnitEmitter& ue) {
+  BlobEncoder blob;
+  ue.encodeImage(blob);
+
+  SimpleLock lock(m_lock);
+  m_items.push_back(Item());
+  Item& item = m_items.back();
+  item.path = ue.getFilepath()->data();
+  item.md5 = ue.md5();
+  const char* data = (const char*)blob.data();
+  item.blob.assign(data, data + blob.size());
+}
+
+/*
+ * Hash-and-displace: place the largest buckets first, trying seeds until
+ * every key in the bucket lands on a distinct free slot.  With four keys
+ * per bucket on average this converges quickly even at 100% occupancy.
+ */
+static bool buildPerfectHash(const std::vector<uint64_t>& hashes,
+                             uint32_t nBuckets,
+                             std::vector<uint32_t>& disp,
+                             std::vector<uint32_t>& slotOf) {
+  uint32_t n = hashes.size();
+  std::vector<std::vector<uint32_t> > buckets(nBuckets);
+  for (uint32_t i = 0; i < n; ++i) {
+    buckets[RepoImage::Slot(hashes[i], 0, nBuckets)].push_back(i);
+  }
+  std::vector<std::pair<size_t, uint32_t> > order;
+  for (uint32_t b = 0; b < nBuckets; ++b) {
+    order.push_back(std::make_pair(buckets[b].size(), b));
+  }
+  std::sort(order.rbegin(), order.rend());
+
+  disp.assign(nBuckets, 0);
+  slotOf.assign(n, 0);
+  std::vector<bool> used(n, false);
+  std::vector<uint32_t> slots;
+  for (uint32_t o = 0; o < nBuckets; ++o) {
+    const std::vector<uint32_t>& keys = buckets[order[o].second];
+    if (keys.empty()) break;
+    uint32_t seed;
+    for (seed = 1; seed < (1u << 24); ++seed) {
+      slots.clear();
+      size_t k;
+      for (k = 0; k < keys.size(); ++k) {
+        uint32_t s = RepoImage::Slot(hashes[keys[k]], seed, n);
+        if (used[s] ||
+            std::find(slots.begin(), slots.end(), s) != slots.end()) {
+          break;
+        }
+        slots.push_back(s);
+      }
+      if (k == keys.size()) break;
+    }
+    if (seed == (1u << 24)) return false;
+    disp[order[o].second] = seed;
+    for (size_t k = 0; k < keys.size(); ++k) {
+      used[slots[k]] = true;
+      slotOf[keys[k]] = slots[k];
+    }
+  }
+  return true;
+}
+
+static void writePad(FILE* f, uint64_t& pos) {
+  static const char zeros[8] = { 0 };
+  uint64_t aligned = alignUp(pos);
+  fwrite(zeros, 1, aligned - pos, f);
+  pos = aligned;
+}
+
+bool RepoImageBuilder::write(const std::string& path) {
+  SimpleLock lock(m_lock);
+
+  // Identical files share one unit blob.
+  std::vector<uint32_t> unitOfItem(m_items.size());
+  std::vector<size_t> unitItems;
+  {
+    hphp_hash_map<std::string, uint32_t, string_hash> byMd5;
+    for (size_t i = 0; i < m_items.size(); ++i) {
+      std::string key = m_items[i].md5.toString();
+      hphp_hash_map<std::string, uint32_t, string_hash>::const_iterator it =
+        byMd5.find(key);
+      if (it == byMd5.end()) {
+        uint32_t idx = unitItems.size();
+        byMd5[key] = idx;
+        unitItems.push_back(i);
+        unitOfItem[i] = idx;
+      } else {
+        unitOfItem[i] = it->second;
+      }
+    }
+  }
+
+  uint32_t nPaths = m_items.size();
+  uint32_t nUnits = unitItems.size();
+  uint32_t nPathBuckets = std::max(1u, (nPaths + 3) / 4);
+  uint32_t nUnitBuckets = std::max(1u, (nUnits + 3) / 4);
+
+  std::vector<uint64_t> hashes;
+  std::vector<uint32_t> pathDisp, pathSlot, unitDisp, unitSlot;
+  for (uint32_t i = 0; i < nPaths; ++i) {
+    const std::string& p = m_items[i].path;
+    hashes.push_back(RepoImage::PathHash(p.c_str(), p.size()));
+  }
+  if (!buildPerfectHash(hashes, nPathBuckets, pathDisp, pathSlot)) {
+    Logger::Error("Unable to build repo image path index");
+    return false;
+  }
+  hashes.clear();
+  for (uint32_t i = 0; i < nUnits; ++i) {
+    hashes.push_back(RepoImage::Md5Hash(m_items[unitItems[i]].md5));
+  }
+  if (!buildPerfectHash(hashes, nUnitBuckets, unitDisp, unitSlot)) {
+    Logger::Error("Unable to build repo image unit index");
+    return false;
+  }
+
+  RepoImage::Header h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, RepoImage::kMagic, sizeof(h.magic));
+  h.version = RepoImage::kVersion;
+  h.nPaths = nPaths;
+  h.nPathBuckets = nPathBuckets;
+  h.nUnits = nUnits;
+  h.nUnitBuckets = nUnitBuckets;
+  strncpy(h.schemaId, Repo::kSchemaId, sizeof(h.schemaId));
+
+  std::vector<RepoImage::PathEntry> pathEntries(nPaths);
+  uint32_t stringsLen = 0;
+  for (uint32_t i = 0; i < nPaths; ++i) {
+    RepoImage::PathEntry& e = pathEntries[pathSlot[i]];
+    e.pathOff = stringsLen;
+    e.pathLen = m_items[i].path.size();
+    e.unitIdx = unitSlot[unitOfItem[i]];
+    e.pad = 0;
+    stringsLen += e.pathLen;
+  }
+  std::vector<RepoImage::UnitEntry> unitEntries(nUnits);
+  uint64_t blobsLen = 0;
+  for (uint32_t i = 0; i < nUnits; ++i) {
+    const Item& item = m_items[unitItems[i]];
+    RepoImage::UnitEntry& e = unitEntries[unitSlot[i]];
+    e.md5[0] = item.md5.q[0];
+    e.md5[1] = item.md5.q[1];
+    e.blobOff = blobsLen;
+    e.blobLen = item.blob.size();
+    blobsLen = alignUp(blobsLen + e.blobLen);
+  }
+
+  h.pathIndexOff = sizeof(h);
+  h.unitIndexOff = h.pathIndexOff + alignUp(nPathBuckets * 4) +
+                   nPaths * sizeof(RepoImage::PathEntry);
+  h.stringsOff = h.unitIndexOff + alignUp(nUnitBuckets * 4) +
+                 nUnits * sizeof(RepoImage::UnitEntry);
+  h.blobsOff = alignUp(h.stringsOff + stringsLen);
+  h.size = h.blobsOff + blobsLen;
+
+  std::string tmpPath = path + ".tmp";
+  FILE* f = fopen(tmpPath.c_str(), "w");
+  if (!f) {
+    Logger::Error("Unable to open %s for write", tmpPath.c_str());
+    return false;
+  }
+  uint64_t pos = 0;
+  pos += fwrite(&h, 1, sizeof(h), f);
+  pos += fwrite(&pathDisp[0], 1, nPathBuckets * 4, f);
+  writePad(f, pos);
+  if (nPaths) {
+    pos += fwrite(&pathEntries[0], 1,
+                  nPaths * sizeof(RepoImage::PathEntry), f);
+  }
+  pos += fwrite(&unitDisp[0], 1, nUnitBuckets * 4, f);
+  writePad(f, pos);
+  if (nUnits) {
+    pos += fwrite(&unitEntries[0], 1,
+                  nUnits * sizeof(RepoImage::UnitEntry), f);
+  }
+  for (uint32_t i = 0; i < nPaths; ++i) {
+    pos += fwrite(m_items[i].path.data(), 1, m_items[i].path.size(), f);
+  }
+  writePad(f, pos);
+  for (uint32_t i = 0; i < nUnits; ++i) {
+    const std::vector<char>& blob = m_items[unitItems[i]].blob;
+    if (!blob.empty()) {
+      pos += fwrite(&blob[0], 1, blob.size(), f);
+    }
+    writePad(f, pos);
+  }
+  bool ok = !ferror(f) && pos == h.size;
+  ok = (fclose(f) == 0) && ok;
+  if (!ok || rename(tmpPath.c_str(), path.c_str()) != 0) {
+    Logger::Error("Unable to write repo image %s", path.c_str());
+    unlink(tmpPath.c_str());
+    return false;
+  }
+  return true;
+}
+
+} } // HPHP::VM
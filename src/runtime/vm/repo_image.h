@@ -0,0 +1,141 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef incl_VM_REPO_IMAGE_H_
+#define incl_VM_REPO_IMAGE_H_
+
+#include <string>
+#include <vector>
+
+#include "util/mutex.h"
+#include "runtime/base/md5.h"
+
+namespace HPHP {
+namespace VM {
+
+class Unit;
+class UnitEmitter;
+
+/*
+ * A RepoImage is a read-only, mmap()ed alternative to the SQLite repo for
+ * authoritative deployments.  The file is written once at build time by a
+ * RepoImageBuilder and contains:
+ *
+ *   Header
+ *   path index:  uint32 disp[nPathBuckets], PathEntry[nPaths]
+ *   unit index:  uint32 disp[nUnitBuckets], UnitEntry[nUnits]
+ *   path strings
+ *   unit blobs   (UnitEmitter::encodeImage() output, 8-byte aligned)
+ *
+ * Both indexes are minimal perfect hashes built with hash-and-displace:
+ * a key first hashes into a bucket, and the bucket's displacement seed
+ * picks its final slot.  Every offset is relative to the start of the
+ * file, so the image is relocatable and can be mapped anywhere.
+ *
+ * Nothing in the mapping is ever written after Load(), so lookups take no
+ * locks.  Units are only deserialized when loadUnit() is called; callers
+ * (FileRepository) cache the resulting Unit as they do for SQLite loads.
+ */
+class RepoImage {
+ public:
+  static const char kMagic[8];
+  static const uint32_t kVersion = 1;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t nPaths;
+    uint32_t nPathBuckets;
+    uint32_t nUnits;
+    uint32_t nUnitBuckets;
+    uint32_t pad;
+    char schemaId[64];
+    uint64_t pathIndexOff;
+    uint64_t unitIndexOff;
+    uint64_t stringsOff;
+    uint64_t blobsOff;
+    uint64_t size;
+  };
+
+  struct PathEntry {
+    uint32_t pathOff;  // relative to Header::stringsOff
+    uint32_t pathLen;
+    uint32_t unitIdx;
+    uint32_t pad;
+  };
+
+  struct UnitEntry {
+    uint64_t md5[2];
+    uint64_t blobOff;  // relative to Header::blobsOff
+    uint64_t blobLen;
+  };
+
+  /*
+   * Map the image at `path' and install it as the process-wide image.
+   * Must be called before any request threads start.  Returns false (and
+   * leaves Get() returning NULL) if the file is missing, truncated, or was
+   * built for a different repo schema.
+   */
+  static bool Load(const std::string& path);
+  static const RepoImage* Get() { return s_image; }
+
+  bool findFile(const char* path, const std::string& root, MD5& md5) const;
+  Unit* loadUnit(const std::string& name, const MD5& md5) const;
+
+  uint32_t numUnits() const { return m_header->nUnits; }
+
+  // Shared by RepoImage and RepoImageBuilder.
+  static uint64_t PathHash(const char* path, uint32_t len);
+  static uint64_t Md5Hash(const MD5& md5);
+  static uint32_t Slot(uint64_t h, uint32_t seed, uint32_t n);
+
+ private:
+  RepoImage(const char* base, size_t size);
+
+  const PathEntry* findPath(const char* path, uint32_t len) const;
+  const UnitEntry* findUnit(const MD5& md5) const;
+
+  static RepoImage* s_image;
+
+  const char* m_base;
+  size_t m_size;
+  const Header* m_header;
+};
+
+/*
+ * Collects UnitEmitters as they are produced by the offline compiler and
+ * lays them out as a RepoImage.  add() may be called from several emitter
+ * threads at once.
+ */
+class RepoImageBuilder {
+ public:
+  void add(const UnitEmitter& ue);
+  bool write(const std::string& path);
+
+ private:
+  struct Item {
+    std::string path;
+    MD5 md5;
+    std::vector<char> blob;
+  };
+
+  SimpleMutex m_lock;
+  std::vector<Item> m_items;
+};
+
+} }
+
+#endif
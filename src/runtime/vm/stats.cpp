@@ -55,6 +55,48 @@ void emitIncTranslOp(x64::X64Assembler&a, Opcode opc) {
   emitInc(a, &tl_counters[0], opcodeToTranslStatCounter(opc), 1);
 }
 
+/*
+ * Sequence counts are sparse, so they live in a lazily allocated map
+ * rather than a dense Op_count^3 table in TLS.  Keys pack the opcodes
+ * 10 bits apiece, with the sequence length in the top bits.
+ */
+typedef hphp_hash_map<uint32_t, uint64_t> OpSeqMap;
+static __thread OpSeqMap* tl_opSeqs;
+
+static inline uint32_t opSeqKey(Opcode a, Opcode b) {
+  return (2u << 30) | (uint32_t(a) << 10) | b;
+}
+
+static inline uint32_t opSeqKey(Opcode a, Opcode b, Opcode c) {
+  return (3u << 30) | (uint32_t(a) << 20) | (uint32_t(b) << 10) | c;
+}
+
+void incOpSeq(Opcode prev2, Opcode prev, Opcode cur) {
+  if (prev == OpLowInvalid) return;
+  if (!tl_opSeqs) tl_opSeqs = new OpSeqMap();
+  ++(*tl_opSeqs)[opSeqKey(prev, cur)];
+  if (prev2 != OpLowInvalid) {
+    ++(*tl_opSeqs)[opSeqKey(prev2, prev, cur)];
+  }
+}
+
+static void dumpOpSeqs() {
+  if (!tl_opSeqs) return;
+  for (OpSeqMap::const_iterator it = tl_opSeqs->begin();
+       it != tl_opSeqs->end(); ++it) {
+    uint32_t k = it->first;
+    Opcode a = (k >> 20) & 0x3ff, b = (k >> 10) & 0x3ff, c = k & 0x3ff;
+    if ((k >> 30) == 2) {
+      TRACE(1, "STAT OpSeq_%s_%s %15ld\n",
+            opcodeToName(b).c_str(), opcodeToName(c).c_str(), it->second);
+    } else {
+      TRACE(1, "STAT OpSeq_%s_%s_%s %15ld\n",
+            opcodeToName(a).c_str(), opcodeToName(b).c_str(),
+            opcodeToName(c).c_str(), it->second);
+    }
+  }
+}
+
 static __thread int64 epoch;
 void dump() {
   if (!enabled()) return;
@@ -75,6 +117,7 @@ void dump() {
             tl_helper_counters[i]);
     }
   }
+  dumpOpSeqs();
 }
 
 void clear() {
@@ -82,6 +125,7 @@ void clear() {
   ++epoch;
   memset(&tl_counters[0], 0, sizeof(tl_counters));
   memset(&tl_helper_counters[0], 0, sizeof(tl_helper_counters));
+  if (tl_opSeqs) tl_opSeqs->clear();
 }
 
 } } }
@@ -141,6 +141,14 @@ static inline bool enableInstrCount() {
   return Trace::moduleEnabled(Trace::stats, 2);
 }
 
+/*
+ * Opcode pair/triple counts from the interpreter.  These are what
+ * bin/superinst.py mines to pick the superinstructions in superinst.h.
+ */
+static inline bool enableOpSeqCount() {
+  return Trace::moduleEnabled(Trace::stats, 3);
+}
+
 static inline void inc(StatCounter stat, int n = 1) {
   if (Trace::moduleEnabled(Trace::stats, 1)) {
     tl_counters[stat] += n;
@@ -168,6 +176,8 @@ extern void emitInc(x64::X64Assembler& a,
                     uint index,
                     int n = 1);
 extern void emitIncTranslOp(x64::X64Assembler& a, Opcode opc);
+// prev2 and prev are OpLowInvalid at the start of a dispatch loop.
+extern void incOpSeq(Opcode prev2, Opcode prev, Opcode cur);
 extern void dump();
 extern void clear();
 
@@ -0,0 +1,70 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+/*
+ * Interpreter superinstructions.
+ *
+ * Each S(a, b) entry fuses opcode b onto the end of opcode a's handler in
+ * VMExecutionContext::dispatchImpl: after a executes, if the next opcode is
+ * b, control jumps straight to b's handler instead of going back through
+ * the indirect dispatch.  Chains of pairs (e.g. CGetL, CGetL2, Add) run
+ * fused end to end.  T(b) lists every distinct b.
+ *
+ * This file is generated by bin/superinst.py from opcode sequence counts
+ * (TRACE=stats:3); regenerate it from a representative workload with:
+ *
+ *   grep 'STAT OpSeq_' hphp.log | bin/superinst.py > \
+ *     src/runtime/vm/superinst.h
+ */
+
+#ifndef incl_VM_SUPERINST_H_
+#define incl_VM_SUPERINST_H_
+
+#define SUPERINSTS \
+  S(CGetL, CGetL2) \
+  S(CGetL2, Add) \
+  S(CGetL2, Lt) \
+  S(CGetL2, Concat) \
+  S(CGetL, JmpZ) \
+  S(CGetL, JmpNZ) \
+  S(CGetL, RetC) \
+  S(CGetL, Concat) \
+  S(Lt, JmpNZ) \
+  S(Lt, JmpZ) \
+  S(SetL, PopC) \
+  S(IncDecL, PopC) \
+  S(Int, SetL) \
+  S(String, Concat) \
+  S(Concat, SetL) \
+  S(Add, SetL) \
+  S(Same, JmpZ) \
+  S(Nop, JmpNZ) \
+  S(IssetL, JmpZ) \
+  S(FPassL, FCall)
+
+#define SUPERINST_SUCCS \
+  T(CGetL2) \
+  T(Add) \
+  T(Lt) \
+  T(Concat) \
+  T(JmpZ) \
+  T(JmpNZ) \
+  T(RetC) \
+  T(PopC) \
+  T(SetL) \
+  T(FCall)
+
+#endif
@@ -3776,32 +3776,44 @@ OPCODES
 #undef O
 };
 
-void TranslatorX64::fixup(VMExecutionContext* ec) const {
+/*
+ * Walks the rbp chain out of the current C++ frames until it reaches a call
+ * out of the TC, and reads that call site's VM registers from the fixup
+ * map. Nothing is written and nothing is asserted, so this is safe to try
+ * from anywhere; returns false if no frame on the chain is a TC call site.
+ */
+bool TranslatorX64::peekFixup(FixupMap::VMRegs* regs) const {
   ActRec* rbp;
   asm volatile("mov %%rbp, %0" : "=r"(rbp));
 
-  ASSERT(RuntimeOption::EvalJit);
-  ActRec* nextAr = rbp;
-  do {
-    rbp = nextAr;
-    FixupMap::VMRegs regs;
+  while (rbp) {
     TRACE(10, "considering frame %p, %p\n", rbp, (void*)rbp->m_savedRip);
     if (g_vmContext->m_stack.isValidAddress(rbp->m_savedRbp) &&
-        m_fixupMap.getFrameRegs(rbp, &regs)) {
-      TRACE(10, "fixup func %s fp %p sp %p pc %p\n",
-            regs.m_fp->m_func->name()->data(),
-            regs.m_fp, regs.m_sp, regs.m_pc);
-      ec->m_fp = const_cast<ActRec*>(regs.m_fp);
-      ec->m_pc = regs.m_pc;
-      vmsp() = regs.m_sp;
-      return;
+        m_fixupMap.getFrameRegs(rbp, regs)) {
+      return true;
     }
-    nextAr = (ActRec*)rbp->m_savedRbp;
-  } while (rbp && rbp != nextAr);
-  // OK, we've exhausted the entire actRec chain.
-  // We are only invoking ::fixup() from contexts that were known
-  // to be called out of the TC, so this cannot happen.
-  NOT_REACHED();
+    ActRec* nextAr = (ActRec*)rbp->m_savedRbp;
+    if (nextAr == rbp) break;
+    rbp = nextAr;
+  }
+  return false;
+}
+
+void TranslatorX64::fixup(VMExecutionContext* ec) const {
+  ASSERT(RuntimeOption::EvalJit);
+  FixupMap::VMRegs regs;
+  if (!peekFixup(&regs)) {
+    // OK, we've exhausted the entire actRec chain.
+    // We are only invoking ::fixup() from contexts that were known
+    // to be called out of the TC, so this cannot happen.
+    NOT_REACHED();
+  }
+  TRACE(10, "fixup func %s fp %p sp %p pc %p\n",
+        regs.m_fp->m_func->name()->data(),
+        regs.m_fp, regs.m_sp, regs.m_pc);
+  ec->m_fp = const_cast<ActRec*>(regs.m_fp);
+  ec->m_pc = regs.m_pc;
+  vmsp() = regs.m_sp;
 }
 
 void
@@ -9991,6 +10003,7 @@ TranslatorX64::requestExit() {
             m_writeLease.m_hintGrabbed);
   PendQ::drain();
   Treadmill::finishRequest(g_vmContext->m_currentThreadIdx);
+  m_debugInfo.flushPerfMaps();
   TRACE(1, "done requestExit(%ld)\n", g_vmContext->m_currentThreadIdx);
   Stats::dump();
   Stats::clear();
@@ -10175,18 +10188,15 @@ void TranslatorX64::recordGdbTranslation(const SrcKey& sk,
                                          TCA start,
                                          int numTCBytes, bool exit,
                                          bool inPrologue) {
-  if (!RuntimeOption::EvalJitNoGdb) {
-    ASSERT(m_writeLease.amOwner());
-    m_debugInfo.recordTracelet(start, start + numTCBytes, srcUnit,
-                               srcUnit->at(sk.offset()),
-                               exit, inPrologue);
-  }
+  // also feeds the perf map and jitdump, which don't need gdb
+  ASSERT(m_writeLease.amOwner());
+  m_debugInfo.recordTracelet(start, start + numTCBytes, srcUnit,
+                             srcUnit->at(sk.offset()),
+                             exit, inPrologue);
 }
 
 void TranslatorX64::recordGdbStub(TCA start, TCA end, const char* name) {
-  if (!RuntimeOption::EvalJitNoGdb) {
-    m_debugInfo.recordStub(start, end, name);
-  }
+  m_debugInfo.recordStub(start, end, name);
 }
 
 void TranslatorX64::defineCns(StringData* name) {
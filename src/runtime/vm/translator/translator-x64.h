@@ -421,6 +421,7 @@ PSEUDOINSTRS
   HPHP::VM::Debug::DebugInfo m_debugInfo;
 
   void fixup(VMExecutionContext* ec) const;
+  bool peekFixup(FixupMap::VMRegs* regs) const;
 
   // helpers for srcDB.
   SrcRec* getSrcRec(const SrcKey& sk) {
@@ -1327,6 +1327,113 @@ void UnitEmitter::commit(UnitOrigin unitOrigin) {
   }
 }
 
+static bool feSnLess(const FuncEmitter* a, const FuncEmitter* b) {
+  return a->sn() < b->sn();
+}
+
+void UnitEmitter::encodeImage(BlobEncoder& sd) const {
+  sd.encodeRaw(m_bc, m_bclen);
+  sd.encodeRaw(m_bc_meta, m_bc_meta_len);
+  sd(m_sourceLocTab)
+    (m_litstrs);
+  sd(uint32_t(m_arrays.size()));
+  for (unsigned i = 0; i < m_arrays.size(); ++i) {
+    sd(m_arrays[i].serialized);
+  }
+  sd(uint32_t(m_preConsts.size()));
+  for (size_t i = 0; i < m_preConsts.size(); ++i) {
+    sd(m_preConsts[i].name)(m_preConsts[i].value);
+  }
+  sd(uint32_t(m_pceVec.size()));
+  for (PceVec::const_iterator it = m_pceVec.begin(); it != m_pceVec.end();
+       ++it) {
+    sd((*it)->name())((*it)->hoistable());
+    (*it)->serdeMetaData(sd);
+  }
+  // Methods live on their PreClassEmitters; interleave them with the
+  // top-level funcs in sn order so decodeImage() recreates identical sns.
+  FeVec fes(m_fes);
+  for (PceVec::const_iterator it = m_pceVec.begin(); it != m_pceVec.end();
+       ++it) {
+    const PreClassEmitter::MethodVec& methods = (*it)->methods();
+    fes.insert(fes.end(), methods.begin(), methods.end());
+  }
+  std::sort(fes.begin(), fes.end(), feSnLess);
+  sd(uint32_t(fes.size()));
+  for (FeVec::const_iterator it = fes.begin(); it != fes.end(); ++it) {
+    FuncEmitter* fe = *it;
+    sd(fe->pce() ? fe->pce()->id() : Id(-1))(fe->name())(fe->top());
+    fe->serdeMetaData(sd);
+  }
+}
+
+void UnitEmitter::decodeImage(BlobDecoder& sd) {
+  size_t bclen;
+  const void* bc = sd.decodeRaw(bclen);
+  setBc((const uchar*)bc, bclen);
+  size_t bc_meta_len;
+  const void* bc_meta = sd.decodeRaw(bc_meta_len);
+  setBcMeta((const uchar*)bc_meta, bc_meta_len);
+  sd(m_sourceLocTab);
+
+  std::vector<const StringData*> litstrs;
+  sd(litstrs);
+  for (unsigned i = 0; i < litstrs.size(); ++i) {
+    Id id UNUSED = mergeLitstr(litstrs[i]);
+    ASSERT(id == Id(i));
+  }
+
+  uint32_t n;
+  sd(n);
+  for (uint32_t i = 0; i < n; ++i) {
+    const StringData* array;
+    sd(array);
+    String s(const_cast<StringData*>(array));
+    Variant v = f_unserialize(s);
+    Id id UNUSED = mergeArray(v.asArrRef().get(), array);
+    ASSERT(id == Id(i));
+  }
+  sd(n);
+  for (uint32_t i = 0; i < n; ++i) {
+    const StringData* name;
+    TypedValue value;
+    sd(name)(value);
+    Id id UNUSED = addPreConst(name, value);
+    ASSERT(id == Id(i));
+  }
+  sd(n);
+  for (uint32_t i = 0; i < n; ++i) {
+    const StringData* name;
+    bool hoistable;
+    sd(name)(hoistable);
+    PreClassEmitter* pce = newPreClassEmitter(name, hoistable);
+    pce->setHoistable(hoistable);
+    pce->serdeMetaData(sd);
+    ASSERT(pce->id() == Id(i));
+  }
+  sd(n);
+  for (uint32_t i = 0; i < n; ++i) {
+    Id preClassId;
+    const StringData* name;
+    bool top;
+    sd(preClassId)(name)(top);
+    FuncEmitter* fe;
+    if (preClassId < 0) {
+      fe = newFuncEmitter(name, top);
+    } else {
+      PreClassEmitter* pce = m_pceVec[preClassId];
+      fe = newMethodEmitter(name, pce);
+      bool added UNUSED = pce->addMethod(fe);
+      ASSERT(added);
+    }
+    ASSERT(fe->sn() == int(i));
+    fe->setTop(top);
+    fe->serdeMetaData(sd);
+    fe->finish(fe->past(), true);
+    recordFunction(fe);
+  }
+}
+
 Unit* UnitEmitter::create() {
   Unit* u = new Unit();
   u->m_repoId = m_repoId;
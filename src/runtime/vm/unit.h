@@ -149,6 +149,10 @@ class SourceLoc {
     char1 = l->char1;
   }
 
+  template<class SerDe> void serde(SerDe& sd) {
+    sd(line0)(char0)(line1)(char1);
+  }
+
   bool same(const SourceLoc *l) const {
     return (this == l) ||
            (line0 == l->line0 && char0 == l->char0 &&
@@ -513,7 +517,7 @@ class UnitEmitter {
   Offset bcPos() const { return (Offset)m_bclen; }
   void setBc(const uchar* bc, size_t bclen);
   void setBcMeta(const uchar* bc_meta, size_t bc_meta_len);
-  const StringData* getFilepath() { return m_filepath; }
+  const StringData* getFilepath() const { return m_filepath; }
   void setFilepath(const StringData* filepath) { m_filepath = filepath; }
   const MD5& md5() const { return m_md5; }
   Id addPreConst(const StringData* name, const TypedValue& value);
@@ -578,6 +582,12 @@ class UnitEmitter {
   void emitInt64(int64 n, int64 pos = -1) { emitImpl(n, pos); }
   void emitDouble(double n, int64 pos = -1) { emitImpl(n, pos); }
   void commit(UnitOrigin unitOrigin);
+  /*
+   * Serialize the whole unit (bytecode, tables, classes and funcs) into a
+   * single self-contained blob, as stored in a RepoImage, and back.
+   */
+  void encodeImage(BlobEncoder& sd) const;
+  void decodeImage(BlobDecoder& sd);
   Func* newFunc(const FuncEmitter* fe, Unit& unit, Id id, int line1, int line2,
                 Offset base, Offset past,
                 const StringData* name, Attr attrs, bool top,
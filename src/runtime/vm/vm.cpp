@@ -22,6 +22,7 @@
 #include <runtime/vm/bytecode.h>
 #include <runtime/vm/funcdict.h>
 #include <runtime/vm/runtime.h>
+#include <runtime/vm/repo_image.h>
 #include <runtime/ext_hhvm/ext_hhvm.h>
 #include <runtime/vm/translator/translator.h>
 #include <runtime/vm/translator/targetcache.h>
@@ -101,6 +102,9 @@ public:
 static VMClassInfoHook vm_class_info_hook;
 
 void ProcessInit() {
+  if (!RuntimeOption::RepoImagePath.empty()) {
+    RepoImage::Load(RuntimeOption::RepoImagePath);
+  }
   // Initialize compiler state
   VM::compile_file(0, 0, MD5(), 0);
   // Install VM's ClassInfoHook
@@ -21590,6 +21590,99 @@ Variant ifa_rtrim(void *extra, int count, INVOKE_FEW_ARGS_IMPL_ARGS) {
 Variant i_rtrim(void *extra, CArrRef params) {
   return invoke_func_few_handler(extra, params, &ifa_rtrim);
 }
+Variant ifa_mysql_async_query_start(void *extra, int count, INVOKE_FEW_ARGS_IMPL_ARGS) {
+  if (UNLIKELY(count < 1 || count > 2)) return throw_wrong_arguments("mysql_async_query_start", count, 1, 2, 1);
+  CVarRef arg0(a0);
+  if (count <= 1) return (x_mysql_async_query_start(arg0));
+  CVarRef arg1(a1);
+  return (x_mysql_async_query_start(arg0, arg1));
+}
+Variant i_mysql_async_query_start(void *extra, CArrRef params) {
+  return invoke_func_few_handler(extra, params, &ifa_mysql_async_query_start);
+}
+Variant ifa_mysql_async_query_completed(void *extra, int count, INVOKE_FEW_ARGS_IMPL_ARGS) {
+  if (UNLIKELY(count > 1)) return throw_toomany_arguments("mysql_async_query_completed", 1, 1);
+  if (count <= 0) return (x_mysql_async_query_completed());
+  CVarRef arg0(a0);
+  return (x_mysql_async_query_completed(arg0));
+}
+Variant i_mysql_async_query_completed(void *extra, CArrRef params) {
+  return invoke_func_few_handler(extra, params, &ifa_mysql_async_query_completed);
+}
+Variant ifa_mysql_async_query_result(void *extra, int count, INVOKE_FEW_ARGS_IMPL_ARGS) {
+  if (UNLIKELY(count > 1)) return throw_toomany_arguments("mysql_async_query_result", 1, 1);
+  if (count <= 0) return (x_mysql_async_query_result());
+  CVarRef arg0(a0);
+  return (x_mysql_async_query_result(arg0));
+}
+Variant i_mysql_async_query_result(void *extra, CArrRef params) {
+  return invoke_func_few_handler(extra, params, &ifa_mysql_async_query_result);
+}
+Variant ifa_mysql_async_wait_actionable(void *extra, int count, INVOKE_FEW_ARGS_IMPL_ARGS) {
+  if (UNLIKELY(count > 2)) return throw_toomany_arguments("mysql_async_wait_actionable", 2, 1);
+  if (count <= 0) return (x_mysql_async_wait_actionable());
+  CVarRef arg0(a0);
+  if (count <= 1) return (x_mysql_async_wait_actionable(arg0));
+  CVarRef arg1(a1);
+  return (x_mysql_async_wait_actionable(arg0, arg1));
+}
+Variant i_mysql_async_wait_actionable(void *extra, CArrRef params) {
+  return invoke_func_few_handler(extra, params, &ifa_mysql_async_wait_actionable);
+}
+Variant ifa_fb_curl_multi_await(void *extra, int count, INVOKE_FEW_ARGS_IMPL_ARGS) {
+  if (UNLIKELY(count < 1 || count > 2)) return throw_wrong_arguments("fb_curl_multi_await", count, 1, 2, 1);
+  CVarRef arg0(a0);
+  if (count <= 1) return (x_fb_curl_multi_await(arg0));
+  CVarRef arg1(a1);
+  return (x_fb_curl_multi_await(arg0, arg1));
+}
+Variant i_fb_curl_multi_await(void *extra, CArrRef params) {
+  return invoke_func_few_handler(extra, params, &ifa_fb_curl_multi_await);
+}
+Variant ifa_hphp_get_io_trace(void *extra, int count, INVOKE_FEW_ARGS_IMPL_ARGS) {
+  if (UNLIKELY(count > 0)) return throw_toomany_arguments("hphp_get_io_trace", 0, 1);
+  return (x_hphp_get_io_trace());
+}
+Variant i_hphp_get_io_trace(void *extra, CArrRef params) {
+  return invoke_func_few_handler(extra, params, &ifa_hphp_get_io_trace);
+}
+Variant ifa_hphp_io_trace_start(void *extra, int count, INVOKE_FEW_ARGS_IMPL_ARGS) {
+  if (UNLIKELY(count > 0)) return throw_toomany_arguments("hphp_io_trace_start", 0, 1);
+  return (x_hphp_io_trace_start(), null);
+}
+Variant i_hphp_io_trace_start(void *extra, CArrRef params) {
+  return invoke_func_few_handler(extra, params, &ifa_hphp_io_trace_start);
+}
+Variant ifa_hphp_get_cpu_time_remaining_ms(void *extra, int count, INVOKE_FEW_ARGS_IMPL_ARGS) {
+  if (UNLIKELY(count > 0)) return throw_toomany_arguments("hphp_get_cpu_time_remaining_ms", 0, 1);
+  return (x_hphp_get_cpu_time_remaining_ms());
+}
+Variant i_hphp_get_cpu_time_remaining_ms(void *extra, CArrRef params) {
+  return invoke_func_few_handler(extra, params, &ifa_hphp_get_cpu_time_remaining_ms);
+}
+Variant ifa_hphp_get_time_remaining_ms(void *extra, int count, INVOKE_FEW_ARGS_IMPL_ARGS) {
+  if (UNLIKELY(count > 0)) return throw_toomany_arguments("hphp_get_time_remaining_ms", 0, 1);
+  return (x_hphp_get_time_remaining_ms());
+}
+Variant i_hphp_get_time_remaining_ms(void *extra, CArrRef params) {
+  return invoke_func_few_handler(extra, params, &ifa_hphp_get_time_remaining_ms);
+}
+Variant ifa_hphp_set_cpu_time_limit_ms(void *extra, int count, INVOKE_FEW_ARGS_IMPL_ARGS) {
+  if (UNLIKELY(count != 1)) return throw_wrong_arguments("hphp_set_cpu_time_limit_ms", count, 1, 1, 1);
+  CVarRef arg0(a0);
+  return (x_hphp_set_cpu_time_limit_ms(arg0), null);
+}
+Variant i_hphp_set_cpu_time_limit_ms(void *extra, CArrRef params) {
+  return invoke_func_few_handler(extra, params, &ifa_hphp_set_cpu_time_limit_ms);
+}
+Variant ifa_hphp_set_time_limit_ms(void *extra, int count, INVOKE_FEW_ARGS_IMPL_ARGS) {
+  if (UNLIKELY(count != 1)) return throw_wrong_arguments("hphp_set_time_limit_ms", count, 1, 1, 1);
+  CVarRef arg0(a0);
+  return (x_hphp_set_time_limit_ms(arg0), null);
+}
+Variant i_hphp_set_time_limit_ms(void *extra, CArrRef params) {
+  return invoke_func_few_handler(extra, params, &ifa_hphp_set_time_limit_ms);
+}
 extern const CallInfo ci_stream_get_wrappers = {(void*)&i_stream_get_wrappers, (void*)&ifa_stream_get_wrappers, 0, 0, 0x0000000000000000LL};
 extern const CallInfo ci_get_class_methods = {(void*)&i_get_class_methods, (void*)&ifa_get_class_methods, 1, 0, 0x0000000000000000LL};
 extern const CallInfo ci_openssl_pkey_export_to_file = {(void*)&i_openssl_pkey_export_to_file, (void*)&ifa_openssl_pkey_export_to_file, 4, 0, 0x0000000000000000LL};
@@ -23755,6 +23848,17 @@ extern const CallInfo ci_ctype_print = {(void*)&i_ctype_print, (void*)&ifa_ctype
 extern const CallInfo ci_drawsetstrokedashoffset = {(void*)&i_drawsetstrokedashoffset, (void*)&ifa_drawsetstrokedashoffset, 2, 0, 0x0000000000000000LL};
 extern const CallInfo ci_session_save_path = {(void*)&i_session_save_path, (void*)&ifa_session_save_path, 1, 0, 0x0000000000000000LL};
 extern const CallInfo ci_rtrim = {(void*)&i_rtrim, (void*)&ifa_rtrim, 2, 0, 0x0000000000000000LL};
+extern const CallInfo ci_mysql_async_query_start = {(void*)&i_mysql_async_query_start, (void*)&ifa_mysql_async_query_start, 2, 0, 0x0000000000000000LL};
+extern const CallInfo ci_mysql_async_query_completed = {(void*)&i_mysql_async_query_completed, (void*)&ifa_mysql_async_query_completed, 1, 0, 0x0000000000000000LL};
+extern const CallInfo ci_mysql_async_query_result = {(void*)&i_mysql_async_query_result, (void*)&ifa_mysql_async_query_result, 1, 0, 0x0000000000000000LL};
+extern const CallInfo ci_mysql_async_wait_actionable = {(void*)&i_mysql_async_wait_actionable, (void*)&ifa_mysql_async_wait_actionable, 2, 0, 0x0000000000000000LL};
+extern const CallInfo ci_fb_curl_multi_await = {(void*)&i_fb_curl_multi_await, (void*)&ifa_fb_curl_multi_await, 2, 0, 0x0000000000000000LL};
+extern const CallInfo ci_hphp_get_io_trace = {(void*)&i_hphp_get_io_trace, (void*)&ifa_hphp_get_io_trace, 0, 0, 0x0000000000000000LL};
+extern const CallInfo ci_hphp_io_trace_start = {(void*)&i_hphp_io_trace_start, (void*)&ifa_hphp_io_trace_start, 0, 0, 0x0000000000000000LL};
+extern const CallInfo ci_hphp_get_cpu_time_remaining_ms = {(void*)&i_hphp_get_cpu_time_remaining_ms, (void*)&ifa_hphp_get_cpu_time_remaining_ms, 0, 0, 0x0000000000000000LL};
+extern const CallInfo ci_hphp_get_time_remaining_ms = {(void*)&i_hphp_get_time_remaining_ms, (void*)&ifa_hphp_get_time_remaining_ms, 0, 0, 0x0000000000000000LL};
+extern const CallInfo ci_hphp_set_cpu_time_limit_ms = {(void*)&i_hphp_set_cpu_time_limit_ms, (void*)&ifa_hphp_set_cpu_time_limit_ms, 1, 0, 0x0000000000000000LL};
+extern const CallInfo ci_hphp_set_time_limit_ms = {(void*)&i_hphp_set_time_limit_ms, (void*)&ifa_hphp_set_time_limit_ms, 1, 0, 0x0000000000000000LL};
 
 struct hashNodeFunc {
   int64 hash;
@@ -24003,13 +24107,15 @@ static const hashNodeFunc funcBuckets[] = {
  {0x5C29B6D7973903A1LL,0,1,"proc_nice",&ci_proc_nice},
  {0x0207E332D629A3A2LL,0,1,"mailparse_msg_get_structure",&ci_mailparse_msg_get_structure},
  {0x0121CD6CDCE1C3A8LL,0,1,"mysql_pconnect_with_db",&ci_mysql_pconnect_with_db},
- {0x7F9E810BC93023A9LL,0,1,"memcache_close",&ci_memcache_close},
+ {0x7F9E810BC93023A9LL,0,0,"memcache_close",&ci_memcache_close},
+ {0x2662DE17A56DC3A9LL,0,1,"mysql_async_query_start",&ci_mysql_async_query_start},
  {0x3238A5BD362443AALL,0,1,"escapeshellcmd",&ci_escapeshellcmd},
  {0x3DB7EBC0B670C3B2LL,0,1,"magicksetimageredprimary",&ci_magicksetimageredprimary},
  {0x61720D771D1A23B3LL,0,1,"posix_getpwnam",&ci_posix_getpwnam},
  {0x03BE37E94875C3B5LL,0,1,"fb_set_exit_callback",&ci_fb_set_exit_callback},
  {0x5A3F5AAD1B13A3BBLL,0,1,"is_executable",&ci_is_executable},
  {0x60294C2616F6A3BDLL,0,1,"mcrypt_enc_get_supported_key_sizes",&ci_mcrypt_enc_get_supported_key_sizes},
+ {0x718C2B0381D303C6LL,0,1,"hphp_get_cpu_time_remaining_ms",&ci_hphp_get_cpu_time_remaining_ms},
  {0x3101CE70BA49A3C8LL,0,1,"error_reporting",&ci_error_reporting},
  {0x4C3B6BE9112E63CBLL,0,1,"str_split",&ci_str_split},
  {0x50C88817090C63CCLL,0,1,"pcntl_wait",&ci_pcntl_wait},
@@ -24104,6 +24210,7 @@ static const hashNodeFunc funcBuckets[] = {
  {0x0AD3BFAB5F780548LL,0,1,"magickcoalesceimages",&ci_magickcoalesceimages},
  {0x1B9E769FFEC3C54DLL,0,1,"pcntl_wtermsig",&ci_pcntl_wtermsig},
  {0x063200B5AAFEC54FLL,0,1,"mysql_thread_id",&ci_mysql_thread_id},
+ {0x36202A74FFE5A563LL,0,1,"mysql_async_wait_actionable",&ci_mysql_async_wait_actionable},
  {0x3DA2058E5C540566LL,0,1,"spliti",&ci_spliti},
  {0x74599147803DC56ALL,0,1,"magickgetstringwidth",&ci_magickgetstringwidth},
  {0x0DE86977367F656BLL,0,1,"register_shutdown_function",&ci_register_shutdown_function},
@@ -24118,6 +24225,7 @@ static const hashNodeFunc funcBuckets[] = {
  {0x709140577B2C6580LL,0,1,"xhprof_network_enable",&ci_xhprof_network_enable},
  {0x02688986D5D76582LL,0,1,"magickspreadimage",&ci_magickspreadimage},
  {0x3B2CD86F5DB72583LL,0,1,"magickblackthresholdimage",&ci_magickblackthresholdimage},
+ {0x30224368BB9FC58ALL,0,1,"hphp_get_time_remaining_ms",&ci_hphp_get_time_remaining_ms},
  {0x3A34B44E4C51C58BLL,0,0,"xml_set_element_handler",&ci_xml_set_element_handler},
  {0x135C66BF0425458BLL,0,0,"_soap_active_version",&ci__soap_active_version},
  {0x1EF2C1426AB0A58BLL,0,1,"dom_node_replace_child",&ci_dom_node_replace_child},
@@ -24227,6 +24335,7 @@ static const hashNodeFunc funcBuckets[] = {
  {0x78420E0B5D110723LL,0,1,"imagetruecolortopalette",&ci_imagetruecolortopalette},
  {0x4DAA3FBC2BD3A724LL,0,1,"magickequalizeimage",&ci_magickequalizeimage},
  {0x31EAD049860CE725LL,0,1,"posix_kill",&ci_posix_kill},
+ {0x1EAA582DAA9AA728LL,0,1,"hphp_set_time_limit_ms",&ci_hphp_set_time_limit_ms},
  {0x1F98B41362CDA72ALL,0,0,"magickgetimagegreenprimary",&ci_magickgetimagegreenprimary},
  {0x17C0D9B1C10B872ALL,0,1,"openssl_x509_export",&ci_openssl_x509_export},
  {0x0D558F552A784730LL,0,1,"ob_get_contents",&ci_ob_get_contents},
@@ -24429,7 +24538,8 @@ static const hashNodeFunc funcBuckets[] = {
  {0x51201EE65BC729F4LL,0,1,"localtime",&ci_localtime},
  {0x2BC61637253BE9F5LL,0,1,"drawgetfontweight",&ci_drawgetfontweight},
  {0x2394D4E030AB69FDLL,0,1,"getmypid",&ci_getmypid},
- {0x0B88D3F582D16A04LL,0,1,"memcache_get_extended_stats",&ci_memcache_get_extended_stats},
+ {0x0B88D3F582D16A04LL,0,0,"memcache_get_extended_stats",&ci_memcache_get_extended_stats},
+ {0x06A574C312AD0A04LL,0,1,"hphp_set_cpu_time_limit_ms",&ci_hphp_set_cpu_time_limit_ms},
  {0x13E0C91488484A0CLL,0,1,"imap_unsubscribe",&ci_imap_unsubscribe},
  {0x472CA39715598A11LL,0,1,"mb_eregi_replace",&ci_mb_eregi_replace},
  {0x66A378C6BBC26A18LL,0,1,"dom_document_create_cdatasection",&ci_dom_document_create_cdatasection},
@@ -24440,6 +24550,7 @@ static const hashNodeFunc funcBuckets[] = {
  {0x3FC127C442BAEA22LL,0,1,"session_id",&ci_session_id},
  {0x5EC0A3DD935EEA25LL,0,0,"magickresampleimage",&ci_magickresampleimage},
  {0x1DB9A1FB97A3AA25LL,0,1,"magicksetimageoption",&ci_magicksetimageoption},
+ {0x31773B24F6E98A29LL,0,1,"mysql_async_query_completed",&ci_mysql_async_query_completed},
  {0x3CAEA6B8D1C92A2ALL,0,1,"stream_bucket_prepend",&ci_stream_bucket_prepend},
  {0x073ACDF9B3F06A2CLL,0,0,"memcache_setoptimeout",&ci_memcache_setoptimeout},
  {0x3DA70155FBE16A2CLL,0,1,"fb_curl_getopt",&ci_fb_curl_getopt},
@@ -24787,6 +24898,7 @@ static const hashNodeFunc funcBuckets[] = {
  {0x367CFD20B4446EE5LL,0,1,"is_array",&ci_is_array},
  {0x6CB6650E66CE4EE8LL,0,1,"magicksetimagebordercolor",&ci_magicksetimagebordercolor},
  {0x72882DBF2D49CEEBLL,0,1,"set_magic_quotes_runtime",&ci_set_magic_quotes_runtime},
+ {0x2EB2AA5DA4F32EF2LL,0,1,"hphp_io_trace_start",&ci_hphp_io_trace_start},
  {0x33FD10AC81146EF8LL,0,1,"thrift_protocol_read_binary",&ci_thrift_protocol_read_binary},
  {0x0CF27A6BC84CEEFDLL,0,0,"openssl_get_publickey",&ci_openssl_get_publickey},
  {0x283E167EB3F04EFDLL,0,1,"posix_getgid",&ci_posix_getgid},
@@ -25066,6 +25178,7 @@ static const hashNodeFunc funcBuckets[] = {
  {0x1C7B8161F3C412C4LL,0,1,"dom_document_create_document_fragment",&ci_dom_document_create_document_fragment},
  {0x407EF03C23BF92CCLL,0,1,"drawpathellipticarcabsolute",&ci_drawpathellipticarcabsolute},
  {0x4ACE27EC476632CFLL,0,1,"apc_bin_dumpfile",&ci_apc_bin_dumpfile},
+ {0x170111DDFC39D2D4LL,0,1,"fb_curl_multi_await",&ci_fb_curl_multi_await},
  {0x4D04C580CF9212D5LL,0,1,"posix_getgroups",&ci_posix_getgroups},
  {0x06E9C984B5F0B2D6LL,0,1,"furchash_hphp_ext",&ci_furchash_hphp_ext},
  {0x56C4896BA2FF52D8LL,0,1,"drawsetstrokeopacity",&ci_drawsetstrokeopacity},
@@ -25495,7 +25608,8 @@ static const hashNodeFunc funcBuckets[] = {
  {0x6A3412DE82715948LL,0,1,"openssl_x509_checkpurpose",&ci_openssl_x509_checkpurpose},
  {0x243BB8B284895949LL,0,1,"apache_get_rewrite_rules",&ci_apache_get_rewrite_rules},
  {0x37F356F578FA394BLL,0,1,"substr",&ci_substr},
- {0x10DB229871AB794CLL,0,1,"imap_msgno",&ci_imap_msgno},
+ {0x10DB229871AB794CLL,0,0,"imap_msgno",&ci_imap_msgno},
+ {0x6A0AC90368DF994CLL,0,1,"mysql_async_query_result",&ci_mysql_async_query_result},
  {0x068438AFD33A9953LL,0,1,"imagecolorclosesthwb",&ci_imagecolorclosesthwb},
  {0x6FAA160ED274795CLL,0,1,"fb_utf8_substr",&ci_fb_utf8_substr},
  {0x140E984EE382F96ALL,0,1,"hphp_unpack_continuation",&ci_hphp_unpack_continuation},
@@ -25684,6 +25798,7 @@ static const hashNodeFunc funcBuckets[] = {
  {0x7039C5EBB1D6BC1ELL,0,1,"array_walk",&ci_array_walk},
  {0x3A5D921797669C1FLL,0,1,"hphp_log",&ci_hphp_log},
  {0x0179CBA2C5F4DC21LL,0,1,"magickgetimageformat",&ci_magickgetimageformat},
+ {0x67F2AAF027E0BC26LL,0,1,"hphp_get_io_trace",&ci_hphp_get_io_trace},
  {0x0B9B362534621C32LL,0,1,"isdrawingwand",&ci_isdrawingwand},
  {0x49965C44E9EE3C33LL,0,1,"set_file_buffer",&ci_set_file_buffer},
  {0x21564F9315F3FC38LL,0,1,"drawsettextdecoration",&ci_drawsettextdecoration},
@@ -26048,913 +26163,913 @@ static const hashNodeFunc *funcMapTable[] = {
   0,0,funcBuckets+224,0,funcBuckets+225,funcBuckets+227,funcBuckets+228,funcBuckets+229,
   funcBuckets+230,0,funcBuckets+231,funcBuckets+232,funcBuckets+233,0,0,funcBuckets+234,
   0,funcBuckets+236,funcBuckets+237,0,0,0,0,0,
-  funcBuckets+238,funcBuckets+239,funcBuckets+240,0,0,0,0,0,
-  0,0,funcBuckets+241,funcBuckets+242,0,funcBuckets+243,0,0,
-  0,0,0,funcBuckets+244,0,funcBuckets+245,0,0,
+  funcBuckets+238,funcBuckets+239,funcBuckets+241,0,0,0,0,0,
+  0,0,funcBuckets+242,funcBuckets+243,0,funcBuckets+244,0,0,
+  0,0,0,funcBuckets+245,0,funcBuckets+246,0,0,
+  0,0,0,0,0,0,funcBuckets+247,0,
+  funcBuckets+248,0,0,funcBuckets+249,funcBuckets+250,0,funcBuckets+251,0,
+  0,0,0,funcBuckets+252,funcBuckets+253,0,0,0,
   0,0,0,0,0,0,0,0,
-  funcBuckets+246,0,0,funcBuckets+247,funcBuckets+248,0,funcBuckets+249,0,
-  0,0,0,funcBuckets+250,funcBuckets+251,0,0,0,
+  0,0,0,0,funcBuckets+254,0,0,0,
+  funcBuckets+255,0,funcBuckets+257,funcBuckets+258,0,0,funcBuckets+259,0,
+  funcBuckets+260,0,0,0,funcBuckets+261,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+252,0,0,0,
-  funcBuckets+253,0,funcBuckets+255,funcBuckets+256,0,0,funcBuckets+257,0,
-  funcBuckets+258,0,0,0,funcBuckets+259,0,0,0,
+  0,funcBuckets+262,0,0,funcBuckets+263,0,0,0,
+  0,funcBuckets+264,0,0,0,funcBuckets+265,0,0,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+260,0,0,funcBuckets+261,0,0,0,
-  0,funcBuckets+262,0,0,0,funcBuckets+263,0,0,
   0,0,0,0,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+268,0,
+  0,0,0,0,0,funcBuckets+269,0,funcBuckets+270,
+  funcBuckets+271,0,funcBuckets+272,0,0,0,0,0,
+  0,0,funcBuckets+273,0,funcBuckets+274,0,0,0,
+  0,funcBuckets+275,funcBuckets+276,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+266,0,
-  0,0,0,0,0,funcBuckets+267,0,funcBuckets+268,
-  funcBuckets+269,0,funcBuckets+270,0,0,0,0,0,
-  0,0,funcBuckets+271,0,funcBuckets+272,0,0,0,
-  0,funcBuckets+273,funcBuckets+274,0,0,0,0,0,
+  0,0,funcBuckets+277,0,0,0,0,0,
+  0,0,0,0,0,funcBuckets+278,0,0,
+  0,0,0,0,0,funcBuckets+279,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+275,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+276,0,0,
-  0,0,0,0,0,funcBuckets+277,0,0,
+  funcBuckets+281,0,0,funcBuckets+282,0,funcBuckets+283,0,0,
+  0,0,0,0,funcBuckets+284,0,funcBuckets+285,0,
+  0,0,0,0,0,funcBuckets+286,0,0,
+  0,funcBuckets+287,0,0,0,funcBuckets+288,0,funcBuckets+289,
   0,0,0,0,0,0,0,0,
-  funcBuckets+279,0,0,funcBuckets+280,0,funcBuckets+281,0,0,
-  0,0,0,0,funcBuckets+282,0,funcBuckets+283,0,
-  0,0,0,0,0,funcBuckets+284,0,0,
-  0,funcBuckets+285,0,0,0,funcBuckets+286,0,funcBuckets+287,
-  0,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+288,0,funcBuckets+289,
-  0,0,0,0,funcBuckets+290,0,0,0,
-  funcBuckets+291,0,0,0,funcBuckets+292,funcBuckets+294,0,0,
-  funcBuckets+295,0,0,0,funcBuckets+296,0,0,0,
-  0,funcBuckets+297,0,0,0,funcBuckets+298,funcBuckets+300,funcBuckets+301,
-  0,0,0,funcBuckets+302,funcBuckets+303,0,funcBuckets+304,0,
-  0,0,0,0,0,0,funcBuckets+306,funcBuckets+307,
-  0,0,0,0,0,0,0,funcBuckets+308,
-  funcBuckets+309,0,0,0,0,0,0,funcBuckets+310,
+  0,0,0,0,0,funcBuckets+290,0,funcBuckets+291,
+  0,0,0,0,funcBuckets+292,0,0,0,
+  funcBuckets+293,0,0,0,funcBuckets+294,funcBuckets+296,0,0,
+  funcBuckets+297,0,0,0,funcBuckets+298,0,0,0,
+  0,funcBuckets+299,0,0,0,funcBuckets+300,funcBuckets+302,funcBuckets+303,
+  0,0,0,funcBuckets+304,funcBuckets+305,0,funcBuckets+306,0,
+  0,0,0,0,0,0,funcBuckets+308,funcBuckets+309,
+  0,0,0,0,0,0,0,funcBuckets+310,
   funcBuckets+311,0,0,0,0,0,0,funcBuckets+312,
-  0,0,0,0,funcBuckets+313,0,0,0,
-  0,funcBuckets+314,0,0,0,funcBuckets+315,0,funcBuckets+316,
-  funcBuckets+318,0,0,0,0,funcBuckets+319,0,0,
-  0,0,0,0,0,0,0,funcBuckets+321,
-  0,0,0,funcBuckets+322,0,0,0,funcBuckets+323,
-  0,funcBuckets+324,0,0,0,0,0,0,
-  0,funcBuckets+325,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+326,0,funcBuckets+327,funcBuckets+328,
+  funcBuckets+313,0,0,0,0,0,0,funcBuckets+314,
+  0,0,0,0,funcBuckets+315,0,0,0,
+  0,funcBuckets+316,0,0,0,funcBuckets+317,0,funcBuckets+318,
+  funcBuckets+320,0,0,0,0,funcBuckets+321,0,0,
+  0,0,0,0,0,0,0,funcBuckets+323,
+  0,0,0,funcBuckets+324,0,0,0,funcBuckets+325,
+  0,funcBuckets+326,0,0,0,0,0,0,
+  0,funcBuckets+327,0,0,0,0,0,0,
+  0,0,0,0,funcBuckets+328,0,funcBuckets+329,funcBuckets+330,
   0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+329,0,0,funcBuckets+330,funcBuckets+331,
-  0,0,0,0,0,funcBuckets+332,0,0,
-  0,0,funcBuckets+333,funcBuckets+334,0,0,funcBuckets+335,0,
-  funcBuckets+337,0,0,0,0,funcBuckets+338,0,funcBuckets+339,
+  0,0,0,funcBuckets+331,0,0,funcBuckets+332,funcBuckets+333,
+  0,0,0,0,0,funcBuckets+334,0,0,
+  0,0,funcBuckets+335,funcBuckets+336,0,0,funcBuckets+337,0,
+  funcBuckets+339,0,0,0,0,funcBuckets+340,0,funcBuckets+341,
   0,0,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+340,0,
-  0,0,funcBuckets+341,funcBuckets+342,0,0,funcBuckets+343,0,
-  funcBuckets+344,0,0,0,0,0,0,funcBuckets+346,
-  0,funcBuckets+347,0,0,0,funcBuckets+348,funcBuckets+350,0,
-  funcBuckets+351,0,funcBuckets+352,funcBuckets+353,0,0,0,0,
-  0,0,0,funcBuckets+354,funcBuckets+357,0,funcBuckets+358,0,
-  0,0,funcBuckets+359,funcBuckets+363,0,0,0,funcBuckets+364,
-  0,funcBuckets+365,0,0,0,0,0,0,
+  0,0,0,funcBuckets+342,0,0,funcBuckets+343,0,
+  0,0,funcBuckets+344,funcBuckets+345,0,0,funcBuckets+346,0,
+  funcBuckets+347,0,0,0,0,0,0,funcBuckets+349,
+  0,funcBuckets+350,0,0,0,funcBuckets+351,funcBuckets+353,0,
+  funcBuckets+354,0,funcBuckets+355,funcBuckets+356,0,0,0,0,
+  0,0,funcBuckets+357,funcBuckets+358,funcBuckets+361,0,funcBuckets+362,0,
+  0,0,funcBuckets+363,funcBuckets+367,0,0,0,funcBuckets+368,
+  0,funcBuckets+369,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  funcBuckets+366,0,0,0,0,funcBuckets+367,0,0,
-  0,0,0,0,0,funcBuckets+368,0,0,
-  0,0,funcBuckets+369,0,0,0,0,0,
-  funcBuckets+370,0,0,0,0,0,funcBuckets+371,0,
-  funcBuckets+372,0,0,funcBuckets+373,funcBuckets+374,0,funcBuckets+375,funcBuckets+376,
-  0,funcBuckets+377,0,0,0,funcBuckets+378,funcBuckets+379,funcBuckets+380,
+  funcBuckets+370,0,0,0,0,funcBuckets+371,0,0,
+  0,0,0,0,0,funcBuckets+372,0,0,
+  0,0,funcBuckets+373,0,0,0,0,0,
+  funcBuckets+374,0,0,0,0,0,funcBuckets+375,0,
+  funcBuckets+376,0,0,funcBuckets+377,funcBuckets+378,0,funcBuckets+379,funcBuckets+380,
+  0,funcBuckets+381,0,0,0,funcBuckets+382,funcBuckets+383,funcBuckets+384,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+381,0,funcBuckets+382,0,
-  0,0,0,0,0,0,funcBuckets+384,0,
-  0,0,0,0,funcBuckets+385,0,0,funcBuckets+387,
-  0,0,0,funcBuckets+388,0,funcBuckets+389,0,0,
-  0,funcBuckets+391,0,0,0,0,0,0,
-  0,funcBuckets+392,0,0,0,0,0,0,
-  0,0,0,funcBuckets+393,0,0,funcBuckets+395,0,
-  0,0,0,funcBuckets+397,0,funcBuckets+398,0,0,
-  0,0,funcBuckets+399,0,0,0,0,0,
-  0,funcBuckets+400,funcBuckets+401,0,0,0,0,0,
-  0,funcBuckets+402,0,0,0,0,0,0,
-  0,0,0,funcBuckets+403,funcBuckets+404,0,0,0,
-  0,0,0,0,0,0,funcBuckets+405,0,
-  0,0,0,0,0,0,funcBuckets+406,0,
-  0,0,funcBuckets+407,0,0,0,0,funcBuckets+408,
-  0,funcBuckets+409,0,0,funcBuckets+411,0,funcBuckets+412,0,
-  0,0,0,0,funcBuckets+413,funcBuckets+414,0,funcBuckets+415,
-  0,0,0,0,0,0,0,funcBuckets+416,
+  0,0,0,0,funcBuckets+385,0,funcBuckets+386,0,
+  0,0,0,0,0,0,funcBuckets+388,0,
+  0,0,0,0,funcBuckets+389,0,0,funcBuckets+391,
+  0,0,0,funcBuckets+392,0,funcBuckets+393,0,0,
+  0,funcBuckets+395,0,0,0,0,0,0,
+  0,funcBuckets+396,0,0,0,0,0,0,
+  0,0,0,funcBuckets+397,0,0,funcBuckets+399,0,
+  0,0,0,funcBuckets+401,0,funcBuckets+402,0,0,
+  0,0,funcBuckets+403,0,0,0,0,0,
+  0,funcBuckets+404,funcBuckets+405,0,0,0,0,0,
+  0,funcBuckets+406,0,0,0,0,0,0,
+  0,0,0,funcBuckets+407,funcBuckets+408,0,0,0,
+  0,0,0,0,0,0,funcBuckets+409,0,
+  0,0,0,0,0,0,funcBuckets+410,0,
+  0,0,funcBuckets+411,0,0,0,0,funcBuckets+412,
+  0,funcBuckets+413,0,0,funcBuckets+415,0,funcBuckets+416,0,
+  0,0,0,0,funcBuckets+417,funcBuckets+418,0,funcBuckets+419,
+  0,0,0,0,0,0,0,funcBuckets+420,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+417,0,0,funcBuckets+418,0,0,
-  0,0,funcBuckets+419,0,0,0,0,0,
+  0,0,funcBuckets+421,0,0,funcBuckets+422,0,0,
+  0,0,funcBuckets+423,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  funcBuckets+420,funcBuckets+421,funcBuckets+422,0,funcBuckets+423,0,0,0,
-  0,0,funcBuckets+424,funcBuckets+425,0,0,funcBuckets+426,0,
-  0,0,0,0,0,0,funcBuckets+427,0,
-  funcBuckets+428,0,funcBuckets+429,0,0,0,0,0,
-  funcBuckets+430,0,funcBuckets+431,0,0,funcBuckets+432,funcBuckets+433,funcBuckets+434,
-  0,funcBuckets+435,funcBuckets+436,0,0,0,0,0,
-  0,0,0,0,funcBuckets+437,0,funcBuckets+440,0,
-  funcBuckets+441,funcBuckets+442,0,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+443,0,
+  funcBuckets+424,funcBuckets+425,funcBuckets+426,0,funcBuckets+427,0,0,0,
+  0,0,funcBuckets+428,funcBuckets+429,0,0,funcBuckets+430,0,
+  0,0,0,0,0,0,funcBuckets+431,0,
+  funcBuckets+432,0,funcBuckets+433,0,0,0,0,0,
+  funcBuckets+434,0,funcBuckets+435,0,0,funcBuckets+436,funcBuckets+437,funcBuckets+438,
+  0,funcBuckets+439,funcBuckets+440,0,0,0,0,0,
+  0,0,0,0,funcBuckets+441,0,funcBuckets+444,0,
+  funcBuckets+445,funcBuckets+446,0,0,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+447,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+444,0,0,0,
-  0,0,0,0,funcBuckets+445,funcBuckets+446,0,funcBuckets+447,
-  0,funcBuckets+448,funcBuckets+449,funcBuckets+450,0,0,funcBuckets+451,funcBuckets+452,
-  0,0,0,0,0,0,0,funcBuckets+453,
+  0,0,0,0,funcBuckets+448,0,0,0,
+  0,0,0,0,funcBuckets+449,funcBuckets+450,0,funcBuckets+451,
+  0,funcBuckets+452,funcBuckets+453,funcBuckets+454,0,0,funcBuckets+455,funcBuckets+456,
+  0,0,0,0,0,0,0,funcBuckets+457,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+454,0,funcBuckets+456,0,0,0,funcBuckets+457,
+  0,funcBuckets+458,0,funcBuckets+460,0,0,0,funcBuckets+461,
   0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+458,funcBuckets+459,0,0,0,
-  0,0,0,funcBuckets+460,funcBuckets+461,funcBuckets+462,0,0,
-  0,0,funcBuckets+463,0,0,0,0,0,
-  funcBuckets+465,0,funcBuckets+466,0,0,0,0,0,
-  0,0,0,funcBuckets+467,0,0,0,funcBuckets+468,
-  0,0,0,0,0,0,0,funcBuckets+469,
-  funcBuckets+471,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+472,funcBuckets+473,0,0,funcBuckets+474,
-  0,0,0,0,0,0,0,funcBuckets+475,
-  funcBuckets+476,funcBuckets+478,0,funcBuckets+479,0,0,0,funcBuckets+481,
-  funcBuckets+483,0,0,0,0,0,0,0,
-  funcBuckets+484,0,0,0,0,0,funcBuckets+485,0,
-  0,0,funcBuckets+486,0,0,0,0,0,
-  funcBuckets+488,0,0,funcBuckets+489,0,0,0,0,
-  0,0,funcBuckets+490,0,0,0,0,funcBuckets+491,
-  0,0,funcBuckets+492,0,funcBuckets+493,funcBuckets+494,0,0,
-  0,funcBuckets+495,0,0,0,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+496,
-  0,funcBuckets+497,funcBuckets+498,0,0,0,0,0,
+  0,0,0,funcBuckets+462,funcBuckets+463,0,0,0,
+  0,0,0,funcBuckets+464,funcBuckets+465,funcBuckets+466,0,0,
+  funcBuckets+467,0,funcBuckets+468,0,0,0,0,0,
+  funcBuckets+470,0,funcBuckets+471,0,0,0,0,0,
+  0,0,0,funcBuckets+472,0,0,0,funcBuckets+473,
+  0,0,0,0,0,0,0,funcBuckets+474,
+  funcBuckets+476,0,0,0,0,0,0,0,
+  0,0,0,funcBuckets+477,funcBuckets+478,0,0,funcBuckets+479,
+  0,0,0,0,0,0,0,funcBuckets+480,
+  funcBuckets+481,funcBuckets+483,0,funcBuckets+484,0,0,0,funcBuckets+486,
+  funcBuckets+488,0,0,0,0,0,0,0,
+  funcBuckets+489,0,0,0,0,0,funcBuckets+490,0,
+  0,0,funcBuckets+491,0,0,0,0,0,
+  funcBuckets+493,0,0,funcBuckets+494,0,0,0,0,
+  0,0,funcBuckets+495,0,0,0,0,funcBuckets+496,
+  0,0,funcBuckets+497,0,funcBuckets+498,funcBuckets+499,0,0,
+  0,funcBuckets+500,0,0,0,0,0,0,
+  0,0,0,0,0,0,0,funcBuckets+501,
+  0,funcBuckets+502,funcBuckets+503,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+500,0,0,0,0,0,funcBuckets+501,
-  funcBuckets+502,0,0,0,funcBuckets+504,0,funcBuckets+505,0,
-  0,0,funcBuckets+506,0,0,funcBuckets+508,funcBuckets+509,funcBuckets+510,
+  0,funcBuckets+505,0,0,0,0,0,funcBuckets+506,
+  funcBuckets+507,0,0,0,funcBuckets+509,0,funcBuckets+510,0,
+  0,0,funcBuckets+511,0,0,funcBuckets+513,funcBuckets+514,funcBuckets+515,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+511,0,0,funcBuckets+512,funcBuckets+513,0,0,
-  0,funcBuckets+514,funcBuckets+515,0,0,0,0,0,
-  funcBuckets+516,funcBuckets+517,0,funcBuckets+518,0,0,0,0,
-  0,0,0,funcBuckets+520,0,0,0,0,
-  0,funcBuckets+522,funcBuckets+523,0,0,funcBuckets+524,0,0,
-  funcBuckets+525,funcBuckets+526,0,0,funcBuckets+527,0,0,0,
-  funcBuckets+528,0,0,0,funcBuckets+529,funcBuckets+530,0,0,
-  funcBuckets+531,0,0,funcBuckets+532,0,0,0,0,
+  0,funcBuckets+516,0,0,funcBuckets+517,funcBuckets+518,0,0,
+  0,funcBuckets+519,funcBuckets+520,0,0,0,0,0,
+  funcBuckets+521,funcBuckets+522,0,funcBuckets+523,0,0,0,0,
+  0,0,0,funcBuckets+525,0,0,0,0,
+  0,funcBuckets+527,funcBuckets+528,0,0,funcBuckets+529,0,0,
+  funcBuckets+530,funcBuckets+531,0,0,funcBuckets+532,0,0,0,
+  funcBuckets+533,0,0,0,funcBuckets+534,funcBuckets+535,0,0,
+  funcBuckets+536,0,0,funcBuckets+537,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+533,funcBuckets+534,0,funcBuckets+535,0,0,funcBuckets+536,
-  0,funcBuckets+537,0,0,funcBuckets+538,funcBuckets+539,0,funcBuckets+540,
+  0,funcBuckets+538,funcBuckets+539,0,funcBuckets+540,0,0,funcBuckets+541,
+  0,funcBuckets+542,0,0,funcBuckets+543,funcBuckets+544,0,funcBuckets+545,
   0,0,0,0,0,0,0,0,
-  funcBuckets+541,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+543,0,0,funcBuckets+544,funcBuckets+545,
-  0,0,funcBuckets+546,funcBuckets+547,0,0,funcBuckets+548,funcBuckets+549,
-  funcBuckets+550,0,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+551,0,funcBuckets+552,0,
-  0,0,0,0,funcBuckets+553,0,0,0,
-  funcBuckets+554,0,0,funcBuckets+555,funcBuckets+556,0,0,funcBuckets+557,
-  funcBuckets+558,0,funcBuckets+559,funcBuckets+561,0,0,0,0,
-  0,0,0,0,0,funcBuckets+562,0,0,
-  0,0,0,funcBuckets+564,funcBuckets+565,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+566,
+  funcBuckets+546,0,0,0,0,0,0,0,
+  0,0,0,funcBuckets+548,0,0,funcBuckets+549,funcBuckets+550,
+  0,0,funcBuckets+551,funcBuckets+552,0,0,funcBuckets+553,funcBuckets+554,
+  funcBuckets+555,0,0,0,0,0,0,0,
+  0,0,0,0,funcBuckets+556,0,funcBuckets+557,0,
+  0,0,0,0,funcBuckets+558,0,0,0,
+  funcBuckets+559,0,0,funcBuckets+560,funcBuckets+561,0,0,funcBuckets+562,
+  funcBuckets+563,0,funcBuckets+564,funcBuckets+566,0,0,0,0,
+  0,0,0,0,0,funcBuckets+567,0,0,
+  0,0,0,funcBuckets+569,funcBuckets+570,0,0,0,
+  0,0,0,0,0,0,0,funcBuckets+571,
   0,0,0,0,0,0,0,0,
-  funcBuckets+567,0,0,0,0,0,0,0,
-  funcBuckets+568,0,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+569,0,0,0,
-  0,0,funcBuckets+570,0,0,0,0,0,
-  0,0,funcBuckets+571,0,funcBuckets+572,0,0,0,
-  0,0,0,0,funcBuckets+573,funcBuckets+574,0,funcBuckets+575,
-  0,0,0,0,0,0,funcBuckets+577,0,
-  0,0,funcBuckets+578,0,funcBuckets+579,0,funcBuckets+580,0,
-  funcBuckets+582,funcBuckets+584,0,0,funcBuckets+585,0,0,0,
-  0,0,0,0,funcBuckets+586,0,funcBuckets+587,funcBuckets+588,
+  funcBuckets+572,0,0,0,0,0,0,0,
+  funcBuckets+573,0,0,0,0,0,0,0,
+  0,0,0,0,funcBuckets+574,0,0,0,
+  0,0,funcBuckets+575,0,0,0,0,0,
+  0,0,funcBuckets+576,0,funcBuckets+577,0,0,0,
+  0,0,0,0,funcBuckets+578,funcBuckets+579,0,funcBuckets+580,
+  0,0,0,0,0,0,funcBuckets+582,0,
+  0,0,funcBuckets+583,0,funcBuckets+584,0,funcBuckets+585,0,
+  funcBuckets+587,funcBuckets+589,0,0,funcBuckets+590,0,0,0,
+  0,0,0,0,funcBuckets+591,0,funcBuckets+592,funcBuckets+593,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+589,
-  0,0,funcBuckets+590,funcBuckets+591,0,0,funcBuckets+592,0,
+  0,0,0,0,0,0,0,funcBuckets+594,
+  0,0,funcBuckets+595,funcBuckets+596,0,0,funcBuckets+597,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+593,0,funcBuckets+594,0,0,
-  0,funcBuckets+595,0,funcBuckets+596,funcBuckets+597,0,0,0,
   0,0,0,funcBuckets+598,0,funcBuckets+599,0,0,
-  0,funcBuckets+600,0,0,0,0,0,0,
-  0,0,funcBuckets+601,0,0,0,funcBuckets+602,0,
-  funcBuckets+603,0,0,0,funcBuckets+604,funcBuckets+605,0,0,
-  0,funcBuckets+606,0,0,0,0,funcBuckets+607,0,
-  0,0,0,funcBuckets+608,0,funcBuckets+609,0,funcBuckets+610,
-  0,0,0,0,0,funcBuckets+611,0,0,
-  0,0,0,0,0,0,0,funcBuckets+612,
-  0,0,funcBuckets+613,0,0,funcBuckets+615,0,0,
-  0,funcBuckets+616,0,0,0,0,0,funcBuckets+617,
-  0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+618,0,0,funcBuckets+619,0,funcBuckets+621,
-  0,0,0,0,0,0,funcBuckets+622,0,
-  0,0,0,0,0,0,funcBuckets+623,funcBuckets+624,
-  funcBuckets+625,funcBuckets+626,0,0,0,0,funcBuckets+627,0,
-  0,0,0,funcBuckets+628,0,0,0,0,
-  funcBuckets+629,funcBuckets+631,0,funcBuckets+632,0,0,0,0,
-  funcBuckets+633,0,funcBuckets+634,funcBuckets+635,0,funcBuckets+637,0,0,
-  0,funcBuckets+638,0,0,0,0,0,0,
-  0,funcBuckets+639,funcBuckets+640,0,0,0,0,0,
-  0,0,0,0,funcBuckets+641,0,funcBuckets+643,0,
-  0,0,funcBuckets+644,0,0,0,funcBuckets+645,funcBuckets+646,
-  0,0,0,0,0,funcBuckets+647,funcBuckets+648,funcBuckets+649,
-  0,0,0,funcBuckets+650,0,0,0,funcBuckets+653,
-  0,0,0,funcBuckets+654,0,0,funcBuckets+655,funcBuckets+656,
-  0,0,0,0,0,0,funcBuckets+657,0,
-  0,funcBuckets+658,0,0,0,0,0,0,
-  0,0,funcBuckets+660,funcBuckets+661,funcBuckets+662,funcBuckets+663,0,0,
-  0,0,0,0,0,funcBuckets+664,0,0,
-  0,0,0,0,funcBuckets+665,0,0,0,
-  0,0,0,0,funcBuckets+666,0,0,0,
-  0,funcBuckets+667,0,0,0,0,0,0,
-  funcBuckets+668,0,0,0,funcBuckets+669,0,0,funcBuckets+670,
-  funcBuckets+671,funcBuckets+672,funcBuckets+673,0,0,funcBuckets+674,0,0,
-  0,0,funcBuckets+676,0,funcBuckets+677,0,funcBuckets+679,0,
-  0,funcBuckets+680,0,0,0,0,0,0,
-  0,0,0,funcBuckets+681,funcBuckets+682,0,0,0,
-  funcBuckets+683,0,0,0,funcBuckets+685,0,0,0,
-  0,0,0,0,funcBuckets+686,0,0,0,
-  funcBuckets+688,0,0,0,0,0,0,funcBuckets+689,
-  funcBuckets+691,0,0,0,0,funcBuckets+692,funcBuckets+693,funcBuckets+694,
-  0,0,0,0,funcBuckets+695,funcBuckets+696,0,0,
-  0,funcBuckets+698,0,0,0,0,0,0,
+  0,funcBuckets+600,0,funcBuckets+601,funcBuckets+602,0,0,0,
+  0,0,0,funcBuckets+603,0,funcBuckets+604,0,0,
+  0,funcBuckets+605,0,0,0,0,0,0,
+  0,0,funcBuckets+606,0,0,0,funcBuckets+607,0,
+  funcBuckets+608,0,0,0,funcBuckets+609,funcBuckets+610,0,0,
+  0,funcBuckets+611,0,0,0,0,funcBuckets+612,0,
+  0,0,0,funcBuckets+613,0,funcBuckets+614,0,funcBuckets+615,
+  0,0,0,0,0,funcBuckets+616,0,0,
+  0,0,0,0,0,0,0,funcBuckets+617,
+  0,0,funcBuckets+618,0,0,funcBuckets+620,0,0,
+  0,funcBuckets+621,0,0,0,0,0,funcBuckets+622,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+699,0,0,0,0,0,0,
-  0,funcBuckets+701,funcBuckets+702,0,funcBuckets+703,funcBuckets+704,0,funcBuckets+705,
-  0,0,0,funcBuckets+706,0,0,0,0,
-  0,0,0,0,funcBuckets+707,0,0,0,
+  0,0,funcBuckets+623,0,0,funcBuckets+624,0,funcBuckets+626,
+  0,0,0,0,0,0,funcBuckets+627,0,
+  0,0,0,0,0,0,funcBuckets+628,funcBuckets+629,
+  funcBuckets+630,funcBuckets+631,0,0,0,0,funcBuckets+632,0,
+  0,0,0,funcBuckets+633,0,0,0,0,
+  funcBuckets+634,funcBuckets+636,0,funcBuckets+637,0,0,0,0,
+  funcBuckets+638,0,funcBuckets+639,funcBuckets+640,0,funcBuckets+642,0,0,
+  0,funcBuckets+643,0,0,0,0,0,0,
+  0,funcBuckets+644,funcBuckets+645,0,0,0,0,0,
+  0,0,0,0,funcBuckets+646,0,funcBuckets+648,0,
+  0,0,funcBuckets+649,0,0,0,funcBuckets+650,funcBuckets+651,
+  0,0,0,0,0,funcBuckets+652,funcBuckets+653,funcBuckets+654,
+  0,0,0,funcBuckets+655,0,0,0,funcBuckets+658,
+  0,0,0,funcBuckets+659,0,0,funcBuckets+660,funcBuckets+661,
+  0,0,0,0,0,0,funcBuckets+662,0,
+  0,funcBuckets+663,0,0,0,0,0,0,
+  0,0,funcBuckets+665,funcBuckets+666,funcBuckets+667,funcBuckets+668,0,0,
+  0,0,0,0,0,funcBuckets+669,0,0,
+  0,0,0,0,funcBuckets+670,0,0,0,
+  0,0,0,0,funcBuckets+672,0,0,0,
+  0,funcBuckets+673,0,0,0,0,0,0,
+  funcBuckets+674,0,0,0,funcBuckets+675,0,0,funcBuckets+676,
+  funcBuckets+677,funcBuckets+678,funcBuckets+679,0,0,funcBuckets+680,0,0,
+  0,funcBuckets+682,funcBuckets+683,0,funcBuckets+684,0,funcBuckets+686,0,
+  0,funcBuckets+687,0,0,0,0,0,0,
+  0,0,0,funcBuckets+688,funcBuckets+689,0,0,0,
+  funcBuckets+690,0,0,0,funcBuckets+692,0,0,0,
+  0,0,0,0,funcBuckets+693,0,0,0,
+  funcBuckets+695,0,0,0,0,0,0,funcBuckets+696,
+  funcBuckets+698,0,0,0,0,funcBuckets+699,funcBuckets+700,funcBuckets+701,
+  0,0,0,0,funcBuckets+702,funcBuckets+703,0,0,
+  0,funcBuckets+705,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  funcBuckets+710,0,0,funcBuckets+711,funcBuckets+713,0,funcBuckets+714,0,
-  0,funcBuckets+715,0,funcBuckets+716,funcBuckets+717,0,0,funcBuckets+718,
-  0,0,funcBuckets+719,0,funcBuckets+720,0,0,0,
+  0,funcBuckets+706,0,0,0,0,0,0,
+  0,funcBuckets+708,funcBuckets+709,0,funcBuckets+710,funcBuckets+711,0,funcBuckets+712,
+  0,0,0,funcBuckets+713,0,0,0,0,
+  0,0,0,0,funcBuckets+714,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+721,0,funcBuckets+722,
-  0,funcBuckets+723,funcBuckets+724,funcBuckets+725,funcBuckets+726,funcBuckets+727,0,0,
-  0,0,0,0,0,funcBuckets+728,funcBuckets+729,0,
-  funcBuckets+730,0,0,0,funcBuckets+731,0,0,0,
-  0,0,0,0,funcBuckets+732,0,funcBuckets+734,0,
-  0,0,0,funcBuckets+735,0,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+736,
-  funcBuckets+737,0,funcBuckets+738,funcBuckets+739,0,0,0,funcBuckets+740,
-  0,0,0,funcBuckets+741,0,0,0,0,
-  0,0,funcBuckets+742,0,0,funcBuckets+743,0,0,
-  0,0,0,0,funcBuckets+745,funcBuckets+746,0,0,
-  0,funcBuckets+748,funcBuckets+749,funcBuckets+750,0,0,0,0,
-  0,0,0,0,0,funcBuckets+751,0,0,
-  0,funcBuckets+752,0,0,0,0,0,0,
-  0,funcBuckets+753,0,funcBuckets+754,0,funcBuckets+755,0,0,
-  0,0,0,0,0,0,funcBuckets+756,0,
-  0,0,0,0,0,funcBuckets+757,funcBuckets+758,0,
-  0,0,0,0,funcBuckets+759,funcBuckets+760,0,0,
-  funcBuckets+761,0,0,funcBuckets+762,0,0,0,0,
-  funcBuckets+763,0,0,funcBuckets+764,0,0,0,0,
+  funcBuckets+717,0,0,funcBuckets+718,funcBuckets+720,0,funcBuckets+721,0,
+  0,funcBuckets+722,0,funcBuckets+723,funcBuckets+724,0,0,funcBuckets+725,
+  0,0,funcBuckets+726,0,funcBuckets+727,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+766,funcBuckets+767,0,0,0,funcBuckets+768,
-  funcBuckets+769,0,0,0,0,0,0,0,
-  0,funcBuckets+770,0,0,0,0,0,funcBuckets+771,
-  0,0,funcBuckets+772,0,0,funcBuckets+773,0,0,
+  0,0,0,0,0,funcBuckets+728,0,funcBuckets+729,
+  0,funcBuckets+730,funcBuckets+731,funcBuckets+732,funcBuckets+733,funcBuckets+734,0,0,
+  0,0,0,0,0,funcBuckets+735,funcBuckets+736,0,
+  funcBuckets+737,0,0,0,funcBuckets+738,0,0,0,
+  0,0,0,0,funcBuckets+739,0,funcBuckets+741,0,
+  0,0,0,funcBuckets+742,0,0,0,0,
+  0,0,0,0,0,0,0,funcBuckets+743,
+  funcBuckets+744,0,funcBuckets+745,funcBuckets+746,0,0,0,funcBuckets+747,
+  0,0,0,funcBuckets+748,0,0,0,0,
+  0,0,funcBuckets+749,0,0,funcBuckets+750,0,0,
+  0,0,0,0,funcBuckets+752,funcBuckets+753,0,0,
+  0,funcBuckets+755,funcBuckets+756,funcBuckets+757,0,0,0,0,
+  0,0,0,0,0,funcBuckets+758,0,0,
+  0,funcBuckets+759,0,0,0,0,0,0,
+  0,funcBuckets+760,0,funcBuckets+761,0,funcBuckets+762,0,0,
+  0,0,0,0,0,0,funcBuckets+763,0,
+  0,0,0,0,0,funcBuckets+764,funcBuckets+765,0,
+  0,0,0,0,funcBuckets+766,funcBuckets+767,0,0,
+  funcBuckets+768,0,0,funcBuckets+769,0,0,0,0,
+  funcBuckets+770,0,0,funcBuckets+771,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+774,
+  0,0,funcBuckets+773,funcBuckets+774,0,0,0,funcBuckets+775,
+  funcBuckets+776,0,0,0,0,0,0,0,
+  0,funcBuckets+777,0,0,0,0,0,funcBuckets+778,
+  0,0,funcBuckets+779,0,0,funcBuckets+780,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+775,funcBuckets+776,0,0,0,0,
-  0,0,0,funcBuckets+777,0,0,0,funcBuckets+778,
-  0,funcBuckets+779,0,0,0,funcBuckets+780,0,0,
-  0,0,0,0,funcBuckets+781,0,funcBuckets+782,0,
+  0,0,0,0,0,0,0,funcBuckets+781,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+785,funcBuckets+787,0,0,funcBuckets+788,funcBuckets+789,0,
-  funcBuckets+790,0,0,0,funcBuckets+791,0,0,0,
-  funcBuckets+792,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+793,0,funcBuckets+794,
-  funcBuckets+795,0,0,0,0,0,funcBuckets+796,0,
-  0,0,0,0,funcBuckets+798,0,funcBuckets+799,0,
+  0,0,funcBuckets+782,funcBuckets+783,0,0,0,0,
+  0,0,0,funcBuckets+784,0,0,0,funcBuckets+785,
+  0,funcBuckets+786,0,0,0,funcBuckets+787,0,0,
+  0,0,0,0,funcBuckets+788,0,funcBuckets+789,0,
   0,0,0,0,0,0,0,0,
+  0,funcBuckets+792,funcBuckets+794,0,0,funcBuckets+795,funcBuckets+796,0,
+  funcBuckets+797,0,0,0,funcBuckets+798,0,0,0,
+  funcBuckets+799,0,0,0,0,0,0,0,
   0,0,0,0,0,funcBuckets+800,0,funcBuckets+801,
-  0,0,0,funcBuckets+802,0,0,0,0,
-  0,0,funcBuckets+804,0,0,0,0,0,
-  0,0,0,funcBuckets+805,0,0,funcBuckets+807,0,
-  funcBuckets+808,0,0,0,0,0,0,funcBuckets+809,
-  funcBuckets+810,0,0,funcBuckets+811,funcBuckets+812,0,0,0,
-  0,0,0,0,0,funcBuckets+813,0,0,
+  funcBuckets+802,0,0,0,0,0,funcBuckets+803,0,
+  0,0,0,0,funcBuckets+805,0,funcBuckets+806,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+814,0,funcBuckets+815,
-  0,funcBuckets+816,funcBuckets+818,0,0,0,funcBuckets+819,0,
-  0,funcBuckets+820,funcBuckets+821,0,0,0,0,funcBuckets+822,
+  0,0,0,0,0,funcBuckets+807,0,funcBuckets+808,
+  0,0,0,funcBuckets+809,0,0,0,0,
+  0,0,funcBuckets+811,0,0,0,0,0,
+  0,0,0,funcBuckets+812,0,0,funcBuckets+814,0,
+  funcBuckets+815,0,0,0,0,0,0,funcBuckets+816,
+  funcBuckets+817,0,0,funcBuckets+818,funcBuckets+819,0,0,0,
+  0,0,0,0,0,funcBuckets+820,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+823,funcBuckets+824,0,0,0,
-  0,0,funcBuckets+825,funcBuckets+826,0,0,0,0,
-  0,funcBuckets+827,0,0,0,funcBuckets+828,funcBuckets+829,0,
-  funcBuckets+830,0,funcBuckets+831,funcBuckets+833,0,0,funcBuckets+835,0,
-  0,0,0,0,funcBuckets+836,0,0,0,
-  0,funcBuckets+837,0,0,0,0,funcBuckets+838,funcBuckets+839,
-  funcBuckets+840,0,0,0,0,0,funcBuckets+842,0,
-  0,funcBuckets+843,0,0,0,0,funcBuckets+844,0,
-  0,funcBuckets+845,0,funcBuckets+846,0,0,0,0,
-  0,0,0,0,0,funcBuckets+847,funcBuckets+848,0,
-  0,funcBuckets+849,funcBuckets+850,0,funcBuckets+851,0,funcBuckets+853,0,
-  0,0,0,funcBuckets+854,funcBuckets+857,0,0,0,
-  0,0,funcBuckets+860,funcBuckets+861,0,0,0,0,
-  funcBuckets+862,0,0,0,0,funcBuckets+863,0,0,
-  0,0,funcBuckets+864,funcBuckets+865,0,0,funcBuckets+866,0,
-  0,funcBuckets+867,funcBuckets+868,0,0,0,0,0,
-  funcBuckets+869,0,funcBuckets+870,0,0,0,0,0,
-  0,0,funcBuckets+872,0,0,0,funcBuckets+874,0,
-  0,funcBuckets+875,0,0,0,funcBuckets+876,0,funcBuckets+877,
-  0,funcBuckets+878,0,0,0,0,0,funcBuckets+879,
-  0,0,funcBuckets+880,0,funcBuckets+882,0,0,funcBuckets+883,
-  0,0,funcBuckets+884,0,0,0,0,0,
-  funcBuckets+885,funcBuckets+886,0,0,0,funcBuckets+887,0,funcBuckets+888,
-  0,0,funcBuckets+889,funcBuckets+890,0,0,0,funcBuckets+891,
-  0,0,0,0,0,0,funcBuckets+892,0,
-  0,funcBuckets+893,0,0,0,0,0,0,
-  0,funcBuckets+894,0,0,0,0,funcBuckets+895,0,
-  0,0,0,funcBuckets+896,0,0,0,0,
-  funcBuckets+898,0,0,0,0,0,0,0,
-  0,funcBuckets+899,0,0,0,0,0,0,
-  funcBuckets+900,0,0,0,0,0,0,0,
-  0,0,funcBuckets+902,funcBuckets+903,funcBuckets+904,0,0,0,
-  funcBuckets+905,funcBuckets+906,0,0,0,0,funcBuckets+907,0,
-  0,0,0,0,0,funcBuckets+908,0,0,
-  0,funcBuckets+911,0,0,0,0,funcBuckets+912,funcBuckets+913,
-  0,0,0,0,0,0,funcBuckets+914,funcBuckets+915,
-  0,funcBuckets+916,funcBuckets+917,0,0,0,0,funcBuckets+918,
-  funcBuckets+919,0,0,0,0,0,funcBuckets+921,funcBuckets+922,
-  funcBuckets+923,funcBuckets+924,0,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+926,0,
-  funcBuckets+927,0,0,0,0,0,0,0,
-  funcBuckets+928,0,0,funcBuckets+931,0,0,0,0,
-  0,0,funcBuckets+932,funcBuckets+933,0,0,0,0,
-  funcBuckets+934,0,0,0,funcBuckets+935,funcBuckets+936,0,0,
-  0,0,0,funcBuckets+937,0,0,funcBuckets+938,0,
-  0,0,funcBuckets+939,0,0,0,funcBuckets+940,0,
-  funcBuckets+942,0,0,0,0,0,funcBuckets+943,funcBuckets+944,
-  0,0,0,0,funcBuckets+945,funcBuckets+947,0,0,
+  0,0,0,0,0,funcBuckets+821,0,funcBuckets+822,
+  0,funcBuckets+823,funcBuckets+825,0,0,0,funcBuckets+826,0,
+  0,funcBuckets+827,funcBuckets+828,0,0,0,0,funcBuckets+829,
   0,0,0,0,0,0,0,0,
-  funcBuckets+948,0,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+949,0,0,0,
+  0,0,0,funcBuckets+830,funcBuckets+831,0,0,0,
+  0,0,funcBuckets+832,funcBuckets+833,0,0,0,0,
+  0,funcBuckets+834,0,0,0,funcBuckets+835,funcBuckets+836,0,
+  funcBuckets+837,0,funcBuckets+838,funcBuckets+840,0,0,funcBuckets+842,0,
+  0,0,0,0,funcBuckets+843,0,0,0,
+  0,funcBuckets+844,0,0,0,0,funcBuckets+845,funcBuckets+846,
+  funcBuckets+847,0,0,0,0,0,funcBuckets+849,0,
+  0,funcBuckets+850,0,0,0,0,funcBuckets+851,0,
+  0,funcBuckets+852,0,funcBuckets+853,0,0,0,0,
+  0,0,0,0,0,funcBuckets+854,funcBuckets+855,0,
+  0,funcBuckets+856,funcBuckets+857,0,funcBuckets+858,0,funcBuckets+860,0,
+  0,0,0,funcBuckets+861,funcBuckets+864,0,0,0,
+  0,0,funcBuckets+867,funcBuckets+868,0,0,0,0,
+  funcBuckets+869,0,0,0,0,funcBuckets+870,0,0,
+  0,0,funcBuckets+871,funcBuckets+872,0,0,funcBuckets+873,0,
+  0,funcBuckets+874,funcBuckets+875,0,0,0,0,0,
+  funcBuckets+876,0,funcBuckets+877,0,0,0,0,0,
+  0,0,funcBuckets+879,0,0,0,funcBuckets+881,0,
+  0,funcBuckets+882,0,0,0,funcBuckets+883,0,funcBuckets+884,
+  0,funcBuckets+885,0,0,0,0,0,funcBuckets+886,
+  0,0,funcBuckets+887,0,funcBuckets+889,0,0,funcBuckets+890,
+  0,0,funcBuckets+891,0,0,0,0,0,
+  funcBuckets+892,funcBuckets+893,0,0,0,funcBuckets+894,0,funcBuckets+895,
+  0,0,funcBuckets+896,funcBuckets+897,0,0,0,funcBuckets+898,
+  0,0,0,0,0,0,funcBuckets+899,0,
+  0,funcBuckets+900,0,0,0,0,0,0,
+  0,funcBuckets+901,0,0,0,0,funcBuckets+902,0,
+  0,0,0,funcBuckets+903,0,0,0,0,
+  funcBuckets+905,0,0,0,0,0,0,0,
+  0,funcBuckets+906,0,0,0,0,0,0,
+  funcBuckets+907,0,0,0,0,0,0,0,
+  0,0,funcBuckets+909,funcBuckets+910,funcBuckets+911,0,0,0,
+  funcBuckets+912,funcBuckets+913,0,0,0,0,funcBuckets+914,0,
+  0,0,0,0,0,funcBuckets+915,0,0,
+  0,funcBuckets+918,0,0,0,0,funcBuckets+919,funcBuckets+920,
+  0,0,0,0,0,0,funcBuckets+921,funcBuckets+922,
+  0,funcBuckets+923,funcBuckets+924,0,0,0,0,funcBuckets+925,
+  funcBuckets+926,0,0,0,0,0,funcBuckets+928,funcBuckets+929,
+  funcBuckets+930,funcBuckets+931,0,0,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+933,0,
+  funcBuckets+934,0,0,0,0,0,0,0,
+  funcBuckets+935,0,0,funcBuckets+938,0,0,0,0,
+  0,0,funcBuckets+939,funcBuckets+940,0,0,0,0,
+  funcBuckets+941,0,0,0,funcBuckets+942,funcBuckets+943,0,0,
+  0,0,0,funcBuckets+944,0,0,funcBuckets+945,0,
+  0,0,funcBuckets+946,0,0,0,funcBuckets+947,0,
+  funcBuckets+949,0,0,0,0,0,funcBuckets+950,funcBuckets+951,
+  0,0,0,0,funcBuckets+952,funcBuckets+954,0,0,
   0,0,0,0,0,0,0,0,
+  funcBuckets+955,0,0,0,0,0,0,0,
+  0,0,0,0,funcBuckets+956,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+950,funcBuckets+951,funcBuckets+952,0,
-  0,0,funcBuckets+953,0,funcBuckets+954,0,0,funcBuckets+955,
   0,0,0,0,0,0,0,0,
-  funcBuckets+956,funcBuckets+958,0,0,0,0,0,0,
-  0,funcBuckets+959,0,0,funcBuckets+960,0,funcBuckets+961,0,
-  0,0,funcBuckets+962,funcBuckets+963,0,0,0,0,
-  0,0,funcBuckets+964,0,0,0,0,0,
-  funcBuckets+965,0,funcBuckets+966,0,0,0,funcBuckets+967,0,
-  0,0,0,0,funcBuckets+968,0,0,funcBuckets+969,
-  funcBuckets+970,0,0,0,funcBuckets+971,0,0,funcBuckets+973,
-  0,0,0,0,funcBuckets+974,funcBuckets+975,0,0,
-  0,funcBuckets+976,funcBuckets+977,funcBuckets+978,funcBuckets+979,funcBuckets+980,0,0,
-  funcBuckets+981,funcBuckets+982,funcBuckets+983,0,0,funcBuckets+984,0,funcBuckets+985,
-  0,0,0,0,0,funcBuckets+986,0,funcBuckets+987,
-  0,0,0,0,funcBuckets+988,0,0,0,
-  0,funcBuckets+989,0,funcBuckets+990,funcBuckets+991,funcBuckets+992,0,0,
-  funcBuckets+993,0,funcBuckets+994,0,0,0,0,0,
-  funcBuckets+995,0,0,funcBuckets+996,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+997,funcBuckets+998,
-  0,0,0,0,0,funcBuckets+1000,funcBuckets+1001,0,
-  0,funcBuckets+1002,0,0,0,0,funcBuckets+1003,funcBuckets+1004,
-  0,funcBuckets+1005,0,funcBuckets+1006,0,0,0,0,
+  0,0,0,0,funcBuckets+957,funcBuckets+958,funcBuckets+959,0,
+  0,0,funcBuckets+960,0,funcBuckets+961,0,0,funcBuckets+962,
   0,0,0,0,0,0,0,0,
-  funcBuckets+1008,0,0,0,funcBuckets+1009,0,0,0,
-  0,funcBuckets+1010,funcBuckets+1011,0,0,0,0,0,
-  0,0,funcBuckets+1013,0,0,0,0,0,
-  0,0,0,funcBuckets+1014,funcBuckets+1015,0,0,0,
-  funcBuckets+1016,0,0,funcBuckets+1017,funcBuckets+1019,funcBuckets+1020,0,0,
-  funcBuckets+1021,0,0,funcBuckets+1022,0,0,0,0,
+  funcBuckets+963,funcBuckets+965,0,0,0,0,0,0,
+  0,funcBuckets+966,0,0,funcBuckets+967,0,funcBuckets+968,0,
+  0,0,funcBuckets+969,funcBuckets+970,0,0,0,0,
+  0,0,funcBuckets+971,0,0,0,0,0,
+  funcBuckets+972,0,funcBuckets+973,0,0,0,funcBuckets+974,0,
+  0,0,0,0,funcBuckets+975,0,0,funcBuckets+976,
+  funcBuckets+977,0,0,0,funcBuckets+978,0,0,funcBuckets+980,
+  0,0,0,0,funcBuckets+981,funcBuckets+982,0,0,
+  0,funcBuckets+983,funcBuckets+984,funcBuckets+985,funcBuckets+986,funcBuckets+987,0,0,
+  funcBuckets+988,funcBuckets+989,funcBuckets+990,0,0,funcBuckets+991,0,funcBuckets+992,
+  0,0,0,0,0,funcBuckets+993,0,funcBuckets+994,
+  0,0,0,0,funcBuckets+995,0,0,0,
+  0,funcBuckets+996,0,funcBuckets+997,funcBuckets+998,funcBuckets+999,0,0,
+  funcBuckets+1000,0,funcBuckets+1001,0,0,0,0,0,
+  funcBuckets+1002,0,0,funcBuckets+1003,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+1004,funcBuckets+1005,
+  0,0,0,0,0,funcBuckets+1007,funcBuckets+1008,0,
+  0,funcBuckets+1009,0,0,0,0,funcBuckets+1010,funcBuckets+1011,
+  0,funcBuckets+1012,0,funcBuckets+1013,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  funcBuckets+1023,0,0,0,0,funcBuckets+1024,0,0,
-  0,funcBuckets+1026,0,0,0,funcBuckets+1027,funcBuckets+1028,0,
-  0,0,funcBuckets+1030,funcBuckets+1031,0,0,0,0,
-  funcBuckets+1032,0,funcBuckets+1033,0,funcBuckets+1034,funcBuckets+1035,funcBuckets+1036,0,
+  funcBuckets+1015,0,0,0,funcBuckets+1016,0,0,0,
+  0,funcBuckets+1017,funcBuckets+1018,0,0,0,0,0,
+  0,0,funcBuckets+1020,0,0,0,0,0,
+  0,0,0,funcBuckets+1021,funcBuckets+1022,0,0,0,
+  funcBuckets+1023,0,0,funcBuckets+1024,funcBuckets+1026,funcBuckets+1027,0,0,
+  funcBuckets+1028,0,0,funcBuckets+1029,0,0,0,0,
+  0,0,funcBuckets+1030,0,0,0,0,0,
+  funcBuckets+1031,0,0,0,0,funcBuckets+1032,0,0,
+  0,funcBuckets+1034,0,0,0,funcBuckets+1035,funcBuckets+1036,0,
+  0,0,funcBuckets+1038,funcBuckets+1039,0,0,0,0,
+  funcBuckets+1040,0,funcBuckets+1041,0,funcBuckets+1042,funcBuckets+1043,funcBuckets+1044,0,
   0,0,0,0,0,0,0,0,
-  funcBuckets+1039,funcBuckets+1040,0,0,funcBuckets+1042,0,0,funcBuckets+1044,
+  funcBuckets+1047,funcBuckets+1048,0,0,funcBuckets+1050,0,0,funcBuckets+1052,
   0,0,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+1045,0,funcBuckets+1047,funcBuckets+1048,0,0,funcBuckets+1049,
-  0,0,funcBuckets+1050,0,0,funcBuckets+1051,funcBuckets+1054,0,
+  0,funcBuckets+1053,0,funcBuckets+1055,funcBuckets+1056,0,0,funcBuckets+1057,
+  0,0,funcBuckets+1058,0,0,funcBuckets+1059,funcBuckets+1062,0,
   0,0,0,0,0,0,0,0,
-  funcBuckets+1055,0,0,funcBuckets+1056,0,0,funcBuckets+1057,0,
-  0,funcBuckets+1058,0,funcBuckets+1059,0,0,0,funcBuckets+1060,
-  funcBuckets+1061,0,0,funcBuckets+1062,0,0,funcBuckets+1063,funcBuckets+1064,
-  0,0,funcBuckets+1065,0,0,0,funcBuckets+1066,funcBuckets+1067,
-  funcBuckets+1068,0,0,0,funcBuckets+1070,0,0,0,
-  0,funcBuckets+1071,funcBuckets+1072,0,0,0,0,funcBuckets+1073,
-  0,0,0,0,0,funcBuckets+1074,0,0,
-  0,funcBuckets+1075,0,funcBuckets+1076,0,0,0,0,
-  0,0,funcBuckets+1077,0,funcBuckets+1078,0,0,funcBuckets+1079,
-  funcBuckets+1080,0,0,funcBuckets+1081,0,0,0,0,
+  funcBuckets+1063,0,0,funcBuckets+1064,0,0,funcBuckets+1065,0,
+  0,funcBuckets+1066,0,funcBuckets+1067,0,0,0,funcBuckets+1068,
+  funcBuckets+1069,0,0,funcBuckets+1070,0,0,funcBuckets+1071,funcBuckets+1072,
+  0,0,funcBuckets+1073,0,0,0,funcBuckets+1074,funcBuckets+1075,
+  funcBuckets+1076,0,0,0,funcBuckets+1078,0,0,0,
+  0,funcBuckets+1079,funcBuckets+1080,0,0,0,0,funcBuckets+1081,
+  0,0,0,0,0,funcBuckets+1082,0,0,
+  0,funcBuckets+1083,0,funcBuckets+1084,0,0,0,0,
+  0,0,funcBuckets+1085,0,funcBuckets+1086,0,0,funcBuckets+1087,
+  funcBuckets+1088,0,0,funcBuckets+1089,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+1082,
-  funcBuckets+1083,0,0,0,funcBuckets+1084,funcBuckets+1085,funcBuckets+1086,0,
-  0,0,funcBuckets+1088,0,funcBuckets+1089,0,0,funcBuckets+1090,
-  0,0,funcBuckets+1091,0,0,funcBuckets+1092,0,0,
-  0,0,0,funcBuckets+1093,0,funcBuckets+1094,0,funcBuckets+1095,
-  funcBuckets+1096,0,0,0,funcBuckets+1098,funcBuckets+1099,0,0,
+  0,0,0,0,0,0,0,funcBuckets+1090,
+  funcBuckets+1091,0,0,0,funcBuckets+1092,funcBuckets+1093,funcBuckets+1094,0,
+  0,0,funcBuckets+1096,0,funcBuckets+1097,0,0,funcBuckets+1098,
+  0,0,funcBuckets+1099,0,0,funcBuckets+1100,0,0,
+  0,0,0,funcBuckets+1101,0,funcBuckets+1102,0,funcBuckets+1103,
+  funcBuckets+1104,0,0,0,funcBuckets+1106,funcBuckets+1107,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+1100,0,funcBuckets+1101,
+  0,0,0,0,0,funcBuckets+1108,0,funcBuckets+1109,
   0,0,0,0,0,0,0,0,
-  funcBuckets+1102,0,0,0,0,funcBuckets+1103,0,funcBuckets+1104,
-  0,0,0,0,funcBuckets+1105,0,funcBuckets+1106,0,
-  0,funcBuckets+1107,0,0,0,funcBuckets+1108,0,0,
-  0,0,funcBuckets+1110,0,0,funcBuckets+1111,0,0,
-  0,0,0,0,0,0,funcBuckets+1112,0,
-  0,0,funcBuckets+1113,0,0,0,0,0,
-  0,0,funcBuckets+1114,funcBuckets+1115,0,0,0,0,
-  0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1116,0,funcBuckets+1117,0,0,
-  0,0,0,funcBuckets+1118,0,0,funcBuckets+1119,0,
+  funcBuckets+1110,0,0,0,0,funcBuckets+1111,0,funcBuckets+1112,
+  0,0,0,0,funcBuckets+1113,0,funcBuckets+1114,0,
+  0,funcBuckets+1115,0,0,0,funcBuckets+1116,0,0,
+  0,0,funcBuckets+1118,0,0,funcBuckets+1119,0,0,
+  0,0,0,0,0,0,funcBuckets+1120,0,
+  0,0,funcBuckets+1121,0,0,0,0,0,
   0,0,funcBuckets+1122,funcBuckets+1123,0,0,0,0,
-  0,funcBuckets+1124,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1125,0,0,0,funcBuckets+1127,
-  0,0,funcBuckets+1128,funcBuckets+1129,0,0,0,funcBuckets+1130,
-  0,0,0,0,0,0,0,funcBuckets+1131,
-  0,0,0,0,0,0,0,funcBuckets+1132,
-  funcBuckets+1134,0,0,0,0,0,0,0,
-  funcBuckets+1135,funcBuckets+1136,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+1137,0,0,funcBuckets+1138,
-  0,0,0,0,0,0,funcBuckets+1139,0,
-  0,funcBuckets+1140,0,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+1141,funcBuckets+1143,
-  0,funcBuckets+1144,0,0,0,0,0,funcBuckets+1145,
-  0,0,0,funcBuckets+1146,funcBuckets+1147,0,funcBuckets+1148,funcBuckets+1150,
-  funcBuckets+1151,0,funcBuckets+1152,0,0,0,0,0,
-  funcBuckets+1153,0,0,0,funcBuckets+1154,0,0,0,
-  funcBuckets+1155,0,0,0,0,funcBuckets+1156,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+1157,0,0,
-  funcBuckets+1159,funcBuckets+1160,funcBuckets+1161,funcBuckets+1162,0,0,0,0,
-  funcBuckets+1163,0,0,0,funcBuckets+1164,0,0,funcBuckets+1165,
-  funcBuckets+1167,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1168,funcBuckets+1169,0,0,0,0,
+  0,0,0,funcBuckets+1124,0,funcBuckets+1125,0,0,
+  0,0,0,funcBuckets+1126,0,0,funcBuckets+1127,0,
+  0,0,funcBuckets+1130,funcBuckets+1131,0,0,0,0,
+  0,funcBuckets+1132,0,0,0,0,0,0,
+  0,0,0,funcBuckets+1133,0,0,0,funcBuckets+1135,
+  0,0,funcBuckets+1136,funcBuckets+1137,0,0,0,funcBuckets+1138,
+  0,0,0,0,0,0,0,funcBuckets+1139,
+  0,0,0,0,0,0,0,funcBuckets+1140,
+  funcBuckets+1142,0,0,0,0,0,0,0,
+  funcBuckets+1143,funcBuckets+1144,0,0,0,0,0,0,
+  0,0,0,0,funcBuckets+1145,0,0,funcBuckets+1146,
+  0,0,0,0,0,0,funcBuckets+1147,0,
+  0,funcBuckets+1148,0,0,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+1149,funcBuckets+1151,
+  0,funcBuckets+1152,0,0,0,0,0,funcBuckets+1153,
+  0,0,0,funcBuckets+1154,funcBuckets+1155,0,funcBuckets+1156,funcBuckets+1158,
+  funcBuckets+1159,0,funcBuckets+1160,0,0,0,0,0,
+  funcBuckets+1161,0,0,0,funcBuckets+1162,0,0,0,
+  funcBuckets+1163,0,0,0,0,funcBuckets+1164,0,0,
+  0,0,0,0,0,0,0,0,
+  0,0,0,0,0,funcBuckets+1165,0,0,
+  funcBuckets+1167,funcBuckets+1168,funcBuckets+1169,funcBuckets+1170,0,0,0,0,
+  funcBuckets+1171,0,0,0,funcBuckets+1172,0,0,funcBuckets+1173,
+  funcBuckets+1175,0,0,0,0,0,0,0,
+  0,0,funcBuckets+1176,funcBuckets+1177,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1170,0,funcBuckets+1171,0,0,
-  funcBuckets+1172,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1173,0,funcBuckets+1175,0,0,0,
-  0,funcBuckets+1176,0,0,funcBuckets+1178,funcBuckets+1179,0,funcBuckets+1180,
-  0,0,0,0,0,funcBuckets+1181,0,0,
+  0,0,0,funcBuckets+1178,0,funcBuckets+1179,0,0,
+  funcBuckets+1180,0,0,0,0,0,0,0,
+  0,0,funcBuckets+1181,0,funcBuckets+1183,0,0,0,
+  0,funcBuckets+1184,0,0,funcBuckets+1186,funcBuckets+1187,0,funcBuckets+1188,
+  0,0,0,0,0,funcBuckets+1189,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1182,0,0,0,funcBuckets+1183,
-  funcBuckets+1184,0,funcBuckets+1185,funcBuckets+1186,0,0,0,funcBuckets+1187,
-  0,0,0,0,0,0,0,funcBuckets+1188,
-  0,0,0,0,0,0,0,funcBuckets+1189,
-  0,0,funcBuckets+1191,0,0,0,0,0,
+  0,0,0,funcBuckets+1190,0,0,0,funcBuckets+1191,
+  funcBuckets+1192,0,funcBuckets+1193,funcBuckets+1194,0,0,0,funcBuckets+1195,
+  0,0,0,0,0,0,0,funcBuckets+1196,
+  0,0,0,0,0,0,0,funcBuckets+1197,
+  0,0,funcBuckets+1199,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1192,0,0,0,0,
-  funcBuckets+1193,0,0,0,0,0,funcBuckets+1194,0,
-  0,0,funcBuckets+1195,0,funcBuckets+1196,0,0,funcBuckets+1197,
-  0,funcBuckets+1198,0,0,funcBuckets+1199,0,0,funcBuckets+1200,
-  0,funcBuckets+1201,funcBuckets+1202,0,0,funcBuckets+1203,funcBuckets+1204,0,
-  0,funcBuckets+1205,0,0,0,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+1206,
-  0,0,0,funcBuckets+1207,0,0,0,0,
-  funcBuckets+1208,0,funcBuckets+1209,funcBuckets+1210,0,0,funcBuckets+1211,0,
-  0,funcBuckets+1212,funcBuckets+1213,0,0,funcBuckets+1214,0,funcBuckets+1216,
+  0,0,0,funcBuckets+1200,0,0,0,0,
+  funcBuckets+1201,0,0,0,0,0,funcBuckets+1202,0,
+  0,0,funcBuckets+1203,0,funcBuckets+1204,0,0,funcBuckets+1205,
+  0,funcBuckets+1206,0,0,funcBuckets+1207,0,0,funcBuckets+1208,
+  0,funcBuckets+1209,funcBuckets+1210,0,0,funcBuckets+1211,funcBuckets+1212,0,
+  0,funcBuckets+1213,0,0,0,0,0,0,
+  0,0,0,0,0,0,0,funcBuckets+1214,
+  0,0,0,funcBuckets+1215,0,0,0,0,
+  funcBuckets+1216,0,funcBuckets+1217,funcBuckets+1218,0,0,funcBuckets+1219,0,
+  0,funcBuckets+1220,funcBuckets+1221,0,0,funcBuckets+1222,0,funcBuckets+1224,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+1217,0,funcBuckets+1218,
-  0,0,funcBuckets+1219,0,funcBuckets+1220,0,funcBuckets+1221,0,
-  funcBuckets+1222,0,0,0,funcBuckets+1223,funcBuckets+1224,funcBuckets+1225,funcBuckets+1226,
-  funcBuckets+1227,0,0,0,funcBuckets+1228,0,0,0,
-  0,funcBuckets+1229,funcBuckets+1230,funcBuckets+1231,funcBuckets+1232,funcBuckets+1234,funcBuckets+1235,funcBuckets+1236,
-  funcBuckets+1237,funcBuckets+1238,0,0,funcBuckets+1240,0,0,0,
-  funcBuckets+1241,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1242,funcBuckets+1243,0,funcBuckets+1244,0,0,
-  0,0,funcBuckets+1246,0,0,funcBuckets+1247,0,0,
+  0,0,0,0,0,funcBuckets+1225,0,funcBuckets+1226,
+  0,0,funcBuckets+1227,0,funcBuckets+1228,0,funcBuckets+1229,0,
+  funcBuckets+1230,0,0,0,funcBuckets+1231,funcBuckets+1232,funcBuckets+1233,funcBuckets+1234,
+  funcBuckets+1235,0,0,0,funcBuckets+1236,0,0,0,
+  0,funcBuckets+1237,funcBuckets+1238,funcBuckets+1239,funcBuckets+1240,funcBuckets+1242,funcBuckets+1243,funcBuckets+1244,
+  funcBuckets+1245,funcBuckets+1246,0,0,funcBuckets+1248,0,0,0,
+  funcBuckets+1249,0,0,0,0,0,0,0,
+  0,0,funcBuckets+1250,funcBuckets+1251,0,funcBuckets+1252,0,0,
+  0,0,funcBuckets+1254,0,0,funcBuckets+1255,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+1248,0,funcBuckets+1250,funcBuckets+1251,
-  funcBuckets+1253,0,0,0,funcBuckets+1255,0,0,0,
-  funcBuckets+1256,0,funcBuckets+1258,0,funcBuckets+1259,0,0,0,
-  0,0,0,0,0,0,funcBuckets+1260,funcBuckets+1261,
-  funcBuckets+1262,0,0,0,0,0,funcBuckets+1264,0,
-  0,funcBuckets+1265,0,0,funcBuckets+1266,0,funcBuckets+1267,0,
-  0,0,funcBuckets+1268,0,0,0,0,0,
-  0,0,0,funcBuckets+1269,0,0,0,0,
-  funcBuckets+1270,0,0,0,0,0,0,0,
-  funcBuckets+1271,0,0,0,0,0,funcBuckets+1272,0,
-  0,0,0,funcBuckets+1273,0,0,0,0,
-  0,0,0,0,funcBuckets+1274,0,0,funcBuckets+1275,
-  0,0,0,0,funcBuckets+1276,0,funcBuckets+1277,0,
-  0,0,0,funcBuckets+1278,0,0,0,0,
-  0,0,funcBuckets+1280,0,funcBuckets+1281,0,0,funcBuckets+1282,
-  funcBuckets+1283,funcBuckets+1284,0,0,0,0,0,0,
+  0,0,0,0,funcBuckets+1256,0,funcBuckets+1258,funcBuckets+1259,
+  funcBuckets+1261,0,0,0,funcBuckets+1263,0,0,0,
+  funcBuckets+1264,0,funcBuckets+1266,0,funcBuckets+1267,0,0,0,
+  0,0,0,0,0,0,funcBuckets+1268,funcBuckets+1269,
+  funcBuckets+1270,0,0,0,0,0,funcBuckets+1272,0,
+  0,funcBuckets+1273,0,0,funcBuckets+1274,0,funcBuckets+1275,0,
+  0,0,funcBuckets+1276,0,0,0,0,0,
+  0,0,0,funcBuckets+1277,0,0,0,0,
+  funcBuckets+1278,0,0,0,0,0,0,0,
+  funcBuckets+1279,0,0,0,0,0,funcBuckets+1280,0,
+  0,0,0,funcBuckets+1281,0,0,0,0,
+  0,0,0,0,funcBuckets+1282,0,0,funcBuckets+1283,
+  0,0,0,0,funcBuckets+1284,0,funcBuckets+1285,0,
+  0,0,0,funcBuckets+1286,0,0,0,0,
+  0,0,funcBuckets+1288,0,funcBuckets+1289,0,0,funcBuckets+1290,
+  funcBuckets+1291,funcBuckets+1292,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1285,funcBuckets+1286,0,0,0,0,
-  0,0,0,funcBuckets+1287,0,0,funcBuckets+1289,0,
-  funcBuckets+1290,0,0,0,0,0,funcBuckets+1291,0,
-  0,0,0,0,0,0,funcBuckets+1292,0,
-  0,0,funcBuckets+1293,0,funcBuckets+1294,funcBuckets+1295,funcBuckets+1296,0,
-  funcBuckets+1297,0,0,funcBuckets+1298,funcBuckets+1299,0,0,0,
-  0,0,0,0,funcBuckets+1300,0,0,funcBuckets+1301,
-  0,0,0,0,0,funcBuckets+1302,funcBuckets+1303,0,
-  funcBuckets+1304,0,funcBuckets+1305,0,0,0,0,0,
-  0,0,funcBuckets+1306,0,0,0,0,0,
-  0,funcBuckets+1307,0,0,0,funcBuckets+1308,0,0,
-  0,0,funcBuckets+1309,0,funcBuckets+1310,0,0,0,
-  0,funcBuckets+1311,0,funcBuckets+1312,0,0,funcBuckets+1313,0,
-  0,0,funcBuckets+1315,0,0,funcBuckets+1316,funcBuckets+1317,0,
-  0,0,0,funcBuckets+1318,funcBuckets+1319,0,0,0,
-  0,funcBuckets+1320,0,0,0,funcBuckets+1321,0,0,
-  0,0,0,0,0,0,funcBuckets+1322,0,
-  0,0,0,0,funcBuckets+1323,0,0,0,
-  funcBuckets+1324,0,0,funcBuckets+1325,0,0,0,funcBuckets+1326,
-  funcBuckets+1327,0,0,0,0,0,0,0,
+  0,0,funcBuckets+1293,funcBuckets+1294,0,0,0,0,
+  0,0,0,funcBuckets+1295,0,0,funcBuckets+1297,0,
+  funcBuckets+1298,0,0,0,0,0,funcBuckets+1299,0,
+  0,0,0,0,0,0,funcBuckets+1300,0,
+  0,0,funcBuckets+1301,0,funcBuckets+1302,funcBuckets+1303,funcBuckets+1304,0,
+  funcBuckets+1305,0,0,funcBuckets+1306,funcBuckets+1307,0,0,0,
+  0,0,0,0,funcBuckets+1308,0,0,funcBuckets+1309,
+  0,0,0,0,funcBuckets+1310,funcBuckets+1311,funcBuckets+1312,0,
+  funcBuckets+1313,0,funcBuckets+1314,0,0,0,0,0,
+  0,0,funcBuckets+1315,0,0,0,0,0,
+  0,funcBuckets+1316,0,0,0,funcBuckets+1317,0,0,
+  0,0,funcBuckets+1318,0,funcBuckets+1319,0,0,0,
+  0,funcBuckets+1320,0,funcBuckets+1321,0,0,funcBuckets+1322,0,
+  0,0,funcBuckets+1324,0,0,funcBuckets+1325,funcBuckets+1326,0,
+  0,0,0,funcBuckets+1327,funcBuckets+1328,0,0,0,
+  0,funcBuckets+1329,0,0,0,funcBuckets+1330,0,0,
+  0,0,0,0,0,0,funcBuckets+1331,0,
+  0,0,0,0,funcBuckets+1332,0,0,0,
+  funcBuckets+1333,0,0,funcBuckets+1334,0,0,0,funcBuckets+1335,
+  funcBuckets+1336,0,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1328,0,funcBuckets+1329,0,0,
-  0,0,funcBuckets+1330,funcBuckets+1331,funcBuckets+1332,0,0,funcBuckets+1333,
-  0,funcBuckets+1335,0,0,funcBuckets+1336,0,0,0,
-  0,0,0,funcBuckets+1338,0,0,0,0,
+  0,0,0,funcBuckets+1337,0,funcBuckets+1338,0,0,
+  0,0,funcBuckets+1339,funcBuckets+1340,funcBuckets+1341,0,0,funcBuckets+1342,
+  0,funcBuckets+1344,0,0,funcBuckets+1345,0,0,0,
+  0,0,0,funcBuckets+1347,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  funcBuckets+1339,0,0,0,0,0,funcBuckets+1340,0,
-  0,0,funcBuckets+1341,0,0,0,0,0,
-  funcBuckets+1342,0,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+1343,funcBuckets+1344,funcBuckets+1347,0,
-  0,funcBuckets+1348,0,funcBuckets+1349,funcBuckets+1350,0,0,0,
-  0,funcBuckets+1351,funcBuckets+1352,0,0,funcBuckets+1353,0,0,
-  0,funcBuckets+1354,funcBuckets+1355,funcBuckets+1356,0,0,funcBuckets+1357,funcBuckets+1358,
-  0,0,funcBuckets+1359,0,funcBuckets+1360,0,funcBuckets+1361,0,
-  funcBuckets+1362,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1363,0,0,funcBuckets+1364,0,
-  0,0,0,0,funcBuckets+1366,0,funcBuckets+1367,funcBuckets+1368,
+  funcBuckets+1348,0,0,0,0,0,funcBuckets+1349,0,
+  0,0,funcBuckets+1350,0,0,0,0,0,
+  funcBuckets+1351,0,0,0,0,0,0,0,
+  0,0,0,0,funcBuckets+1352,funcBuckets+1353,funcBuckets+1356,0,
+  0,funcBuckets+1357,0,funcBuckets+1358,funcBuckets+1359,0,0,0,
+  0,funcBuckets+1360,funcBuckets+1361,0,0,funcBuckets+1362,0,0,
+  0,funcBuckets+1363,funcBuckets+1364,funcBuckets+1365,0,0,funcBuckets+1366,funcBuckets+1367,
+  0,0,funcBuckets+1368,0,funcBuckets+1369,0,funcBuckets+1370,0,
+  funcBuckets+1371,0,0,0,0,0,0,0,
+  0,0,0,funcBuckets+1372,0,0,funcBuckets+1373,0,
+  0,0,0,0,funcBuckets+1375,0,funcBuckets+1376,funcBuckets+1377,
   0,0,0,0,0,0,0,0,
-  funcBuckets+1369,0,0,funcBuckets+1370,0,0,funcBuckets+1371,0,
-  0,0,funcBuckets+1372,funcBuckets+1374,0,0,0,funcBuckets+1375,
-  0,0,0,0,funcBuckets+1376,0,0,0,
+  funcBuckets+1378,0,0,funcBuckets+1379,0,0,funcBuckets+1380,0,
+  0,0,funcBuckets+1381,funcBuckets+1383,0,0,0,funcBuckets+1384,
+  0,0,0,0,funcBuckets+1385,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1377,0,0,0,0,0,
-  0,funcBuckets+1378,funcBuckets+1379,0,funcBuckets+1382,0,0,funcBuckets+1383,
-  funcBuckets+1384,0,funcBuckets+1386,0,0,0,0,0,
-  0,funcBuckets+1387,0,0,0,0,0,0,
-  0,0,funcBuckets+1388,funcBuckets+1389,0,funcBuckets+1390,0,0,
-  0,0,0,funcBuckets+1391,0,0,0,0,
-  0,0,0,funcBuckets+1393,0,0,funcBuckets+1394,funcBuckets+1395,
-  0,0,0,funcBuckets+1396,0,0,funcBuckets+1397,0,
-  0,0,0,0,funcBuckets+1398,funcBuckets+1399,0,0,
-  0,0,0,funcBuckets+1400,0,funcBuckets+1401,0,funcBuckets+1403,
-  0,funcBuckets+1404,0,0,0,0,0,0,
-  funcBuckets+1405,funcBuckets+1406,0,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+1407,0,
-  0,funcBuckets+1408,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+1409,0,funcBuckets+1410,0,
+  0,0,funcBuckets+1386,0,0,0,0,0,
+  0,funcBuckets+1387,funcBuckets+1388,0,funcBuckets+1391,0,0,funcBuckets+1392,
+  funcBuckets+1393,0,funcBuckets+1395,0,0,0,0,0,
+  0,funcBuckets+1396,0,0,0,0,0,0,
+  0,0,funcBuckets+1397,funcBuckets+1398,0,funcBuckets+1399,0,0,
+  0,0,0,funcBuckets+1400,0,0,0,0,
+  0,0,0,funcBuckets+1402,0,0,funcBuckets+1403,funcBuckets+1404,
+  0,0,0,funcBuckets+1405,0,0,funcBuckets+1406,0,
+  0,0,0,0,funcBuckets+1407,funcBuckets+1408,0,0,
+  0,0,0,funcBuckets+1409,0,funcBuckets+1410,0,funcBuckets+1412,
+  0,funcBuckets+1413,0,0,0,0,0,0,
+  funcBuckets+1414,funcBuckets+1415,0,0,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+1416,0,
+  0,funcBuckets+1417,0,0,0,0,0,0,
+  0,0,0,0,funcBuckets+1418,0,funcBuckets+1419,0,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1411,0,funcBuckets+1412,funcBuckets+1414,0,funcBuckets+1416,
-  0,0,0,0,0,0,0,funcBuckets+1417,
-  funcBuckets+1418,funcBuckets+1420,0,0,funcBuckets+1421,0,funcBuckets+1422,funcBuckets+1423,
-  0,funcBuckets+1424,funcBuckets+1425,0,0,funcBuckets+1426,0,0,
-  0,funcBuckets+1427,funcBuckets+1428,funcBuckets+1429,0,funcBuckets+1430,0,0,
-  0,0,0,funcBuckets+1432,0,funcBuckets+1433,0,funcBuckets+1434,
+  0,0,funcBuckets+1420,0,funcBuckets+1421,funcBuckets+1423,0,funcBuckets+1425,
+  0,0,0,0,0,0,0,funcBuckets+1426,
+  funcBuckets+1427,funcBuckets+1429,0,0,funcBuckets+1430,0,funcBuckets+1431,funcBuckets+1432,
+  0,funcBuckets+1433,funcBuckets+1434,0,0,funcBuckets+1435,0,0,
+  0,funcBuckets+1436,funcBuckets+1437,funcBuckets+1438,0,funcBuckets+1439,0,0,
+  0,0,0,funcBuckets+1441,0,funcBuckets+1442,0,funcBuckets+1443,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+1436,0,0,
-  0,funcBuckets+1437,0,0,0,0,0,funcBuckets+1438,
-  funcBuckets+1440,funcBuckets+1441,0,funcBuckets+1442,0,0,funcBuckets+1443,funcBuckets+1445,
-  0,0,funcBuckets+1446,0,0,funcBuckets+1447,0,0,
-  0,0,0,0,funcBuckets+1448,funcBuckets+1449,0,0,
-  funcBuckets+1450,0,0,0,0,funcBuckets+1451,0,0,
-  0,funcBuckets+1452,0,0,0,0,funcBuckets+1453,0,
-  funcBuckets+1454,0,funcBuckets+1458,0,0,0,0,funcBuckets+1459,
-  funcBuckets+1460,0,0,funcBuckets+1461,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+1462,0,
-  0,0,funcBuckets+1463,0,funcBuckets+1464,funcBuckets+1465,0,0,
+  0,0,0,0,0,funcBuckets+1445,0,0,
+  0,funcBuckets+1446,0,0,0,0,0,funcBuckets+1447,
+  funcBuckets+1449,funcBuckets+1450,0,funcBuckets+1451,0,0,funcBuckets+1452,funcBuckets+1454,
+  0,0,funcBuckets+1455,0,0,funcBuckets+1456,0,0,
+  0,0,0,0,funcBuckets+1457,funcBuckets+1458,0,0,
+  funcBuckets+1459,0,0,0,0,funcBuckets+1460,0,0,
+  0,funcBuckets+1461,0,0,0,0,funcBuckets+1462,0,
+  funcBuckets+1463,0,funcBuckets+1467,0,0,0,0,funcBuckets+1468,
+  funcBuckets+1469,0,0,funcBuckets+1470,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+1471,0,
+  0,0,funcBuckets+1472,0,funcBuckets+1473,funcBuckets+1474,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+1466,
-  funcBuckets+1467,0,0,0,0,0,0,0,
-  0,funcBuckets+1468,0,funcBuckets+1469,funcBuckets+1470,0,0,0,
+  0,0,0,0,0,0,0,funcBuckets+1475,
+  funcBuckets+1476,0,0,0,0,0,0,0,
+  0,funcBuckets+1477,0,funcBuckets+1478,funcBuckets+1479,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1471,0,0,funcBuckets+1472,0,0,
-  0,0,0,0,funcBuckets+1473,0,0,funcBuckets+1474,
-  0,funcBuckets+1475,funcBuckets+1476,0,0,funcBuckets+1478,funcBuckets+1479,funcBuckets+1480,
-  0,funcBuckets+1482,0,0,funcBuckets+1483,0,funcBuckets+1484,0,
-  0,0,0,funcBuckets+1485,funcBuckets+1486,0,0,0,
-  0,0,0,funcBuckets+1487,funcBuckets+1488,funcBuckets+1489,0,funcBuckets+1490,
+  0,0,funcBuckets+1480,0,0,funcBuckets+1481,0,0,
+  0,0,0,0,funcBuckets+1482,0,0,funcBuckets+1483,
+  0,funcBuckets+1484,funcBuckets+1485,0,0,funcBuckets+1487,funcBuckets+1488,funcBuckets+1489,
+  0,funcBuckets+1491,0,0,funcBuckets+1492,0,funcBuckets+1493,0,
+  0,0,0,funcBuckets+1494,funcBuckets+1495,0,0,0,
+  0,0,0,funcBuckets+1496,funcBuckets+1497,funcBuckets+1498,0,funcBuckets+1499,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1491,0,funcBuckets+1492,0,0,0,
-  0,0,0,funcBuckets+1494,0,0,funcBuckets+1495,0,
-  0,0,0,0,0,0,0,funcBuckets+1496,
-  0,funcBuckets+1497,0,0,funcBuckets+1498,0,0,funcBuckets+1499,
-  0,0,0,0,0,0,funcBuckets+1502,0,
-  0,0,funcBuckets+1503,0,0,0,0,0,
+  0,0,funcBuckets+1500,0,funcBuckets+1501,0,0,0,
+  0,0,0,funcBuckets+1503,0,0,funcBuckets+1504,0,
+  0,0,0,0,0,0,0,funcBuckets+1505,
+  0,funcBuckets+1506,0,0,funcBuckets+1507,0,0,funcBuckets+1508,
+  0,0,0,0,0,0,funcBuckets+1511,0,
+  0,0,funcBuckets+1512,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1504,funcBuckets+1505,0,0,0,0,
-  funcBuckets+1506,funcBuckets+1507,0,0,funcBuckets+1508,0,0,0,
-  0,0,0,0,funcBuckets+1509,0,0,funcBuckets+1510,
-  0,0,funcBuckets+1511,funcBuckets+1512,0,funcBuckets+1514,funcBuckets+1515,0,
+  0,0,funcBuckets+1513,funcBuckets+1514,0,0,0,0,
+  funcBuckets+1515,funcBuckets+1516,0,0,funcBuckets+1517,0,0,0,
+  0,0,0,0,funcBuckets+1518,0,0,funcBuckets+1519,
+  0,0,funcBuckets+1520,funcBuckets+1521,0,funcBuckets+1523,funcBuckets+1524,0,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+1516,0,0,0,0,0,0,
-  0,funcBuckets+1517,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+1519,0,0,0,
+  0,funcBuckets+1525,0,0,0,0,0,0,
+  0,funcBuckets+1526,0,0,0,0,0,0,
+  0,0,0,0,funcBuckets+1528,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+1520,0,0,
-  0,0,funcBuckets+1521,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+1522,0,0,
-  funcBuckets+1524,0,0,funcBuckets+1525,funcBuckets+1526,0,funcBuckets+1527,funcBuckets+1528,
-  funcBuckets+1529,0,0,0,0,0,0,0,
+  0,0,0,0,0,funcBuckets+1529,0,0,
+  0,0,funcBuckets+1530,0,0,0,0,0,
+  0,0,0,0,0,funcBuckets+1531,0,0,
+  funcBuckets+1533,0,0,funcBuckets+1534,funcBuckets+1535,0,funcBuckets+1536,funcBuckets+1537,
+  funcBuckets+1538,0,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+1530,0,0,
-  0,funcBuckets+1531,0,0,funcBuckets+1533,funcBuckets+1534,0,0,
-  0,funcBuckets+1535,0,0,0,0,0,0,
-  funcBuckets+1536,0,0,0,funcBuckets+1538,0,0,funcBuckets+1539,
-  0,0,0,0,funcBuckets+1540,0,0,funcBuckets+1541,
-  0,0,0,0,0,0,funcBuckets+1543,funcBuckets+1544,
-  0,0,0,0,0,0,funcBuckets+1545,0,
-  0,0,0,0,0,0,funcBuckets+1546,funcBuckets+1547,
-  0,0,0,0,0,funcBuckets+1548,0,0,
-  0,0,0,0,0,0,funcBuckets+1549,funcBuckets+1550,
-  0,0,funcBuckets+1551,0,0,0,0,0,
+  0,0,0,0,0,funcBuckets+1539,0,0,
+  0,funcBuckets+1540,0,0,funcBuckets+1542,funcBuckets+1543,0,0,
+  0,funcBuckets+1544,0,0,0,0,0,0,
+  funcBuckets+1545,0,0,0,funcBuckets+1547,0,0,funcBuckets+1548,
+  0,0,0,0,funcBuckets+1549,0,0,funcBuckets+1550,
+  0,0,0,0,0,0,funcBuckets+1552,funcBuckets+1553,
+  0,0,0,0,0,0,funcBuckets+1554,0,
+  0,0,0,0,0,0,funcBuckets+1555,funcBuckets+1556,
+  0,0,0,0,0,funcBuckets+1557,0,0,
+  0,0,0,0,0,0,funcBuckets+1558,funcBuckets+1559,
+  0,0,funcBuckets+1560,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1552,0,0,0,funcBuckets+1553,
-  0,0,0,funcBuckets+1554,funcBuckets+1555,funcBuckets+1556,0,0,
-  0,0,funcBuckets+1557,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+1558,0,funcBuckets+1559,
-  0,0,0,funcBuckets+1560,0,funcBuckets+1561,funcBuckets+1562,0,
+  0,0,0,funcBuckets+1561,0,0,0,funcBuckets+1562,
+  0,0,0,funcBuckets+1563,funcBuckets+1564,funcBuckets+1565,0,0,
+  0,0,funcBuckets+1566,0,0,0,0,0,
+  0,0,0,0,0,funcBuckets+1567,0,funcBuckets+1568,
+  0,0,0,funcBuckets+1569,0,funcBuckets+1570,funcBuckets+1571,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+1563,
-  0,0,funcBuckets+1564,funcBuckets+1566,0,0,0,funcBuckets+1567,
-  0,0,0,0,0,funcBuckets+1568,0,0,
-  0,0,funcBuckets+1571,0,0,0,funcBuckets+1572,0,
-  0,0,0,0,0,funcBuckets+1573,0,0,
-  funcBuckets+1574,0,funcBuckets+1575,0,0,0,0,funcBuckets+1576,
-  0,funcBuckets+1577,funcBuckets+1578,0,funcBuckets+1579,funcBuckets+1580,0,0,
+  0,0,0,0,0,0,0,funcBuckets+1572,
+  0,0,funcBuckets+1573,funcBuckets+1575,0,0,0,funcBuckets+1576,
+  0,0,0,0,0,funcBuckets+1577,0,0,
+  0,0,funcBuckets+1580,0,0,0,funcBuckets+1581,0,
+  0,0,0,0,0,funcBuckets+1582,0,0,
+  funcBuckets+1583,0,funcBuckets+1584,0,0,0,0,funcBuckets+1585,
+  0,funcBuckets+1586,funcBuckets+1587,0,funcBuckets+1588,funcBuckets+1589,0,0,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+1581,0,0,funcBuckets+1582,0,0,funcBuckets+1584,
-  0,0,0,0,0,funcBuckets+1585,funcBuckets+1586,0,
-  funcBuckets+1587,0,0,funcBuckets+1588,0,0,0,0,
-  0,funcBuckets+1589,0,0,0,0,0,0,
-  0,funcBuckets+1590,0,0,funcBuckets+1591,0,0,0,
-  0,0,0,funcBuckets+1592,0,funcBuckets+1593,0,0,
-  0,0,0,0,funcBuckets+1595,funcBuckets+1596,0,funcBuckets+1597,
-  funcBuckets+1598,0,0,0,0,0,0,0,
-  funcBuckets+1599,0,0,0,0,0,funcBuckets+1600,funcBuckets+1601,
-  0,funcBuckets+1602,0,0,0,funcBuckets+1603,0,0,
+  0,funcBuckets+1590,0,0,funcBuckets+1591,0,0,funcBuckets+1593,
+  0,0,0,0,0,funcBuckets+1594,funcBuckets+1595,0,
+  funcBuckets+1596,0,0,funcBuckets+1597,0,0,0,0,
+  0,funcBuckets+1598,0,0,0,0,0,0,
+  0,funcBuckets+1599,0,0,funcBuckets+1600,0,0,0,
+  0,0,0,funcBuckets+1601,0,funcBuckets+1602,0,0,
+  0,0,0,0,funcBuckets+1604,funcBuckets+1605,0,funcBuckets+1606,
+  funcBuckets+1607,0,0,0,0,0,0,0,
+  funcBuckets+1608,0,0,0,0,0,funcBuckets+1609,funcBuckets+1610,
+  0,funcBuckets+1611,0,0,0,funcBuckets+1612,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1604,0,0,0,0,0,
-  0,funcBuckets+1605,0,0,0,0,0,0,
-  0,funcBuckets+1606,funcBuckets+1607,funcBuckets+1608,0,0,0,0,
-  0,funcBuckets+1609,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1610,funcBuckets+1612,0,0,0,
-  0,0,0,0,0,funcBuckets+1613,funcBuckets+1615,0,
-  0,0,0,0,0,funcBuckets+1616,funcBuckets+1618,0,
-  funcBuckets+1619,0,0,0,0,funcBuckets+1620,funcBuckets+1621,0,
-  0,0,0,funcBuckets+1622,0,0,0,0,
-  0,0,0,funcBuckets+1623,funcBuckets+1624,funcBuckets+1625,0,funcBuckets+1626,
-  funcBuckets+1627,0,0,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+1628,0,
-  0,0,0,funcBuckets+1629,0,funcBuckets+1630,0,funcBuckets+1631,
+  0,0,funcBuckets+1613,0,0,0,0,0,
+  0,funcBuckets+1614,0,0,0,0,0,0,
+  0,funcBuckets+1615,funcBuckets+1616,funcBuckets+1617,0,0,0,0,
+  0,funcBuckets+1618,0,0,0,0,0,0,
+  0,0,0,funcBuckets+1619,funcBuckets+1621,0,0,0,
+  0,0,0,0,0,funcBuckets+1622,funcBuckets+1624,0,
+  0,0,0,0,0,funcBuckets+1625,funcBuckets+1627,0,
+  funcBuckets+1628,0,0,0,0,funcBuckets+1629,funcBuckets+1630,0,
+  0,0,0,funcBuckets+1631,0,0,0,0,
+  0,0,0,funcBuckets+1632,funcBuckets+1633,funcBuckets+1634,0,funcBuckets+1635,
+  funcBuckets+1636,0,0,0,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+1637,0,
+  0,0,0,funcBuckets+1638,0,funcBuckets+1639,0,funcBuckets+1640,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+1632,0,0,0,funcBuckets+1633,funcBuckets+1634,funcBuckets+1635,
+  0,funcBuckets+1641,0,0,0,funcBuckets+1642,funcBuckets+1643,funcBuckets+1644,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+1636,0,0,0,0,0,0,
-  0,funcBuckets+1637,0,0,0,0,funcBuckets+1638,funcBuckets+1639,
-  0,funcBuckets+1640,0,0,0,0,0,0,
-  0,funcBuckets+1641,0,0,0,0,0,0,
-  0,funcBuckets+1642,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+1643,0,0,funcBuckets+1644,
-  0,0,0,0,0,funcBuckets+1645,0,funcBuckets+1646,
-  funcBuckets+1647,0,funcBuckets+1648,funcBuckets+1649,0,0,0,0,
+  0,funcBuckets+1645,0,0,0,0,0,0,
+  0,funcBuckets+1646,0,0,0,0,funcBuckets+1647,funcBuckets+1648,
+  0,funcBuckets+1649,0,0,0,0,0,0,
+  0,funcBuckets+1650,0,0,0,0,0,0,
+  0,funcBuckets+1651,0,0,0,0,0,0,
+  0,0,0,0,funcBuckets+1652,0,0,funcBuckets+1653,
+  0,0,0,0,0,funcBuckets+1654,0,funcBuckets+1655,
+  funcBuckets+1656,0,funcBuckets+1657,funcBuckets+1658,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1651,funcBuckets+1652,0,0,funcBuckets+1653,0,
-  funcBuckets+1654,funcBuckets+1655,funcBuckets+1657,0,0,funcBuckets+1658,0,0,
-  0,0,0,funcBuckets+1659,funcBuckets+1660,0,0,funcBuckets+1661,
-  funcBuckets+1662,0,0,0,0,funcBuckets+1663,0,0,
-  0,funcBuckets+1664,0,0,0,0,0,0,
-  0,funcBuckets+1665,0,0,0,0,funcBuckets+1666,0,
-  funcBuckets+1667,0,0,0,funcBuckets+1668,funcBuckets+1669,0,0,
-  funcBuckets+1671,0,0,funcBuckets+1672,funcBuckets+1673,0,0,0,
+  0,0,funcBuckets+1660,funcBuckets+1661,0,0,funcBuckets+1662,0,
+  funcBuckets+1663,funcBuckets+1664,funcBuckets+1666,0,0,funcBuckets+1667,0,0,
+  0,0,0,funcBuckets+1668,funcBuckets+1669,0,0,funcBuckets+1670,
+  funcBuckets+1671,0,0,0,0,funcBuckets+1672,0,0,
+  0,funcBuckets+1673,0,0,0,0,0,0,
+  0,funcBuckets+1674,0,0,0,0,funcBuckets+1675,0,
+  funcBuckets+1676,0,0,0,funcBuckets+1677,funcBuckets+1678,0,0,
+  funcBuckets+1680,0,0,funcBuckets+1681,funcBuckets+1682,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+1675,0,0,0,
-  0,funcBuckets+1676,0,0,0,0,funcBuckets+1677,0,
-  0,funcBuckets+1678,0,0,0,0,funcBuckets+1679,0,
-  0,funcBuckets+1680,0,funcBuckets+1681,0,0,0,funcBuckets+1682,
-  0,funcBuckets+1683,0,0,0,0,funcBuckets+1684,0,
-  0,0,0,0,0,0,0,funcBuckets+1685,
-  funcBuckets+1686,0,0,funcBuckets+1688,funcBuckets+1689,0,0,0,
-  funcBuckets+1691,0,0,0,0,0,0,0,
-  funcBuckets+1692,0,0,0,0,0,0,funcBuckets+1693,
+  0,0,0,0,funcBuckets+1684,0,0,0,
+  0,funcBuckets+1685,0,0,0,0,funcBuckets+1686,0,
+  0,funcBuckets+1687,0,0,0,0,funcBuckets+1688,0,
+  0,funcBuckets+1689,0,funcBuckets+1690,0,0,0,funcBuckets+1691,
+  0,funcBuckets+1692,0,0,0,0,funcBuckets+1693,0,
+  0,0,0,0,0,0,0,funcBuckets+1694,
+  funcBuckets+1695,0,0,funcBuckets+1697,funcBuckets+1698,0,0,0,
+  funcBuckets+1700,0,0,0,0,0,0,0,
+  funcBuckets+1701,0,0,0,0,0,0,funcBuckets+1702,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+1694,0,0,
-  0,funcBuckets+1695,0,0,0,0,0,funcBuckets+1697,
-  0,funcBuckets+1699,funcBuckets+1700,funcBuckets+1701,funcBuckets+1702,0,0,0,
-  funcBuckets+1703,0,0,0,0,0,funcBuckets+1704,0,
+  0,0,0,0,0,funcBuckets+1703,0,0,
+  0,funcBuckets+1704,0,0,0,0,0,funcBuckets+1706,
+  0,funcBuckets+1708,funcBuckets+1709,funcBuckets+1710,funcBuckets+1711,0,0,0,
+  funcBuckets+1712,0,0,0,0,0,funcBuckets+1713,0,
   0,0,0,0,0,0,0,0,
-  funcBuckets+1705,0,0,0,0,0,0,0,
+  funcBuckets+1714,0,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1706,0,0,0,0,
+  0,0,0,funcBuckets+1715,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  funcBuckets+1707,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+1708,0,0,
-  0,0,0,0,funcBuckets+1709,0,0,0,
-  0,0,funcBuckets+1710,0,0,0,0,0,
-  0,0,0,funcBuckets+1711,0,0,0,0,
-  0,funcBuckets+1712,0,0,0,0,0,0,
-  0,funcBuckets+1714,0,0,funcBuckets+1715,0,0,funcBuckets+1716,
-  0,0,0,funcBuckets+1718,0,0,0,0,
-  0,0,0,0,0,funcBuckets+1719,0,funcBuckets+1721,
-  funcBuckets+1722,0,funcBuckets+1723,0,0,funcBuckets+1724,0,0,
-  0,0,0,0,0,0,funcBuckets+1726,0,
-  0,0,0,0,0,0,0,funcBuckets+1727,
-  funcBuckets+1728,funcBuckets+1729,0,funcBuckets+1730,funcBuckets+1731,0,0,0,
-  0,0,0,funcBuckets+1732,0,0,0,0,
-  0,0,0,0,funcBuckets+1733,0,0,0,
+  funcBuckets+1716,0,0,0,0,0,0,0,
+  0,0,0,0,0,funcBuckets+1717,0,0,
+  0,0,0,0,funcBuckets+1718,0,0,0,
+  0,0,funcBuckets+1719,0,0,0,0,0,
+  0,0,0,funcBuckets+1720,0,0,0,0,
+  0,funcBuckets+1721,0,0,0,0,0,0,
+  0,funcBuckets+1723,0,0,funcBuckets+1724,0,0,funcBuckets+1725,
+  0,0,0,funcBuckets+1727,0,0,0,0,
+  0,0,0,0,0,funcBuckets+1728,0,funcBuckets+1730,
+  funcBuckets+1731,0,funcBuckets+1732,0,0,funcBuckets+1733,0,0,
+  0,0,0,0,0,0,funcBuckets+1735,0,
+  0,0,0,0,0,0,0,funcBuckets+1736,
+  funcBuckets+1737,funcBuckets+1738,0,funcBuckets+1739,funcBuckets+1740,0,0,0,
+  0,0,0,funcBuckets+1742,0,0,0,0,
+  0,0,0,0,funcBuckets+1743,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1734,0,0,0,0,funcBuckets+1735,
-  0,funcBuckets+1736,0,0,0,0,0,0,
+  0,0,funcBuckets+1744,0,0,0,0,funcBuckets+1745,
+  0,funcBuckets+1746,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  funcBuckets+1738,0,funcBuckets+1739,funcBuckets+1740,0,0,0,0,
-  funcBuckets+1741,0,0,funcBuckets+1742,0,funcBuckets+1743,funcBuckets+1745,0,
-  funcBuckets+1746,0,0,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+1747,0,
-  0,0,0,0,funcBuckets+1748,0,0,0,
-  0,0,0,0,funcBuckets+1749,funcBuckets+1750,0,funcBuckets+1751,
-  0,0,0,0,0,0,funcBuckets+1752,funcBuckets+1753,
-  funcBuckets+1754,funcBuckets+1756,funcBuckets+1757,0,0,0,0,0,
+  funcBuckets+1748,0,funcBuckets+1749,funcBuckets+1750,0,0,0,0,
+  funcBuckets+1751,0,0,funcBuckets+1752,0,funcBuckets+1753,funcBuckets+1755,0,
+  funcBuckets+1756,0,0,0,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+1757,0,
   0,0,0,0,funcBuckets+1758,0,0,0,
-  0,0,funcBuckets+1759,funcBuckets+1760,0,0,0,0,
-  0,0,funcBuckets+1761,0,0,funcBuckets+1762,0,0,
-  0,0,0,0,0,0,0,funcBuckets+1763,
+  0,0,0,0,funcBuckets+1759,funcBuckets+1760,0,funcBuckets+1761,
+  0,0,0,0,0,0,funcBuckets+1762,funcBuckets+1763,
+  funcBuckets+1764,funcBuckets+1766,funcBuckets+1767,0,0,0,0,0,
+  0,0,0,0,funcBuckets+1768,0,0,0,
+  0,0,funcBuckets+1769,funcBuckets+1770,0,0,0,0,
+  0,0,funcBuckets+1771,0,0,funcBuckets+1772,0,0,
+  0,0,0,0,0,0,0,funcBuckets+1773,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+1764,funcBuckets+1765,funcBuckets+1766,0,0,0,funcBuckets+1767,
-  funcBuckets+1768,0,0,0,0,funcBuckets+1769,0,0,
-  0,0,0,0,funcBuckets+1770,0,0,0,
-  0,0,0,0,funcBuckets+1771,0,0,funcBuckets+1772,
-  funcBuckets+1773,0,0,funcBuckets+1774,0,funcBuckets+1775,0,0,
+  0,funcBuckets+1774,funcBuckets+1775,funcBuckets+1776,0,0,0,funcBuckets+1777,
+  funcBuckets+1778,0,0,0,0,funcBuckets+1779,0,0,
+  0,0,0,0,funcBuckets+1780,0,0,0,
+  0,0,0,0,funcBuckets+1781,0,0,funcBuckets+1782,
+  funcBuckets+1783,0,0,funcBuckets+1784,0,funcBuckets+1785,0,0,
   0,0,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+1777,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+1778,0,0,0,
-  funcBuckets+1780,0,0,funcBuckets+1781,0,0,funcBuckets+1782,funcBuckets+1783,
-  0,0,funcBuckets+1784,0,0,funcBuckets+1786,0,funcBuckets+1787,
-  0,0,0,0,0,0,funcBuckets+1788,0,
+  0,funcBuckets+1787,0,0,0,0,0,0,
+  0,0,0,0,funcBuckets+1788,0,0,0,
+  funcBuckets+1790,0,0,funcBuckets+1791,0,0,funcBuckets+1792,funcBuckets+1793,
+  0,0,funcBuckets+1794,0,0,funcBuckets+1796,0,funcBuckets+1797,
+  0,0,0,0,0,0,funcBuckets+1798,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1790,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+1791,0,
-  funcBuckets+1792,funcBuckets+1794,0,funcBuckets+1795,0,0,0,0,
-  0,funcBuckets+1796,funcBuckets+1797,0,0,funcBuckets+1798,0,0,
-  0,0,0,0,0,funcBuckets+1799,0,0,
-  0,0,funcBuckets+1800,funcBuckets+1801,0,funcBuckets+1802,0,0,
-  funcBuckets+1803,0,0,funcBuckets+1804,funcBuckets+1805,0,0,0,
-  0,0,funcBuckets+1806,funcBuckets+1807,funcBuckets+1808,funcBuckets+1809,0,funcBuckets+1810,
-  0,funcBuckets+1811,funcBuckets+1812,0,0,funcBuckets+1813,0,funcBuckets+1814,
-  0,0,0,0,0,funcBuckets+1815,0,funcBuckets+1816,
+  0,0,0,funcBuckets+1800,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+1801,0,
+  funcBuckets+1802,funcBuckets+1804,0,funcBuckets+1805,0,0,0,0,
+  0,funcBuckets+1806,funcBuckets+1807,0,0,funcBuckets+1808,0,0,
+  0,0,0,0,0,funcBuckets+1809,0,0,
+  0,0,funcBuckets+1810,funcBuckets+1811,0,funcBuckets+1812,0,0,
+  funcBuckets+1813,0,0,funcBuckets+1814,funcBuckets+1815,0,0,0,
+  0,0,funcBuckets+1816,funcBuckets+1817,funcBuckets+1818,funcBuckets+1819,0,funcBuckets+1820,
+  0,funcBuckets+1821,funcBuckets+1822,0,0,funcBuckets+1823,0,funcBuckets+1824,
+  0,0,0,0,0,funcBuckets+1825,0,funcBuckets+1826,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1817,0,0,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+1818,
-  0,0,0,0,0,0,0,funcBuckets+1819,
-  0,0,0,0,funcBuckets+1821,funcBuckets+1822,0,0,
-  0,funcBuckets+1823,0,0,0,funcBuckets+1825,0,0,
-  0,0,0,funcBuckets+1826,0,funcBuckets+1827,funcBuckets+1828,0,
+  0,0,funcBuckets+1827,0,0,0,0,0,
+  0,0,0,0,0,0,0,funcBuckets+1828,
+  0,0,0,0,0,0,0,funcBuckets+1829,
+  0,0,0,0,funcBuckets+1831,funcBuckets+1832,0,0,
+  0,funcBuckets+1833,0,0,0,funcBuckets+1835,0,0,
+  0,0,0,funcBuckets+1836,0,funcBuckets+1837,funcBuckets+1838,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1829,0,funcBuckets+1830,funcBuckets+1831,0,
-  funcBuckets+1832,0,0,0,funcBuckets+1833,0,funcBuckets+1834,0,
-  funcBuckets+1835,0,0,0,funcBuckets+1836,funcBuckets+1837,funcBuckets+1838,0,
-  0,funcBuckets+1839,0,funcBuckets+1840,0,0,0,0,
-  0,0,funcBuckets+1841,0,funcBuckets+1842,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+1843,
-  funcBuckets+1844,0,0,0,funcBuckets+1845,0,funcBuckets+1846,0,
-  funcBuckets+1847,0,0,0,0,0,funcBuckets+1848,0,
-  0,0,funcBuckets+1849,0,funcBuckets+1850,0,0,0,
-  0,0,0,funcBuckets+1851,funcBuckets+1852,0,0,funcBuckets+1853,
-  funcBuckets+1854,funcBuckets+1855,funcBuckets+1856,0,funcBuckets+1857,0,0,funcBuckets+1858,
-  funcBuckets+1859,0,0,0,funcBuckets+1860,funcBuckets+1861,0,0,
+  0,0,0,funcBuckets+1839,0,funcBuckets+1840,funcBuckets+1841,0,
+  funcBuckets+1842,0,0,0,funcBuckets+1843,0,funcBuckets+1844,0,
+  funcBuckets+1845,0,0,0,funcBuckets+1846,funcBuckets+1847,funcBuckets+1848,0,
+  0,funcBuckets+1849,0,funcBuckets+1850,0,0,0,0,
+  0,0,funcBuckets+1851,0,funcBuckets+1852,0,0,0,
+  0,0,0,0,0,0,0,funcBuckets+1853,
+  funcBuckets+1854,0,0,0,funcBuckets+1855,0,funcBuckets+1856,0,
+  funcBuckets+1857,0,0,0,0,0,funcBuckets+1858,0,
+  0,0,funcBuckets+1859,0,funcBuckets+1860,0,0,0,
+  0,0,0,funcBuckets+1861,funcBuckets+1862,0,0,funcBuckets+1863,
+  funcBuckets+1864,funcBuckets+1865,funcBuckets+1866,0,funcBuckets+1867,0,0,funcBuckets+1868,
+  funcBuckets+1869,0,0,0,funcBuckets+1870,funcBuckets+1871,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+1862,0,0,
-  0,0,0,0,0,funcBuckets+1863,0,funcBuckets+1864,
-  0,funcBuckets+1865,0,0,0,0,0,0,
-  funcBuckets+1866,0,0,funcBuckets+1867,0,0,0,0,
-  0,funcBuckets+1868,0,0,0,funcBuckets+1869,funcBuckets+1870,funcBuckets+1871,
-  0,funcBuckets+1873,0,0,funcBuckets+1874,funcBuckets+1875,0,0,
+  0,0,0,0,0,funcBuckets+1872,0,0,
+  0,0,0,0,0,funcBuckets+1873,0,funcBuckets+1874,
+  0,funcBuckets+1875,0,0,0,0,0,0,
+  funcBuckets+1876,0,0,funcBuckets+1877,0,0,0,0,
+  0,funcBuckets+1878,0,0,0,funcBuckets+1879,funcBuckets+1880,funcBuckets+1881,
+  0,funcBuckets+1883,0,0,funcBuckets+1884,funcBuckets+1885,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1876,0,funcBuckets+1877,funcBuckets+1878,0,
+  0,0,0,funcBuckets+1886,0,funcBuckets+1887,funcBuckets+1888,0,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+1879,funcBuckets+1880,0,0,0,0,funcBuckets+1881,
-  0,0,0,0,funcBuckets+1882,0,0,0,
-  0,0,funcBuckets+1883,0,0,0,funcBuckets+1884,0,
-  funcBuckets+1885,0,0,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+1887,0,
-  0,0,0,0,0,0,0,funcBuckets+1888,
-  0,0,funcBuckets+1889,0,0,funcBuckets+1890,funcBuckets+1891,0,
-  funcBuckets+1892,0,funcBuckets+1894,0,funcBuckets+1895,0,0,0,
-  funcBuckets+1896,0,0,0,0,0,funcBuckets+1897,0,
-  funcBuckets+1898,funcBuckets+1899,0,0,0,0,0,0,
-  0,0,0,funcBuckets+1900,funcBuckets+1902,0,0,0,
-  funcBuckets+1904,funcBuckets+1906,0,0,funcBuckets+1907,0,0,funcBuckets+1908,
-  0,funcBuckets+1909,0,0,funcBuckets+1910,0,0,0,
-  0,0,funcBuckets+1911,0,0,0,0,0,
-  funcBuckets+1912,0,funcBuckets+1913,0,0,0,0,0,
-  0,0,funcBuckets+1914,0,0,0,0,funcBuckets+1915,
-  0,0,0,0,funcBuckets+1916,0,funcBuckets+1917,funcBuckets+1918,
-  0,funcBuckets+1919,0,0,0,0,0,0,
+  0,funcBuckets+1889,funcBuckets+1890,0,0,0,0,funcBuckets+1891,
+  0,0,0,0,funcBuckets+1892,0,0,0,
+  0,0,funcBuckets+1893,0,0,0,funcBuckets+1894,0,
+  funcBuckets+1895,0,0,0,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+1897,0,
+  0,0,0,0,0,0,0,funcBuckets+1898,
+  0,0,funcBuckets+1899,0,0,funcBuckets+1900,funcBuckets+1901,0,
+  funcBuckets+1902,0,funcBuckets+1904,0,funcBuckets+1905,0,0,0,
+  funcBuckets+1906,0,0,0,0,0,funcBuckets+1907,0,
+  funcBuckets+1908,funcBuckets+1909,0,0,0,0,0,0,
+  0,0,0,funcBuckets+1910,funcBuckets+1912,0,0,0,
+  funcBuckets+1914,funcBuckets+1916,0,0,funcBuckets+1917,0,0,funcBuckets+1918,
+  0,funcBuckets+1919,0,0,funcBuckets+1920,0,0,0,
+  0,0,funcBuckets+1921,0,0,0,0,0,
+  funcBuckets+1922,0,funcBuckets+1923,0,0,0,0,0,
+  0,0,funcBuckets+1924,0,0,0,0,funcBuckets+1925,
+  0,0,0,0,funcBuckets+1926,0,funcBuckets+1927,funcBuckets+1928,
+  0,funcBuckets+1929,0,0,0,0,funcBuckets+1930,0,
   0,0,0,0,0,0,0,0,
-  0,0,funcBuckets+1920,funcBuckets+1921,0,0,0,0,
-  funcBuckets+1922,0,0,0,funcBuckets+1923,0,funcBuckets+1924,0,
-  0,0,0,0,0,0,funcBuckets+1925,0,
-  0,0,0,funcBuckets+1926,0,0,0,0,
-  funcBuckets+1927,0,0,0,0,0,0,funcBuckets+1928,
-  funcBuckets+1929,funcBuckets+1930,0,0,0,0,funcBuckets+1931,0,
-  0,funcBuckets+1932,0,0,0,0,0,funcBuckets+1934,
-  funcBuckets+1935,0,0,0,0,0,0,0,
-  0,funcBuckets+1936,0,0,funcBuckets+1937,0,0,0,
+  0,0,funcBuckets+1931,funcBuckets+1932,0,0,0,0,
+  funcBuckets+1933,0,0,0,funcBuckets+1934,0,funcBuckets+1935,0,
+  0,0,0,0,0,0,funcBuckets+1936,0,
+  0,0,0,funcBuckets+1937,0,0,0,0,
+  funcBuckets+1938,0,0,0,0,0,0,funcBuckets+1939,
+  funcBuckets+1940,funcBuckets+1941,0,0,0,0,funcBuckets+1942,0,
+  0,funcBuckets+1943,0,0,0,0,0,funcBuckets+1945,
+  funcBuckets+1946,0,0,0,0,0,0,0,
+  0,funcBuckets+1947,0,0,funcBuckets+1948,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+1938,0,0,0,funcBuckets+1939,0,0,
+  0,funcBuckets+1949,0,0,0,funcBuckets+1950,0,0,
   0,0,0,0,0,0,0,0,
-  0,funcBuckets+1940,0,funcBuckets+1941,0,0,0,0,
-  0,0,funcBuckets+1942,funcBuckets+1943,0,0,0,0,
+  0,funcBuckets+1951,0,funcBuckets+1952,0,0,0,0,
+  0,0,funcBuckets+1953,funcBuckets+1954,0,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+1944,0,
-  funcBuckets+1945,funcBuckets+1946,0,0,0,0,0,funcBuckets+1947,
+  0,0,0,0,0,0,funcBuckets+1955,0,
+  funcBuckets+1956,funcBuckets+1957,0,0,0,0,0,funcBuckets+1958,
   0,0,0,0,0,0,0,0,
-  funcBuckets+1949,0,funcBuckets+1950,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+1951,funcBuckets+1953,
-  0,funcBuckets+1954,0,funcBuckets+1955,funcBuckets+1956,funcBuckets+1957,0,0,
-  0,0,funcBuckets+1958,0,0,0,0,0,
-  0,0,0,0,funcBuckets+1959,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+1960,
-  0,0,funcBuckets+1961,funcBuckets+1962,0,0,0,0,
-  0,0,0,funcBuckets+1964,0,0,funcBuckets+1965,funcBuckets+1966,
-  0,0,0,0,0,0,funcBuckets+1967,0,
-  0,funcBuckets+1968,0,0,funcBuckets+1969,funcBuckets+1970,0,0,
-  funcBuckets+1971,0,funcBuckets+1973,0,funcBuckets+1974,0,0,0,
-  0,0,funcBuckets+1975,0,0,0,funcBuckets+1976,0,
-  0,0,0,0,0,funcBuckets+1977,0,0,
-  funcBuckets+1978,0,funcBuckets+1979,0,0,0,0,0,
-  0,0,funcBuckets+1980,0,0,0,0,funcBuckets+1981,
-  funcBuckets+1983,0,0,0,0,0,0,0,
-  0,funcBuckets+1984,funcBuckets+1985,0,0,funcBuckets+1987,funcBuckets+1988,0,
-  0,funcBuckets+1991,0,0,0,0,0,funcBuckets+1992,
-  0,0,0,0,0,funcBuckets+1993,0,0,
+  funcBuckets+1960,0,funcBuckets+1961,0,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+1962,funcBuckets+1964,
+  0,funcBuckets+1965,0,funcBuckets+1966,funcBuckets+1967,funcBuckets+1968,0,0,
+  0,0,funcBuckets+1969,0,0,0,0,0,
+  0,0,0,0,funcBuckets+1970,0,0,0,
+  0,0,0,0,0,0,0,funcBuckets+1971,
+  0,0,funcBuckets+1972,funcBuckets+1973,0,0,0,0,
+  0,0,0,funcBuckets+1975,0,0,funcBuckets+1976,funcBuckets+1977,
+  0,0,0,0,0,0,funcBuckets+1978,0,
+  0,funcBuckets+1979,0,0,funcBuckets+1980,funcBuckets+1981,0,0,
+  funcBuckets+1982,0,funcBuckets+1984,0,funcBuckets+1985,0,0,0,
+  0,0,funcBuckets+1986,0,0,0,funcBuckets+1987,0,
+  0,0,0,0,0,funcBuckets+1988,0,0,
+  funcBuckets+1989,0,funcBuckets+1990,0,0,0,0,0,
+  0,0,funcBuckets+1991,0,0,0,0,funcBuckets+1992,
   funcBuckets+1994,0,0,0,0,0,0,0,
-  funcBuckets+1995,funcBuckets+1996,0,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+1997,0,
-  0,0,0,funcBuckets+1998,funcBuckets+1999,0,0,funcBuckets+2000,
-  funcBuckets+2001,0,0,funcBuckets+2002,0,0,0,0,
-  0,0,funcBuckets+2003,funcBuckets+2004,0,0,0,0,
-  0,funcBuckets+2005,0,0,0,0,0,0,
-  0,funcBuckets+2006,0,0,0,0,0,0,
-  funcBuckets+2007,0,0,0,0,funcBuckets+2008,0,0,
-  funcBuckets+2009,0,funcBuckets+2012,0,0,funcBuckets+2013,funcBuckets+2014,0,
-  funcBuckets+2015,funcBuckets+2016,funcBuckets+2017,funcBuckets+2018,0,0,0,0,
-  0,funcBuckets+2019,0,funcBuckets+2020,0,0,0,0,
-  0,0,funcBuckets+2021,0,0,funcBuckets+2023,0,0,
-  0,funcBuckets+2024,0,funcBuckets+2025,funcBuckets+2026,0,0,0,
-  funcBuckets+2027,0,0,funcBuckets+2028,0,0,funcBuckets+2029,0,
-  0,0,0,0,0,funcBuckets+2030,0,funcBuckets+2031,
-  0,0,0,0,0,0,0,funcBuckets+2032,
+  0,funcBuckets+1995,funcBuckets+1996,0,0,funcBuckets+1998,funcBuckets+1999,0,
+  0,funcBuckets+2002,0,0,0,0,0,funcBuckets+2003,
+  0,0,0,0,0,funcBuckets+2004,0,0,
+  funcBuckets+2005,0,0,0,0,0,0,0,
+  funcBuckets+2006,funcBuckets+2007,0,0,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+2008,0,
+  0,0,0,funcBuckets+2009,funcBuckets+2010,0,0,funcBuckets+2011,
+  funcBuckets+2012,0,0,funcBuckets+2013,0,0,0,0,
+  0,0,funcBuckets+2014,funcBuckets+2015,0,0,0,0,
+  0,funcBuckets+2016,0,0,0,0,0,0,
+  0,funcBuckets+2017,0,0,0,0,0,0,
+  funcBuckets+2018,0,0,0,0,funcBuckets+2019,0,0,
+  funcBuckets+2020,0,funcBuckets+2023,0,0,funcBuckets+2024,funcBuckets+2025,0,
+  funcBuckets+2026,funcBuckets+2027,funcBuckets+2028,funcBuckets+2029,0,0,0,0,
+  0,funcBuckets+2030,0,funcBuckets+2031,0,0,0,0,
+  0,0,funcBuckets+2032,0,0,funcBuckets+2034,0,0,
+  0,funcBuckets+2035,0,funcBuckets+2036,funcBuckets+2037,0,0,0,
+  funcBuckets+2038,0,0,funcBuckets+2039,0,0,funcBuckets+2040,0,
+  0,0,0,0,0,funcBuckets+2041,0,funcBuckets+2042,
+  0,0,0,0,0,0,0,funcBuckets+2043,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+2033,0,0,funcBuckets+2035,
-  0,0,0,funcBuckets+2037,funcBuckets+2038,0,0,funcBuckets+2039,
-  funcBuckets+2040,0,funcBuckets+2041,funcBuckets+2042,0,0,funcBuckets+2043,0,
-  0,0,funcBuckets+2045,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+2046,0,0,
-  0,0,funcBuckets+2047,0,funcBuckets+2048,funcBuckets+2050,0,funcBuckets+2051,
-  0,funcBuckets+2052,0,funcBuckets+2053,0,0,0,0,
-  0,0,0,0,0,funcBuckets+2054,0,0,
-  funcBuckets+2055,0,0,0,0,funcBuckets+2056,0,0,
-  0,0,0,0,0,0,funcBuckets+2057,0,
-  0,0,funcBuckets+2058,0,0,0,0,0,
-  0,0,0,0,funcBuckets+2059,0,0,0,
+  0,0,0,0,funcBuckets+2044,0,0,funcBuckets+2046,
+  0,0,0,funcBuckets+2048,funcBuckets+2049,0,0,funcBuckets+2050,
+  funcBuckets+2051,0,funcBuckets+2052,funcBuckets+2053,0,0,funcBuckets+2054,0,
+  0,0,funcBuckets+2056,0,0,0,0,0,
+  0,0,0,0,0,funcBuckets+2057,0,0,
+  0,0,funcBuckets+2058,0,funcBuckets+2059,funcBuckets+2061,0,funcBuckets+2062,
+  0,funcBuckets+2063,0,funcBuckets+2064,0,0,0,0,
+  0,0,0,0,0,funcBuckets+2065,0,0,
+  funcBuckets+2066,0,0,0,0,funcBuckets+2067,0,0,
+  0,0,0,0,0,0,funcBuckets+2068,0,
+  0,0,funcBuckets+2069,0,0,0,0,0,
+  0,0,0,0,funcBuckets+2070,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+2060,
-  0,0,0,funcBuckets+2061,0,0,0,0,
-  0,0,0,funcBuckets+2062,0,0,funcBuckets+2063,0,
-  0,0,funcBuckets+2064,0,0,0,0,0,
-  0,funcBuckets+2065,0,funcBuckets+2066,funcBuckets+2067,0,funcBuckets+2068,0,
-  0,0,funcBuckets+2069,0,0,0,funcBuckets+2070,0,
-  0,funcBuckets+2071,funcBuckets+2072,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+2073,0,
-  0,0,0,funcBuckets+2074,0,0,0,funcBuckets+2075,
-  0,0,0,funcBuckets+2076,0,0,0,0,
-  funcBuckets+2077,0,0,funcBuckets+2078,0,0,0,0,
-  0,0,0,funcBuckets+2079,0,0,0,0,
-  0,0,0,funcBuckets+2080,funcBuckets+2081,0,0,funcBuckets+2082,
-  0,funcBuckets+2083,funcBuckets+2084,0,0,funcBuckets+2085,0,0,
-  funcBuckets+2086,0,funcBuckets+2087,0,0,funcBuckets+2088,0,funcBuckets+2089,
+  0,0,0,0,0,0,0,funcBuckets+2071,
+  0,0,0,funcBuckets+2072,0,0,0,0,
+  0,0,0,funcBuckets+2073,0,0,funcBuckets+2074,0,
+  0,0,funcBuckets+2075,0,0,0,0,0,
+  0,funcBuckets+2076,0,funcBuckets+2077,funcBuckets+2078,0,funcBuckets+2079,0,
+  0,0,funcBuckets+2080,0,0,0,funcBuckets+2081,0,
+  0,funcBuckets+2082,funcBuckets+2083,0,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+2084,0,
+  0,0,0,funcBuckets+2085,0,0,0,funcBuckets+2086,
+  0,0,0,funcBuckets+2087,0,0,0,0,
+  funcBuckets+2088,0,0,funcBuckets+2089,0,0,0,0,
+  0,0,0,funcBuckets+2090,0,0,0,0,
+  0,0,0,funcBuckets+2091,funcBuckets+2092,0,0,funcBuckets+2093,
+  0,funcBuckets+2094,funcBuckets+2095,0,0,funcBuckets+2096,0,0,
+  funcBuckets+2097,0,funcBuckets+2098,0,0,funcBuckets+2099,0,funcBuckets+2100,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+2090,0,
-  funcBuckets+2091,funcBuckets+2092,funcBuckets+2093,funcBuckets+2094,0,0,0,0,
-  0,funcBuckets+2095,0,funcBuckets+2096,funcBuckets+2098,0,0,0,
-  funcBuckets+2099,0,0,0,funcBuckets+2100,0,0,0,
-  funcBuckets+2101,0,funcBuckets+2102,0,0,0,0,0,
-  0,funcBuckets+2103,0,funcBuckets+2104,0,0,0,0,
-  funcBuckets+2105,funcBuckets+2106,funcBuckets+2107,0,0,0,0,0,
-  0,0,0,0,0,0,0,funcBuckets+2108,
-  0,funcBuckets+2110,0,funcBuckets+2111,0,0,0,0,
-  0,0,0,funcBuckets+2112,0,0,0,funcBuckets+2113,
-  0,funcBuckets+2114,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+2116,0,0,0,
-  0,0,funcBuckets+2118,0,0,0,0,0,
-  0,funcBuckets+2120,0,0,0,0,0,0,
-  0,0,0,0,funcBuckets+2121,0,0,0,
+  0,0,0,0,0,0,funcBuckets+2101,0,
+  funcBuckets+2102,funcBuckets+2103,funcBuckets+2104,funcBuckets+2105,0,0,0,0,
+  0,funcBuckets+2106,0,funcBuckets+2107,funcBuckets+2109,0,0,0,
+  funcBuckets+2110,0,0,0,funcBuckets+2111,0,0,0,
+  funcBuckets+2112,0,funcBuckets+2113,0,0,0,0,0,
+  0,funcBuckets+2114,0,funcBuckets+2115,0,0,0,0,
+  funcBuckets+2116,funcBuckets+2117,funcBuckets+2118,0,0,0,0,0,
+  0,0,0,0,0,0,0,funcBuckets+2119,
+  0,funcBuckets+2121,0,funcBuckets+2122,0,0,0,0,
+  0,0,0,funcBuckets+2123,0,0,0,funcBuckets+2124,
+  0,funcBuckets+2125,0,0,0,0,0,0,
+  0,0,0,0,funcBuckets+2127,0,0,0,
+  0,0,funcBuckets+2129,0,0,0,0,0,
+  0,funcBuckets+2131,0,0,0,0,0,0,
+  0,0,0,0,funcBuckets+2132,0,0,0,
   0,0,0,0,0,0,0,0,
-  0,0,0,0,0,funcBuckets+2122,0,0,
-  funcBuckets+2123,0,0,funcBuckets+2124,0,funcBuckets+2125,0,0,
-  0,0,0,0,funcBuckets+2126,0,0,0,
-  0,0,0,funcBuckets+2128,funcBuckets+2129,0,0,0,
-  0,0,funcBuckets+2130,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+2131,0,
-  funcBuckets+2132,0,0,0,funcBuckets+2133,0,funcBuckets+2134,0,
-  0,0,0,funcBuckets+2135,0,0,funcBuckets+2136,funcBuckets+2137,
-  0,funcBuckets+2138,0,0,0,funcBuckets+2139,0,funcBuckets+2140,
-  funcBuckets+2141,0,funcBuckets+2142,0,0,funcBuckets+2143,0,0,
-  0,0,0,0,funcBuckets+2144,0,funcBuckets+2145,0,
-  0,0,0,0,0,0,funcBuckets+2146,0,
-  0,funcBuckets+2147,0,0,0,0,0,funcBuckets+2148,
-  funcBuckets+2149,0,0,0,0,0,0,0,
-  0,funcBuckets+2150,funcBuckets+2151,0,0,0,0,0,
-  0,0,0,0,0,0,funcBuckets+2152,0,
-  funcBuckets+2153,0,0,0,0,0,funcBuckets+2154,0,
-  funcBuckets+2155,0,0,0,0,funcBuckets+2156,funcBuckets+2157,0,
+  0,0,0,0,0,funcBuckets+2133,0,0,
+  funcBuckets+2134,0,0,funcBuckets+2135,0,funcBuckets+2136,0,0,
+  0,0,0,0,funcBuckets+2137,0,0,0,
+  0,0,0,funcBuckets+2139,funcBuckets+2140,0,0,0,
+  0,0,funcBuckets+2141,0,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+2142,0,
+  funcBuckets+2143,0,0,0,funcBuckets+2144,0,funcBuckets+2145,0,
+  0,0,0,funcBuckets+2146,0,0,funcBuckets+2147,funcBuckets+2148,
+  0,funcBuckets+2149,0,0,0,funcBuckets+2150,0,funcBuckets+2151,
+  funcBuckets+2152,0,funcBuckets+2153,0,0,funcBuckets+2154,0,0,
+  0,0,0,0,funcBuckets+2155,0,funcBuckets+2156,0,
+  0,0,0,0,0,0,funcBuckets+2157,0,
+  0,funcBuckets+2158,0,0,0,0,0,funcBuckets+2159,
+  funcBuckets+2160,0,0,0,0,0,0,0,
+  0,funcBuckets+2161,funcBuckets+2162,0,0,0,0,0,
+  0,0,0,0,0,0,funcBuckets+2163,0,
+  funcBuckets+2164,0,0,0,0,0,funcBuckets+2165,0,
+  funcBuckets+2166,0,0,0,0,funcBuckets+2167,funcBuckets+2168,0,
   0,0,0,0,0,0,0,0,
-  funcBuckets+2159,0,0,funcBuckets+2160,0,0,0,funcBuckets+2161,
-  0,0,0,0,0,0,funcBuckets+2162,0,
-  0,0,funcBuckets+2163,funcBuckets+2164,0,0,0,0,
+  funcBuckets+2170,0,0,funcBuckets+2171,0,0,0,funcBuckets+2172,
+  0,0,0,0,0,0,funcBuckets+2173,0,
+  0,0,funcBuckets+2174,funcBuckets+2175,0,0,0,0,
 
 };
 static inline const hashNodeFunc *findFunc(const char *name, int64 hash) {
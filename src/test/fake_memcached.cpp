@@ -0,0 +1,271 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include <test/fake_memcached.h>
+#include <util/timer.h>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <deque>
+
+using namespace HPHP;
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+struct Reply {
+  Reply(int64 d) : due(d), hangup(false) {}
+  int64 due;
+  std::string data;
+  bool hangup;  // close the connection once this is written
+};
+}
+
+struct FakeMemcached::Client {
+  Client(int f) : fd(f), closing(false), hangup(false) {}
+  int fd;
+  bool closing;
+  bool hangup;
+  std::string in;
+  std::deque<Reply> replies;
+  std::string out;  // replies that are due, not yet written
+};
+
+FakeMemcached::FakeMemcached(int latencyUs /* = 0 */)
+  : m_latencyUs(latencyUs), m_dropGets(false), m_port(0), m_listen(-1),
+    m_thread(this, &FakeMemcached::run) {
+  m_wake[0] = m_wake[1] = -1;
+}
+
+FakeMemcached::~FakeMemcached() {
+  stop();
+}
+
+void FakeMemcached::preload(const std::string &key, const std::string &value,
+                            uint32 flags /* = 0 */) {
+  m_data[key] = std::make_pair(flags, value);
+}
+
+int FakeMemcached::start() {
+  m_listen = socket(AF_INET, SOCK_STREAM, 0);
+  if (m_listen < 0) return 0;
+  int one = 1;
+  setsockopt(m_listen, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  socklen_t len = sizeof(addr);
+  if (bind(m_listen, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      listen(m_listen, 128) < 0 ||
+      getsockname(m_listen, (struct sockaddr *)&addr, &len) < 0 ||
+      pipe(m_wake) < 0) {
+    close(m_listen);
+    m_listen = -1;
+    return 0;
+  }
+  fcntl(m_listen, F_SETFL, fcntl(m_listen, F_GETFL) | O_NONBLOCK);
+  m_port = ntohs(addr.sin_port);
+  m_thread.start();
+  return m_port;
+}
+
+void FakeMemcached::stop() {
+  if (m_listen < 0) return;
+  if (write(m_wake[1], "x", 1) < 0) {
+    // the thread will still notice once its poll times out
+  }
+  m_thread.waitForEnd();
+  close(m_listen);
+  close(m_wake[0]);
+  close(m_wake[1]);
+  m_listen = -1;
+}
+
+/*
+ * Handles every complete command in client.in. Returns false on "quit" or
+ * a command it doesn't know.
+ */
+bool FakeMemcached::process(Client &client, int64 now) {
+  while (true) {
+    size_t eol = client.in.find("\r\n");
+    if (eol == std::string::npos) return true;
+
+    std::vector<std::string> words;
+    size_t p = 0;
+    while (p < eol) {
+      size_t q = client.in.find(' ', p);
+      if (q == std::string::npos || q > eol) q = eol;
+      if (q > p) words.push_back(client.in.substr(p, q - p));
+      p = q + 1;
+    }
+    if (words.empty()) {
+      client.in.erase(0, eol + 2);
+      continue;
+    }
+
+    const std::string &cmd = words[0];
+    Reply reply(now + m_latencyUs);
+    if (cmd == "get" || cmd == "gets") {
+      for (unsigned int i = 1; i < words.size(); i++) {
+        hphp_string_map<std::pair<uint32, std::string> >::const_iterator it =
+          m_data.find(words[i]);
+        if (it == m_data.end()) continue;
+        char header[320];
+        int n = snprintf(header, sizeof(header), "VALUE %s %u %d",
+                         words[i].c_str(), it->second.first,
+                         (int)it->second.second.size());
+        reply.data.append(header, n);
+        if (cmd == "gets") reply.data.append(" 1");
+        reply.data.append("\r\n");
+        reply.data.append(it->second.second);
+        reply.data.append("\r\n");
+      }
+      reply.data.append("END\r\n");
+      client.in.erase(0, eol + 2);
+      if (m_dropGets) {
+        reply.data.resize(reply.data.size() / 2);
+        reply.hangup = true;
+      }
+    } else if (cmd == "set" || cmd == "add" || cmd == "replace") {
+      if (words.size() < 5) return false;
+      size_t bytes = atoi(words[4].c_str());
+      if (client.in.size() < eol + 2 + bytes + 2) return true;
+      bool exists = m_data.find(words[1]) != m_data.end();
+      if ((cmd == "add" && exists) || (cmd == "replace" && !exists)) {
+        reply.data = "NOT_STORED\r\n";
+      } else {
+        m_data[words[1]] =
+          std::make_pair((uint32)strtoul(words[2].c_str(), NULL, 10),
+                         client.in.substr(eol + 2, bytes));
+        reply.data = "STORED\r\n";
+      }
+      client.in.erase(0, eol + 2 + bytes + 2);
+      if (words.size() > 5 && words[5] == "noreply") continue;
+    } else if (cmd == "delete") {
+      if (words.size() < 2) return false;
+      reply.data = m_data.erase(words[1]) ? "DELETED\r\n" : "NOT_FOUND\r\n";
+      client.in.erase(0, eol + 2);
+    } else if (cmd == "flush_all") {
+      m_data.clear();
+      reply.data = "OK\r\n";
+      client.in.erase(0, eol + 2);
+    } else if (cmd == "version") {
+      reply.data = "VERSION 1.4.5\r\n";
+      client.in.erase(0, eol + 2);
+    } else {
+      return false;
+    }
+    client.replies.push_back(reply);
+  }
+}
+
+void FakeMemcached::run() {
+  std::vector<Client*> clients;
+  std::vector<struct pollfd> fds;
+
+  while (true) {
+    int64 now = Timer::GetCurrentTimeMicros();
+    int64 next = -1;
+    for (unsigned int i = 0; i < clients.size(); i++) {
+      Client &c = *clients[i];
+      while (!c.hangup && !c.replies.empty() &&
+             c.replies.front().due <= now) {
+        c.out.append(c.replies.front().data);
+        if (c.replies.front().hangup) c.hangup = true;
+        c.replies.pop_front();
+      }
+      if (!c.replies.empty() &&
+          (next < 0 || c.replies.front().due < next)) {
+        next = c.replies.front().due;
+      }
+    }
+
+    fds.clear();
+    struct pollfd pfd;
+    pfd.fd = m_wake[0];
+    pfd.events = POLLIN;
+    fds.push_back(pfd);
+    pfd.fd = m_listen;
+    fds.push_back(pfd);
+    for (unsigned int i = 0; i < clients.size(); i++) {
+      pfd.fd = clients[i]->fd;
+      pfd.events = clients[i]->out.empty() ? POLLIN : (POLLIN | POLLOUT);
+      fds.push_back(pfd);
+    }
+    for (unsigned int i = 0; i < fds.size(); i++) fds[i].revents = 0;
+
+    int timeout = next < 0 ? 1000 : (int)((next - now + 999) / 1000);
+    if (poll(&fds[0], fds.size(), timeout) < 0 && errno != EINTR) break;
+    if (fds[0].revents) break;
+
+    if (fds[1].revents & POLLIN) {
+      int fd;
+      while ((fd = accept(m_listen, NULL, NULL)) >= 0) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        clients.push_back(new Client(fd));
+      }
+    }
+
+    now = Timer::GetCurrentTimeMicros();
+    for (unsigned int i = 2; i < fds.size(); i++) {
+      Client &c = *clients[i - 2];
+      if (fds[i].revents & POLLIN) {
+        char buf[64 * 1024];
+        ssize_t n = recv(c.fd, buf, sizeof(buf), 0);
+        if (n <= 0) {
+          c.closing = true;
+        } else {
+          c.in.append(buf, n);
+          if (!process(c, now)) c.closing = true;
+        }
+      }
+      if ((fds[i].revents & POLLOUT) && !c.out.empty()) {
+        ssize_t n = send(c.fd, c.out.data(), c.out.size(), MSG_NOSIGNAL);
+        if (n > 0) {
+          c.out.erase(0, n);
+        } else if (errno != EAGAIN) {
+          c.closing = true;
+        }
+      }
+      if (fds[i].revents & (POLLERR | POLLHUP)) c.closing = true;
+      if (c.hangup && c.out.empty()) c.closing = true;
+    }
+
+    unsigned int kept = 0;
+    for (unsigned int i = 0; i < clients.size(); i++) {
+      if (clients[i]->closing) {
+        close(clients[i]->fd);
+        delete clients[i];
+      } else {
+        clients[kept++] = clients[i];
+      }
+    }
+    clients.resize(kept);
+  }
+
+  for (unsigned int i = 0; i < clients.size(); i++) {
+    close(clients[i]->fd);
+    delete clients[i];
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
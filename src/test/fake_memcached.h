@@ -0,0 +1,82 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef __TEST_FAKE_MEMCACHED_H__
+#define __TEST_FAKE_MEMCACHED_H__
+
+#include <util/base.h>
+#include <util/async_func.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * In-process stand-in for a memcached server, so memcache client
+ * benchmarks don't need real servers. Speaks enough of the text protocol
+ * for the Memcache extension: get/gets, set/add/replace, delete,
+ * flush_all, version and quit.
+ *
+ * Every reply is held back by the configured latency, measured from when
+ * the request arrived, to look like a server across a network. Replies on
+ * different connections overlap, as they would on a real server.
+ *
+ * For client tests it can also be preloaded, and made to hang up half way
+ * through every get reply, like a server dying mid-response.
+ */
+class FakeMemcached {
+public:
+  explicit FakeMemcached(int latencyUs = 0);
+  ~FakeMemcached();
+
+  /**
+   * Listens on an ephemeral port on 127.0.0.1 and starts serving. Returns
+   * the port, or 0 on failure.
+   */
+  int start();
+  void stop();
+
+  int port() const { return m_port; }
+
+  /**
+   * Stores a value as "set" would. Call before start().
+   */
+  void preload(const std::string &key, const std::string &value,
+               HPHP::uint32 flags = 0);
+
+  /**
+   * Sends only the first half of each get reply, then closes the
+   * connection. Call before start().
+   */
+  void dropGetReplies() { m_dropGets = true; }
+
+  void run();
+
+private:
+  struct Client;
+
+  int m_latencyUs;
+  bool m_dropGets;
+  int m_port;
+  int m_listen;
+  int m_wake[2];
+  HPHP::hphp_string_map<std::pair<HPHP::uint32, std::string> > m_data;
+  HPHP::AsyncFunc<FakeMemcached> m_thread;
+
+  bool process(Client &client, HPHP::int64 now);
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // __TEST_FAKE_MEMCACHED_H__
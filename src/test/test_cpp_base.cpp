@@ -19,6 +19,7 @@
 #include <util/logger.h>
 #include <runtime/base/memory/memory_manager.h>
 #include <runtime/base/builtin_functions.h>
+#include <runtime/base/program_functions.h>
 #include <runtime/ext/ext_variable.h>
 #include <runtime/ext/ext_apc.h>
 #include <runtime/ext/ext_mysql.h>
@@ -26,6 +27,11 @@
 #include <runtime/base/shared/shared_store_base.h>
 #include <runtime/base/runtime_option.h>
 #include <runtime/base/server/ip_block_map.h>
+#include <runtime/base/server/server_stats.h>
+#include <runtime/base/server/stack_sampler.h>
+#include <runtime/base/memory/heap_profiler.h>
+#include <runtime/base/timeout_thread.h>
+#include <util/async_func.h>
 #include <test/test_mysql_info.inc>
 #include <system/lib/systemlib.h>
 
@@ -39,11 +45,16 @@ TestCppBase::TestCppBase() {
 bool TestCppBase::RunTests(const std::string &which) {
   bool ret = true;
   RUN_TEST(TestSmartAllocator);
+  RUN_TEST(TestLastPeakUsage);
   RUN_TEST(TestString);
   RUN_TEST(TestArray);
   RUN_TEST(TestObject);
   RUN_TEST(TestVariant);
   RUN_TEST(TestIpBlockMap);
+  RUN_TEST(TestServerStats);
+  RUN_TEST(TestStackSampler);
+  RUN_TEST(TestHeapProfiler);
+  RUN_TEST(TestTimeoutThread);
   RUN_TEST(TestEqualAsStr);
   return ret;
 }
@@ -124,6 +135,47 @@ bool TestCppBase::TestSmartAllocator() {
 ///////////////////////////////////////////////////////////////////////////////
 // data types
 
+namespace {
+/*
+ * One request on a thread of its own, started and ended the way a server
+ * thread does it.
+ */
+class PeakUsageRequest {
+public:
+  PeakUsageRequest() : usage(0), lastPeak(0), peakAfter(-1) {}
+
+  void run() {
+    hphp_session_init();
+    MemoryManager *mm = MemoryManager::TheMemoryManager().getNoCheck();
+    ExecutionContext *context = hphp_context_init();
+    {
+      Array arr;
+      for (int i = 0; i < 10000; i++) arr.append(i);
+      usage = mm->getStats(true).usage;
+    }
+    hphp_context_exit(context, false);
+    hphp_session_exit();
+    lastPeak = mm->getLastPeakUsage();
+    peakAfter = mm->getStats().peakUsage;
+  }
+
+  int64 usage;
+  int64 lastPeak;
+  int64 peakAfter;
+};
+}
+
+bool TestCppBase::TestLastPeakUsage() {
+  // what the replay benchmark reports: the stats are reset at the end of
+  // the request, but its peak is kept
+  PeakUsageRequest req;
+  AsyncFunc<PeakUsageRequest>(&req, &PeakUsageRequest::run).run();
+  VERIFY(req.usage > 0);
+  VERIFY(req.lastPeak >= req.usage);
+  VS(req.peakAfter, 0);
+  return Count(true);
+}
+
 bool TestCppBase::TestString() {
   // constructors
   {
@@ -955,6 +1007,306 @@ bool TestCppBase::TestIpBlockMap() {
   return Count(true);
 }
 
+bool TestCppBase::TestServerStats() {
+  bool enableStats = RuntimeOption::EnableStats;
+  bool enableWebStats = RuntimeOption::EnableWebStats;
+  RuntimeOption::EnableStats = RuntimeOption::EnableWebStats = true;
+  ServerStats::GetLogger();
+
+  int counter = ServerStats::Register("test.counter");
+  VERIFY(counter >= 0);
+  VS(ServerStats::Register("test.counter"), counter);
+  ServerStats::Reset();
+  ServerStats::Log(counter, 5);
+  ServerStats::Log(counter, 7);
+  VS(ServerStats::Get(counter), 12);
+  VS(ServerStats::Get("test.counter"), 12);
+  ServerStats::Reset();
+  VS(ServerStats::Get(counter), 0);
+
+  int histogram = ServerStats::RegisterHistogram("test.histogram");
+  VERIFY(histogram >= 0);
+  for (int i = 1; i <= 10000; i++) {
+    ServerStats::LogHistogram(histogram, i);
+  }
+  VS(ServerStats::GetCount(histogram), 10000);
+  // buckets are good to about 3%
+  int64 p50 = ServerStats::GetPercentile(histogram, 50);
+  int64 p99 = ServerStats::GetPercentile(histogram, 99);
+  VERIFY(p50 >= 4850 && p50 <= 5150);
+  VERIFY(p99 >= 9600 && p99 <= 10000);
+  ServerStats::Clear();
+  VS(ServerStats::GetCount(histogram), 0);
+
+  RuntimeOption::EnableStats = enableStats;
+  RuntimeOption::EnableWebStats = enableWebStats;
+  return Count(true);
+}
+
+/*
+ * The count on stack's line of a folded stack report, 0 if it has none.
+ */
+static int64 folded_count(const std::string &report, const std::string &stack) {
+  std::string prefix = stack + " ";
+  size_t pos = 0;
+  while (pos < report.size()) {
+    size_t eol = report.find('\n', pos);
+    if (eol == std::string::npos) eol = report.size();
+    if (report.compare(pos, prefix.size(), prefix) == 0) {
+      return atoll(report.c_str() + pos + prefix.size());
+    }
+    pos = eol + 1;
+  }
+  return 0;
+}
+
+bool TestCppBase::TestStackSampler() {
+  ThreadInfo *info = ThreadInfo::s_threadInfo.getNoCheck();
+  const char *frames[StackSampler::MaxDepth];
+
+  VS(StackSampler::CollectFrames(info, frames, StackSampler::MaxDepth), 1);
+  VS(frames[0], "[no frames]");
+  if (!hhvm) {
+    FIFunctionNoMem outer("outer");
+    FIFunctionNoMem inner("inner");
+    VS(StackSampler::CollectFrames(info, frames, StackSampler::MaxDepth), 2);
+    VS(frames[0], "inner");
+    VS(frames[1], "outer");
+    VS(StackSampler::CollectFrames(info, frames, 1), 1);
+    VS(frames[0], "inner");
+  }
+
+  // samples are taken by hand; the timer is too slow to fire meanwhile
+  int intervalMs = RuntimeOption::StackSamplerIntervalMs;
+  RuntimeOption::StackSamplerIntervalMs = 600000;
+  StackSampler::Restart();
+
+  // a ring's worth and more before anything drains it: whatever doesn't
+  // fit is counted as dropped
+  const int count = StackSampler::RingSize + 10;
+  StackSampler::StartRequest("/a.php");
+  for (int i = 0; i < count; i++) StackSampler::Sample(info);
+  std::string report;
+  StackSampler::Report(report);
+  int64 a = folded_count(report, "/a.php;[no frames]");
+  VERIFY(a >= StackSampler::RingSize);
+  VS(a + folded_count(report, "[dropped]"), count);
+
+  // counts add up across reports, per url
+  StackSampler::StartRequest("/b.php");
+  StackSampler::Sample(info);
+  StackSampler::Sample(info);
+  StackSampler::EndRequest();
+  StackSampler::Sample(info); // between requests, not counted
+  report.clear();
+  StackSampler::Report(report);
+  VS(folded_count(report, "/a.php;[no frames]"), a);
+  VS(folded_count(report, "/b.php;[no frames]"), 2);
+
+  StackSampler::Clear();
+  report.clear();
+  StackSampler::Report(report);
+  VERIFY(report.empty());
+
+  StackSampler::Stop();
+  RuntimeOption::StackSamplerIntervalMs = intervalMs;
+  StackSampler::Restart();
+  return Count(true);
+}
+
+namespace {
+/*
+ * Turns the heap profiler on with the given sampling interval while in
+ * scope, starting and ending with nothing collected.
+ */
+class HeapProfilerScope {
+public:
+  explicit HeapProfilerScope(int64 sampleBytes)
+    : m_sampleBytes(RuntimeOption::HeapProfilerSampleBytes) {
+    RuntimeOption::HeapProfilerSampleBytes = sampleBytes;
+    HeapProfiler::Restart();
+    HeapProfiler::Clear();
+  }
+  ~HeapProfilerScope() {
+    HeapProfiler::EndRequest();
+    HeapProfiler::Clear();
+    RuntimeOption::HeapProfilerSampleBytes = m_sampleBytes;
+    HeapProfiler::Restart();
+  }
+
+private:
+  int64 m_sampleBytes;
+};
+}
+
+bool TestCppBase::TestHeapProfiler() {
+  // Nothing is checked while a request is sampling: Variants and Strings
+  // are smart allocated, and would be sampled along with the fake objects.
+  HeapProfilerScope scope(1024);
+  const int64 mb = 1 << 20;
+  void *p1 = (void*)0x10000, *p2 = (void*)0x20000, *p3 = (void*)0x30000;
+  std::string report;
+
+  // small objects are rarely sampled, but each sample stands for enough
+  // bytes that the estimate comes out near what was really allocated
+  const int64 small = 64, count = 100000;
+  HeapProfiler::StartRequest("/w.php");
+  for (int64 i = 0; i < count; i++) HeapProfiler::OnAlloc(NULL, small);
+  HeapProfiler::EndRequest();
+  HeapProfiler::ReportAllocated(report);
+  int64 estimate = folded_count(report, "/w.php;[no frames]");
+  VERIFY(estimate > small * count * 9 / 10 &&
+         estimate < small * count * 11 / 10);
+  HeapProfiler::Clear();
+
+  // objects much bigger than the interval are always sampled, at their
+  // own size; the peak is the live heap at its high, not at the end
+  std::string live2, live1, liveEnd, pprof;
+  HeapProfiler::StartRequest("/p.php");
+  HeapProfiler::OnAlloc(p1, mb);
+  HeapProfiler::OnAlloc(p2, mb);
+  HeapProfiler::ReportLive(live2);
+  HeapProfiler::OnFree(p1);
+  HeapProfiler::OnFree((void*)0x40000); // never sampled
+  HeapProfiler::ReportLive(live1);
+  HeapProfiler::OnFree(p2);
+  HeapProfiler::OnAlloc(p3, mb);
+  HeapProfiler::EndRequest();
+  HeapProfiler::OnFree(p3); // went with the request
+  HeapProfiler::ReportLive(liveEnd);
+
+  // a second request's peak adds to the first's
+  HeapProfiler::StartRequest("/q.php");
+  HeapProfiler::OnAlloc(p1, mb);
+  HeapProfiler::ReportPprof(pprof);
+  HeapProfiler::EndRequest();
+
+  VS(live2, "/p.php;[no frames] 2097152\n");
+  VS(live1, "/p.php;[no frames] 1048576\n");
+  VS(liveEnd, "");
+  report.clear();
+  HeapProfiler::ReportAllocated(report);
+  VS(report, "/p.php;[no frames] 3145728\n/q.php;[no frames] 1048576\n");
+  report.clear();
+  HeapProfiler::ReportPeak(report);
+  VS(report, "/p.php;[no frames] 2097152\n/q.php;[no frames] 1048576\n");
+
+  // pprof: /p.php is done and only allocated, /q.php is still live;
+  // frames get made up addresses in the order they're first seen,
+  // innermost first, and are listed one byte back too
+  VS(pprof.substr(0, 23), "--- symbol\nbinary=hhvm\n");
+  VERIFY(pprof.find("\n0x20 [no frames]\n") != std::string::npos);
+  VERIFY(pprof.find("\n0x1f [no frames]\n") != std::string::npos);
+  VERIFY(pprof.find("\n0x30 /p.php\n") != std::string::npos);
+  VERIFY(pprof.find("\n0x2f /p.php\n") != std::string::npos);
+  VERIFY(pprof.find("\n0x40 /q.php\n") != std::string::npos);
+  VERIFY(pprof.find("\n0x3f /q.php\n") != std::string::npos);
+  std::string heap =
+    "---\n--- heap\n"
+    "heap profile: 1: 1048576 [3: 3145728] @ heapprofile\n"
+    "0: 0 [3: 3145728] @ 0x20 0x30\n"
+    "1: 1048576 [0: 0] @ 0x20 0x40\n";
+  VERIFY(pprof.size() > heap.size());
+  VS(pprof.substr(pprof.size() - heap.size()), heap);
+
+  HeapProfiler::Clear();
+  report.clear();
+  HeapProfiler::ReportAllocated(report);
+  HeapProfiler::ReportPeak(report);
+  VS(report, "");
+  return Count(true);
+}
+
+namespace {
+/*
+ * Puts this thread under a TimeoutThread of its own while in scope.
+ */
+class TimeoutThreadScope {
+public:
+  explicit TimeoutThreadScope(RequestInjectionData &data)
+    : m_data(data), m_timeoutMs(data.timeoutMs), m_thread(1, 0),
+      m_func(&m_thread, &TimeoutThread::run) {
+    m_thread.registerRequestThread(&data);
+    m_func.start();
+  }
+  ~TimeoutThreadScope() {
+    TimeoutThread::SetTimeoutMs(0);
+    TimeoutThread::SetCpuTimeoutMs(0);
+    m_thread.stop();
+    m_func.waitForEnd();
+    m_data.timeoutThread = NULL;
+    m_data.timeoutMs = m_timeoutMs;
+    m_data.fetchAndClearFlags();
+  }
+
+private:
+  RequestInjectionData &m_data;
+  int64 m_timeoutMs;
+  TimeoutThread m_thread;
+  AsyncFunc<TimeoutThread> m_func;
+};
+}
+
+static bool timed_out(RequestInjectionData &data) {
+  return data.conditionFlags & RequestInjectionData::TimedOutFlag;
+}
+
+bool TestCppBase::TestTimeoutThread() {
+  RequestInjectionData &data = ThreadInfo::s_threadInfo->m_reqInjectionData;
+  // slack for the timeout thread to get scheduled
+  const int64 slackMs = 10;
+
+  // with nobody to enforce a deadline, there's nothing to cut I/O down to
+  TimeoutThread::SetTimeoutMs(1000);
+  VS(TimeoutThread::GetRemainingMs(), -1);
+  VS(TimeoutThread::ClampTimeoutMs(5000), 5000);
+  TimeoutThread::SetTimeoutMs(0);
+
+  TimeoutThreadScope scope(data);
+  data.fetchAndClearFlags();
+
+  // a deadline more than a turn of the wheel away
+  TimeoutThread::SetTimeoutMs(10000);
+  int64 left = TimeoutThread::GetRemainingMs();
+  VERIFY(left > 9000 && left <= 10000);
+  VS(TimeoutThread::ClampTimeoutMs(5000), 5000);
+  VERIFY(TimeoutThread::ClampTimeoutMs(20000) <= 10000);
+  usleep(20000); // let the timeout thread go to sleep on it
+  VERIFY(!timed_out(data));
+
+  // brought in, which has to wake the timeout thread up
+  int64 start = TimeoutThread::Now();
+  TimeoutThread::SetTimeoutMs(50);
+  while (!timed_out(data) && TimeoutThread::Now() < start + 1000) {
+    usleep(1000);
+  }
+  int64 end = TimeoutThread::Now();
+  VERIFY(timed_out(data));
+  VERIFY(end >= start + 50 && end <= start + 50 + slackMs);
+  TimeoutThread::SetTimeoutMs(0);
+  data.fetchAndClearFlags();
+
+  // a CPU time limit doesn't run out while the thread is blocked
+  TimeoutThread::SetCpuTimeoutMs(50);
+  usleep(100000);
+  VERIFY(!timed_out(data));
+  int64 cpuLeft = TimeoutThread::GetCpuRemainingMs();
+  VERIFY(cpuLeft > 0 && cpuLeft <= 50);
+
+  // but does once the thread has spent it
+  int64 cpuStart = TimeoutThread::CpuNow(data.cpuClock);
+  int64 cpuDeadline = cpuStart + cpuLeft;
+  while (!timed_out(data) &&
+         TimeoutThread::CpuNow(data.cpuClock) < cpuStart + 1000) {
+  }
+  int64 cpu = TimeoutThread::CpuNow(data.cpuClock);
+  VERIFY(timed_out(data));
+  VERIFY(cpu >= cpuDeadline && cpu <= cpuDeadline + slackMs);
+  VS(TimeoutThread::GetCpuRemainingMs(), 0);
+
+  return Count(true);
+}
+
 bool TestCppBase::TestEqualAsStr() {
 
   const int arr_len = 18;
@@ -39,7 +39,12 @@ class TestCppBase : public TestBase {
 
   // building blocks
   bool TestSmartAllocator();
+  bool TestLastPeakUsage();
   bool TestIpBlockMap();
+  bool TestServerStats();
+  bool TestHeapProfiler();
+  bool TestStackSampler();
+  bool TestTimeoutThread();
 
   /**
    * Date types. This in turn tests StringData, ArrayData, StringOffset,
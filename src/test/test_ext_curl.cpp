@@ -87,6 +87,7 @@ bool TestExtCurl::RunTests(const std::string &which) {
   RUN_TEST(test_curl_multi_remove_handle);
   RUN_TEST(test_curl_multi_exec);
   RUN_TEST(test_curl_multi_select);
+  RUN_TEST(test_fb_curl_multi_await);
   RUN_TEST(test_curl_multi_getcontent);
   RUN_TEST(test_curl_multi_info_read);
   RUN_TEST(test_curl_multi_close);
@@ -258,6 +259,32 @@ bool TestExtCurl::test_curl_multi_select() {
   return Count(true);
 }
 
+bool TestExtCurl::test_fb_curl_multi_await() {
+  Object mh = f_curl_multi_init();
+  Variant c1 = f_curl_init(String(get_request_uri()));
+  Variant c2 = f_curl_init(String(get_request_uri()));
+  f_curl_setopt(c1, k_CURLOPT_RETURNTRANSFER, true);
+  f_curl_setopt(c2, k_CURLOPT_RETURNTRANSFER, true);
+  f_curl_multi_add_handle(mh, c1);
+  f_curl_multi_add_handle(mh, c2);
+
+  int finished = 0;
+  for (int i = 0; i < 10 && finished < 2; i++) {
+    Array done = f_fb_curl_multi_await(mh, 1.0).toArray();
+    for (ArrayIter iter(done); iter; ++iter) {
+      Array info = iter.second().toArray();
+      VS(info["result"], 0);
+      VERIFY(same(info["handle"], c1) || same(info["handle"], c2));
+      finished++;
+    }
+  }
+  VS(finished, 2);
+  VS(f_curl_multi_getcontent(c1), "OK");
+  VS(f_curl_multi_getcontent(c2), "OK");
+  VS(f_fb_curl_multi_await(mh, 0.01), Array::Create());
+  return Count(true);
+}
+
 bool TestExtCurl::test_curl_multi_getcontent() {
   Object mh = f_curl_multi_init();
   Variant c1 = f_curl_init(String(get_request_uri()));
@@ -16,6 +16,11 @@
 
 #include <test/test_ext_memcache.h>
 #include <runtime/ext/ext_memcache.h>
+#include <runtime/ext/ext_options.h>
+#include <runtime/ext/ext_variable.h>
+#include <runtime/ext/ext_zlib.h>
+#include <test/fake_memcached.h>
+#include <util/timer.h>
 
 IMPLEMENT_SEP_EXTENSION_TEST(Memcache);
 ///////////////////////////////////////////////////////////////////////////////
@@ -29,6 +34,8 @@ bool TestExtMemcache::RunTests(const std::string &which) {
   RUN_TEST(test_memcache_set);
   RUN_TEST(test_memcache_replace);
   RUN_TEST(test_memcache_get);
+  RUN_TEST(test_memcache_get_dropped_server);
+  RUN_TEST(test_memcache_get_timeout);
   RUN_TEST(test_memcache_delete);
   RUN_TEST(test_memcache_increment);
   RUN_TEST(test_memcache_decrement);
@@ -49,6 +56,57 @@ bool TestExtMemcache::RunTests(const std::string &which) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+#define KEY_COUNT 40
+
+static String key_name(int i) {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "key%d", i);
+  return String(buf, CopyString);
+}
+
+static String key_value(int i) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "value %d", i);
+  return String(buf, CopyString);
+}
+
+static Array all_keys() {
+  Array keys;
+  for (int i = 0; i < KEY_COUNT; i++) keys.append(key_name(i));
+  return keys;
+}
+
+/*
+ * Starts a fake server and adds it to mc, with a short connect timeout so
+ * a slow server can't stretch a get past its op timeout. With preload, the
+ * server gets every key up front, for servers too slow to fill with set().
+ */
+static bool add_fake_server(p_Memcache mc, FakeMemcached &server,
+                            bool preload) {
+  if (preload) {
+    for (int i = 0; i < KEY_COUNT; i++) {
+      server.preload(key_name(i).data(), key_value(i).data());
+    }
+  }
+  int port = server.start();
+  return port && mc->t_connect("127.0.0.1", port, 0, 100);
+}
+
+/*
+ * Whatever came back has the right values, and is some but not all of the
+ * keys: the ones on the servers that answered.
+ */
+static bool some_keys(CArrRef got) {
+  if (got.size() == 0 || got.size() >= KEY_COUNT) return false;
+  for (ArrayIter iter(got); iter; ++iter) {
+    String key = iter.first().toString();
+    if (!same(iter.second(), key_value(atoi(key.data() + 3)))) return false;
+  }
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool TestExtMemcache::test_memcache_connect() {
   return Count(true);
 }
@@ -70,6 +128,85 @@ bool TestExtMemcache::test_memcache_replace() {
 }
 
 bool TestExtMemcache::test_memcache_get() {
+  FakeMemcached servers[3];
+  p_Memcache mc(NEWOBJ(c_Memcache)());
+  for (int i = 0; i < 3; i++) {
+    VERIFY(add_fake_server(mc, servers[i], false));
+  }
+  for (int i = 0; i < KEY_COUNT; i++) {
+    VERIFY(mc->t_set(key_name(i), key_value(i)));
+  }
+  // compressed, and compressed after serializing
+  Array row = CREATE_MAP2("id", 7, "name", "user 7");
+  VERIFY(mc->t_set("zipped", f_gzcompress(key_value(7)), 2));
+  VERIFY(mc->t_set("zipped_row", f_gzcompress(f_serialize(row)), 3));
+
+  // the parallel get asks each server for the keys libmemcached put there
+  f_ini_set("memcache.parallel_get", "1");
+  Array got = mc->t_get(all_keys()).toArray();
+  VS(got.size(), KEY_COUNT);
+  for (int i = 0; i < KEY_COUNT; i++) {
+    VS(got[key_name(i)], key_value(i));
+  }
+  got = mc->t_get(CREATE_VECTOR3("zipped", "zipped_row", "missing"))
+    .toArray();
+  VS(got.size(), 2);
+  VS(got["zipped"], key_value(7));
+  VS(got["zipped_row"], row);
+
+  // the same again over the kept-alive sockets, and through libmemcached
+  Array keys = all_keys();
+  keys.append("zipped");
+  got = mc->t_get(keys).toArray();
+  VS(got.size(), KEY_COUNT + 1);
+  f_ini_set("memcache.parallel_get", "0");
+  Array slow = mc->t_get(keys).toArray();
+  f_ini_set("memcache.parallel_get", "1");
+  VS(slow.size(), got.size());
+  for (ArrayIter iter(got); iter; ++iter) {
+    VS(slow[iter.first()], iter.second());
+  }
+  return Count(true);
+}
+
+bool TestExtMemcache::test_memcache_get_dropped_server() {
+  // the second server cuts every get reply off half way
+  FakeMemcached good, bad;
+  bad.dropGetReplies();
+  p_Memcache mc(NEWOBJ(c_Memcache)());
+  VERIFY(add_fake_server(mc, good, true));
+  VERIFY(add_fake_server(mc, bad, true));
+
+  // its keys are misses, even the ones it sent in full before hanging up
+  f_ini_set("memcache.parallel_get", "1");
+  Array got = mc->t_get(all_keys()).toArray();
+  VERIFY(some_keys(got));
+  // and the other server's socket is still good for the next call
+  Array again = mc->t_get(all_keys()).toArray();
+  VERIFY(some_keys(again));
+  VS(again.size(), got.size());
+  return Count(true);
+}
+
+bool TestExtMemcache::test_memcache_get_timeout() {
+  // the second server answers well after the 50ms op timeout
+  FakeMemcached fast, slow(500 * 1000);
+  p_Memcache mc(NEWOBJ(c_Memcache)());
+  VERIFY(add_fake_server(mc, fast, true));
+  VERIFY(add_fake_server(mc, slow, true));
+  VERIFY(mc->t_setoptimeout(50));
+
+  f_ini_set("memcache.parallel_get", "1");
+  for (int i = 0; i < 2; i++) {
+    // the slow server's keys are misses, and the call doesn't wait for it;
+    // the second time round it gets a fresh socket, not the one left
+    // half way through the late reply
+    int64 start = Timer::GetCurrentTimeMicros();
+    Array got = mc->t_get(all_keys()).toArray();
+    int64 elapsed = Timer::GetCurrentTimeMicros() - start;
+    VERIFY(some_keys(got));
+    VERIFY(elapsed < 400 * 1000);
+  }
   return Count(true);
 }
 
@@ -33,6 +33,8 @@ class TestExtMemcache : public TestCppExt {
   bool test_memcache_set();
   bool test_memcache_replace();
   bool test_memcache_get();
+  bool test_memcache_get_dropped_server();
+  bool test_memcache_get_timeout();
   bool test_memcache_delete();
   bool test_memcache_increment();
   bool test_memcache_decrement();
@@ -16,6 +16,7 @@
 
 #include <test/test_ext_mysql.h>
 #include <runtime/ext/ext_mysql.h>
+#include <runtime/ext/mysql_pool.h>
 #include <runtime/base/runtime_option.h>
 #include <test/test_mysql_info.inc>
 
@@ -51,6 +52,8 @@ bool TestExtMysql::RunTests(const std::string &which) {
   RUN_TEST(test_mysql_set_timeout);
   RUN_TEST(test_mysql_query);
   RUN_TEST(test_mysql_unbuffered_query);
+  RUN_TEST(test_mysql_async_query);
+  RUN_TEST(test_mysql_pool_reap);
   RUN_TEST(test_mysql_db_query);
   RUN_TEST(test_mysql_list_dbs);
   RUN_TEST(test_mysql_list_tables);
@@ -323,6 +326,87 @@ bool TestExtMysql::test_mysql_unbuffered_query() {
   return Count(true);
 }
 
+bool TestExtMysql::test_mysql_async_query() {
+  Variant conn = f_mysql_connect(TEST_HOSTNAME, TEST_USERNAME, TEST_PASSWORD);
+  VERIFY(CreateTestTable());
+  VS(f_mysql_query("insert into test (name) values ('test'),('test2')"), true);
+
+  VS(f_mysql_async_query_start("select name from test order by id", conn),
+     true);
+  // the link is busy until its result has been fetched
+  VS(f_mysql_query("select 1", conn), false);
+  VS(f_mysql_multi_query("select 1", conn), false);
+  VS(f_mysql_select_db(TEST_DATABASE, conn), false);
+
+  Array ready = f_mysql_async_wait_actionable(CREATE_VECTOR1(conn), 5.0);
+  VS(ready.size(), 1);
+  VS(f_mysql_async_query_completed(conn), true);
+
+  Variant res = f_mysql_async_query_result(conn);
+  VS(f_mysql_num_rows(res), 2);
+  Variant row = f_mysql_fetch_row(res);
+  VS(row[0], "test");
+  row = f_mysql_fetch_row(res);
+  VS(row[0], "test2");
+
+  VS(f_mysql_async_query_result(conn), false);
+  VS(f_mysql_async_wait_actionable().size(), 0);
+
+  // a write skipped by MySQLReadOnly "works", as with mysql_query()
+  RuntimeOption::MySQLReadOnly = true;
+  VS(f_mysql_async_query_start("delete from test", conn), true);
+  VS(f_mysql_async_query_completed(conn), true);
+  VS(f_mysql_async_query_result(conn), true);
+  RuntimeOption::MySQLReadOnly = false;
+  VS(f_mysql_async_query_result(conn), false);
+  return Count(true);
+}
+
+bool TestExtMysql::test_mysql_pool_reap() {
+  // put the pool options back however the test ends
+  struct SavedOptions {
+    SavedOptions()
+      : pool(RuntimeOption::MySQLPool),
+        minIdle(RuntimeOption::MySQLPoolMinIdle),
+        pingInterval(RuntimeOption::MySQLPoolPingInterval),
+        idleTimeout(RuntimeOption::MySQLPoolIdleTimeout) {}
+    ~SavedOptions() {
+      RuntimeOption::MySQLPool = pool;
+      RuntimeOption::MySQLPoolMinIdle = minIdle;
+      RuntimeOption::MySQLPoolPingInterval = pingInterval;
+      RuntimeOption::MySQLPoolIdleTimeout = idleTimeout;
+    }
+    bool pool;
+    int minIdle;
+    int pingInterval;
+    int idleTimeout;
+  } saved;
+
+  RuntimeOption::MySQLPool = true;
+  RuntimeOption::MySQLPoolMinIdle = 0;
+  RuntimeOption::MySQLPoolPingInterval = 10;
+  RuntimeOption::MySQLPoolIdleTimeout = 60;
+
+  Variant conn = f_mysql_pconnect(TEST_HOSTNAME, TEST_USERNAME, TEST_PASSWORD);
+  VERIFY(!same(conn, false));
+  VS(f_mysql_close(conn), true); // back into the pool
+
+  // pinged every PingInterval, but that does not keep it around
+  time_t now = time(0);
+  for (int i = 1; i <= 5; i++) {
+    MySQLConnectionPool::HealthCheck(now + i * 10);
+  }
+  std::string stats = MySQLConnectionPool::ReportStats();
+  VERIFY(stats.find("<pinged>5</pinged>") != std::string::npos);
+  VERIFY(stats.find("<idle>1</idle>") != std::string::npos);
+
+  MySQLConnectionPool::HealthCheck(now + 60);
+  stats = MySQLConnectionPool::ReportStats();
+  VERIFY(stats.find("<reaped>1</reaped>") != std::string::npos);
+  VERIFY(stats.find("<idle>0</idle>") != std::string::npos);
+  return Count(true);
+}
+
 bool TestExtMysql::test_mysql_db_query() {
   try {
     f_mysql_db_query("", "");
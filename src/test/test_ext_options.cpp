@@ -69,6 +69,7 @@ bool TestExtOptions::RunTests(const std::string &which) {
   RUN_TEST(test_putenv);
   RUN_TEST(test_set_magic_quotes_runtime);
   RUN_TEST(test_set_time_limit);
+  RUN_TEST(test_hphp_time_limit_ms);
   RUN_TEST(test_sys_get_temp_dir);
   RUN_TEST(test_version_compare);
   RUN_TEST(test_zend_logo_guid);
@@ -386,6 +387,21 @@ bool TestExtOptions::test_set_time_limit() {
   return Count(true);
 }
 
+bool TestExtOptions::test_hphp_time_limit_ms() {
+  f_hphp_set_time_limit_ms(5000);
+  int64 left = f_hphp_get_time_remaining_ms();
+  VERIFY(left > 0 && left <= 5000);
+  f_hphp_set_time_limit_ms(0);
+  VS(f_hphp_get_time_remaining_ms(), -1);
+
+  f_hphp_set_cpu_time_limit_ms(5000);
+  left = f_hphp_get_cpu_time_remaining_ms();
+  VERIFY(left > 0 && left <= 5000);
+  f_hphp_set_cpu_time_limit_ms(0);
+  VS(f_hphp_get_cpu_time_remaining_ms(), -1);
+  return Count(true);
+}
+
 bool TestExtOptions::test_sys_get_temp_dir() {
   VERIFY(f_sys_get_temp_dir() == "/tmp");
   return Count(true);
@@ -74,6 +74,7 @@ class TestExtOptions : public TestCppExt {
   bool test_putenv();
   bool test_set_magic_quotes_runtime();
   bool test_set_time_limit();
+  bool test_hphp_time_limit_ms();
   bool test_sys_get_temp_dir();
   bool test_version_compare();
   bool test_zend_logo_guid();
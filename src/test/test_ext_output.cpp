@@ -16,6 +16,8 @@
 
 #include <test/test_ext_output.h>
 #include <runtime/ext/ext_output.h>
+#include <runtime/ext/ext_file.h>
+#include <runtime/base/server/io_trace.h>
 
 IMPLEMENT_SEP_EXTENSION_TEST(Output);
 ///////////////////////////////////////////////////////////////////////////////
@@ -45,6 +47,7 @@ bool TestExtOutput::RunTests(const std::string &which) {
   RUN_TEST(test_hphp_stats);
   RUN_TEST(test_hphp_get_stats);
   RUN_TEST(test_hphp_get_timers);
+  RUN_TEST(test_hphp_io_trace);
   RUN_TEST(test_hphp_output_global_state);
 
   return ret;
@@ -223,6 +226,30 @@ bool TestExtOutput::test_hphp_get_timers() {
   return Count(true);
 }
 
+bool TestExtOutput::test_hphp_io_trace() {
+  f_hphp_io_trace_start();
+  f_file_put_contents("test/test_ext_output.tmp", "io trace");
+  Array events = f_hphp_get_io_trace();
+  f_unlink("test/test_ext_output.tmp");
+
+  bool found = false;
+  for (ArrayIter iter(events); iter; ++iter) {
+    Array e = iter.second().toArray();
+    if (e["name"] == "file::write") {
+      VS(e["bytes"], 8);
+      VERIFY(e["end"].toInt64() >= e["start"].toInt64());
+      found = true;
+    }
+  }
+  VERIFY(found);
+
+  // nothing carries over into the next request, traced or not
+  IOTrace::EndRequest();
+  IOTrace::StartRequest("/next.php");
+  VS(f_hphp_get_io_trace().size(), 0);
+  return Count(true);
+}
+
 bool TestExtOutput::test_hphp_output_global_state() {
   return Count(true);
 }
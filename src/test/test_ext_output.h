@@ -49,6 +49,7 @@ class TestExtOutput : public TestCppExt {
   bool test_hphp_stats();
   bool test_hphp_get_stats();
   bool test_hphp_get_timers();
+  bool test_hphp_io_trace();
   bool test_hphp_output_global_state();
 };
 
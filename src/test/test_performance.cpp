@@ -15,7 +15,16 @@
 */
 
 #include <test/test_performance.h>
+#include <test/fake_memcached.h>
+#include <runtime/base/shared/shared_session_store.h>
+#include <runtime/base/server/access_log.h>
+#include <runtime/base/server/transport.h>
+#include <runtime/base/runtime_option.h>
 #include <util/util.h>
+#include <util/timer.h>
+#include <util/async_func.h>
+#include <sys/stat.h>
+#include <fcntl.h>
 
 #define PERF_LOOP_COUNT "500"
 
@@ -36,6 +45,56 @@
   "$end = timing_get_cpu_time();\n"                   \
   "print (($end - $start)/1000).\"ms\";\n"            \
 
+/*
+ * For benchmarks that time a few loops per input and print one line each:
+ * bench_lap() records the milliseconds since the last lap under a name,
+ * and bench_print() writes them out after the input's name and size. CPU
+ * time by default, wall time for ones that wait on I/O.
+ */
+#define PERF_BENCH                                                      \
+  "function bench_now($wall) {\n"                                       \
+  "  return $wall ? microtime(true) * 1000000 : timing_get_cpu_time();\n" \
+  "}\n"                                                                 \
+  "function bench_start($wall = false) {\n"                             \
+  "  return array('wall' => $wall, 'last' => bench_now($wall),\n"       \
+  "               'laps' => array());\n"                                \
+  "}\n"                                                                 \
+  "function bench_restart(&$b) {\n"                                     \
+  "  $b['last'] = bench_now($b['wall']);\n"                             \
+  "}\n"                                                                 \
+  "function bench_lap(&$b, $what) {\n"                                  \
+  "  $now = bench_now($b['wall']);\n"                                   \
+  "  $b['laps'][$what] = ($now - $b['last']) / 1000;\n"                 \
+  "  $b['last'] = $now;\n"                                              \
+  "}\n"                                                                 \
+  "function bench_print($b, $name, $size, $reps, $note = '') {\n"       \
+  "  printf('%-8s %9d x%-7d', $name, $size, $reps);\n"                  \
+  "  foreach ($b['laps'] as $what => $ms) {\n"                          \
+  "    printf(' %s %8.1fms', $what, $ms);\n"                            \
+  "  }\n"                                                               \
+  "  echo $note === '' ? \"\\n\" : \" $note\\n\";\n"                    \
+  "}\n"                                                                 \
+
+namespace {
+/*
+ * Runs every bench's run() on a thread of its own, all of them started
+ * together, and returns how long they took in microseconds.
+ */
+template<class T>
+int64 run_benches(const vector<boost::shared_ptr<T> > &benches) {
+  typedef AsyncFunc<T> BenchFunc;
+  vector<boost::shared_ptr<BenchFunc> > funcs;
+  for (unsigned int i = 0; i < benches.size(); i++) {
+    funcs.push_back(boost::shared_ptr<BenchFunc>
+                    (new BenchFunc(benches[i].get(), &T::run)));
+  }
+  int64 start = Timer::GetCurrentTimeMicros();
+  for (unsigned int i = 0; i < funcs.size(); i++) funcs[i]->start();
+  for (unsigned int i = 0; i < funcs.size(); i++) funcs[i]->waitForEnd();
+  return Timer::GetCurrentTimeMicros() - start;
+}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 TestPerformance::TestPerformance() {
@@ -47,6 +106,13 @@ bool TestPerformance::RunTests(const std::string &which) {
   bool ret = true;
   RUN_TEST(TestBasicOperations);
   RUN_TEST(TestMemoryUsage);
+  RUN_TEST(TestSort);
+  RUN_TEST(TestEscaping);
+  RUN_TEST(TestJsonDecode);
+  RUN_TEST(TestUnserialize);
+  RUN_TEST(TestMemcacheGet);
+  RUN_TEST(TestSessionStore);
+  RUN_TEST(TestAccessLog);
   RUN_TEST(TestAdHocFile);
   RUN_TEST(TestAdHoc);
   return ret;
@@ -145,6 +211,397 @@ bool TestPerformance::TestMemoryUsage() {
   return true;
 }
 
+bool TestPerformance::TestSort() {
+  // Each size is sorted enough times to touch roughly 10M elements in
+  // total, so the per-case numbers are comparable across sizes.
+  VCR(PERF_START PERF_BENCH
+      "function make_ints($n) {\n"
+      "  $a = array(); for ($i = 0; $i < $n; $i++) $a[] = mt_rand();\n"
+      "  return $a;\n"
+      "}\n"
+      "function make_doubles($n) {\n"
+      "  $a = array(); for ($i = 0; $i < $n; $i++) $a[] = mt_rand() / 7.0;\n"
+      "  return $a;\n"
+      "}\n"
+      "function make_strings($n) {\n"
+      "  $a = array();\n"
+      "  for ($i = 0; $i < $n; $i++) $a[] = 'k'.md5($i);\n"
+      "  return $a;\n"
+      "}\n"
+      "function make_mixed($n) {\n"
+      "  $a = array();\n"
+      "  for ($i = 0; $i < $n; $i++) $a[] = $i % 2 ? 'k'.$i : $i;\n"
+      "  return $a;\n"
+      "}\n"
+      "function bench($name, $n, $a) {\n"
+      "  $reps = max(1, (int)(10000000 / $n));\n"
+      "  $k = array_flip($a);\n"
+      "  $b = bench_start();\n"
+      "  for ($r = 0; $r < $reps; $r++) { $c = $a; sort($c); }\n"
+      "  bench_lap($b, 'sort');\n"
+      "  for ($r = 0; $r < $reps; $r++) { $c = $a; rsort($c); }\n"
+      "  bench_lap($b, 'rsort');\n"
+      "  for ($r = 0; $r < $reps; $r++) { $c = $k; ksort($c); }\n"
+      "  bench_lap($b, 'ksort');\n"
+      "  for ($r = 0; $r < $reps; $r++) {\n"
+      "    $c = $a; $d = $a; array_multisort($c, $d);\n"
+      "  }\n"
+      "  bench_lap($b, 'multisort');\n"
+      "  bench_print($b, $name, $n, $reps);\n"
+      "}\n"
+      "mt_srand(1);\n"
+      "for ($n = 10; $n <= 10000000; $n *= 10) {\n"
+      "  bench('int', $n, make_ints($n));\n"
+      "  bench('double', $n, make_doubles($n));\n"
+      "  bench('string', $n, make_strings($n));\n"
+      "  bench('mixed', $n, make_mixed($n));\n"
+      "}\n"
+      "\n\n/* sort()/rsort()/ksort()/array_multisort() by element type */"
+      PERF_END);
+  return true;
+}
+
+bool TestPerformance::TestEscaping() {
+  VCR(PERF_START PERF_BENCH
+      "function bench($name, $s) {\n"
+      "  $reps = (int)(10000000 / strlen($s));\n"
+      "  $b = bench_start();\n"
+      "  for ($r = 0; $r < $reps; $r++) htmlspecialchars($s, ENT_QUOTES);\n"
+      "  bench_lap($b, 'htmlspecialchars');\n"
+      "  for ($r = 0; $r < $reps; $r++) addslashes($s);\n"
+      "  bench_lap($b, 'addslashes');\n"
+      "  for ($r = 0; $r < $reps; $r++) json_encode($s);\n"
+      "  bench_lap($b, 'json_encode');\n"
+      "  bench_print($b, $name, strlen($s), $reps);\n"
+      "}\n"
+      "$words = 'The quick brown fox jumps over the lazy dog. ';\n"
+      "$tags = '<a href=\"/x?a=1&b=2\">it\\'s</a>\\n';\n"
+      "foreach (array(16, 256, 4096, 65536) as $n) {\n"
+      "  bench('ascii', substr(str_repeat($words, $n / 32 + 1), 0, $n));\n"
+      "  bench('escapes', substr(str_repeat($tags, $n / 16 + 1), 0, $n));\n"
+      "  bench('utf8', substr(str_repeat($words.'\xc3\xa9t\xc3\xa9 ',\n"
+      "                                  $n / 32 + 1), 0, $n));\n"
+      "}\n"
+      "\n\n/* htmlspecialchars()/addslashes()/json_encode() */"
+      PERF_END);
+  return true;
+}
+
+bool TestPerformance::TestJsonDecode() {
+  VCR(PERF_START PERF_BENCH
+      "function bench($name, $s) {\n"
+      "  $loose = JSON_FB_LOOSE;\n"
+      "  $reps = (int)(20000000 / strlen($s)) + 1;\n"
+      "  $b = bench_start();\n"
+      "  for ($r = 0; $r < $reps; $r++) json_decode($s, true);\n"
+      "  bench_lap($b, 'assoc');\n"
+      "  for ($r = 0; $r < $reps; $r++) json_decode($s);\n"
+      "  bench_lap($b, 'object');\n"
+      "  for ($r = 0; $r < $reps; $r++) json_decode($s, true, $loose);\n"
+      "  bench_lap($b, 'pda');\n"
+      "  $same = json_decode($s, true) === json_decode($s, true, $loose);\n"
+      "  bench_print($b, $name, strlen($s), $reps,\n"
+      "              $same ? 'same' : 'DIFFERENT');\n"
+      "}\n"
+      "foreach (array(1, 10, 100, 1000, 10000) as $n) {\n"
+      "  $rows = array();\n"
+      "  for ($i = 0; $i < $n; $i++) {\n"
+      "    $rows[] = array('id' => $i, 'name' => \"user $i\",\n"
+      "                    'score' => $i / 7, 'tags' => array('a', 'b\\\"c'),\n"
+      "                    'bio' => \"caf\xc3\xa9 \xf0\x9f\x98\x80\",\n"
+      "                    'active' => ($i % 2) == 0, 'ref' => null);\n"
+      "  }\n"
+      "  bench('records', json_encode($rows));\n"
+      "  bench('ints', json_encode(range(0, $n * 8)));\n"
+      "}\n"
+      "\n\n/* json_decode() */"
+      PERF_END);
+  return true;
+}
+
+bool TestPerformance::TestUnserialize() {
+  VCR(PERF_START PERF_BENCH
+      "function bench($name, $v) {\n"
+      "  $s = serialize($v);\n"
+      "  $reps = (int)(20000000 / strlen($s)) + 1;\n"
+      "  $b = bench_start();\n"
+      "  for ($r = 0; $r < $reps; $r++) unserialize($s);\n"
+      "  bench_lap($b, 'unserialize');\n"
+      "  bench_print($b, $name, strlen($s), $reps,\n"
+      "              unserialize($s) === $v ? 'same' : 'DIFFERENT');\n"
+      "}\n"
+      "foreach (array(10, 100, 1000, 10000) as $n) {\n"
+      "  $ints = $doubles = $rows = $config = array();\n"
+      "  for ($i = 0; $i < $n; $i++) {\n"
+      "    $ints[] = $i * 7919 - 5000;\n"
+      "    $doubles[] = $i / 8 + 0.25;\n"
+      "    $rows[$i * 3] = array('id' => $i, 'name' => \"user $i\",\n"
+      "                          'score' => $i * 1.5, 'flags' => $i & 7,\n"
+      "                          'active' => ($i % 2) == 0);\n"
+      "    $config['section' . ($i % 16)]['key' . $i] = \"value $i\";\n"
+      "  }\n"
+      "  bench('ints', $ints);\n"
+      "  bench('doubles', $doubles);\n"
+      "  bench('rows', $rows);\n"
+      "  bench('config', $config);\n"
+      "}\n"
+      "\n\n/* unserialize() */"
+      PERF_END);
+  return true;
+}
+
+bool TestPerformance::TestMemcacheGet() {
+  // Four fake servers 1ms away; a multi-key get should cost about one
+  // round trip however many of them the keys are spread over.
+  const int count = 4;
+  boost::shared_ptr<FakeMemcached> servers[count];
+  string ports;
+  for (int i = 0; i < count; i++) {
+    servers[i] = boost::shared_ptr<FakeMemcached>(new FakeMemcached(1000));
+    int port = servers[i]->start();
+    if (!port) {
+      printf("unable to start fake memcached\n");
+      return false;
+    }
+    char buf[16];
+    snprintf(buf, sizeof(buf), i ? ", %d" : "%d", port);
+    ports += buf;
+  }
+
+  string input = PERF_START PERF_BENCH
+    "$mc = new Memcache();\n"
+    "foreach (array(PORTS) as $port) $mc->addServer('127.0.0.1', $port);\n"
+    "$keys = array();\n"
+    "for ($i = 0; $i < 1000; $i++) {\n"
+    "  $mc->set('key'.$i, str_repeat('v', 100 + $i));\n"
+    "  $mc->set('row'.$i, array('id' => $i, 'name' => \"user $i\"));\n"
+    "  $keys[] = 'key'.$i; $keys[] = 'row'.$i;\n"
+    "}\n"
+    "function bench($mc, $keys, $n) {\n"
+    "  $ask = array_slice($keys, 0, $n);\n"
+    "  $reps = 200;\n"
+    "  $b = bench_start(true);\n"
+    "  $results = array();\n"
+    "  foreach (array('libmemcached' => 0, 'parallel' => 1) as $what => $p) {\n"
+    "    ini_set('memcache.parallel_get', $p);\n"
+    "    $mc->get($ask);\n"
+    "    bench_restart($b);\n"
+    "    for ($r = 0; $r < $reps; $r++) $got = $mc->get($ask);\n"
+    "    bench_lap($b, $what);\n"
+    "    $results[] = $got;\n"
+    "  }\n"
+    "  bench_print($b, 'keys', $n, $reps,\n"
+    "              $results[0] == $results[1] && count($results[1]) == $n ?\n"
+    "              'same' : 'DIFFERENT');\n"
+    "}\n"
+    "foreach (array(1, 10, 100, 2000) as $n) bench($mc, $keys, $n);\n"
+    "\n\n/* Memcache::get() with an array of keys, wall time */"
+    PERF_END;
+  Util::replaceAll(input, "PORTS", ports);
+
+  VCR(input.c_str());
+  return true;
+}
+
+namespace {
+/*
+ * One thread's worth of session traffic: each request reads one of a few
+ * hot sessions and writes it back, changing it one time in ten. "files"
+ * does what FileSessionModule does per request (open, read, rewrite,
+ * close); "shm" goes through SharedSessionStore like the shm module,
+ * which only touches a session it didn't change.
+ */
+class SessionBench {
+public:
+  static const int Requests = 2000;
+  static const int Sessions = 64;
+
+  SessionBench(SharedSessionStore *store, const string &dir, int seed)
+    : m_store(store), m_dir(dir), m_seed(seed), m_conflicts(0),
+      m_writeErrors(0) {}
+
+  int conflicts() const { return m_conflicts; }
+  int writeErrors() const { return m_writeErrors; }
+
+  void run() {
+    string data(1024, 'x');
+    char key[32];
+    for (int i = 0; i < Requests; i++) {
+      snprintf(key, sizeof(key), "sess%d", rand_r(&m_seed) % Sessions);
+      bool change = rand_r(&m_seed) % 10 == 0;
+      if (m_store) {
+        string value;
+        int64 version = m_store->read(key, 1440, value);
+        if (value.empty() || change) {
+          value = data;
+          value[i % value.size()] = 'a' + i % 26;
+        } else {
+          m_store->touch(key, 1440);
+          continue;
+        }
+        if (m_store->write(key, value.data(), value.size(), version, 1440) ==
+            SharedSessionStore::Conflict) {
+          m_conflicts++;
+        }
+      } else {
+        string path = m_dir + "/sess_" + key;
+        int fd = open(path.c_str(), O_CREAT | O_RDWR, 0600);
+        if (fd < 0) continue;
+        struct stat sbuf;
+        fstat(fd, &sbuf);
+        string value(sbuf.st_size, '\0');
+        if (sbuf.st_size && read(fd, &value[0], sbuf.st_size) < 0) {
+          value.clear();
+        }
+        if (value.empty() || change) {
+          value = data;
+          value[i % value.size()] = 'a' + i % 26;
+        }
+        if (ftruncate(fd, 0) == 0) {
+          lseek(fd, 0, SEEK_SET);
+          if (write(fd, value.data(), value.size()) < 0) m_writeErrors++;
+        }
+        close(fd);
+      }
+    }
+  }
+
+private:
+  SharedSessionStore *m_store;
+  string m_dir;
+  unsigned int m_seed;
+  int m_conflicts;
+  int m_writeErrors;
+};
+}
+
+bool TestPerformance::TestSessionStore() {
+  char dir[] = "/tmp/session_bench.XXXXXX";
+  if (!mkdtemp(dir)) {
+    printf("unable to create %s\n", dir);
+    return false;
+  }
+
+  int threadCounts[] = {1, 8, 32, 128};
+  for (unsigned int t = 0; t < sizeof(threadCounts) / sizeof(int); t++) {
+    int n = threadCounts[t];
+    for (int shm = 0; shm <= 1; shm++) {
+      SharedSessionStore store;
+      vector<boost::shared_ptr<SessionBench> > benches;
+      for (int i = 0; i < n; i++) {
+        benches.push_back(boost::shared_ptr<SessionBench>
+                          (new SessionBench(shm ? &store : NULL, dir, i)));
+      }
+      int64 elapsed = run_benches(benches);
+
+      int conflicts = 0;
+      int writeErrors = 0;
+      for (int i = 0; i < n; i++) {
+        conflicts += benches[i]->conflicts();
+        writeErrors += benches[i]->writeErrors();
+      }
+      int64 total = (int64)n * SessionBench::Requests;
+      printf("%-5s %3d threads %8lld requests %8.1fms %8.0f req/s "
+             "%6d conflicts %6d write errors\n", shm ? "shm" : "files", n,
+             total, elapsed / 1000.0, total * 1e6 / elapsed, conflicts,
+             writeErrors);
+    }
+  }
+
+  Util::ssystem((string("rm -rf ") + dir).c_str());
+  return Count(true);
+}
+
+namespace {
+class LogBenchTransport : public Transport {
+public:
+  LogBenchTransport() { setResponse(200, "OK"); }
+
+  virtual const char *getUrl() { return "/bench.php?id=12345";}
+  virtual const char *getRemoteHost() { return "10.0.0.1";}
+  virtual const void *getPostData(int &size) { size = 0; return NULL;}
+  virtual const uint16 getRemotePort() { return 0; }
+  virtual Method getMethod() { return Transport::GET;}
+  virtual std::string getHeader(const char *name) { return "bench/1.0";}
+  virtual void getHeaders(HeaderMap &headers) {}
+  virtual void addHeaderImpl(const char *name, const char *value) {}
+  virtual void removeHeaderImpl(const char *name) {}
+  virtual void sendImpl(const void *data, int size, int code, bool chunked) {}
+};
+
+static IMPLEMENT_THREAD_LOCAL(AccessLog::ThreadData, s_logBenchThreadData);
+static AccessLog::ThreadData *get_log_bench_thread_data() {
+  return s_logBenchThreadData.get();
+}
+
+/*
+ * One request thread logging as fast as it can.
+ */
+class LogBench {
+public:
+  static const int Requests = 2000;
+
+  LogBench(AccessLog *log) : m_log(log) {}
+
+  void run() {
+    LogBenchTransport transport;
+    for (int i = 0; i < Requests; i++) {
+      m_log->onNewRequest();
+      m_log->log(&transport, NULL);
+    }
+  }
+
+private:
+  AccessLog *m_log;
+};
+}
+
+bool TestPerformance::TestAccessLog() {
+  char file[] = "/tmp/access_bench.XXXXXX";
+  int fd = mkstemp(file);
+  if (fd < 0) {
+    printf("unable to create %s\n", file);
+    return false;
+  }
+  close(fd);
+
+  const int n = 200;
+  int savedBufferKB = RuntimeOption::AccessLogBufferKB;
+  for (int buffered = 0; buffered <= 1; buffered++) {
+    RuntimeOption::AccessLogBufferKB = buffered ? 256 : 0;
+    unlink(file);
+    int64 elapsed;
+    {
+      AccessLog log(get_log_bench_thread_data);
+      log.init("%h %l %u %t \"%r\" %>s %b \"%{User-Agent}i\" %T", "",
+               file, "");
+      vector<boost::shared_ptr<LogBench> > benches;
+      for (int i = 0; i < n; i++) {
+        benches.push_back(boost::shared_ptr<LogBench>(new LogBench(&log)));
+      }
+      elapsed = run_benches(benches);
+      log.stop();
+    }
+
+    int64 lines = 0;
+    FILE *f = fopen(file, "r");
+    if (f) {
+      for (int c = fgetc(f); c != EOF; c = fgetc(f)) {
+        if (c == '\n') lines++;
+      }
+      fclose(f);
+    }
+    int64 total = (int64)n * LogBench::Requests;
+    printf("%-8s %3d threads %8lld lines %8.1fms %9.0f lines/s "
+           "%8lld written\n", buffered ? "buffered" : "direct", n, total,
+           elapsed / 1000.0, total * 1e6 / elapsed, lines);
+  }
+  RuntimeOption::AccessLogBufferKB = savedBufferKB;
+
+  unlink(file);
+  return Count(true);
+}
+
 bool TestPerformance::TestAdHocFile() {
   string input;
   FILE *f = fopen("test/perf_ad_hoc.php", "r");
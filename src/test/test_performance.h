@@ -32,6 +32,13 @@ class TestPerformance : public TestCodeRun {
 
   bool TestBasicOperations();
   bool TestMemoryUsage();
+  bool TestSort();
+  bool TestEscaping();
+  bool TestJsonDecode();
+  bool TestUnserialize();
+  bool TestMemcacheGet();
+  bool TestSessionStore();
+  bool TestAccessLog();
   bool TestAdHocFile();
   bool TestAdHoc();
 };
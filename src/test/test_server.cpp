@@ -42,6 +42,15 @@ TestServer::TestServer() {
 
 static int s_server_port = 0;
 static int inherit_fd = -1;
+// one more "-v" setting for the server, for tests that need their own
+static string s_server_option;
+
+namespace {
+struct ServerOption {
+  explicit ServerOption(const char *option) { s_server_option = option; }
+  ~ServerOption() { s_server_option.clear(); }
+};
+}
 
 bool TestServer::VerifyServerResponse(const char *input, const char *output,
                                       const char *url, const char *method,
@@ -131,18 +140,28 @@ void TestServer::RunServer() {
   string portConfig = "Server.Port=" + lexical_cast<string>(s_server_port);
   string fd = lexical_cast<string>(inherit_fd);
 
+  const char *path;
+  std::vector<const char *> argv;
   if (Option::EnableEval < Option::FullEval) {
-    const char *argv[] = {"", "--mode=server",
+    const char *args[] = {"", "--mode=server",
                           "--config=test/config-server.hdf", "-v",
-                          portConfig.c_str(), "--port-fd", fd.c_str(), NULL};
-    Process::Exec("runtime/tmp/TestServer/test", argv, NULL, out, &err);
+                          portConfig.c_str(), "--port-fd", fd.c_str()};
+    path = "runtime/tmp/TestServer/test";
+    argv.assign(args, args + sizeof(args) / sizeof(args[0]));
   } else {
-    const char *argv[] = {"", "--file=/unittest/rootdoc/string",
+    const char *args[] = {"", "--file=/unittest/rootdoc/string",
                           "--mode=server", portConfig.c_str(), "-v",
                           "--config=test/config-eval.hdf",
-                          portConfig.c_str(), "--port-fd", fd.c_str(), NULL};
-    Process::Exec(HHVM_PATH, argv, NULL, out, &err);
+                          portConfig.c_str(), "--port-fd", fd.c_str()};
+    path = HHVM_PATH;
+    argv.assign(args, args + sizeof(args) / sizeof(args[0]));
   }
+  if (!s_server_option.empty()) {
+    argv.push_back("-v");
+    argv.push_back(s_server_option.c_str());
+  }
+  argv.push_back(NULL);
+  Process::Exec(path, &argv[0], NULL, out, &err);
 }
 
 void TestServer::StopServer() {
@@ -178,6 +197,7 @@ bool TestServer::RunTests(const std::string &which) {
   RUN_TEST(TestCookie);
   RUN_TEST(TestResponseHeader);
   RUN_TEST(TestSetCookie);
+  RUN_TEST(TestCompression);
   //RUN_TEST(TestRequestHandling);
   RUN_TEST(TestHttpClient);
   RUN_TEST(TestRPCServer);
@@ -333,6 +353,24 @@ bool TestServer::TestSetCookie() {
   return true;
 }
 
+bool TestServer::TestCompression() {
+  // with compression threads, which get anything this big
+  ServerOption option("Server.CompressionThreadCount=2");
+  const char *page = "<?php echo str_repeat('compress me ', 200);";
+
+  VSRESH(page, "Content-Encoding: gzip", "Accept-Encoding: gzip");
+  VSRESH(page, "Content-Encoding: gzip", "Accept-Encoding: deflate, x-gzip");
+  VSRESH(page, "Content-Encoding: gzip", "Accept-Encoding: *");
+
+  // refused with a zero weight, the body comes back as it is
+  VSRESH(page, "compress me compress me",
+         "Accept-Encoding: gzip;q=0, identity");
+  VSRESH(page, "compress me compress me", "Accept-Encoding: gzip;q=0.0");
+  VSRESH(page, "compress me compress me", "Accept-Encoding: *;q=0");
+
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 class TestTransport : public Transport {
@@ -43,6 +43,7 @@ public:
   // test transport related extension functions
   bool TestResponseHeader();
   bool TestSetCookie();
+  bool TestCompression();
 
   // test multithreaded request processing
   bool TestRequestHandling();
@@ -89,6 +90,11 @@ protected:
                                   NULL, true, __FILE__,__LINE__)))      \
     return false;
 
+#define VSRESH(input, output, header)                                   \
+  if (!Count(VerifyServerResponse(input, output, "string", "GET",       \
+                                  header, NULL, true, __FILE__,__LINE__))) \
+    return false;
+
 #define VSGET(input, output, url)                                       \
   if (!Count(VerifyServerResponse(input, output, url, "GET", NULL,      \
                                   NULL, false, __FILE__,__LINE__)))     \
@@ -19,7 +19,12 @@
 #include <util/lfu_table.h>
 #include <runtime/base/complex_types.h>
 #include <runtime/base/shared/shared_string.h>
+#include <runtime/base/shared/shared_session_store.h>
 #include <runtime/base/zend/zend_string.h>
+#include <util/light_process.h>
+#include <util/async_func.h>
+#include <util/timer.h>
+#include <sys/wait.h>
 
 #define VERIFY_DUMP(map, exp)                                           \
   if (!(exp)) {                                                         \
@@ -39,8 +44,10 @@ bool TestUtil::RunTests(const std::string &which) {
   bool ret = true;
   //RUN_TEST(TestLFUTable);
   RUN_TEST(TestSharedString);
+  RUN_TEST(TestSharedSessionStore);
   RUN_TEST(TestCanonicalize);
   RUN_TEST(TestHDF);
+  RUN_TEST(TestLightProcess);
   return ret;
 }
 
@@ -240,6 +247,58 @@ bool TestUtil::TestSharedString() {
   return Count(true);
 }
 
+bool TestUtil::TestSharedSessionStore() {
+  SharedSessionStore store;
+  string value;
+
+  // first write of a new session, then two requests racing on it
+  VERIFY(store.read("s1", 1440, value) == 0);
+  VERIFY(store.write("s1", "a|i:1;", 6, 0, 1440) ==
+         SharedSessionStore::Written);
+  int64 v1 = store.read("s1", 1440, value);
+  VERIFY(v1 > 0 && value == "a|i:1;");
+  int64 v1b = store.read("s1", 1440, value);
+  VERIFY(v1b == v1);
+
+  VERIFY(store.write("s1", "a|i:2;", 6, v1, 1440) ==
+         SharedSessionStore::Written);
+  VERIFY(store.write("s1", "a|i:3;", 6, v1b, 1440) ==
+         SharedSessionStore::Conflict);
+  // the loser writing back what it read counts as a conflict as well (the
+  // shm handler doesn't write unmodified data at all), but writing what is
+  // already there does not
+  VERIFY(store.write("s1", "a|i:1;", 6, v1b, 1440) ==
+         SharedSessionStore::Conflict);
+  VERIFY(store.write("s1", "a|i:2;", 6, v1b, 1440) ==
+         SharedSessionStore::Unchanged);
+  VERIFY(store.read("s1", 1440, value) > v1 && value == "a|i:2;");
+
+  // touching keeps the data and version, so it can't cause a conflict
+  int64 v2 = store.read("s1", 1440, value);
+  VERIFY(store.touch("s1", 1440));
+  VERIFY(store.read("s1", 1440, value) == v2 && value == "a|i:2;");
+  VERIFY(!store.touch("nope", 1440));
+  VERIFY(store.write("s1", "a|i:4;", 6, -1, 1440) ==
+         SharedSessionStore::Written);
+
+  // someone else created the session after we found none
+  VERIFY(store.write("s2", "x", 1, 0, 1440) == SharedSessionStore::Written);
+  VERIFY(store.write("s2", "y", 1, 0, 1440) == SharedSessionStore::Conflict);
+  VERIFY(store.size() == 2);
+
+  VERIFY(store.erase("s2"));
+  VERIFY(!store.erase("s2"));
+  VERIFY(store.read("s2", 1440, value) == 0);
+
+  // a negative lifetime has everything expired already
+  VERIFY(store.read("s1", -1, value) == 0);
+  VERIFY(store.gc(1440) == 0);
+  VERIFY(store.gc(-1) == 1);
+  VERIFY(store.size() == 0);
+
+  return Count(true);
+}
+
 bool TestUtil::TestCanonicalize() {
   VERIFY(Util::canonicalize("foo") == "foo");
   VERIFY(Util::canonicalize("/foo") == "/foo");
@@ -277,3 +336,125 @@ bool TestUtil::TestHDF() {
 
   return Count(true);
 }
+
+///////////////////////////////////////////////////////////////////////////////
+// light processes
+
+namespace {
+struct LightProcessScope {
+  explicit LightProcessScope(int count) {
+    LightProcess::Initialize("/tmp/test_light_process", count,
+                             std::vector<int>());
+  }
+  ~LightProcessScope() { LightProcess::Close(); }
+};
+
+/*
+ * Spawns through the shadows the way a request thread would: popen() and
+ * pclose(), and proc_open() with a pipe for the child's stdout.
+ */
+class SpawnWorker {
+public:
+  static const int Rounds = 20;
+
+  SpawnWorker() : failures(0) {}
+
+  void run() {
+    for (int i = 0; i < Rounds; i++) {
+      if (!Popen()) failures++;
+      if (!ProcOpen()) failures++;
+    }
+  }
+
+  static bool Popen() {
+    FILE *f = LightProcess::popen("echo popen", "r");
+    if (!f) return false;
+    char buf[64];
+    bool ok = fgets(buf, sizeof(buf), f) && !strcmp(buf, "popen\n");
+    return LightProcess::pclose(f) == 0 && ok;
+  }
+
+  static bool ProcOpen() {
+    int fds[2];
+    if (pipe(fds) < 0) return false;
+    std::vector<int> created(1, fds[1]);
+    std::vector<int> desired(1, 1);
+    pid_t pid = LightProcess::proc_open("echo proc_open", created, desired,
+                                        "", std::vector<std::string>());
+    close(fds[1]);
+    char buf[64];
+    ssize_t n = pid > 0 ? read(fds[0], buf, sizeof(buf)) : -1;
+    close(fds[0]);
+    if (pid <= 0) return false;
+    int stat;
+    return LightProcess::waitpid(pid, &stat, 0) == pid &&
+      WIFEXITED(stat) && WEXITSTATUS(stat) == 0 &&
+      n == 10 && !memcmp(buf, "proc_open\n", 10);
+  }
+
+  int failures;
+};
+
+class BlockingWaiter {
+public:
+  explicit BlockingWaiter(pid_t p) : pid(p), ret(0), stat(0) {}
+  void run() { ret = LightProcess::waitpid(pid, &stat, 0); }
+
+  pid_t pid;
+  pid_t ret;
+  int stat;
+};
+}
+
+static pid_t spawn(const char *cmd) {
+  return LightProcess::proc_open(cmd, std::vector<int>(), std::vector<int>(),
+                                 "", std::vector<std::string>());
+}
+
+bool TestUtil::TestLightProcess() {
+  LightProcessScope scope(2);
+  VERIFY(LightProcess::Available());
+
+  // several threads spawning through the same shadows at once
+  const int count = 4;
+  SpawnWorker workers[count];
+  std::vector<boost::shared_ptr<AsyncFunc<SpawnWorker> > > funcs;
+  for (int i = 0; i < count; i++) {
+    funcs.push_back(boost::shared_ptr<AsyncFunc<SpawnWorker> >
+                    (new AsyncFunc<SpawnWorker>(&workers[i],
+                                                &SpawnWorker::run)));
+    funcs.back()->start();
+  }
+  for (int i = 0; i < count; i++) {
+    funcs[i]->waitForEnd();
+    VS(workers[i].failures, 0);
+  }
+
+  // a blocking waitpid doesn't hold up other spawns
+  pid_t pid = spawn("exec sleep 1");
+  VERIFY(pid > 0);
+  BlockingWaiter waiter(pid);
+  AsyncFunc<BlockingWaiter> waiterFunc(&waiter, &BlockingWaiter::run);
+  waiterFunc.start();
+  usleep(100000); // let its request get to the shadow
+  int64 start = Timer::GetCurrentTimeMicros();
+  for (int i = 0; i < 5; i++) {
+    VERIFY(SpawnWorker::Popen());
+    VERIFY(SpawnWorker::ProcOpen());
+  }
+  VERIFY(Timer::GetCurrentTimeMicros() - start < 500000);
+  waiterFunc.waitForEnd();
+  VS(waiter.ret, pid);
+  VERIFY(WIFEXITED(waiter.stat) && WEXITSTATUS(waiter.stat) == 0);
+
+  // a child still running when the wait times out gets killed
+  pid = spawn("exec sleep 30");
+  VERIFY(pid > 0);
+  start = Timer::GetCurrentTimeMicros();
+  int stat = 0;
+  VS(LightProcess::waitpid(pid, &stat, 0, 1), pid);
+  VERIFY(WIFSIGNALED(stat) && WTERMSIG(stat) == SIGKILL);
+  VERIFY(Timer::GetCurrentTimeMicros() - start < 5000000);
+
+  return Count(true);
+}
@@ -30,8 +30,10 @@ class TestUtil : public TestBase {
 
   bool TestLFUTable();
   bool TestSharedString();
+  bool TestSharedSessionStore();
   bool TestCanonicalize();
   bool TestHDF();
+  bool TestLightProcess();
 };
 
 ///////////////////////////////////////////////////////////////////////////////
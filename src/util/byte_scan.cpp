@@ -0,0 +1,206 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#include <util/byte_scan.h>
+#include <util/assert.h>
+
+// The vector kernels are compiled with per-function target attributes so
+// the rest of the binary does not need -msse4.2/-mavx2, and are only ever
+// called after cpuid says the instructions exist.
+#if defined(__x86_64__) && \
+  (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define BYTE_SCAN_SIMD 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+ByteSet &ByteSet::add(char c) {
+  if (contains(c)) return *this;
+  ASSERT(m_count < MaxBytes);
+  unsigned char uc = (unsigned char)c;
+  m_map[uc >> 6] |= 1ULL << (uc & 63);
+  m_bytes[m_count++] = c;
+  return *this;
+}
+
+ByteSet &ByteSet::addControl() {
+  m_control = true;
+  m_map[0] |= 0xffffffffULL;
+  return *this;
+}
+
+ByteSet &ByteSet::addHigh() {
+  m_high = true;
+  m_map[2] = m_map[3] = ~0ULL;
+  return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// kernels
+
+static const char *scan_scalar(const char *p, const char *end,
+                               const ByteSet &set) {
+  for (; p < end; p++) {
+    if (set.contains(*p)) break;
+  }
+  return p;
+}
+
+#ifdef BYTE_SCAN_SIMD
+
+/*
+ * Control and high bytes share one signed compare: as signed chars, 0x80-0xff
+ * are negative, so "x < 0x20" is true for both ranges. Control-only sets
+ * then mask the negative lanes back out; high-only sets just OR in the
+ * input itself, since movemask only looks at each lane's sign bit.
+ */
+
+__attribute__((__target__("sse4.2")))
+static const char *scan_sse42(const char *p, const char *end,
+                              const ByteSet &set) {
+  const __m128i needles = _mm_loadu_si128((const __m128i*)set.bytes());
+  const int count = set.count();
+  const __m128i space = _mm_set1_epi8(0x20);
+  const __m128i zero = _mm_setzero_si128();
+  const bool control = set.control();
+  const bool high = set.high();
+
+  for (; end - p >= 16; p += 16) {
+    __m128i x = _mm_loadu_si128((const __m128i*)p);
+    int idx = 16;
+    if (count) {
+      idx = _mm_cmpestri(needles, count, x, 16,
+                         _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY |
+                         _SIDD_LEAST_SIGNIFICANT);
+    }
+    if (control || high) {
+      __m128i m;
+      if (control) {
+        m = _mm_cmplt_epi8(x, space);
+        if (!high) m = _mm_andnot_si128(_mm_cmplt_epi8(x, zero), m);
+      } else {
+        m = x;
+      }
+      int bits = _mm_movemask_epi8(m);
+      if (bits) {
+        int i = __builtin_ctz(bits);
+        if (i < idx) idx = i;
+      }
+    }
+    if (idx < 16) return p + idx;
+  }
+  return scan_scalar(p, end, set);
+}
+
+__attribute__((__target__("avx2")))
+static const char *scan_avx2(const char *p, const char *end,
+                             const ByteSet &set) {
+  __m256i needles[ByteSet::MaxBytes];
+  const int count = set.count();
+  for (int i = 0; i < count; i++) {
+    needles[i] = _mm256_set1_epi8(set.bytes()[i]);
+  }
+  const __m256i space = _mm256_set1_epi8(0x20);
+  const __m256i zero = _mm256_setzero_si256();
+  const bool control = set.control();
+  const bool high = set.high();
+
+  for (; end - p >= 32; p += 32) {
+    __m256i x = _mm256_loadu_si256((const __m256i*)p);
+    __m256i m = zero;
+    for (int i = 0; i < count; i++) {
+      m = _mm256_or_si256(m, _mm256_cmpeq_epi8(x, needles[i]));
+    }
+    if (control) {
+      __m256i c = _mm256_cmpgt_epi8(space, x);
+      if (!high) c = _mm256_andnot_si256(_mm256_cmpgt_epi8(zero, x), c);
+      m = _mm256_or_si256(m, c);
+    } else if (high) {
+      m = _mm256_or_si256(m, x);
+    }
+    unsigned bits = _mm256_movemask_epi8(m);
+    if (bits) return p + __builtin_ctz(bits);
+  }
+  return scan_sse42(p, end, set);
+}
+
+static SimdLevel detect_simd_level() {
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return SimdScalar;
+  if (!(ecx & bit_SSE4_2)) return SimdScalar;
+
+  // AVX2 needs the CPU bit and the OS saving ymm state (OSXSAVE + XCR0).
+  const unsigned osxsave = 1u << 27, avx = 1u << 28;
+  if ((ecx & (osxsave | avx)) != (osxsave | avx)) return SimdSSE42;
+  unsigned xcr0_lo, xcr0_hi;
+  __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+  if ((xcr0_lo & 6) != 6) return SimdSSE42;
+  if (__get_cpuid_max(0, NULL) < 7) return SimdSSE42;
+  __cpuid_count(7, 0, eax, ebx, ecx, edx);
+  return (ebx & (1u << 5)) ? SimdAVX2 : SimdSSE42;
+}
+
+#else
+
+static SimdLevel detect_simd_level() {
+  return SimdScalar;
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// dispatch
+
+SimdLevel simd_level() {
+  static SimdLevel s_level = detect_simd_level();
+  return s_level;
+}
+
+const char *simd_level_name(SimdLevel level) {
+  switch (level) {
+  case SimdAVX2:   return "avx2";
+  case SimdSSE42:  return "sse4.2";
+  case SimdScalar: break;
+  }
+  return "scalar";
+}
+
+/*
+ * byte_scan_impl starts out pointing at this resolver rather than being set
+ * by a static initializer, so a caller running during static init still
+ * works. Threads may race to resolve; they all store the same kernel.
+ */
+static const char *scan_resolve(const char *p, const char *end,
+                                const ByteSet &set) {
+  ByteScanFunc f = scan_scalar;
+#ifdef BYTE_SCAN_SIMD
+  switch (simd_level()) {
+  case SimdAVX2:   f = scan_avx2;  break;
+  case SimdSSE42:  f = scan_sse42; break;
+  case SimdScalar: break;
+  }
+#endif
+  atomic_release_store(&byte_scan_impl, f);
+  return f(p, end, set);
+}
+
+ByteScanFunc byte_scan_impl = scan_resolve;
+
+///////////////////////////////////////////////////////////////////////////////
+}
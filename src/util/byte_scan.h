@@ -0,0 +1,95 @@
+/*
+   +----------------------------------------------------------------------+
+   | HipHop for PHP                                                       |
+   +----------------------------------------------------------------------+
+   | Copyright (c) 2010- Facebook, Inc. (http://www.facebook.com)         |
+   +----------------------------------------------------------------------+
+   | This source file is subject to version 3.01 of the PHP license,      |
+   | that is bundled with this package in the file LICENSE, and is        |
+   | available through the world-wide-web at the following url:           |
+   | http://www.php.net/license/3_01.txt                                  |
+   | If you did not receive a copy of the PHP license and are unable to   |
+   | obtain it through the world-wide-web, please send a note to          |
+   | license@php.net so we can mail you a copy immediately.               |
+   +----------------------------------------------------------------------+
+*/
+
+#ifndef __BYTE_SCAN_H__
+#define __BYTE_SCAN_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <util/atomic.h>
+
+namespace HPHP {
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Vector instruction sets we have kernels for, best last. Detected once per
+ * process with cpuid; the answer is the same on every thread.
+ */
+enum SimdLevel {
+  SimdScalar,
+  SimdSSE42,
+  SimdAVX2
+};
+
+SimdLevel simd_level();
+const char *simd_level_name(SimdLevel level);
+
+/**
+ * A set of "interesting" bytes for byte_scan(): up to 16 literal bytes plus,
+ * optionally, every control byte (0x00-0x1f) and/or every byte with the high
+ * bit set (0x80-0xff). Sets are cheap to copy but not free to build, so
+ * callers usually keep the ones they need in function-local statics, which
+ * are built on first use whatever the static initialization order.
+ */
+class ByteSet {
+public:
+  static const int MaxBytes = 16;
+
+  ByteSet() : m_count(0), m_control(false), m_high(false) {
+    memset(m_map, 0, sizeof(m_map));
+    memset(m_bytes, 0, sizeof(m_bytes));
+  }
+
+  ByteSet &add(char c);
+  ByteSet &addControl();
+  ByteSet &addHigh();
+
+  bool contains(char c) const {
+    unsigned char uc = (unsigned char)c;
+    return (m_map[uc >> 6] >> (uc & 63)) & 1;
+  }
+
+  int count() const { return m_count; }
+  const char *bytes() const { return m_bytes; }
+  bool control() const { return m_control; }
+  bool high() const { return m_high; }
+
+private:
+  uint64_t m_map[4];
+  char m_bytes[MaxBytes];
+  int m_count;
+  bool m_control;
+  bool m_high;
+};
+
+/**
+ * Returns a pointer to the first byte in [p, end) that is in the set, or end
+ * if there is none. Escaping loops use this to find the next byte they need
+ * to rewrite and copy everything before it with one memcpy.
+ */
+typedef const char *(*ByteScanFunc)(const char *p, const char *end,
+                                    const ByteSet &set);
+extern ByteScanFunc byte_scan_impl;
+
+inline const char *byte_scan(const char *p, const char *end,
+                             const ByteSet &set) {
+  return atomic_acquire_load(&byte_scan_impl)(p, end, set);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif // __BYTE_SCAN_H__
@@ -156,7 +156,110 @@ public:
         PERF_COUNT_HW_CACHE_L1D | ((PERF_COUNT_HW_CACHE_OP_WRITE) << 8)) {}
 };
 
-HardwareCounter::HardwareCounter() : m_countersSet(false) {
+class HardwareCounterGroup {
+public:
+  HardwareCounterGroup() : m_leader(-1), m_count(0) {
+    static const struct {
+      uint32_t type;
+      uint64_t config;
+    } events[HardwareCounter::RequestEventCount] = {
+      { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+      { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+      { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+      { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+      { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+    };
+
+    for (int i = 0; i < HardwareCounter::RequestEventCount; i++) {
+      m_fds[i] = -1;
+#ifndef VALGRIND
+      struct perf_event_attr pe;
+      memset(&pe, 0, sizeof(pe));
+      pe.type = events[i].type;
+      pe.size = sizeof(pe);
+      pe.config = events[i].config;
+      // switches happen in the kernel, everything else is the request's own
+      pe.exclude_kernel = events[i].type != PERF_TYPE_SOFTWARE;
+      pe.exclude_hv = 1;
+      if (m_leader < 0) {
+        pe.disabled = 1;
+        pe.read_format = PERF_FORMAT_GROUP |
+          PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      }
+      int fd = syscall(__NR_perf_event_open, &pe, 0, -1, m_leader, 0);
+      if (fd < 0) {
+        Logger::Verbose("perf_event_open failed for request event %d: %s",
+                        i, Util::safe_strerror(errno).c_str());
+        continue;
+      }
+      if (m_leader < 0) m_leader = fd;
+      m_fds[i] = fd;
+      m_index[i] = m_count++;
+#endif
+    }
+    if (m_leader >= 0 &&
+        ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) < 0) {
+      Logger::Warning("perf_event failed to enable request counters: %s",
+                      Util::safe_strerror(errno).c_str());
+      close();
+    }
+  }
+
+  ~HardwareCounterGroup() {
+    close();
+  }
+
+  bool read(int64 *values) {
+    if (m_leader < 0) return false;
+
+    // nr, time enabled, time running, then one value per member
+    uint64_t buf[3 + HardwareCounter::RequestEventCount];
+    ssize_t size = (3 + m_count) * sizeof(uint64_t);
+    if (::read(m_leader, buf, size) != size || !buf[2]) return false;
+    double scale = (double)buf[1] / buf[2];
+    for (int i = 0; i < HardwareCounter::RequestEventCount; i++) {
+      values[i] = m_fds[i] < 0 ? -1 : (int64)(buf[3 + m_index[i]] * scale);
+    }
+    return true;
+  }
+
+private:
+  int m_leader;
+  int m_count;
+  int m_fds[HardwareCounter::RequestEventCount];
+  int m_index[HardwareCounter::RequestEventCount]; // position in a read
+
+  void close() {
+    for (int i = 0; i < HardwareCounter::RequestEventCount; i++) {
+      if (m_fds[i] >= 0) {
+        ::close(m_fds[i]);
+        m_fds[i] = -1;
+      }
+    }
+    m_leader = -1;
+    m_count = 0;
+  }
+};
+
+const char *HardwareCounter::RequestEventNames[RequestEventCount] = {
+  "cycles",
+  "instructions",
+  "llc_misses",
+  "branch_misses",
+  "context_switches",
+};
+
+bool HardwareCounter::GetRequestCounters(int64 *values) {
+  HardwareCounter *counter = s_counter.getNoCheck();
+  if (!counter) return false;
+  if (!counter->m_requestCounters) {
+    counter->m_requestCounters = new HardwareCounterGroup();
+  }
+  return counter->m_requestCounters->read(values);
+}
+
+HardwareCounter::HardwareCounter()
+  : m_countersSet(false), m_requestCounters(NULL) {
   m_instructionCounter = new InstructionCounter();
   if (RuntimeOption::EvalProfileHWEvents == "") {
     m_loadCounter = new LoadCounter();
@@ -177,6 +280,7 @@ HardwareCounter::~HardwareCounter() {
     delete m_counters[i];
   }
   m_counters.clear();
+  delete m_requestCounters;
 }
 
 void HardwareCounter::Reset(void) {
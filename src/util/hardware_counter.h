@@ -35,12 +35,35 @@ struct PerfTable {
 };
 
 class HardwareCounterImpl;
+class HardwareCounterGroup;
 
 class HardwareCounter {
 public:
   HardwareCounter();
   ~HardwareCounter();
 
+  /**
+   * Counters the server takes over every request. They are opened as one
+   * perf_event group per thread, on first use, and read with a single
+   * read(), so ratios like instructions per cycle hold up even when the
+   * kernel has to multiplex them.
+   */
+  enum RequestEvent {
+    Cycles,
+    Instructions,
+    LLCMisses,
+    BranchMisses,
+    ContextSwitches,
+    RequestEventCount
+  };
+  static const char *RequestEventNames[RequestEventCount];
+
+  /**
+   * Fills values[RequestEventCount], with -1 for events this machine can't
+   * count. False when none can be counted.
+   */
+  static bool GetRequestCounters(int64 *values);
+
   static void  Reset(void);
   static int64 GetInstructionCount(void);
   static int64 GetLoadCount(void);
@@ -66,6 +89,7 @@ private:
   LoadCounter *m_loadCounter;
   StoreCounter *m_storeCounter;
   std::vector<HardwareCounterImpl *> m_counters;
+  HardwareCounterGroup *m_requestCounters;
 };
 ///////////////////////////////////////////////////////////////////////////////
 }}
@@ -22,8 +22,10 @@
 #include <afdt.h>
 #include <string>
 #include <vector>
+#include <list>
 #include <stdlib.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/wait.h>
 #include <poll.h>
 #include <pwd.h>
@@ -38,15 +40,6 @@ namespace HPHP {
 static const unsigned int BUFFER_SIZE = 4096;
 Mutex LightProcess::s_mutex;
 
-static void read_buf(FILE *fin, char *buf) {
-  if (!fgets(buf, BUFFER_SIZE, fin)) {
-    buf[0] = '\0';
-    return;
-  }
-  // get rid of '\n'
-  buf[strlen(buf) - 1] = '\0';
-}
-
 static bool send_fd(int afdt_fd, int fd) {
   afdt_error_t err;
   errno = 0;
@@ -94,93 +87,189 @@ static void close_fds(const vector<int> &fds) {
   }
 }
 
+static void set_cloexec(int fd) {
+  fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // shadow process tasks
 
-static void do_popen(FILE *fin, FILE *fout, int afdt_fd) {
-  char buf[BUFFER_SIZE];
-  char cwd[BUFFER_SIZE];
-
-  if (!fgets(buf, BUFFER_SIZE, fin)) buf[0] = '\0';
-  bool read_only = (buf[0] == 'r');
+namespace {
 
-  read_buf(fin, buf);
+/*
+ * Buffers the request pipe ourselves, so the event loop can tell a whole
+ * request is already in even when poll() says there's nothing to read.
+ */
+class RequestReader {
+public:
+  explicit RequestReader(int fd) : m_fd(fd), m_pos(0) {}
+
+  bool hasLine() const {
+    return m_buf.find('\n', m_pos) != string::npos;
+  }
+
+  /**
+   * Reads whatever has come in. False when the parent is gone.
+   */
+  bool fill() {
+    if (m_pos) {
+      m_buf.erase(0, m_pos);
+      m_pos = 0;
+    }
+    char buf[BUFFER_SIZE];
+    while (true) {
+      ssize_t n = read(m_fd, buf, sizeof(buf));
+      if (n < 0 && errno == EINTR) continue;
+      if (n <= 0) return false;
+      m_buf.append(buf, n);
+      return true;
+    }
+  }
 
-  string old_cwd = Process::GetCurrentDirectory();
-  read_buf(fin, cwd);
-  if (old_cwd != cwd) {
-    if (chdir(cwd)) {
-      // Ignore chdir failures, because the compiled version might not have the
-      // directory any more.
-      Logger::Warning("Light Process failed chdir to %s.", cwd);
+  /**
+   * The rest of a request is written right behind its first line, so this
+   * only ever blocks briefly.
+   */
+  bool readLine(string &line) {
+    size_t eol;
+    while ((eol = m_buf.find('\n', m_pos)) == string::npos) {
+      if (!fill()) {
+        line.clear();
+        return false;
+      }
     }
+    line = m_buf.substr(m_pos, eol - m_pos);
+    m_pos = eol + 1;
+    return true;
   }
 
-  FILE *f = buf[0] ? ::popen(buf, read_only ? "r" : "w") : NULL;
+private:
+  int m_fd;
+  string m_buf;
+  size_t m_pos;
+};
 
-  if (old_cwd != cwd && chdir(old_cwd.c_str())) {
-    // only here if we can't change the cwd back
-  }
+struct Waiter {
+  int64 id;
+  pid_t pid;
+  int options;
+  time_t deadline; // 0 for none
+  bool killed;
+};
 
-  if (f == NULL) {
-    Logger::Error("Light process failed popen: %d (%s).", errno,
-                  strerror(errno));
-    fprintf(fout, "error\n");
-    fflush(fout);
-  } else {
-    fprintf(fout, "success\n%lld\n", (int64)f);
-    fflush(fout);
-    int fd = fileno(f);
-    send_fd(afdt_fd, fd);
-  }
 }
 
-static void do_pclose(FILE *fin, FILE *fout) {
-  char buf[BUFFER_SIZE];
-
-  int64 fptr = 0;
-  read_buf(fin, buf);
-  sscanf(buf, "%lld", &fptr);
-  FILE *f = (FILE *)fptr;
-  int ret = ::pclose(f);
+static int s_sigchld[2] = { -1, -1 };
 
-  fprintf(fout, "%d\n", ret);
-  if (ret < 0) {
-    fprintf(fout, "%d\n", errno);
+static void sigchld_handler(int sig) {
+  int saved = errno;
+  if (write(s_sigchld[1], "", 1) < 0) {
+    // the pipe is full, so a wakeup is pending anyway
   }
+  errno = saved;
+}
+
+static void respond(FILE *fout, int64 id, int64 ret, int stat, int err,
+                    bool hasFd = false) {
+  fprintf(fout, "%lld %lld %d %d %d\n", id, ret, stat, err, hasFd ? 1 : 0);
   fflush(fout);
 }
 
-static void do_proc_open(FILE *fin, FILE *fout, int afdt_fd) {
-  char cmd[BUFFER_SIZE];
-  read_buf(fin, cmd);
-  if (strlen(cmd) == 0) {
-    fprintf(fout, "error\n%d\n", ENOENT);
-    fflush(fout);
+/*
+ * vfork() borrows our address space until the exec, so the child only makes
+ * system calls, and everything it needs is set up beforehand.
+ */
+static pid_t spawn_shell(const char *cmd, const char *cwd, char **envp,
+                         const vector<int> &from, const vector<int> &to) {
+  pid_t child = vfork();
+  if (child == 0) {
+    for (unsigned int i = 0; i < from.size(); i++) {
+      if (from[i] == to[i]) {
+        fcntl(to[i], F_SETFD, 0);
+      } else {
+        dup2(from[i], to[i]);
+      }
+    }
+    if (*cwd && chdir(cwd)) {
+      // non-zero for error
+      // chdir failed, the working directory remains unchanged
+    }
+    if (envp) {
+      execle("/bin/sh", "sh", "-c", cmd, NULL, envp);
+    } else {
+      execl("/bin/sh", "sh", "-c", cmd, NULL);
+    }
+    _exit(127);
+  }
+  return child;
+}
+
+static void do_popen(RequestReader &in, FILE *fout, int afdt_fd, int64 id) {
+  string type, cmd, cwd;
+  in.readLine(type);
+  in.readLine(cmd);
+  in.readLine(cwd);
+  if (cmd.empty()) {
+    respond(fout, id, -1, 0, ENOENT);
     return;
   }
 
-  char cwd[BUFFER_SIZE];
-  read_buf(fin, cwd);
+  int fds[2];
+  if (pipe(fds)) {
+    int err = errno;
+    Logger::Error("Light process failed popen: %d (%s).", err,
+                  strerror(err));
+    respond(fout, id, -1, 0, err);
+    return;
+  }
+  set_cloexec(fds[0]);
+  set_cloexec(fds[1]);
+
+  bool read_only = (type[0] == 'r');
+  int theirs = read_only ? fds[1] : fds[0];
+  int ours = read_only ? fds[0] : fds[1];
+  vector<int> from(1, theirs);
+  vector<int> to(1, read_only ? STDOUT_FILENO : STDIN_FILENO);
+  pid_t child = spawn_shell(cmd.c_str(), cwd.c_str(), NULL, from, to);
+  int err = errno;
+  ::close(theirs);
+
+  if (child < 0) {
+    Logger::Error("Light process failed popen: %d (%s).", err,
+                  strerror(err));
+    respond(fout, id, -1, 0, err);
+  } else {
+    respond(fout, id, child, 0, 0, true);
+    send_fd(afdt_fd, ours);
+  }
+  ::close(ours);
+}
 
-  char buf[BUFFER_SIZE];
+static void do_proc_open(RequestReader &in, FILE *fout, int afdt_fd,
+                         int64 id) {
+  string cmd;
+  in.readLine(cmd);
+  string cwd;
+  in.readLine(cwd);
+
+  string buf;
   int env_size = 0;
   vector<string> env;
-  read_buf(fin, buf);
-  sscanf(buf, "%d", &env_size);
+  in.readLine(buf);
+  sscanf(buf.c_str(), "%d", &env_size);
   for (int i = 0; i < env_size; i++) {
-    read_buf(fin, buf);
+    in.readLine(buf);
     env.push_back(buf);
   }
 
   int pipe_size = 0;
-  read_buf(fin, buf);
-  sscanf(buf, "%d", &pipe_size);
+  in.readLine(buf);
+  sscanf(buf.c_str(), "%d", &pipe_size);
   vector<int> pvals;
   for (int i = 0; i < pipe_size; i++) {
     int fd_value;
-    read_buf(fin, buf);
-    sscanf(buf, "%d", &fd_value);
+    in.readLine(buf);
+    sscanf(buf.c_str(), "%d", &fd_value);
     pvals.push_back(fd_value);
   }
 
@@ -188,82 +277,105 @@ static void do_proc_open(FILE *fin, FILE *fout, int afdt_fd) {
   for (int i = 0; i < pipe_size; i++) {
     int fd = recv_fd(afdt_fd);
     if (fd < 0) {
-      fprintf(fout, "error\n%d\n", EPROTO);
-      fflush(fout);
+      respond(fout, id, -1, 0, EPROTO);
       close_fds(pkeys);
       return;
     }
+    set_cloexec(fd);
     pkeys.push_back(fd);
   }
+  if (cmd.empty()) {
+    respond(fout, id, -1, 0, ENOENT);
+    close_fds(pkeys);
+    return;
+  }
 
   // now ready to start the child process
-  pid_t child = fork();
-  if (child == 0) {
-    for (int i = 0; i < pipe_size; i++) {
-      dup2(pkeys[i], pvals[i]);
-    }
-    if (strlen(cwd) > 0 && chdir(cwd)) {
-      // non-zero for error
-      // chdir failed, the working directory remains unchanged
-    }
-    if (!env.empty()) {
-      char **envp = build_envp(env);
-      execle("/bin/sh", "sh", "-c", cmd, NULL, envp);
-      free(envp);
-    } else {
-      execl("/bin/sh", "sh", "-c", cmd, NULL);
-    }
-    _exit(127);
-  } else if (child > 0) {
+  char **envp = build_envp(env);
+  pid_t child = spawn_shell(cmd.c_str(), cwd.c_str(), envp, pkeys, pvals);
+  int err = errno;
+  free(envp);
+  if (child > 0) {
     // successfully created the child process
-    fprintf(fout, "%lld\n", (int64)child);
-    fflush(fout);
+    respond(fout, id, child, 0, 0);
   } else {
     // failed creating the child process
-    fprintf(fout, "error\n%d\n", errno);
-    fflush(fout);
+    respond(fout, id, -1, 0, err);
   }
 
   close_fds(pkeys);
 }
 
-static pid_t waited = 0;
-
-static void kill_handler(int sig) {
-  if (sig == SIGALRM && waited) {
-    kill(waited, SIGKILL);
-  }
-}
-
-static void do_waitpid(FILE *fin, FILE *fout) {
-  char buf[BUFFER_SIZE];
-  read_buf(fin, buf);
+/*
+ * Answers right away unless the caller wants to block on a child that is
+ * still running; then it waits in the list until SIGCHLD comes in for it.
+ */
+static void do_waitpid(RequestReader &in, FILE *fout, int64 id,
+                       std::list<Waiter> &waiters) {
+  string buf;
+  in.readLine(buf);
   int64 p = -1;
   int options = 0;
   int timeout = 0;
-  sscanf(buf, "%lld %d %d", &p, &options, &timeout);
+  sscanf(buf.c_str(), "%lld %d %d", &p, &options, &timeout);
   pid_t pid = (pid_t)p;
-  int stat;
-  if (timeout > 0) {
-    waited = pid;
-    signal(SIGALRM, kill_handler);
-    alarm(timeout);
-  }
-  pid_t ret = ::waitpid(pid, &stat, options);
-  alarm(0); // cancel the previous alarm if not triggered yet
-  waited = 0;
-  fprintf(fout, "%lld %d\n", (int64)ret, stat);
-  if (ret < 0) {
-    fprintf(fout, "%d\n", errno);
+
+  int stat = 0;
+  pid_t ret = ::waitpid(pid, &stat, options | WNOHANG);
+  if (ret != 0 || (options & WNOHANG)) {
+    respond(fout, id, ret, stat, ret < 0 ? errno : 0);
+    return;
   }
-  fflush(fout);
+
+  Waiter w;
+  w.id = id;
+  w.pid = pid;
+  w.options = options;
+  w.deadline = timeout > 0 ? time(NULL) + timeout : 0;
+  w.killed = false;
+  waiters.push_back(w);
 }
 
-static void do_change_user(FILE *fin, FILE *fout) {
-  char uname[BUFFER_SIZE];
-  read_buf(fin, uname);
-  if (strlen(uname) > 0) {
-    struct passwd *pw = getpwnam(uname);
+static void check_waiters(FILE *fout, std::list<Waiter> &waiters) {
+  std::list<Waiter>::iterator it = waiters.begin();
+  while (it != waiters.end()) {
+    int stat = 0;
+    pid_t ret = ::waitpid(it->pid, &stat, it->options | WNOHANG);
+    if (ret == 0) {
+      ++it;
+      continue;
+    }
+    respond(fout, it->id, ret, stat, ret < 0 ? errno : 0);
+    it = waiters.erase(it);
+  }
+}
+
+/*
+ * Kills children that are still running past their waiters' timeouts, and
+ * returns how long poll() can sleep until the next one is due.
+ */
+static int expire_waiters(std::list<Waiter> &waiters) {
+  time_t now = time(NULL);
+  int timeout = -1;
+  for (std::list<Waiter>::iterator it = waiters.begin();
+       it != waiters.end(); ++it) {
+    if (!it->deadline || it->killed) continue;
+    if (it->deadline <= now) {
+      if (it->pid > 0) kill(it->pid, SIGKILL);
+      it->killed = true;
+      continue;
+    }
+    int ms = (it->deadline - now) * 1000;
+    if (timeout < 0 || ms < timeout) timeout = ms;
+  }
+  return timeout;
+}
+
+static void do_change_user(RequestReader &in) {
+  string uname;
+  in.readLine(uname);
+  if (uname.size() > 0) {
+    struct passwd *pw = getpwnam(uname.c_str());
     if (pw) {
       if (pw->pw_gid) {
         setgid(pw->pw_gid);
@@ -275,6 +387,32 @@ static void do_change_user(FILE *fin, FILE *fout) {
   }
 }
 
+/*
+ * Returns false once there's nothing more to do.
+ */
+static bool do_request(RequestReader &in, FILE *fout, int afdt_fd,
+                       std::list<Waiter> &waiters) {
+  string line;
+  if (!in.readLine(line)) return false;
+
+  char name[32];
+  long long id = 0;
+  if (sscanf(line.c_str(), "%31s %lld", name, &id) < 1) return true;
+  if (strcmp(name, "exit") == 0) {
+    Logger::Info("LightProces exiting upon request");
+    return false;
+  } else if (strcmp(name, "popen") == 0) {
+    do_popen(in, fout, afdt_fd, id);
+  } else if (strcmp(name, "proc_open") == 0) {
+    do_proc_open(in, fout, afdt_fd, id);
+  } else if (strcmp(name, "waitpid") == 0) {
+    do_waitpid(in, fout, id, waiters);
+  } else if (strcmp(name, "change_user") == 0) {
+    do_change_user(in);
+  }
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // light-weight process
 
@@ -283,7 +421,8 @@ static int g_procsCount = 0;
 
 LightProcess::LightProcess()
 : m_shadowProcess(0), m_fin(NULL), m_fout(NULL), m_afdt_fd(-1),
-  m_afdt_lfd(-1) { }
+  m_afdt_lfd(-1), m_reader(this, &LightProcess::readResponses),
+  m_nextId(0), m_dead(false) { }
 
 LightProcess::~LightProcess() {
 }
@@ -309,9 +448,14 @@ void LightProcess::Initialize(const std::string &prefix, int count,
       }
       g_procs.reset();
       g_procsCount = 0;
-      break;
+      return;
     }
   }
+
+  // only after the last fork, so no shadow starts out with a thread's locks
+  for (int i = 0; i < count; i++) {
+    g_procs[i].m_reader.start();
+  }
 }
 
 bool LightProcess::initShadow(const std::string &prefix, int id,
@@ -403,6 +547,8 @@ void LightProcess::closeShadow() {
   if (m_shadowProcess) {
     fprintf(m_fout, "exit\n");
     fflush(m_fout);
+    // the shadow going away ends the reader thread
+    m_reader.waitForEnd();
     fclose(m_fin);
     fclose(m_fout);
     // removes the "zombie" process, so not to interfere with later waits
@@ -430,50 +576,152 @@ bool LightProcess::Available() {
 }
 
 void LightProcess::runShadow(int fdin, int fdout) {
-  FILE *fin = fdopen(fdin, "r");
   FILE *fout = fdopen(fdout, "w");
 
-  char buf[BUFFER_SIZE];
+  // none of this is for the children
+  set_cloexec(fdin);
+  set_cloexec(fdout);
+  set_cloexec(m_afdt_fd);
 
-  pollfd pfd[1];
+  if (pipe(s_sigchld) == 0) {
+    set_cloexec(s_sigchld[0]);
+    set_cloexec(s_sigchld[1]);
+    fcntl(s_sigchld[0], F_SETFL, O_NONBLOCK);
+    fcntl(s_sigchld[1], F_SETFL, O_NONBLOCK);
+  } else {
+    Logger::Error("LightProcess unable to create pipe: %d (%s).", errno,
+                  strerror(errno));
+  }
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = sigchld_handler;
+  sa.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+  sigemptyset(&sa.sa_mask);
+  sigaction(SIGCHLD, &sa, NULL);
+  sigset_t mask;
+  sigemptyset(&mask);
+  sigaddset(&mask, SIGCHLD);
+  sigprocmask(SIG_UNBLOCK, &mask, NULL);
+
+  RequestReader in(fdin);
+  std::list<Waiter> waiters;
+
+  pollfd pfd[2];
   pfd[0].fd = fdin;
   pfd[0].events = POLLIN;
+  pfd[1].fd = s_sigchld[0];
+  pfd[1].events = POLLIN;
   while (true) {
-    int ret = poll(pfd, 1, -1);
+    bool more = true;
+    while (more && in.hasLine()) {
+      more = do_request(in, fout, m_afdt_fd, waiters);
+    }
+    if (!more) break;
+
+    int ret = poll(pfd, 2, expire_waiters(waiters));
     if (ret < 0 && errno == EINTR) {
       continue;
     }
-    if (pfd[0].revents & POLLHUP) {
-      // no more command can come in
-      Logger::Error("Lost parent, LightProcess exiting");
-      break;
+    if (pfd[1].revents & POLLIN) {
+      char buf[64];
+      while (read(s_sigchld[0], buf, sizeof(buf)) > 0) {}
+      check_waiters(fout, waiters);
     }
-    else if (pfd[0].revents & POLLIN) {
-      if (!fgets(buf, BUFFER_SIZE, fin)) buf[0] = '\0';
-      if (strncmp(buf, "exit", 4) == 0) {
-        Logger::Info("LightProces exiting upon request");
+    if (pfd[0].revents & (POLLIN | POLLHUP)) {
+      if (!in.fill()) {
+        // no more command can come in
+        Logger::Error("Lost parent, LightProcess exiting");
         break;
-      } else if (strncmp(buf, "popen", 5) == 0) {
-        do_popen(fin, fout, m_afdt_fd);
-      } else if (strncmp(buf, "pclose", 6) == 0) {
-        do_pclose(fin, fout);
-      } else if (strncmp(buf, "proc_open", 9) == 0) {
-        do_proc_open(fin, fout, m_afdt_fd);
-      } else if (strncmp(buf, "waitpid", 7) == 0) {
-        do_waitpid(fin, fout);
-      } else if (strncmp(buf, "change_user", 11) == 0) {
-        do_change_user(fin, fout);
       }
     }
   }
 
-  fclose(fin);
   fclose(fout);
+  ::close(fdin);
   ::close(m_afdt_fd);
   remove(m_afdtFilename.c_str());
   exit(0);
 }
 
+void LightProcess::call(const char *name, const std::string &body,
+                        Response &resp, const vector<int> *fds /* = NULL */) {
+  resp.ret = -1;
+  resp.stat = 0;
+  resp.err = EPIPE;
+  resp.fd = -1;
+  resp.done = false;
+
+  int64 id;
+  {
+    Lock lock(&m_responded);
+    if (m_dead) return;
+    id = ++m_nextId;
+    m_pending[id] = &resp;
+  }
+
+  bool error_send = false;
+  int save_errno = 0;
+  {
+    Lock lock(m_procMutex);
+    fprintf(m_fout, "%s %lld\n%s", name, id, body.c_str());
+    fflush(m_fout);
+    for (unsigned int i = 0; fds && i < fds->size(); i++) {
+      if (!send_fd(m_afdt_fd, (*fds)[i])) {
+        error_send = true;
+        save_errno = errno;
+        break;
+      }
+    }
+  }
+
+  Lock lock(&m_responded);
+  while (!resp.done) {
+    m_responded.wait();
+  }
+  if (error_send && resp.ret < 0) {
+    // On this error, the receiver side returns dummy errno,
+    // use the sender side errno here.
+    resp.err = save_errno;
+  }
+}
+
+void LightProcess::readResponses() {
+  char buf[BUFFER_SIZE];
+  while (fgets(buf, BUFFER_SIZE, m_fin)) {
+    long long id, ret;
+    int stat, err, hasFd;
+    if (sscanf(buf, "%lld %lld %d %d %d", &id, &ret, &stat, &err,
+               &hasFd) != 5) {
+      continue;
+    }
+    int fd = hasFd ? recv_fd(m_afdt_fd) : -1;
+
+    Lock lock(&m_responded);
+    std::map<int64, Response*>::iterator it = m_pending.find(id);
+    if (it == m_pending.end()) {
+      if (fd >= 0) ::close(fd);
+      continue;
+    }
+    Response *resp = it->second;
+    m_pending.erase(it);
+    resp->ret = ret;
+    resp->stat = stat;
+    resp->err = err;
+    resp->fd = fd;
+    resp->done = true;
+    m_responded.notifyAll();
+  }
+
+  Lock lock(&m_responded);
+  m_dead = true;
+  for (std::map<int64, Response*>::iterator it = m_pending.begin();
+       it != m_pending.end(); ++it) {
+    it->second->done = true;
+  }
+  m_pending.clear();
+  m_responded.notifyAll();
+}
+
 int LightProcess::GetId() {
   return (long)pthread_self() % g_procsCount;
 }
@@ -515,34 +763,23 @@ FILE *LightProcess::HeavyPopenImpl(const char *cmd, const char *type,
 
 FILE *LightProcess::LightPopenImpl(const char *cmd, const char *type,
                                    const char *cwd) {
-  int id = GetId();
-  Lock lock(g_procs[id].m_procMutex);
-
-  fprintf(g_procs[id].m_fout, "popen\n%s\n%s\n%s\n", type, cmd, cwd);
-  fflush(g_procs[id].m_fout);
-
-  char buf[BUFFER_SIZE];
-  read_buf(g_procs[id].m_fin, buf);
-  if (strncmp(buf, "error", 5) == 0) {
-    return NULL;
-  }
+  LightProcess &proc = g_procs[GetId()];
 
-  int64 fptr = 0;
-  read_buf(g_procs[id].m_fin, buf);
-  sscanf(buf, "%lld", &fptr);
-  if (!fptr) {
-    Logger::Error("Light process failed to return the file pointer.");
+  std::ostringstream os;
+  os << type << "\n" << cmd << "\n" << (cwd ? cwd : "") << "\n";
+  Response resp;
+  proc.call("popen", os.str(), resp);
+  if (resp.ret <= 0) {
     return NULL;
   }
-
-  int fd = recv_fd(g_procs[id].m_afdt_fd);
-  if (fd < 0) {
+  if (resp.fd < 0) {
     Logger::Error("Light process failed to send the file descriptor.");
     return NULL;
   }
-  FILE *f = fdopen(fd, type);
-  g_procs[id].m_popenMap[(int64)f] = fptr;
 
+  FILE *f = fdopen(resp.fd, type);
+  Lock lock(proc.m_procMutex);
+  proc.m_popenMap[(int64)f] = resp.ret;
   return f;
 }
 
@@ -551,81 +788,52 @@ int LightProcess::pclose(FILE *f) {
     return ::pclose(f);
   }
 
-  int id = GetId();
-  Lock lock(g_procs[id].m_procMutex);
-
-  std::map<int64, int64>::iterator it = g_procs[id].m_popenMap.find((int64)f);
-  if (it == g_procs[id].m_popenMap.end()) {
-    // try to close it with normal pclose
-    return ::pclose(f);
+  LightProcess &proc = g_procs[GetId()];
+  int64 pid;
+  {
+    Lock lock(proc.m_procMutex);
+    std::map<int64, int64>::iterator it = proc.m_popenMap.find((int64)f);
+    if (it == proc.m_popenMap.end()) {
+      // try to close it with normal pclose
+      return ::pclose(f);
+    }
+    pid = it->second;
+    proc.m_popenMap.erase(it);
   }
 
-  int64 f2 = it->second;
-  g_procs[id].m_popenMap.erase((int64)f);
   fclose(f);
-  fprintf(g_procs[id].m_fout, "pclose\n%lld\n", f2);
-  fflush(g_procs[id].m_fout);
-
-  char buf[BUFFER_SIZE];
-  read_buf(g_procs[id].m_fin, buf);
-  int ret = -1;
-  sscanf(buf, "%d", &ret);
-  if (ret < 0) {
-    read_buf(g_procs[id].m_fin, buf);
-    sscanf(buf, "%d", &errno);
+  int stat;
+  if (waitpid((pid_t)pid, &stat, 0) < 0) {
+    return -1;
   }
-  return ret;
+  return stat;
 }
 
 pid_t LightProcess::proc_open(const char *cmd, const vector<int> &created,
                               const vector<int> &desired,
                               const char *cwd, const vector<string> &env) {
-  int id = GetId();
-  Lock lock(g_procs[id].m_procMutex);
   assert(Available());
   assert(created.size() == desired.size());
+  LightProcess &proc = g_procs[GetId()];
 
-  if (fprintf(g_procs[id].m_fout, "proc_open\n%s\n%s\n", cmd, cwd) <= 0) {
-    Logger::Error("Failed to send command proc_open");
-    return -1;
-  }
-  fprintf(g_procs[id].m_fout, "%d\n", (int)env.size());
+  std::ostringstream os;
+  os << cmd << "\n" << cwd << "\n" << env.size() << "\n";
   for (unsigned int i = 0; i < env.size(); i++) {
-    fprintf(g_procs[id].m_fout, "%s\n", env[i].c_str());
+    os << env[i] << "\n";
   }
-
-  fprintf(g_procs[id].m_fout, "%d\n", (int)created.size());
-
+  os << created.size() << "\n";
   for (unsigned int i = 0; i < desired.size(); i++) {
-    fprintf(g_procs[id].m_fout, "%d\n", desired[i]);
-  }
-  fflush(g_procs[id].m_fout);
-  bool error_send = false;
-  int save_errno = 0;
-  for (unsigned int i = 0; i < created.size(); i++) {
-    if (!send_fd(g_procs[id].m_afdt_fd, created[i])) {
-      error_send = true;
-      save_errno = errno;
-      break;
-    }
+    os << desired[i] << "\n";
   }
 
-  char buf[BUFFER_SIZE];
-  read_buf(g_procs[id].m_fin, buf);
-  if (strncmp(buf, "error", 5) == 0) {
-    read_buf(g_procs[id].m_fin, buf);
-    sscanf(buf, "%d", &errno);
-    if (error_send) {
-      // On this error, the receiver side returns dummy errno,
-      // use the sender side errno here.
-      errno = save_errno;
-    }
+  Response resp;
+  proc.call("proc_open", os.str(), resp, &created);
+  if (resp.ret < 0) {
+    errno = resp.err;
     return -1;
   }
-  int64 pid = -1;
-  sscanf(buf, "%lld", &pid);
-  ASSERT(pid);
-  return (pid_t)pid;
+  ASSERT(resp.ret);
+  return (pid_t)resp.ret;
 }
 
 pid_t LightProcess::waitpid(pid_t pid, int *stat_loc, int options,
@@ -635,25 +843,15 @@ pid_t LightProcess::waitpid(pid_t pid, int *stat_loc, int options,
     return ::waitpid(pid, stat_loc, options);
   }
 
-  int id = GetId();
-  Lock lock(g_procs[id].m_procMutex);
-
-  fprintf(g_procs[id].m_fout, "waitpid\n%lld %d %d\n", (int64)pid, options,
-          timeout);
-  fflush(g_procs[id].m_fout);
-
-  char buf[BUFFER_SIZE];
-  read_buf(g_procs[id].m_fin, buf);
-  if (!buf[0]) return -1;
-  int64 ret;
-  int stat;
-  sscanf(buf, "%lld %d", &ret, &stat);
-  *stat_loc = stat;
-  if (ret < 0) {
-    read_buf(g_procs[id].m_fin, buf);
-    sscanf(buf, "%d", &errno);
-  }
-  return (pid_t)ret;
+  std::ostringstream os;
+  os << (int64)pid << " " << options << " " << timeout << "\n";
+  Response resp;
+  g_procs[GetId()].call("waitpid", os.str(), resp);
+  *stat_loc = resp.stat;
+  if (resp.ret < 0) {
+    errno = resp.err;
+  }
+  return (pid_t)resp.ret;
 }
 
 pid_t LightProcess::pcntl_waitpid(pid_t pid, int *stat_loc, int options) {
@@ -661,11 +859,10 @@ pid_t LightProcess::pcntl_waitpid(pid_t pid, int *stat_loc, int options) {
     return ::waitpid(pid, stat_loc, options);
   }
 
-  int id = GetId();
-  Lock lock(g_procs[id].m_procMutex);
-
+  // no lock: a blocking wait here mustn't hold up spawns
+  pid_t shadow = g_procs[GetId()].m_shadowProcess;
   pid_t p = ::waitpid(pid, stat_loc, options);
-  if (p == g_procs[id].m_shadowProcess) {
+  if (p == shadow) {
     // got the shadow process, wait again
     p = ::waitpid(pid, stat_loc, options);
   }
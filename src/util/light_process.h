@@ -19,6 +19,8 @@
 
 #include "process.h"
 #include "lock.h"
+#include "async_func.h"
+#include "synchronizable.h"
 #include <string>
 #include <vector>
 
@@ -26,6 +28,18 @@ namespace HPHP {
 ///////////////////////////////////////////////////////////////////////////////
 // light-weight process
 
+/**
+ * Shadow processes forked early on, while the server is still small, that
+ * start child processes for it.
+ *
+ * Every request to a shadow carries an id and gets a response line with
+ * that id, so any number of threads can have requests out to the same
+ * shadow: a caller only holds the shadow's lock while writing its request,
+ * and a reader thread hands each response to the thread waiting for it.
+ * The shadow itself never blocks on a child. It starts them with vfork(),
+ * so it doesn't copy its page tables per spawn, and it answers a blocking
+ * waitpid only when SIGCHLD says the child is done.
+ */
 class LightProcess {
 public:
   LightProcess();
@@ -65,8 +79,23 @@ public:
   static pid_t pcntl_waitpid(pid_t pid, int *stat_loc, int options);
 
 private:
+  struct Response {
+    int64 ret;
+    int stat;
+    int err;
+    int fd;    // passed back over the afdt socket, or -1
+    bool done;
+  };
+
   static int GetId();
 
+  /**
+   * Sends "name id\nbody" and any fds, and waits for the response.
+   */
+  void call(const char *name, const std::string &body, Response &resp,
+            const std::vector<int> *fds = NULL);
+  void readResponses();
+
   bool initShadow(const std::string &prefix, int id,
                   const std::vector<int> &inherited_fds);
   void runShadow(int fdin, int fdout);
@@ -86,11 +115,17 @@ private:
   pid_t m_shadowProcess;
   FILE *m_fin;   // the pipe to read from the child
   FILE *m_fout;  // the pipe to write to the child
-  Mutex m_procMutex;
+  Mutex m_procMutex; // for writing requests and for m_popenMap
   std::string m_afdtFilename;
   int m_afdt_fd;
   int m_afdt_lfd;
-  std::map<int64, int64> m_popenMap;
+  std::map<int64, int64> m_popenMap; // FILE* to pid
+
+  AsyncFunc<LightProcess> m_reader;
+  Synchronizable m_responded; // protects the following
+  std::map<int64, Response*> m_pending;
+  int64 m_nextId;
+  bool m_dead;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -22,6 +22,8 @@
 
 #include "util/trace.h"
 #include "util/logger.h"
+#include "util/async_func.h"
+#include "util/synchronizable.h"
 #include "util/stat_cache.h"
 #include "runtime/base/runtime_option.h"
 #include "runtime/vm/translator/hooks.h"
@@ -873,8 +875,56 @@ std::string StatCache::realpathImpl(const char* path) {
 
 StatCache StatCache::s_sc;
 
+class StatCache::Refresher : public Synchronizable {
+ public:
+  Refresher() : m_stopped(false), m_thread(this, &Refresher::run) {}
+
+  void start() { m_thread.start(); }
+  void stop() {
+    {
+      Lock lock(this);
+      m_stopped = true;
+      notify();
+    }
+    m_thread.waitForEnd();
+  }
+
+  void run() {
+    long long ns = RuntimeOption::ServerStatCacheRefreshMs * 1000000LL;
+    Lock lock(this);
+    while (!m_stopped) {
+      s_sc.refresh();
+      wait(ns / 1000000000LL, ns % 1000000000LL);
+    }
+  }
+
+ private:
+  bool m_stopped;
+  AsyncFunc<Refresher> m_thread;
+};
+
+StatCache::Refresher* StatCache::s_refresher;
+
+void StatCache::StartRefresher() {
+  StopRefresher();
+  if (!RuntimeOption::ServerStatCache ||
+      RuntimeOption::ServerStatCacheRefreshMs <= 0) {
+    return;
+  }
+  s_refresher = new Refresher();
+  s_refresher->start();
+}
+
+void StatCache::StopRefresher() {
+  if (s_refresher) {
+    s_refresher->stop();
+    delete s_refresher;
+    s_refresher = NULL;
+  }
+}
+
 void StatCache::requestInit() {
-  if (!RuntimeOption::ServerStatCache) return;
+  if (!RuntimeOption::ServerStatCache || s_refresher) return;
   s_sc.refresh();
 }
 
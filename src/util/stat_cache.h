@@ -90,12 +90,20 @@ class StatCache {
   ~StatCache();
 
   static void requestInit(); // Process pending file change notifications.
+  /*
+   * With Server.StatCacheRefreshMs set, a background thread processes them
+   * instead, and requestInit() does nothing.
+   */
+  static void StartRefresher();
+  static void StopRefresher();
   static int stat(const std::string& path, struct stat* buf);
   static int lstat(const std::string& path, struct stat* buf);
   static std::string readlink(const std::string& path);
   static std::string realpath(const char* path);
 
  private:
+  class Refresher;
+
   bool init();
   void clear();
   void reset();
@@ -113,6 +121,7 @@ class StatCache {
   std::string realpathImpl(const char* path);
 
   static StatCache s_sc;
+  static Refresher* s_refresher;
 
   NameNodeMap m_path2Node;  // stat() path cache.
   NameNodeMap m_lpath2Node; // lstat() path cache.